@@ -4,14 +4,18 @@
  * Uses Tolk library for screen reader support (NVDA, JAWS, etc.)
  * Uses OpenAL for directional audio radar tones.
  * Tolk provides a unified interface to screen readers with SAPI fallback.
+ * Speech runs on its own thread; on Linux speech-dispatcher or espeak-ng is used.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <ctype.h>
 #include <math.h>
 
+#include <SDL3/SDL.h>
+
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -28,6 +32,7 @@ extern "C" {
 #include "fixer.h"
 #include "3dc.h"
 #include "platform.h"
+#include "inline.h"
 #include "gamedef.h"
 #include "stratdef.h"
 #include "bh_types.h"
@@ -37,6 +42,8 @@ extern "C" {
 #include "avpview.h"
 #include "equipmnt.h"
 #include "los.h"
+#include "pfarlocs.h"
+#include "pvisible.h"
 
 /* Mission objectives function from missions.cpp */
 int GetMissionObjectivesText(char* buffer, int bufferSize);
@@ -51,6 +58,12 @@ extern TEMPLATE_AMMO_DATA TemplateAmmo[];
 extern enum VISION_MODE_ID CurrentVisionMode;
 /* Note: PLAYERCLOAK_MAXENERGY is defined in bh_types.h */
 
+/* Locate the render module containing a point (pvisible.c) */
+MODULE* ModuleFromPosition(VECTORCH *position, MODULE* startingModule);
+
+/* Console/HUD message line (hud.c) */
+void NewOnScreenMessage(unsigned char *messagePtr);
+
 /* Line of sight check */
 int IsThisObjectVisibleFromThisPosition_WithIgnore(DISPLAYBLOCK *ignoredObjectPtr,
     DISPLAYBLOCK *objectPtr, VECTORCH *positionPtr, int maxRange);
@@ -91,12 +104,302 @@ typedef enum {
     LOG_ERROR = 3
 } LOG_LEVEL;
 
+/*
+ * Log calls never touch the disk. Log_Write claims a slot in a lock-free
+ * ring of fixed-size binary records (bounded MPSC queue with per-slot
+ * sequence numbers), stores the format pointer, a tick stamp and the raw
+ * arguments, and returns. A background thread formats the records and
+ * writes them out. Format strings must be literals; %s arguments are
+ * copied into the record because the caller's buffer may be gone by then.
+ */
+#define LOG_RING_SIZE           1024    /* Records, must be a power of two */
+#define LOG_RING_MASK           (LOG_RING_SIZE - 1)
+#define LOG_MAX_ARGS            8
+#define LOG_STRING_BYTES        160     /* Inline storage for %s arguments */
+#define LOG_LINE_BYTES          1024
+#define LOG_DRAIN_INTERVAL_MS   50
+#define LOG_WAKE_INTERVAL       (LOG_RING_SIZE / 4)
+
+typedef enum {
+    LOG_ARG_INT,
+    LOG_ARG_LONG,
+    LOG_ARG_LLONG,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_POINTER,
+    LOG_ARG_STRING,
+    LOG_ARG_NONE        /* %% or an unsupported conversion */
+} LOG_ARG_TYPE;
+
+typedef union {
+    long long i;
+    double d;
+    const void* p;
+    unsigned int str;   /* Offset into LOG_RECORD.strings */
+} LOG_ARG_VALUE;
+
+typedef struct {
+    SDL_AtomicU32 sequence;         /* == slot position when free, +1 when published */
+    unsigned char level;
+    unsigned char argCount;
+    unsigned short stringBytes;
+    Uint64 ticks;                   /* SDL_GetPerformanceCounter at Log_Write */
+    const char* format;
+    unsigned char argTypes[LOG_MAX_ARGS];
+    LOG_ARG_VALUE args[LOG_MAX_ARGS];
+    char strings[LOG_STRING_BYTES];
+} LOG_RECORD;
+
+/* One parsed printf conversion */
+typedef struct {
+    int stars;              /* '*' width/precision arguments preceding the value */
+    LOG_ARG_TYPE type;
+} LOG_SPEC;
+
 static FILE* g_LogFile = NULL;
 static int g_LoggingEnabled = 1;
 static LOG_LEVEL g_LogLevel = LOG_DEBUG;  /* Default to DEBUG for troubleshooting */
 
+static LOG_RECORD g_LogRing[LOG_RING_SIZE];
+static SDL_AtomicU32 g_LogWritePos;
+static Uint32 g_LogReadPos = 0;            /* Owned by the drain side */
+static SDL_AtomicInt g_LogDropped;         /* Overflowed records since last report */
+static int g_LogDroppedTotal = 0;
+static SDL_Thread* g_LogThread = NULL;
+static SDL_Semaphore* g_LogWake = NULL;
+static SDL_AtomicInt g_LogThreadRunning;
+static SDL_SpinLock g_LogDrainLock = 0;    /* Serializes synchronous drains without the thread */
+static Uint64 g_LogBaseTicks = 0;
+static Uint64 g_LogTickFrequency = 1;
+static ULARGE_INTEGER g_LogBaseTime;       /* Local time at g_LogBaseTicks, 100ns units */
+
 static const char* LogLevelNames[] = { "DEBUG", "INFO", "WARNING", "ERROR" };
 
+/* Parse the conversion following a '%'. Returns the first char after it. */
+static const char* Log_ParseSpec(const char* p, LOG_SPEC* spec)
+{
+    int longness = 0;
+
+    spec->stars = 0;
+    spec->type = LOG_ARG_NONE;
+
+    if (*p == '%') return p + 1;
+
+    while (*p && strchr("-+ #0", *p)) p++;
+    if (*p == '*') { spec->stars++; p++; }
+    else while (*p >= '0' && *p <= '9') p++;
+    if (*p == '.') {
+        p++;
+        if (*p == '*') { spec->stars++; p++; }
+        else while (*p >= '0' && *p <= '9') p++;
+    }
+    while (*p && strchr("hlLjzt", *p)) {
+        if (*p == 'l') longness++;
+        else if (*p == 'j' || *p == 'z' || *p == 't') longness = 2;
+        p++;
+    }
+
+    switch (*p) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            spec->type = longness >= 2 ? LOG_ARG_LLONG : (longness == 1 ? LOG_ARG_LONG : LOG_ARG_INT);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            spec->type = LOG_ARG_DOUBLE;
+            break;
+        case 'p':
+            spec->type = LOG_ARG_POINTER;
+            break;
+        case 's':
+            spec->type = LOG_ARG_STRING;
+            break;
+        default:
+            return p;   /* Unsupported (or end of string): leave it as literal text */
+    }
+    return p + 1;
+}
+
+/* Copy the arguments described by format into the record */
+static void Log_CaptureArgs(LOG_RECORD* rec, const char* format, va_list args)
+{
+    const char* p = format;
+    LOG_SPEC spec;
+    int argc = 0;
+    unsigned int stringBytes = 0;
+
+    while ((p = strchr(p, '%')) != NULL) {
+        p = Log_ParseSpec(p + 1, &spec);
+        if (spec.type == LOG_ARG_NONE) continue;
+        if (argc + spec.stars + 1 > LOG_MAX_ARGS) break;
+
+        while (spec.stars-- > 0) {
+            rec->argTypes[argc] = LOG_ARG_INT;
+            rec->args[argc++].i = va_arg(args, int);
+        }
+
+        rec->argTypes[argc] = (unsigned char)spec.type;
+        switch (spec.type) {
+            case LOG_ARG_INT:     rec->args[argc].i = va_arg(args, int); break;
+            case LOG_ARG_LONG:    rec->args[argc].i = va_arg(args, long); break;
+            case LOG_ARG_LLONG:   rec->args[argc].i = va_arg(args, long long); break;
+            case LOG_ARG_DOUBLE:  rec->args[argc].d = va_arg(args, double); break;
+            case LOG_ARG_POINTER: rec->args[argc].p = va_arg(args, void*); break;
+            case LOG_ARG_STRING: {
+                const char* str = va_arg(args, const char*);
+                unsigned int room = LOG_STRING_BYTES - stringBytes;
+                unsigned int len;
+                if (!str) str = "(null)";
+                len = (unsigned int)strlen(str);
+                if (room == 0) {
+                    rec->args[argc].str = LOG_STRING_BYTES - 1;   /* Shares the last terminator */
+                    break;
+                }
+                if (len >= room) len = room - 1;
+                memcpy(rec->strings + stringBytes, str, len);
+                rec->strings[stringBytes + len] = '\0';
+                rec->args[argc].str = stringBytes;
+                stringBytes += len + 1;
+                break;
+            }
+            default:
+                break;
+        }
+        argc++;
+    }
+
+    rec->argCount = (unsigned char)argc;
+    rec->stringBytes = (unsigned short)stringBytes;
+    if (stringBytes == 0) rec->strings[LOG_STRING_BYTES - 1] = '\0';
+}
+
+/* Expand a record's format with its stored arguments */
+static void Log_FormatRecord(const LOG_RECORD* rec, char* line, int lineSize)
+{
+    const char* p = rec->format;
+    int used = 0;
+    int arg = 0;
+
+    while (*p && used < lineSize - 1) {
+        const char* specStart;
+        char specBuf[64];
+        int specLen = 0;
+        LOG_SPEC spec;
+        int n;
+
+        if (*p != '%') {
+            line[used++] = *p++;
+            continue;
+        }
+
+        specStart = p;
+        p = Log_ParseSpec(p + 1, &spec);
+        if (spec.type == LOG_ARG_NONE) {
+            if (p - specStart == 2 && specStart[1] == '%') line[used++] = '%';
+            else { line[used++] = '%'; p = specStart + 1; }
+            continue;
+        }
+        if (arg + spec.stars + 1 > rec->argCount) {
+            n = snprintf(line + used, lineSize - used, "<?>");
+            used += (n > 0) ? n : 0;
+            continue;
+        }
+
+        /* Rebuild the spec with any '*' replaced by its captured value */
+        for (const char* s = specStart; s < p && specLen < (int)sizeof(specBuf) - 12; s++) {
+            if (*s == '*') specLen += snprintf(specBuf + specLen, sizeof(specBuf) - specLen, "%d", (int)rec->args[arg++].i);
+            else specBuf[specLen++] = *s;
+        }
+        specBuf[specLen] = '\0';
+
+        switch (rec->argTypes[arg]) {
+            case LOG_ARG_INT:     n = snprintf(line + used, lineSize - used, specBuf, (int)rec->args[arg].i); break;
+            case LOG_ARG_LONG:    n = snprintf(line + used, lineSize - used, specBuf, (long)rec->args[arg].i); break;
+            case LOG_ARG_LLONG:   n = snprintf(line + used, lineSize - used, specBuf, rec->args[arg].i); break;
+            case LOG_ARG_DOUBLE:  n = snprintf(line + used, lineSize - used, specBuf, rec->args[arg].d); break;
+            case LOG_ARG_POINTER: n = snprintf(line + used, lineSize - used, specBuf, rec->args[arg].p); break;
+            case LOG_ARG_STRING:  n = snprintf(line + used, lineSize - used, specBuf, rec->strings + rec->args[arg].str); break;
+            default:              n = 0; break;
+        }
+        arg++;
+        if (n > 0) used += n;
+        if (used > lineSize - 1) used = lineSize - 1;
+    }
+    line[used] = '\0';
+}
+
+/* Convert a record's tick stamp to local wall-clock time */
+static void Log_TicksToTime(Uint64 ticks, SYSTEMTIME* st)
+{
+    ULARGE_INTEGER t;
+    FILETIME ft;
+    Uint64 elapsed = ticks - g_LogBaseTicks;
+
+    t.QuadPart = g_LogBaseTime.QuadPart
+        + (elapsed / g_LogTickFrequency) * 10000000ULL
+        + ((elapsed % g_LogTickFrequency) * 10000000ULL) / g_LogTickFrequency;
+    ft.dwLowDateTime = t.LowPart;
+    ft.dwHighDateTime = t.HighPart;
+    FileTimeToSystemTime(&ft, st);
+}
+
+static void Log_WriteLine(LOG_LEVEL level, Uint64 ticks, const char* text)
+{
+    SYSTEMTIME st;
+    Log_TicksToTime(ticks, &st);
+    fprintf(g_LogFile, "[%04d-%02d-%02d %02d:%02d:%02d.%03d] [%s] %s\n",
+            st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond, st.wMilliseconds,
+            LogLevelNames[level], text);
+}
+
+/* Format and write every published record. Only one drainer at a time. */
+static void Log_DrainPending(void)
+{
+    char line[LOG_LINE_BYTES];
+    int written = 0;
+    int dropped;
+
+    for (;;) {
+        LOG_RECORD* rec = &g_LogRing[g_LogReadPos & LOG_RING_MASK];
+        Uint32 seq = SDL_GetAtomicU32(&rec->sequence);
+        if ((int)(seq - (g_LogReadPos + 1)) < 0) break;   /* Not published yet */
+
+        Log_FormatRecord(rec, line, sizeof(line));
+        Log_WriteLine((LOG_LEVEL)rec->level, rec->ticks, line);
+        written++;
+
+        /* Hand the slot back to producers for the next lap */
+        SDL_SetAtomicU32(&rec->sequence, g_LogReadPos + LOG_RING_SIZE);
+        g_LogReadPos++;
+    }
+
+    dropped = SDL_SetAtomicInt(&g_LogDropped, 0);
+    if (dropped > 0) {
+        g_LogDroppedTotal += dropped;
+        snprintf(line, sizeof(line), "Log ring overflow: %d record(s) dropped", dropped);
+        Log_WriteLine(LOG_WARNING, SDL_GetPerformanceCounter(), line);
+        written++;
+    }
+
+    if (written) fflush(g_LogFile);
+}
+
+/* Without the drain thread, producers on any thread drain in turn */
+static void Log_DrainLocked(void)
+{
+    SDL_LockSpinlock(&g_LogDrainLock);
+    Log_DrainPending();
+    SDL_UnlockSpinlock(&g_LogDrainLock);
+}
+
+static int SDLCALL Log_DrainThread(void* data)
+{
+    (void)data;
+    while (SDL_GetAtomicInt(&g_LogThreadRunning)) {
+        SDL_WaitSemaphoreTimeout(g_LogWake, LOG_DRAIN_INTERVAL_MS);
+        Log_DrainPending();
+    }
+    Log_DrainPending();
+    return 0;
+}
+
 /* Initialize logging system */
 static void Log_Init(void)
 {
@@ -110,11 +413,40 @@ static void Log_Init(void)
     if (g_LogFile) {
         /* Write header */
         SYSTEMTIME st;
+        FILETIME ft;
         GetLocalTime(&st);
         fprintf(g_LogFile, "=== AVP Accessibility Log ===\n");
         fprintf(g_LogFile, "Started: %04d-%02d-%02d %02d:%02d:%02d\n\n",
                 st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
         fflush(g_LogFile);
+
+        /* Anchor record tick stamps to local time */
+        SystemTimeToFileTime(&st, &ft);
+        g_LogBaseTime.LowPart = ft.dwLowDateTime;
+        g_LogBaseTime.HighPart = ft.dwHighDateTime;
+        g_LogBaseTicks = SDL_GetPerformanceCounter();
+        g_LogTickFrequency = SDL_GetPerformanceFrequency();
+        if (g_LogTickFrequency == 0) g_LogTickFrequency = 1;
+
+        for (Uint32 i = 0; i < LOG_RING_SIZE; i++) {
+            SDL_SetAtomicU32(&g_LogRing[i].sequence, i);
+        }
+        SDL_SetAtomicU32(&g_LogWritePos, 0);
+        SDL_SetAtomicInt(&g_LogDropped, 0);
+        g_LogReadPos = 0;
+        g_LogDroppedTotal = 0;
+
+        /* Without a drain thread Log_Write falls back to writing synchronously */
+        SDL_SetAtomicInt(&g_LogThreadRunning, 1);
+        g_LogWake = SDL_CreateSemaphore(0);
+        if (g_LogWake) {
+            g_LogThread = SDL_CreateThread(Log_DrainThread, "AccessibilityLog", NULL);
+        }
+        if (!g_LogThread) {
+            SDL_SetAtomicInt(&g_LogThreadRunning, 0);
+            fprintf(g_LogFile, "Log drain thread unavailable, writing synchronously\n\n");
+            fflush(g_LogFile);
+        }
     }
 }
 
@@ -122,34 +454,68 @@ static void Log_Init(void)
 static void Log_Shutdown(void)
 {
     if (g_LogFile) {
+        if (g_LogThread) {
+            SDL_SetAtomicInt(&g_LogThreadRunning, 0);
+            SDL_SignalSemaphore(g_LogWake);
+            SDL_WaitThread(g_LogThread, NULL);
+            g_LogThread = NULL;
+        } else {
+            Log_DrainLocked();
+        }
+        if (g_LogWake) {
+            SDL_DestroySemaphore(g_LogWake);
+            g_LogWake = NULL;
+        }
+
+        if (g_LogDroppedTotal > 0) {
+            fprintf(g_LogFile, "\n%d log record(s) dropped due to ring overflow\n", g_LogDroppedTotal);
+        }
         fprintf(g_LogFile, "\n=== Log Closed ===\n");
         fclose(g_LogFile);
         g_LogFile = NULL;
     }
 }
 
-/* Write a log entry */
+/* Queue a log entry; formatting and disk I/O happen on the drain thread */
 static void Log_Write(LOG_LEVEL level, const char* format, ...)
 {
     if (!g_LoggingEnabled || !g_LogFile) return;
     if (level < g_LogLevel) return;  /* Filter by log level */
 
-    SYSTEMTIME st;
-    GetLocalTime(&st);
+    LOG_RECORD* rec;
+    Uint32 pos = SDL_GetAtomicU32(&g_LogWritePos);
+
+    /* Claim a slot */
+    for (;;) {
+        rec = &g_LogRing[pos & LOG_RING_MASK];
+        int diff = (int)(SDL_GetAtomicU32(&rec->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_CompareAndSwapAtomicU32(&g_LogWritePos, pos, pos + 1)) break;
+        } else if (diff < 0) {
+            /* Ring full: the drain thread has fallen a whole lap behind */
+            SDL_AddAtomicInt(&g_LogDropped, 1);
+            return;
+        }
+        pos = SDL_GetAtomicU32(&g_LogWritePos);
+    }
 
-    /* Timestamp and level */
-    fprintf(g_LogFile, "[%04d-%02d-%02d %02d:%02d:%02d.%03d] [%s] ",
-            st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond, st.wMilliseconds,
-            LogLevelNames[level]);
+    rec->level = (unsigned char)level;
+    rec->ticks = SDL_GetPerformanceCounter();
+    rec->format = format;
 
-    /* Message */
     va_list args;
     va_start(args, format);
-    vfprintf(g_LogFile, format, args);
+    Log_CaptureArgs(rec, format, args);
     va_end(args);
 
-    fprintf(g_LogFile, "\n");
-    fflush(g_LogFile);
+    /* Publish */
+    SDL_SetAtomicU32(&rec->sequence, pos + 1);
+
+    if (!g_LogThread) {
+        Log_DrainLocked();
+    } else if (((pos + 1) & (LOG_WAKE_INTERVAL - 1)) == 0) {
+        SDL_SignalSemaphore(g_LogWake);
+    }
 }
 
 /* Convenience macros */
@@ -158,12 +524,8 @@ static void Log_Write(LOG_LEVEL level, const char* format, ...)
 #define LOG_WRN(fmt, ...) Log_Write(LOG_WARNING, fmt, ##__VA_ARGS__)
 #define LOG_ERR(fmt, ...) Log_Write(LOG_ERROR, fmt, ##__VA_ARGS__)
 
-/* Player state tracking for change detection */
-static int g_LastHealth = -1;
-static int g_LastArmor = -1;
-static int g_LastWeaponSlot = -1;
-static int g_LastAmmo = -1;
-static int g_HealthWarningGiven = 0;
+/* Player events queued by the engine (dispatched from the scheduler) */
+static int g_EventsPending = 0;
 
 /* Timing for radar updates */
 static unsigned int g_LastRadarUpdate = 0;
@@ -171,10 +533,8 @@ static unsigned int g_LastRadarUpdate = 0;
 /* Last spoken text for repeat function */
 static char g_LastSpokenText[512] = {0};
 
-/* Redundancy prevention - track last spoken text per category */
+/* Last selected menu item, for repeating it on request */
 static char g_LastMenuText[256] = {0};
-static char g_LastStateText[256] = {0};
-static char g_LastLocationText[256] = {0};
 static int g_LastPitchZone = 0;  /* -1 = looking down, 0 = level, 1 = looking up */
 
 /* Pitch indicator state */
@@ -191,20 +551,9 @@ static int g_LastCenteringToneTime = 0;  /* Debounce centering tone */
 /* Interaction detection state */
 static int g_LastInteractiveNearby = 0;  /* Was an interactive nearby last frame? */
 static char g_LastInteractiveType[64] = {0};  /* Type of last interactive */
-static int g_InteractionCheckFrames = 0;  /* Frame counter for interaction checks */
 
-/* Weapon state tracking */
-static int g_LastWeaponState = -1;  /* Last weapon state for change detection */
-static int g_LastPrimaryRounds = -1;  /* Track ammo for reload detection */
-static int g_LastSecondaryRounds = -1;
-
-/* On-screen message tracking */
-static char g_LastOnScreenMessage[256] = {0};  /* Prevent duplicate announcements */
-
-/* Predator equipment tracking */
-static int g_LastCloakOn = -1;           /* Cloak state (-1 = unknown) */
-static int g_LastVisionMode = -1;        /* Vision mode enum value */
-static int g_LastFieldChargePercent = -1; /* Energy percentage (0-100) */
+/* Environment sweep in progress (runs from the scheduler) */
+static int g_EnvSweepActive = 0;
 
 /* Obstruction announcement tracking */
 static char g_LastObstructionText[256] = {0};  /* Prevent repeating same obstruction */
@@ -237,133 +586,319 @@ static OBSTRUCTION_STATE g_ObstructionState = {
 };
 
 /* ============================================
- * Announcement Priority/Cooldown System
- * Prevents auditory overload during intense gameplay
+ * Profiling
+ * Rolling timings for each part of the accessibility layer, read out by
+ * the ACCESSIBILITY_PROFILE console command and optionally dumped to file
  * ============================================ */
 
-/* Priority levels for announcements */
+#define PROF_WINDOW 512                 /* Samples kept per zone */
+#define PROF_MAX_RANK (PROF_WINDOW / 100 + 1)
+#define PROF_SCREEN_ZONES 3             /* Costliest zones read out on screen */
+
 typedef enum {
-    ANNOUNCE_PRIORITY_CRITICAL = 0,  /* Damage, health critical - always plays, triggers cooldown */
-    ANNOUNCE_PRIORITY_HIGH = 1,      /* Obstruction warnings, interaction prompts */
-    ANNOUNCE_PRIORITY_NORMAL = 2,    /* Weapon changes, pickups */
-    ANNOUNCE_PRIORITY_LOW = 3        /* Radar, navigation updates */
-} ANNOUNCE_PRIORITY;
+    PROF_ZONE_FRAME,            /* All of Accessibility_Update */
+    PROF_ZONE_AUTONAV,
+    PROF_ZONE_INPUT,
+    PROF_ZONE_EVENTS,           /* Player event dispatch */
+    PROF_ZONE_OBSTRUCTION,
+    PROF_ZONE_INTERACTION,
+    PROF_ZONE_PITCH,
+    PROF_ZONE_RADAR,
+    PROF_ZONE_RADAR_VOICES,
+    PROF_ZONE_NAVIGATION,
+    PROF_ZONE_RAYCAST,          /* CastObstructionFan, cache hits included */
+    PROF_ZONE_TTS_DISPATCH,     /* Queueing speech on the game thread */
+    PROF_ZONE_ENVIRONMENT,      /* Environment_Describe sweep */
+    PROF_ZONE_PATH_DISTANCE,    /* Walking distance field */
+    PROF_ZONE_COUNT
+} PROF_ZONE;
+
+static const char* g_ProfZoneNames[PROF_ZONE_COUNT] = {
+    "frame", "autonav", "input", "events", "obstruction",
+    "interaction", "pitch", "radar", "voices", "navigation", "raycast", "tts",
+    "environment", "pathdist"
+};
 
-/* Cooldown tracking */
-static unsigned int g_LastCriticalAnnouncementTime = 0;  /* When last critical was played */
-static unsigned int g_LastHighAnnouncementTime = 0;      /* When last high priority was played */
-static unsigned int g_LastNormalAnnouncementTime = 0;    /* When last normal was played */
+typedef struct {
+    Uint32 samples[PROF_WINDOW];    /* Nanoseconds, ring buffer */
+    int next;
+    int count;
+    Uint64 calls;                   /* Since the last reset */
+} PROF_ZONE_DATA;
 
-/* Cooldown durations in milliseconds */
-#define COOLDOWN_AFTER_CRITICAL_MS 600   /* Suppress non-critical for 600ms after damage */
-#define COOLDOWN_AFTER_HIGH_MS 400       /* Suppress low priority for 400ms after high */
-#define COOLDOWN_BETWEEN_SAME_MS 200     /* Min time between same-priority announcements */
+typedef struct {
+    int count;
+    double minUs, meanUs, p99Us, maxUs;
+} PROF_STATS;
 
-/* Check if an announcement at given priority is allowed based on cooldowns */
-static int Announcement_IsAllowed(ANNOUNCE_PRIORITY priority)
+static PROF_ZONE_DATA g_ProfZones[PROF_ZONE_COUNT];
+static double g_ProfNsPerTick = 0.0;
+static int g_ProfDumpIntervalMs = 0;            /* [Profiling] DumpInterval, 0 = off */
+static char g_ProfDumpPath[MAX_PATH] = "accessibility_profile.txt";
+static unsigned int g_ProfLastDump = 0;
+
+static Uint64 Prof_Begin(void)
 {
-    unsigned int currentTime = GetTickCount();
+    return SDL_GetPerformanceCounter();
+}
 
-    /* Critical announcements always allowed */
-    if (priority == ANNOUNCE_PRIORITY_CRITICAL) {
-        return 1;
+/* Record the time since Prof_Begin against a zone; returns it in nanoseconds */
+static Uint64 Prof_End(PROF_ZONE zone, Uint64 start)
+{
+    if (g_ProfNsPerTick == 0.0) {
+        g_ProfNsPerTick = 1e9 / (double)SDL_GetPerformanceFrequency();
     }
 
-    /* High priority - blocked during critical cooldown */
-    if (priority == ANNOUNCE_PRIORITY_HIGH) {
-        if ((currentTime - g_LastCriticalAnnouncementTime) < COOLDOWN_AFTER_CRITICAL_MS) {
-            return 0;  /* Still in critical cooldown */
-        }
-        return 1;
+    Uint64 ns = (Uint64)((double)(SDL_GetPerformanceCounter() - start) * g_ProfNsPerTick);
+    PROF_ZONE_DATA* z = &g_ProfZones[zone];
+    z->samples[z->next] = ns > 0xffffffffu ? 0xffffffffu : (Uint32)ns;
+    z->next = (z->next + 1) % PROF_WINDOW;
+    if (z->count < PROF_WINDOW) z->count++;
+    z->calls++;
+    return ns;
+}
+
+static void Prof_GetStats(PROF_ZONE zone, PROF_STATS* stats)
+{
+    PROF_ZONE_DATA* z = &g_ProfZones[zone];
+    Uint32 top[PROF_MAX_RANK];      /* Largest samples, descending */
+    int rank = z->count / 100 + 1;  /* p99 is the rank'th largest */
+    int topCount = 0;
+    Uint32 minNs = 0xffffffffu;
+    Uint64 sum = 0;
+
+    stats->count = z->count;
+    if (z->count == 0) {
+        stats->minUs = stats->meanUs = stats->p99Us = stats->maxUs = 0.0;
+        return;
     }
 
-    /* Normal priority - blocked during critical and high cooldowns */
-    if (priority == ANNOUNCE_PRIORITY_NORMAL) {
-        if ((currentTime - g_LastCriticalAnnouncementTime) < COOLDOWN_AFTER_CRITICAL_MS) {
-            return 0;
-        }
-        if ((currentTime - g_LastHighAnnouncementTime) < COOLDOWN_AFTER_HIGH_MS) {
-            return 0;
+    for (int i = 0; i < z->count; i++) {
+        Uint32 ns = z->samples[i];
+        sum += ns;
+        if (ns < minNs) minNs = ns;
+
+        if (topCount == rank && ns <= top[rank - 1]) continue;
+        int pos = (topCount < rank) ? topCount++ : rank - 1;
+        while (pos > 0 && top[pos - 1] < ns) {
+            top[pos] = top[pos - 1];
+            pos--;
         }
-        return 1;
+        top[pos] = ns;
     }
 
-    /* Low priority - blocked during all higher priority cooldowns */
-    if (priority == ANNOUNCE_PRIORITY_LOW) {
-        if ((currentTime - g_LastCriticalAnnouncementTime) < COOLDOWN_AFTER_CRITICAL_MS) {
-            return 0;
-        }
-        if ((currentTime - g_LastHighAnnouncementTime) < COOLDOWN_AFTER_HIGH_MS) {
-            return 0;
-        }
-        if ((currentTime - g_LastNormalAnnouncementTime) < COOLDOWN_BETWEEN_SAME_MS) {
-            return 0;
-        }
-        return 1;
+    stats->minUs = minNs / 1000.0;
+    stats->meanUs = (double)sum / z->count / 1000.0;
+    stats->p99Us = top[rank - 1] / 1000.0;
+    stats->maxUs = top[0] / 1000.0;
+}
+
+static void Prof_FormatZone(PROF_ZONE zone, char* buf, size_t size)
+{
+    PROF_STATS st;
+    Prof_GetStats(zone, &st);
+    snprintf(buf, size, "%-12s %8llu calls  min %8.1f  mean %8.1f  p99 %8.1f  max %8.1f us",
+             g_ProfZoneNames[zone], (unsigned long long)g_ProfZones[zone].calls,
+             st.minUs, st.meanUs, st.p99Us, st.maxUs);
+}
+
+/* Append the full table to the dump file */
+static void Prof_Dump(void)
+{
+    FILE* f = fopen(g_ProfDumpPath, "a");
+    if (!f) {
+        LOG_WRN("Could not open profile dump file %s", g_ProfDumpPath);
+        g_ProfDumpIntervalMs = 0;
+        return;
     }
 
-    return 1;
+    SYSTEMTIME st;
+    GetLocalTime(&st);
+    fprintf(f, "--- %04d-%02d-%02d %02d:%02d:%02d, last %d samples per zone ---\n",
+            st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond, PROF_WINDOW);
+
+    char line[160];
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        if (g_ProfZones[i].count == 0) continue;
+        Prof_FormatZone((PROF_ZONE)i, line, sizeof(line));
+        fprintf(f, "%s\n", line);
+    }
+    fclose(f);
 }
 
-/* Record that an announcement was made at a given priority */
-static void Announcement_RecordTime(ANNOUNCE_PRIORITY priority)
+/* Periodic dump, if enabled - call once per frame */
+static void Prof_Update(void)
 {
-    unsigned int currentTime = GetTickCount();
+    if (g_ProfDumpIntervalMs <= 0) return;
 
-    switch (priority) {
-        case ANNOUNCE_PRIORITY_CRITICAL:
-            g_LastCriticalAnnouncementTime = currentTime;
-            break;
-        case ANNOUNCE_PRIORITY_HIGH:
-            g_LastHighAnnouncementTime = currentTime;
-            break;
-        case ANNOUNCE_PRIORITY_NORMAL:
-            g_LastNormalAnnouncementTime = currentTime;
-            break;
-        case ANNOUNCE_PRIORITY_LOW:
-            /* Low priority doesn't block anything */
-            break;
+    unsigned int now = GetTickCount();
+    if (g_ProfLastDump == 0) g_ProfLastDump = now;
+    if (now - g_ProfLastDump < (unsigned int)g_ProfDumpIntervalMs) return;
+    g_ProfLastDump = now;
+
+    Prof_Dump();
+}
+
+extern "C" void Accessibility_ShowProfile(void)
+{
+    char line[160];
+
+    /* Everything to the log; the console gets the frame total and the
+     * costliest zones, since on-screen messages are also spoken */
+    LOG_INF("Accessibility profile, last %d samples per zone:", PROF_WINDOW);
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        if (g_ProfZones[i].count == 0) continue;
+        Prof_FormatZone((PROF_ZONE)i, line, sizeof(line));
+        LOG_INF("  %s", line);
+    }
+
+    PROF_STATS frame;
+    Prof_GetStats(PROF_ZONE_FRAME, &frame);
+    if (frame.count == 0) {
+        NewOnScreenMessage((unsigned char*)"ACCESSIBILITY PROFILE: NO SAMPLES YET");
+        return;
+    }
+    snprintf(line, sizeof(line), "ACCESSIBILITY FRAME: MEAN %.0fUS, P99 %.0fUS, MAX %.0fUS",
+             frame.meanUs, frame.p99Us, frame.maxUs);
+    NewOnScreenMessage((unsigned char*)line);
+
+    int shown[PROF_SCREEN_ZONES];
+    double shownP99[PROF_SCREEN_ZONES];
+    int shownCount = 0;
+    for (int i = PROF_ZONE_FRAME + 1; i < PROF_ZONE_COUNT; i++) {
+        PROF_STATS st;
+        Prof_GetStats((PROF_ZONE)i, &st);
+        if (st.count == 0) continue;
+
+        if (shownCount == PROF_SCREEN_ZONES && st.p99Us <= shownP99[shownCount - 1]) continue;
+        int pos = (shownCount < PROF_SCREEN_ZONES) ? shownCount++ : shownCount - 1;
+        while (pos > 0 && shownP99[pos - 1] < st.p99Us) {
+            shown[pos] = shown[pos - 1];
+            shownP99[pos] = shownP99[pos - 1];
+            pos--;
+        }
+        shown[pos] = i;
+        shownP99[pos] = st.p99Us;
+    }
+    for (int i = 0; i < shownCount; i++) {
+        snprintf(line, sizeof(line), "%s: P99 %.0fUS", g_ProfZoneNames[shown[i]], shownP99[i]);
+        for (char* c = line; *c; c++) *c = (char)toupper((unsigned char)*c);
+        NewOnScreenMessage((unsigned char*)line);
     }
+
+    if (g_ProfDumpIntervalMs > 0) Prof_Dump();
 }
 
-#ifdef _WIN32
-/* Tolk screen reader library state */
-static int g_TolkInitialized = 0;
-#endif
+extern "C" void Accessibility_ResetProfile(void)
+{
+    memset(g_ProfZones, 0, sizeof(g_ProfZones));
+    NewOnScreenMessage((unsigned char*)"ACCESSIBILITY PROFILE RESET");
+}
 
 /* ============================================
  * Audio Radar Tone System (OpenAL)
+ * A small pool of voices, one per tracked contact, playing wavetables
+ * synthesised once per enemy class at startup. Each class has a clear tone
+ * for contacts in sight and a muffled one for contacts only heard.
  * ============================================ */
 
 #define RADAR_TONE_SAMPLE_RATE 44100
 #define RADAR_TONE_DURATION_MS 150
 #define RADAR_TONE_SAMPLES (RADAR_TONE_SAMPLE_RATE * RADAR_TONE_DURATION_MS / 1000)
 #define RADAR_BASE_FREQUENCY 440.0f  /* A4 note - pleasant base frequency */
+#define RADAR_MAX_VOICES 6           /* Contacts heard at once */
+#define RADAR_PING_STAGGER_MS 70     /* Gap between contacts' pings in one sweep */
+
+/* Enemy classes with their own wavetable */
+typedef enum {
+    RADAR_VOICE_DEFAULT,
+    RADAR_VOICE_ALIEN,
+    RADAR_VOICE_QUEEN,
+    RADAR_VOICE_FACEHUGGER,
+    RADAR_VOICE_PREDATOR,
+    RADAR_VOICE_XENOBORG,
+    RADAR_VOICE_HUMAN,
+    RADAR_VOICE_KIND_COUNT
+} RADAR_VOICE_KIND;
+
+/* Whether the player's module can see the contact's */
+typedef enum {
+    RADAR_TONE_SEEN,
+    RADAR_TONE_HEARD,       /* Behind walls or closed doors */
+    RADAR_TONE_VARIANT_COUNT
+} RADAR_TONE_VARIANT;
+
+typedef struct {
+    float pitch;        /* Multiple of RADAR_BASE_FREQUENCY */
+    float harmonic2;    /* Level of the octave relative to the fundamental */
+    float harmonic3;    /* Level of the twelfth */
+} RADAR_WAVE_SPEC;
 
-static ALuint g_RadarToneBuffer = 0;
-static ALuint g_RadarToneSource = 0;
+/* Different enemies have distinct tones
+ * Aliens: Lower, menacing (0.75x)
+ * Queen: Very low, ominous (0.6x), heavy octave
+ * Facehuggers: Very high, frantic (1.8x)
+ * Predators: Mid-range, distinctive (1.2x)
+ * Xenoborgs: Slightly lower, mechanical feel (0.9x), hollow odd harmonic
+ * Marines: Higher, sharp (1.5x)
+ */
+static const RADAR_WAVE_SPEC g_RadarWaveSpecs[RADAR_VOICE_KIND_COUNT] = {
+    { 1.0f,  0.0f,  0.0f  },    /* Default: plain sine */
+    { 0.75f, 0.3f,  0.0f  },    /* Alien */
+    { 0.6f,  0.5f,  0.15f },    /* Queen */
+    { 1.8f,  0.0f,  0.0f  },    /* Facehugger */
+    { 1.2f,  0.2f,  0.2f  },    /* Predator */
+    { 0.9f,  0.0f,  0.45f },    /* Xenoborg */
+    { 1.5f,  0.15f, 0.0f  },    /* Marine */
+};
+
+typedef struct {
+    ALuint source;
+    STRATEGYBLOCK* sb;          /* Tracked contact, NULL when the voice is free */
+    RADAR_VOICE_KIND kind;      /* Wavetable attached to the source */
+    RADAR_TONE_VARIANT variant;
+    int pingPending;
+    unsigned int pingAtMs;
+} RADAR_VOICE;
+
+typedef void (*RADAR_DEFER_FN)(void);
+
+static ALuint g_RadarWaveBuffers[RADAR_TONE_VARIANT_COUNT][RADAR_VOICE_KIND_COUNT];
+static RADAR_VOICE g_RadarVoices[RADAR_MAX_VOICES];
+static int g_RadarVoiceCount = 0;                   /* Sources actually created */
 static int g_RadarToneInitialized = 0;
+static RADAR_DEFER_FN g_RadarDeferUpdates = NULL;   /* AL_SOFT_deferred_updates, if present */
+static RADAR_DEFER_FN g_RadarProcessUpdates = NULL;
 
-/* Generate a soft sine wave tone buffer */
-static int RadarTone_GenerateBuffer(void)
+/* Synthesise one enemy class's tone: a few sine partials under a soft envelope.
+ * The heard variant keeps only the fundamental, quieter and slower to swell. */
+static int RadarTone_GenerateBuffer(RADAR_VOICE_KIND kind, RADAR_TONE_VARIANT variant)
 {
-    if (g_RadarToneBuffer != 0) {
-        return 1; /* Already generated */
-    }
+    const RADAR_WAVE_SPEC* spec = &g_RadarWaveSpecs[kind];
+    ALuint* buffer = &g_RadarWaveBuffers[variant][kind];
+    int heard = (variant == RADAR_TONE_HEARD);
+    float harmonic2 = heard ? 0.0f : spec->harmonic2;
+    float harmonic3 = heard ? 0.0f : spec->harmonic3;
+    float fadeFraction = heard ? 0.4f : 0.2f;
+    float amplitude = heard ? 14000.0f : 24000.0f;
 
     /* Allocate buffer for 16-bit mono samples */
     short* samples = (short*)malloc(RADAR_TONE_SAMPLES * sizeof(short));
     if (!samples) return 0;
 
-    /* Generate sine wave with soft attack/decay envelope */
+    float frequency = RADAR_BASE_FREQUENCY * spec->pitch;
+    float norm = 1.0f / (1.0f + harmonic2 + harmonic3);
+
     for (int i = 0; i < RADAR_TONE_SAMPLES; i++) {
         float t = (float)i / RADAR_TONE_SAMPLE_RATE;
-        float phase = 2.0f * 3.14159265f * RADAR_BASE_FREQUENCY * t;
-        float sample = sinf(phase);
+        float phase = 2.0f * 3.14159265f * frequency * t;
+        float sample = (sinf(phase) +
+                        harmonic2 * sinf(2.0f * phase) +
+                        harmonic3 * sinf(3.0f * phase)) * norm;
 
-        /* Soft envelope: fade in/out over 20% of duration */
+        /* Soft envelope: fade in/out over part of the duration */
         float envelope = 1.0f;
-        float fadeLen = RADAR_TONE_SAMPLES * 0.2f;
+        float fadeLen = RADAR_TONE_SAMPLES * fadeFraction;
         if (i < (int)fadeLen) {
             envelope = (float)i / fadeLen;
         } else if (i > RADAR_TONE_SAMPLES - (int)fadeLen) {
@@ -371,133 +906,213 @@ static int RadarTone_GenerateBuffer(void)
         }
 
         /* Apply envelope and convert to 16-bit */
-        samples[i] = (short)(sample * envelope * 24000.0f);
+        samples[i] = (short)(sample * envelope * amplitude);
     }
 
     /* Create OpenAL buffer */
-    alGenBuffers(1, &g_RadarToneBuffer);
+    alGenBuffers(1, buffer);
     if (alGetError() != AL_NO_ERROR) {
+        *buffer = 0;
         free(samples);
         return 0;
     }
 
-    alBufferData(g_RadarToneBuffer, AL_FORMAT_MONO16, samples,
+    alBufferData(*buffer, AL_FORMAT_MONO16, samples,
                  RADAR_TONE_SAMPLES * sizeof(short), RADAR_TONE_SAMPLE_RATE);
 
     free(samples);
 
     if (alGetError() != AL_NO_ERROR) {
-        alDeleteBuffers(1, &g_RadarToneBuffer);
-        g_RadarToneBuffer = 0;
+        alDeleteBuffers(1, buffer);
+        *buffer = 0;
         return 0;
     }
 
     return 1;
 }
 
-/* Initialize radar tone source */
+/* Shutdown radar tone system */
+static void RadarTone_Shutdown(void)
+{
+    for (int i = 0; i < g_RadarVoiceCount; i++) {
+        alSourceStop(g_RadarVoices[i].source);
+        alDeleteSources(1, &g_RadarVoices[i].source);
+        g_RadarVoices[i].source = 0;
+        g_RadarVoices[i].sb = NULL;
+    }
+    g_RadarVoiceCount = 0;
+
+    for (int v = 0; v < RADAR_TONE_VARIANT_COUNT; v++) {
+        for (int k = 0; k < RADAR_VOICE_KIND_COUNT; k++) {
+            if (g_RadarWaveBuffers[v][k] != 0) {
+                alDeleteBuffers(1, &g_RadarWaveBuffers[v][k]);
+                g_RadarWaveBuffers[v][k] = 0;
+            }
+        }
+    }
+
+    g_RadarDeferUpdates = NULL;
+    g_RadarProcessUpdates = NULL;
+    g_RadarToneInitialized = 0;
+}
+
+/* Initialize the wavetable bank and the voice sources */
 static int RadarTone_Init(void)
 {
     if (g_RadarToneInitialized) {
         return 1;
     }
 
-    /* Generate the tone buffer first */
-    if (!RadarTone_GenerateBuffer()) {
-        Accessibility_Log("Failed to generate radar tone buffer\n");
-        return 0;
+    /* Generate every tone up front so tracking a new contact costs no synthesis */
+    for (int v = 0; v < RADAR_TONE_VARIANT_COUNT; v++) {
+        for (int k = 0; k < RADAR_VOICE_KIND_COUNT; k++) {
+            if (!RadarTone_GenerateBuffer((RADAR_VOICE_KIND)k, (RADAR_TONE_VARIANT)v)) {
+                Accessibility_Log("Failed to generate radar tone buffer\n");
+                RadarTone_Shutdown();
+                return 0;
+            }
+        }
     }
 
-    /* Create source */
-    alGenSources(1, &g_RadarToneSource);
-    if (alGetError() != AL_NO_ERROR) {
+    /* One source per voice; a device short of sources just gets fewer voices */
+    for (int i = 0; i < RADAR_MAX_VOICES; i++) {
+        RADAR_VOICE* voice = &g_RadarVoices[i];
+        alGenSources(1, &voice->source);
+        if (alGetError() != AL_NO_ERROR) {
+            voice->source = 0;
+            break;
+        }
+
+        voice->sb = NULL;
+        voice->kind = RADAR_VOICE_DEFAULT;
+        voice->variant = RADAR_TONE_SEEN;
+        voice->pingPending = 0;
+        alSourcei(voice->source, AL_BUFFER, g_RadarWaveBuffers[RADAR_TONE_SEEN][RADAR_VOICE_DEFAULT]);
+
+        /* Use SOURCE_RELATIVE for UI sounds to not interfere with game 3D audio */
+        alSourcef(voice->source, AL_REFERENCE_DISTANCE, 5000.0f);
+        alSourcef(voice->source, AL_MAX_DISTANCE, 50000.0f);
+        alSourcei(voice->source, AL_SOURCE_RELATIVE, AL_TRUE);
+        g_RadarVoiceCount++;
+    }
+
+    if (g_RadarVoiceCount == 0) {
         Accessibility_Log("Failed to create radar tone source\n");
+        RadarTone_Shutdown();
         return 0;
     }
 
-    /* Attach buffer to source */
-    alSourcei(g_RadarToneSource, AL_BUFFER, g_RadarToneBuffer);
-
-    /* Set source properties for 3D positioning */
-    alSourcef(g_RadarToneSource, AL_GAIN, 0.7f);
-    alSourcef(g_RadarToneSource, AL_REFERENCE_DISTANCE, 5000.0f);
-    alSourcef(g_RadarToneSource, AL_MAX_DISTANCE, 50000.0f);
-    alSourcei(g_RadarToneSource, AL_SOURCE_RELATIVE, AL_FALSE);
+    /* Prefer deferred updates; alcSuspendContext is the portable fallback */
+    if (alIsExtensionPresent("AL_SOFT_deferred_updates")) {
+        g_RadarDeferUpdates = (RADAR_DEFER_FN)alGetProcAddress("alDeferUpdatesSOFT");
+        g_RadarProcessUpdates = (RADAR_DEFER_FN)alGetProcAddress("alProcessUpdatesSOFT");
+        if (!g_RadarDeferUpdates || !g_RadarProcessUpdates) {
+            g_RadarDeferUpdates = NULL;
+            g_RadarProcessUpdates = NULL;
+        }
+    }
 
     g_RadarToneInitialized = 1;
-    Accessibility_Log("Radar tone system initialized\n");
+    Accessibility_Log("Radar tone system initialized (%d voices)\n", g_RadarVoiceCount);
     return 1;
 }
 
-/* Shutdown radar tone system */
-static void RadarTone_Shutdown(void)
+/* Hold source changes so a frame's voice updates reach the mixer together */
+static void RadarTone_BeginBatch(void)
 {
-    if (g_RadarToneSource != 0) {
-        alSourceStop(g_RadarToneSource);
-        alDeleteSources(1, &g_RadarToneSource);
-        g_RadarToneSource = 0;
+    if (g_RadarDeferUpdates) {
+        g_RadarDeferUpdates();
+        return;
     }
+    ALCcontext* context = alcGetCurrentContext();
+    if (context) alcSuspendContext(context);
+}
 
-    if (g_RadarToneBuffer != 0) {
-        alDeleteBuffers(1, &g_RadarToneBuffer);
-        g_RadarToneBuffer = 0;
+static void RadarTone_EndBatch(void)
+{
+    if (g_RadarProcessUpdates) {
+        g_RadarProcessUpdates();
+        return;
     }
-
-    g_RadarToneInitialized = 0;
+    ALCcontext* context = alcGetCurrentContext();
+    if (context) alcProcessContext(context);
 }
 
-/* Get pitch multiplier for enemy type - different enemies have distinct tones
- * Aliens: Lower, menacing (0.75x)
- * Predators: Mid-range, distinctive (1.2x)
- * Marines: Higher, sharp (1.5x)
- * Facehuggers: Very high, frantic (1.8x)
- * Queen: Very low, ominous (0.6x)
- */
-static float GetEnemyPitchMultiplier(AVP_BEHAVIOUR_TYPE bhvr)
+static RADAR_VOICE_KIND RadarTone_VoiceKind(AVP_BEHAVIOUR_TYPE bhvr)
 {
     switch (bhvr) {
         case I_BehaviourAlien:
-            return 0.75f;  /* Lower, menacing */
+            return RADAR_VOICE_ALIEN;
         case I_BehaviourQueenAlien:
-            return 0.6f;   /* Very low, ominous */
+            return RADAR_VOICE_QUEEN;
         case I_BehaviourFaceHugger:
-            return 1.8f;   /* High, frantic */
+            return RADAR_VOICE_FACEHUGGER;
         case I_BehaviourPredator:
-            return 1.2f;   /* Distinctive mid-high */
+            return RADAR_VOICE_PREDATOR;
         case I_BehaviourXenoborg:
-            return 0.9f;   /* Slightly lower, mechanical feel */
+            return RADAR_VOICE_XENOBORG;
         case I_BehaviourMarine:
         case I_BehaviourSeal:
-            return 1.5f;   /* Higher, sharp */
+            return RADAR_VOICE_HUMAN;
         default:
-            return 1.0f;   /* Default */
+            return RADAR_VOICE_DEFAULT;
     }
 }
 
-/* Play a directional radar tone for an entity
- * - Position determines stereo panning (left/right/front/back)
- * - Vertical offset determines pitch (above = higher, below = lower)
- * - Distance affects volume
- * - Entity type affects base pitch (different enemies have distinct tones)
- */
-static void RadarTone_PlayDirectional(int targetX, int targetY, int targetZ,
-                                       int playerX, int playerY, int playerZ,
-                                       int playerYaw, AVP_BEHAVIOUR_TYPE entityType)
+/* Voice tracking sb, or a free voice when sb is NULL */
+static RADAR_VOICE* RadarTone_FindVoice(STRATEGYBLOCK* sb)
 {
-    if (!g_RadarToneInitialized) {
-        if (!RadarTone_Init()) return;
+    for (int i = 0; i < g_RadarVoiceCount; i++) {
+        if (g_RadarVoices[i].sb == sb) return &g_RadarVoices[i];
     }
+    return NULL;
+}
 
-    /* Check if source is already playing - if so, let it finish (allows parallel sounds) */
-    ALint state;
-    alGetSourcei(g_RadarToneSource, AL_SOURCE_STATE, &state);
-    if (state == AL_PLAYING) {
-        return;  /* Let current sound finish, don't interrupt */
+static void RadarTone_ReleaseVoice(RADAR_VOICE* voice)
+{
+    alSourceStop(voice->source);
+    voice->sb = NULL;
+    voice->pingPending = 0;
+}
+
+/* Attach a wavetable to a voice; the source must not be playing */
+static void RadarTone_SetTone(RADAR_VOICE* voice, RADAR_VOICE_KIND kind, RADAR_TONE_VARIANT variant)
+{
+    if (kind == voice->kind && variant == voice->variant) return;
+    alSourcei(voice->source, AL_BUFFER, g_RadarWaveBuffers[variant][kind]);
+    voice->kind = kind;
+    voice->variant = variant;
+}
+
+/* Seen or only heard, from the level's module visibility table; the
+ * VMODULE list is only walked where an open or closed door decides */
+static RADAR_TONE_VARIANT RadarTone_ContactVariant(STRATEGYBLOCK* sb)
+{
+    MODULE* from = Player->ObStrategyBlock->containingModule;
+    MODULE* to = sb->containingModule;
+    int seen;
+
+    if (!from || !to) return RADAR_TONE_SEEN;   /* Unknown: keep the plain tone */
+
+    switch (ModuleVisibility(from, to)) {
+        case MVIS_Hidden:  seen = 0; break;
+        case MVIS_Visible: seen = 1; break;
+        default:           seen = IsModuleVisibleFromModule(from, to); break;
     }
+    return seen ? RADAR_TONE_SEEN : RADAR_TONE_HEARD;
+}
 
-    /* Use SOURCE_RELATIVE for UI sounds to not interfere with game 3D audio */
-    alSourcei(g_RadarToneSource, AL_SOURCE_RELATIVE, AL_TRUE);
+static int PathDist_ToBlock(STRATEGYBLOCK* sb, int straight);
 
+/* Place a voice around the listener
+ * - Position determines stereo panning (left/right/front/back)
+ * - Vertical offset determines pitch (above = higher, below = lower)
+ * - Walking distance affects volume
+ * The enemy class's base pitch is already in its wavetable.
+ */
+static void RadarTone_PlaceVoice(RADAR_VOICE* voice, int targetX, int targetY, int targetZ,
+                                 int playerX, int playerY, int playerZ, int playerYaw)
+{
     /* Calculate relative position */
     float dx = (float)(targetX - playerX);
     float dy = (float)(targetY - playerY);
@@ -518,42 +1133,31 @@ static void RadarTone_PlayDirectional(int targetX, int targetY, int targetZ,
     float posY = dy * scale;
     float posZ = -relZ * scale;  /* OpenAL uses -Z as forward */
 
-    /* Set source position in 3D space */
-    alSource3f(g_RadarToneSource, AL_POSITION, posX, posY, posZ);
+    alSource3f(voice->source, AL_POSITION, posX, posY, posZ);
 
-    /* Calculate pitch based on:
-     * 1. Enemy type (different enemies have distinct base tones)
-     * 2. Vertical offset (above = higher pitch, below = lower)
-     */
     float distance = sqrtf(dx*dx + dy*dy + dz*dz);
     float verticalRatio = 0.0f;
     if (distance > 0.0f) {
         verticalRatio = dy / distance;  /* -1 to 1 range */
     }
 
-    /* Get enemy-specific pitch multiplier */
-    float enemyPitch = GetEnemyPitchMultiplier(entityType);
-
-    /* Apply vertical variation: -1 (below) -> -0.3, 0 (level) -> 0, 1 (above) -> +0.3 */
-    float pitch = enemyPitch + (verticalRatio * 0.3f);
-
-    /* Clamp to reasonable range */
+    /* Apply vertical variation: -1 (below) -> -0.3, 0 (level) -> 0, 1 (above) -> +0.3,
+     * clamped to a reasonable range around the class's own pitch */
+    float basePitch = g_RadarWaveSpecs[voice->kind].pitch;
+    float pitch = basePitch + (verticalRatio * 0.3f);
     if (pitch < 0.4f) pitch = 0.4f;
     if (pitch > 2.5f) pitch = 2.5f;
 
-    alSourcef(g_RadarToneSource, AL_PITCH, pitch);
+    alSourcef(voice->source, AL_PITCH, pitch / basePitch);
 
-    /* Distance-based volume (closer = louder) */
+    /* Distance-based volume (closer to walk = louder) */
     float maxRange = (float)AccessibilitySettings.radar_range;
-    float volumeScale = 1.0f - (distance / maxRange);
+    float walkDistance = (float)PathDist_ToBlock(voice->sb, (int)distance);
+    float volumeScale = 1.0f - (walkDistance / maxRange);
     if (volumeScale < 0.2f) volumeScale = 0.2f;
     if (volumeScale > 1.0f) volumeScale = 1.0f;
     /* Lower gain to not overpower game sounds */
-    alSourcef(g_RadarToneSource, AL_GAIN, 0.35f * volumeScale);
-
-    /* Play the tone */
-    alSourceRewind(g_RadarToneSource);
-    alSourcePlay(g_RadarToneSource);
+    alSourcef(voice->source, AL_GAIN, 0.35f * volumeScale);
 }
 
 /* ============================================
@@ -724,12 +1328,35 @@ static void CenteringTone_Play(void)
 }
 
 /* ============================================
- * TTS Implementation (Tolk Screen Reader Library)
+ * TTS Backends
  * ============================================ */
 
-#ifdef _WIN32
+/*
+ * Every backend call is made from the speech thread only (Tolk needs COM
+ * initialised on the thread that uses it), so none of them need locking.
+ */
+typedef struct {
+    const char* name;
+    int (*init)(void);
+    void (*shutdown)(void);
+    void (*speak)(const char* text, int interrupt);
+    void (*silence)(void);
+    int (*is_speaking)(void);   /* 0 when the backend cannot tell */
+} TTS_BACKEND;
 
-static int TTS_InitTolk(void)
+#define TTS_MAX_TEXT 2048
+
+/* Backend selection: "auto", "tolk", "speechd", "espeak", "sink" or "none".
+ * Overridden by the AVP_TTS_BACKEND / AVP_TTS_SINK environment variables. */
+static char g_TTSBackendName[32] = "auto";
+static char g_TTSSinkPath[260] = {0};
+
+#ifdef _WIN32
+
+/* Tolk screen reader library state */
+static int g_TolkInitialized = 0;
+
+static int TTS_InitTolk(void)
 {
     if (g_TolkInitialized) {
         return 1; /* Already initialized */
@@ -776,2088 +1403,5400 @@ static void TTS_ShutdownTolk(void)
     }
 }
 
-static void TTS_SpeakInternal(const char* text, int interrupt)
+static void TTS_SpeakTolk(const char* text, int interrupt)
 {
-    if (!g_TolkInitialized || !text || !AccessibilitySettings.tts_enabled) {
-        return;
-    }
+    /* Speech thread only, so a static conversion buffer is safe */
+    static WCHAR wtext[TTS_MAX_TEXT];
 
-    /* Convert to wide string for Tolk */
-    int len = MultiByteToWideChar(CP_UTF8, 0, text, -1, NULL, 0);
-    if (len <= 0) return;
+    if (!g_TolkInitialized) return;
 
-    WCHAR* wtext = (WCHAR*)malloc(len * sizeof(WCHAR));
-    if (!wtext) return;
-
-    MultiByteToWideChar(CP_UTF8, 0, text, -1, wtext, len);
+    if (MultiByteToWideChar(CP_UTF8, 0, text, -1, wtext, TTS_MAX_TEXT) <= 0) return;
 
     /* Output through screen reader (speech + braille) */
     Tolk_Output(wtext, interrupt ? true : false);
+}
 
-    free(wtext);
+static void TTS_SilenceTolk(void)
+{
+    if (g_TolkInitialized) Tolk_Silence();
+}
 
-    /* Store for repeat function */
-    strncpy(g_LastSpokenText, text, sizeof(g_LastSpokenText) - 1);
-    g_LastSpokenText[sizeof(g_LastSpokenText) - 1] = '\0';
+static int TTS_IsSpeakingTolk(void)
+{
+    return g_TolkInitialized && Tolk_IsSpeaking() ? 1 : 0;
 }
 
+static const TTS_BACKEND g_TTSBackendTolk = {
+    "tolk", TTS_InitTolk, TTS_ShutdownTolk, TTS_SpeakTolk, TTS_SilenceTolk, TTS_IsSpeakingTolk
+};
+
 #else
-/* Non-Windows stub implementations */
-static int TTS_InitTolk(void) { return 0; }
-static void TTS_ShutdownTolk(void) {}
-static void TTS_SpeakInternal(const char* text, int interrupt) {
-    (void)text; (void)interrupt;
+
+/*
+ * speech-dispatcher and espeak-ng are loaded at runtime so neither is a
+ * build or install dependency; whichever is present gets used.
+ */
+
+/* libspeechd */
+typedef void* (*SPD_OPEN_FN)(const char*, const char*, const char*, int);
+typedef int (*SPD_SAY_FN)(void*, int, const char*);
+typedef int (*SPD_CONN_FN)(void*);
+typedef void (*SPD_CLOSE_FN)(void*);
+typedef int (*SPD_SET_INT_FN)(void*, int);
+typedef void (*SPD_CALLBACK_FN)(size_t msgId, size_t clientId, int state);
+
+#define SPD_MODE_SINGLE 0
+#define SPD_MODE_THREADED 1
+#define SPD_PRIORITY_MESSAGE 2
+#define SPD_PRIORITY_TEXT 3
+#define SPD_END 2
+#define SPD_CANCEL 8
+#define SPD_EVENT_END 1
+#define SPD_EVENT_CANCEL 3
+
+/* The public head of libspeechd's SPDConnection, where the callbacks go */
+typedef struct {
+    int mode;
+    FILE* stream;
+    SPD_CALLBACK_FN callback_begin;
+    SPD_CALLBACK_FN callback_end;
+    SPD_CALLBACK_FN callback_cancel;
+    SPD_CALLBACK_FN callback_pause;
+    SPD_CALLBACK_FN callback_resume;
+    void* callback_im;
+} SPD_CONNECTION_HEAD;
+
+static struct {
+    void* lib;
+    void* conn;
+    SPD_SAY_FN say;
+    SPD_CONN_FN cancel;
+    SPD_CLOSE_FN close;
+    SPD_SET_INT_FN set_rate;
+    SPD_SET_INT_FN set_volume;
+    int rate;
+    int volume;
+    int notified;               /* END/CANCEL callbacks registered */
+    SDL_AtomicInt said;         /* Id of the last message sent */
+    SDL_AtomicInt finished;     /* Highest message id that ended or was cancelled */
+    Uint64 estimatedEnd;        /* Without callbacks: SDL_GetTicks when speech should be done */
+} g_Speechd;
+
+/* Runs on libspeechd's event thread. Message ids only go up, so speech is
+ * over once the last message sent has ended or been cancelled. */
+static void TTS_SpeechdEvent(size_t msgId, size_t clientId, int state)
+{
+    (void)clientId;
+    if (state != SPD_EVENT_END && state != SPD_EVENT_CANCEL) return;
+
+    int finished = SDL_GetAtomicInt(&g_Speechd.finished);
+    while ((int)msgId > finished &&
+           !SDL_CompareAndSwapAtomicInt(&g_Speechd.finished, finished, (int)msgId)) {
+        finished = SDL_GetAtomicInt(&g_Speechd.finished);
+    }
 }
-#endif
 
-/* ============================================
- * Public TTS Functions
- * ============================================ */
+/* Turn on END/CANCEL notifications; they need a threaded connection */
+static int TTS_SpeechdNotify(void* conn)
+{
+    typedef int (*SPD_NOTIFY_FN)(void*, int);
+    SPD_NOTIFY_FN notify = (SPD_NOTIFY_FN)SDL_LoadFunction(g_Speechd.lib, "spd_set_notification_on");
+    SPD_CONNECTION_HEAD* head = (SPD_CONNECTION_HEAD*)conn;
+
+    if (!notify) return 0;
+    head->callback_end = TTS_SpeechdEvent;
+    head->callback_cancel = TTS_SpeechdEvent;
+    if (notify(conn, SPD_END) != 0 || notify(conn, SPD_CANCEL) != 0) {
+        head->callback_end = head->callback_cancel = NULL;
+        return 0;
+    }
+    return 1;
+}
 
-extern "C" void TTS_Speak(const char* text)
+static int TTS_InitSpeechd(void)
 {
-    if (!AccessibilitySettings.enabled) return;
+    SPD_OPEN_FN open;
+
+    g_Speechd.lib = SDL_LoadObject("libspeechd.so.2");
+    if (!g_Speechd.lib) return 0;
+
+    open = (SPD_OPEN_FN)SDL_LoadFunction(g_Speechd.lib, "spd_open");
+    g_Speechd.say = (SPD_SAY_FN)SDL_LoadFunction(g_Speechd.lib, "spd_say");
+    g_Speechd.cancel = (SPD_CONN_FN)SDL_LoadFunction(g_Speechd.lib, "spd_cancel");
+    g_Speechd.close = (SPD_CLOSE_FN)SDL_LoadFunction(g_Speechd.lib, "spd_close");
+    g_Speechd.set_rate = (SPD_SET_INT_FN)SDL_LoadFunction(g_Speechd.lib, "spd_set_voice_rate");
+    g_Speechd.set_volume = (SPD_SET_INT_FN)SDL_LoadFunction(g_Speechd.lib, "spd_set_volume");
+
+    g_Speechd.notified = 0;
+    SDL_SetAtomicInt(&g_Speechd.said, 0);
+    SDL_SetAtomicInt(&g_Speechd.finished, 0);
+    g_Speechd.estimatedEnd = 0;
+
+    if (open && g_Speechd.say && g_Speechd.cancel && g_Speechd.close) {
+        g_Speechd.conn = open("avp", "accessibility", NULL, SPD_MODE_THREADED);
+        if (g_Speechd.conn) {
+            g_Speechd.notified = TTS_SpeechdNotify(g_Speechd.conn);
+            if (!g_Speechd.notified) {
+                g_Speechd.close(g_Speechd.conn);
+                g_Speechd.conn = NULL;
+            }
+        }
+        if (!g_Speechd.conn) {
+            g_Speechd.conn = open("avp", "accessibility", NULL, SPD_MODE_SINGLE);
+        }
+    }
+    if (!g_Speechd.conn) {
+        SDL_UnloadObject(g_Speechd.lib);
+        g_Speechd.lib = NULL;
+        return 0;
+    }
 
-#ifdef _WIN32
-    /* Interrupt previous speech if configured */
-    int interrupt = AccessibilitySettings.tts_interrupt ? 1 : 0;
-    TTS_SpeakInternal(text, interrupt);
-#endif
+    g_Speechd.rate = g_Speechd.volume = -1000;   /* Force first apply */
+    LOG_INF("speech-dispatcher connected (%s)",
+            g_Speechd.notified ? "speech end events" : "estimated speech length");
+    return 1;
+}
 
-    LOG_INF("TTS: %s", text);
+static void TTS_ShutdownSpeechd(void)
+{
+    if (g_Speechd.conn) g_Speechd.close(g_Speechd.conn);
+    if (g_Speechd.lib) SDL_UnloadObject(g_Speechd.lib);
+    g_Speechd.conn = NULL;
+    g_Speechd.lib = NULL;
 }
 
-extern "C" void TTS_SpeakQueued(const char* text)
+static void TTS_SpeakSpeechd(const char* text, int interrupt)
 {
-    if (!AccessibilitySettings.enabled) return;
+    if (!g_Speechd.conn) return;
 
-#ifdef _WIN32
-    /* Don't interrupt - queue after current speech */
-    TTS_SpeakInternal(text, 0);
-#endif
+    /* Settings are -10..10 and 0..100; speechd wants -100..100 for both */
+    if (g_Speechd.set_rate && g_Speechd.rate != AccessibilitySettings.tts_rate) {
+        g_Speechd.rate = AccessibilitySettings.tts_rate;
+        g_Speechd.set_rate(g_Speechd.conn, g_Speechd.rate * 10);
+    }
+    if (g_Speechd.set_volume && g_Speechd.volume != AccessibilitySettings.tts_volume) {
+        g_Speechd.volume = AccessibilitySettings.tts_volume;
+        g_Speechd.set_volume(g_Speechd.conn, g_Speechd.volume * 2 - 100);
+    }
+
+    if (interrupt) g_Speechd.cancel(g_Speechd.conn);
+    int id = g_Speechd.say(g_Speechd.conn, interrupt ? SPD_PRIORITY_MESSAGE : SPD_PRIORITY_TEXT, text);
+
+    if (g_Speechd.notified) {
+        if (id > 0) SDL_SetAtomicInt(&g_Speechd.said, id);
+    } else if (id >= 0) {
+        /* No events: guess from length, at about six characters a word
+         * and espeak's 175 wpm plus 15 per rate step */
+        Uint64 now = SDL_GetTicks();
+        int wpm = 175 + AccessibilitySettings.tts_rate * 15;
+        if (wpm < 80) wpm = 80;
+        Uint64 start = (!interrupt && g_Speechd.estimatedEnd > now) ? g_Speechd.estimatedEnd : now;
+        g_Speechd.estimatedEnd = start + 150 + (Uint64)strlen(text) * 10000 / (Uint64)wpm;
+    }
 }
 
-extern "C" void TTS_SpeakPriority(const char* text)
+static void TTS_SilenceSpeechd(void)
 {
-    if (!AccessibilitySettings.enabled) return;
+    if (g_Speechd.conn) g_Speechd.cancel(g_Speechd.conn);
+    g_Speechd.estimatedEnd = 0;
+}
 
-#ifdef _WIN32
-    /* Always interrupt previous speech */
-    TTS_SpeakInternal(text, 1);
-#endif
+static int TTS_IsSpeakingSpeechd(void)
+{
+    if (!g_Speechd.conn) return 0;
+    if (g_Speechd.notified) {
+        return SDL_GetAtomicInt(&g_Speechd.said) > SDL_GetAtomicInt(&g_Speechd.finished) ? 1 : 0;
+    }
+    return SDL_GetTicks() < g_Speechd.estimatedEnd ? 1 : 0;
 }
 
-extern "C" void TTS_Stop(void)
+static const TTS_BACKEND g_TTSBackendSpeechd = {
+    "speechd", TTS_InitSpeechd, TTS_ShutdownSpeechd, TTS_SpeakSpeechd, TTS_SilenceSpeechd, TTS_IsSpeakingSpeechd
+};
+
+/* libespeak-ng */
+typedef int (*ESPEAK_INIT_FN)(int, int, const char*, int);
+typedef int (*ESPEAK_SYNTH_FN)(const void*, size_t, unsigned int, int, unsigned int, unsigned int, unsigned int*, void*);
+typedef int (*ESPEAK_VOID_FN)(void);
+typedef int (*ESPEAK_PARAM_FN)(int, int, int);
+
+#define ESPEAK_AUDIO_OUTPUT_PLAYBACK 0
+#define ESPEAK_POS_CHARACTER 1
+#define ESPEAK_CHARS_UTF8 1
+#define ESPEAK_PARAM_RATE 1
+#define ESPEAK_PARAM_VOLUME 2
+
+static struct {
+    void* lib;
+    ESPEAK_SYNTH_FN synth;
+    ESPEAK_VOID_FN cancel;
+    ESPEAK_VOID_FN is_playing;
+    ESPEAK_VOID_FN terminate;
+    ESPEAK_PARAM_FN set_parameter;
+    int rate;
+    int volume;
+} g_Espeak;
+
+static int TTS_InitEspeak(void)
 {
-#ifdef _WIN32
-    if (g_TolkInitialized) {
-        Tolk_Silence();
+    ESPEAK_INIT_FN initialize;
+
+    g_Espeak.lib = SDL_LoadObject("libespeak-ng.so.1");
+    if (!g_Espeak.lib) return 0;
+
+    initialize = (ESPEAK_INIT_FN)SDL_LoadFunction(g_Espeak.lib, "espeak_Initialize");
+    g_Espeak.synth = (ESPEAK_SYNTH_FN)SDL_LoadFunction(g_Espeak.lib, "espeak_Synth");
+    g_Espeak.cancel = (ESPEAK_VOID_FN)SDL_LoadFunction(g_Espeak.lib, "espeak_Cancel");
+    g_Espeak.is_playing = (ESPEAK_VOID_FN)SDL_LoadFunction(g_Espeak.lib, "espeak_IsPlaying");
+    g_Espeak.terminate = (ESPEAK_VOID_FN)SDL_LoadFunction(g_Espeak.lib, "espeak_Terminate");
+    g_Espeak.set_parameter = (ESPEAK_PARAM_FN)SDL_LoadFunction(g_Espeak.lib, "espeak_SetParameter");
+
+    if (!initialize || !g_Espeak.synth || !g_Espeak.cancel || !g_Espeak.is_playing ||
+        !g_Espeak.terminate || initialize(ESPEAK_AUDIO_OUTPUT_PLAYBACK, 0, NULL, 0) <= 0) {
+        SDL_UnloadObject(g_Espeak.lib);
+        g_Espeak.lib = NULL;
+        return 0;
     }
-#endif
+
+    g_Espeak.rate = g_Espeak.volume = -1000;   /* Force first apply */
+    LOG_INF("espeak-ng initialized");
+    return 1;
 }
 
-extern "C" int TTS_IsSpeaking(void)
+static void TTS_ShutdownEspeak(void)
 {
-#ifdef _WIN32
-    if (!g_TolkInitialized) return 0;
-    return Tolk_IsSpeaking() ? 1 : 0;
-#else
-    return 0;
-#endif
+    if (g_Espeak.lib) {
+        g_Espeak.terminate();
+        SDL_UnloadObject(g_Espeak.lib);
+        g_Espeak.lib = NULL;
+    }
 }
 
-extern "C" void TTS_SetRate(int rate)
+static void TTS_SpeakEspeak(const char* text, int interrupt)
 {
-    /* Rate adjustment not supported by Tolk - store setting for compatibility */
-    if (rate < -10) rate = -10;
-    if (rate > 10) rate = 10;
-    AccessibilitySettings.tts_rate = rate;
-    /* Note: Tolk uses the screen reader's default speech settings */
+    if (!g_Espeak.lib) return;
+
+    /* 175 wpm is espeak's default; each rate step is 15 wpm */
+    if (g_Espeak.set_parameter && g_Espeak.rate != AccessibilitySettings.tts_rate) {
+        g_Espeak.rate = AccessibilitySettings.tts_rate;
+        g_Espeak.set_parameter(ESPEAK_PARAM_RATE, 175 + g_Espeak.rate * 15, 0);
+    }
+    if (g_Espeak.set_parameter && g_Espeak.volume != AccessibilitySettings.tts_volume) {
+        g_Espeak.volume = AccessibilitySettings.tts_volume;
+        g_Espeak.set_parameter(ESPEAK_PARAM_VOLUME, g_Espeak.volume, 0);
+    }
+
+    if (interrupt) g_Espeak.cancel();
+    g_Espeak.synth(text, strlen(text) + 1, 0, ESPEAK_POS_CHARACTER, 0, ESPEAK_CHARS_UTF8, NULL, NULL);
 }
 
-extern "C" void TTS_SetVolume(int volume)
+static void TTS_SilenceEspeak(void)
 {
-    /* Volume adjustment not supported by Tolk - store setting for compatibility */
-    if (volume < 0) volume = 0;
-    if (volume > 100) volume = 100;
-    AccessibilitySettings.tts_volume = volume;
-    /* Note: Tolk uses the screen reader's default speech settings */
+    if (g_Espeak.lib) g_Espeak.cancel();
 }
 
-/* ============================================
- * Configuration File Support
- * ============================================ */
+static int TTS_IsSpeakingEspeak(void)
+{
+    return g_Espeak.lib && g_Espeak.is_playing() ? 1 : 0;
+}
+
+static const TTS_BACKEND g_TTSBackendEspeak = {
+    "espeak", TTS_InitEspeak, TTS_ShutdownEspeak, TTS_SpeakEspeak, TTS_SilenceEspeak, TTS_IsSpeakingEspeak
+};
 
+#endif
+
+/*
+ * Sink backend: writes one line per utterance to a file, or to a command's
+ * stdin when the path starts with '|'. Intended for tests and for piping
+ * into external speech tools. Lines are "SAY <text>", "INTERRUPT <text>"
+ * and "SILENCE".
+ */
 #ifdef _WIN32
-static void LoadConfigFile(void)
-{
-    char iniPath[MAX_PATH];
-    char buffer[64];
+#define TTS_POPEN _popen
+#define TTS_PCLOSE _pclose
+#else
+#define TTS_POPEN popen
+#define TTS_PCLOSE pclose
+#endif
 
-    /* Try to find accessibility.ini in current directory */
-    GetCurrentDirectoryA(MAX_PATH, iniPath);
-    strcat(iniPath, "\\accessibility.ini");
+static FILE* g_TTSSinkFile = NULL;
+static int g_TTSSinkIsPipe = 0;
 
-    /* Check if file exists */
-    DWORD attrs = GetFileAttributesA(iniPath);
-    if (attrs == INVALID_FILE_ATTRIBUTES) {
-        Accessibility_Log("No accessibility.ini found, using defaults\n");
-        return;
+static int TTS_InitSink(void)
+{
+    if (g_TTSSinkPath[0] == '\0') return 0;
+
+    if (g_TTSSinkPath[0] == '|') {
+        g_TTSSinkFile = TTS_POPEN(g_TTSSinkPath + 1, "w");
+        g_TTSSinkIsPipe = 1;
+    } else {
+        g_TTSSinkFile = fopen(g_TTSSinkPath, "a");
+        g_TTSSinkIsPipe = 0;
     }
+    if (!g_TTSSinkFile) return 0;
 
-    Accessibility_Log("Loading config from %s\n", iniPath);
+    LOG_INF("TTS sink opened: %s", g_TTSSinkPath);
+    return 1;
+}
 
-    /* General settings */
-    AccessibilitySettings.enabled = GetPrivateProfileIntA("General", "Enabled", 1, iniPath);
-    AccessibilitySettings.tts_enabled = GetPrivateProfileIntA("General", "TTSEnabled", 1, iniPath);
-    AccessibilitySettings.audio_radar_enabled = GetPrivateProfileIntA("General", "RadarEnabled", 1, iniPath);
-    AccessibilitySettings.navigation_cues_enabled = GetPrivateProfileIntA("General", "NavigationCues", 1, iniPath);
-    AccessibilitySettings.state_announcements_enabled = GetPrivateProfileIntA("General", "StateAnnouncements", 1, iniPath);
-    AccessibilitySettings.menu_narration_enabled = GetPrivateProfileIntA("General", "MenuNarration", 1, iniPath);
+static void TTS_ShutdownSink(void)
+{
+    if (!g_TTSSinkFile) return;
+    if (g_TTSSinkIsPipe) TTS_PCLOSE(g_TTSSinkFile);
+    else fclose(g_TTSSinkFile);
+    g_TTSSinkFile = NULL;
+}
 
-    /* TTS settings */
-    AccessibilitySettings.tts_rate = GetPrivateProfileIntA("TTS", "Rate", 0, iniPath);
-    if (AccessibilitySettings.tts_rate < -10) AccessibilitySettings.tts_rate = -10;
-    if (AccessibilitySettings.tts_rate > 10) AccessibilitySettings.tts_rate = 10;
+static void TTS_SpeakSink(const char* text, int interrupt)
+{
+    if (!g_TTSSinkFile) return;
+    fprintf(g_TTSSinkFile, "%s %s\n", interrupt ? "INTERRUPT" : "SAY", text);
+    fflush(g_TTSSinkFile);
+}
 
-    AccessibilitySettings.tts_volume = GetPrivateProfileIntA("TTS", "Volume", 100, iniPath);
-    if (AccessibilitySettings.tts_volume < 0) AccessibilitySettings.tts_volume = 0;
-    if (AccessibilitySettings.tts_volume > 100) AccessibilitySettings.tts_volume = 100;
+static void TTS_SilenceSink(void)
+{
+    if (!g_TTSSinkFile) return;
+    fprintf(g_TTSSinkFile, "SILENCE\n");
+    fflush(g_TTSSinkFile);
+}
 
-    AccessibilitySettings.tts_interrupt = GetPrivateProfileIntA("TTS", "Interrupt", 1, iniPath);
+static int TTS_IsSpeakingSink(void)
+{
+    return 0;
+}
 
-    /* Radar settings */
-    AccessibilitySettings.radar_update_interval_ms = GetPrivateProfileIntA("Radar", "UpdateInterval", 500, iniPath);
-    AccessibilitySettings.radar_max_enemies = GetPrivateProfileIntA("Radar", "MaxEnemies", 5, iniPath);
-    AccessibilitySettings.radar_range = GetPrivateProfileIntA("Radar", "Range", 50000, iniPath);
+static const TTS_BACKEND g_TTSBackendSink = {
+    "sink", TTS_InitSink, TTS_ShutdownSink, TTS_SpeakSink, TTS_SilenceSink, TTS_IsSpeakingSink
+};
 
-    /* Warning thresholds */
-    AccessibilitySettings.health_warning_threshold = GetPrivateProfileIntA("Warnings", "HealthThreshold", 25, iniPath);
-    AccessibilitySettings.ammo_warning_threshold = GetPrivateProfileIntA("Warnings", "AmmoThreshold", 10, iniPath);
+/* Candidates in "auto" order */
+static const TTS_BACKEND* const g_TTSBackends[] = {
+    &g_TTSBackendSink,      /* Only succeeds when a sink path is configured */
+#ifdef _WIN32
+    &g_TTSBackendTolk,
+#else
+    &g_TTSBackendSpeechd,
+    &g_TTSBackendEspeak,
+#endif
+};
 
-    /* Logging settings */
-    g_LoggingEnabled = GetPrivateProfileIntA("Logging", "Enabled", 1, iniPath);
+static const TTS_BACKEND* TTS_SelectBackend(void)
+{
+    const char* env;
+    int count = (int)(sizeof(g_TTSBackends) / sizeof(g_TTSBackends[0]));
 
-    char levelStr[32];
-    GetPrivateProfileStringA("Logging", "Level", "DEBUG", levelStr, sizeof(levelStr), iniPath);
-    if (_stricmp(levelStr, "DEBUG") == 0) g_LogLevel = LOG_DEBUG;
-    else if (_stricmp(levelStr, "INFO") == 0) g_LogLevel = LOG_INFO;
-    else if (_stricmp(levelStr, "WARNING") == 0) g_LogLevel = LOG_WARNING;
-    else if (_stricmp(levelStr, "ERROR") == 0) g_LogLevel = LOG_ERROR;
+    env = SDL_getenv("AVP_TTS_BACKEND");
+    if (env && env[0]) {
+        strncpy(g_TTSBackendName, env, sizeof(g_TTSBackendName) - 1);
+        g_TTSBackendName[sizeof(g_TTSBackendName) - 1] = '\0';
+    }
+    env = SDL_getenv("AVP_TTS_SINK");
+    if (env && env[0]) {
+        strncpy(g_TTSSinkPath, env, sizeof(g_TTSSinkPath) - 1);
+        g_TTSSinkPath[sizeof(g_TTSSinkPath) - 1] = '\0';
+    }
 
-    LOG_INF("Config loaded successfully");
+    if (strcmp(g_TTSBackendName, "none") == 0) return NULL;
+
+    for (int i = 0; i < count; i++) {
+        int wanted = strcmp(g_TTSBackendName, "auto") == 0 ||
+                     strcmp(g_TTSBackendName, g_TTSBackends[i]->name) == 0;
+        if (wanted && g_TTSBackends[i]->init()) {
+            LOG_INF("TTS backend: %s", g_TTSBackends[i]->name);
+            return g_TTSBackends[i];
+        }
+    }
+
+    LOG_WRN("No TTS backend available (requested: %s)", g_TTSBackendName);
+    return NULL;
 }
-#else
-static void LoadConfigFile(void) { /* No-op on non-Windows */ }
-#endif
 
 /* ============================================
- * Initialization and Shutdown
+ * TTS Speech Thread
  * ============================================ */
 
-extern "C" int Accessibility_Init(void)
+/*
+ * The game thread only ever copies text into a small bounded queue under a
+ * mutex that is never held across a backend call, so it cannot stall
+ * behind the screen reader. The speech thread pops the highest-priority
+ * message (FIFO within a priority) and hands it to the backend.
+ *
+ * Non-interrupting messages are held back while the backend reports it is
+ * still talking, which gives later updates a chance to supersede them:
+ * a message with a category replaces any pending message of the same
+ * category in place (e.g. successive "N meters." progress updates), and an
+ * exact duplicate of a pending message is dropped. A message whose
+ * announcement rule gave it a time-to-live is discarded unspoken once that
+ * runs out, so a backlog never reports what was true seconds ago.
+ */
+#define TTS_QUEUE_SIZE 16
+#define TTS_CATEGORY_LEN 32
+#define TTS_POLL_INTERVAL_MS 50
+#define TTS_INIT_TIMEOUT_MS 5000
+
+typedef enum {
+    TTS_PRIORITY_QUEUED = 0,     /* TTS_SpeakQueued / TTS_SpeakCategory */
+    TTS_PRIORITY_NORMAL = 1,     /* TTS_Speak */
+    TTS_PRIORITY_URGENT = 2      /* TTS_SpeakPriority */
+} TTS_PRIORITY;
+
+typedef struct {
+    char text[TTS_MAX_TEXT];
+    char category[TTS_CATEGORY_LEN];
+    int priority;
+    int interrupt;
+    int replace;                 /* Supersedes a pending message of the same category */
+    unsigned int order;
+    Uint64 expires;              /* SDL_GetTicks deadline, 0 = never */
+} TTS_MESSAGE;
+
+static TTS_MESSAGE g_TTSQueue[TTS_QUEUE_SIZE];
+static int g_TTSQueueCount = 0;
+static unsigned int g_TTSNextOrder = 0;
+static int g_TTSSilenceRequested = 0;
+static int g_TTSRunning = 0;
+static int g_TTSDropped = 0;
+static int g_TTSExpired = 0;
+static SDL_Mutex* g_TTSMutex = NULL;
+static SDL_Condition* g_TTSWake = NULL;
+static SDL_Thread* g_TTSThread = NULL;
+static SDL_Semaphore* g_TTSReady = NULL;
+static SDL_AtomicInt g_TTSBusy;              /* Queue non-empty or backend talking */
+static SDL_AtomicInt g_TTSFailed;            /* The worker gave up: no backend came up */
+static Uint64 g_TTSClipUntil = 0;            /* A speech clip is playing until then */
+static const TTS_BACKEND* g_TTSBackend = NULL;
+
+/* Caller holds g_TTSMutex */
+static void TTS_RemoveAt(int index)
 {
-    if (g_AccessibilityInitialized) {
-        return 1;
+    g_TTSQueue[index] = g_TTSQueue[g_TTSQueueCount - 1];
+    g_TTSQueueCount--;
+}
+
+/* Caller holds g_TTSMutex. Discards expired messages, returns -1 when empty. */
+static int TTS_FindNext(void)
+{
+    Uint64 now = SDL_GetTicks();
+    for (int i = g_TTSQueueCount - 1; i >= 0; i--) {
+        if (g_TTSQueue[i].expires && now >= g_TTSQueue[i].expires) {
+            TTS_RemoveAt(i);
+            g_TTSExpired++;
+        }
     }
 
-    /* Initialize logging first */
-    Log_Init();
-    LOG_INF("=== Accessibility System Starting ===");
+    int best = -1;
+    for (int i = 0; i < g_TTSQueueCount; i++) {
+        if (best < 0 ||
+            g_TTSQueue[i].priority > g_TTSQueue[best].priority ||
+            (g_TTSQueue[i].priority == g_TTSQueue[best].priority &&
+             (int)(g_TTSQueue[i].order - g_TTSQueue[best].order) < 0)) {
+            best = i;
+        }
+    }
+    return best;
+}
 
-    /* Load configuration from INI file */
-    LoadConfigFile();
+static void TTS_EnqueueMessage(const char* text, const char* category, int priority, int interrupt,
+                               int replace, unsigned int ttlMs)
+{
+    TTS_MESSAGE* msg = NULL;
 
-    LOG_INF("Initializing accessibility system...");
+    if (!g_TTSThread || !text || !text[0] || !AccessibilitySettings.tts_enabled) return;
 
-    /* Initialize TTS (Tolk screen reader library) */
-    if (!TTS_InitTolk()) {
-        Accessibility_Log("Warning: TTS initialization failed\n");
-        AccessibilitySettings.tts_enabled = 0;
+    /* Store for repeat function */
+    if (text != g_LastSpokenText) {
+        strncpy(g_LastSpokenText, text, sizeof(g_LastSpokenText) - 1);
+        g_LastSpokenText[sizeof(g_LastSpokenText) - 1] = '\0';
     }
 
-    g_AccessibilityInitialized = 1;
+    SDL_LockMutex(g_TTSMutex);
+    if (!g_TTSRunning) {
+        SDL_UnlockMutex(g_TTSMutex);
+        return;
+    }
 
-    /* Announce startup */
-    TTS_Speak("Accessibility features enabled");
+    if (interrupt) {
+        /* Interrupting speech also discards everything queued behind it */
+        for (int i = g_TTSQueueCount - 1; i >= 0; i--) {
+            if (g_TTSQueue[i].priority <= priority) TTS_RemoveAt(i);
+        }
+    }
 
-    return 1;
+    for (int i = 0; i < g_TTSQueueCount && !msg; i++) {
+        if (replace && category && category[0] && g_TTSQueue[i].replace &&
+            strcmp(g_TTSQueue[i].category, category) == 0) {
+            msg = &g_TTSQueue[i];   /* Superseded: reuse its slot and position */
+        } else if (g_TTSQueue[i].priority == priority && strcmp(g_TTSQueue[i].text, text) == 0) {
+            SDL_UnlockMutex(g_TTSMutex);
+            return;
+        }
+    }
+
+    if (!msg) {
+        if (g_TTSQueueCount < TTS_QUEUE_SIZE) {
+            msg = &g_TTSQueue[g_TTSQueueCount++];
+        } else {
+            /* Full: evict the oldest lowest-priority message if it matters less */
+            int victim = 0;
+            for (int i = 1; i < g_TTSQueueCount; i++) {
+                if (g_TTSQueue[i].priority < g_TTSQueue[victim].priority ||
+                    (g_TTSQueue[i].priority == g_TTSQueue[victim].priority &&
+                     (int)(g_TTSQueue[i].order - g_TTSQueue[victim].order) < 0)) {
+                    victim = i;
+                }
+            }
+            g_TTSDropped++;
+            if (g_TTSQueue[victim].priority > priority) {
+                SDL_UnlockMutex(g_TTSMutex);
+                return;
+            }
+            msg = &g_TTSQueue[victim];
+        }
+        msg->order = g_TTSNextOrder++;
+    }
+
+    strncpy(msg->text, text, TTS_MAX_TEXT - 1);
+    msg->text[TTS_MAX_TEXT - 1] = '\0';
+    strncpy(msg->category, category ? category : "", TTS_CATEGORY_LEN - 1);
+    msg->category[TTS_CATEGORY_LEN - 1] = '\0';
+    msg->priority = priority;
+    msg->interrupt = interrupt;
+    msg->replace = replace;
+    msg->expires = ttlMs ? SDL_GetTicks() + ttlMs : 0;
+
+    SDL_SetAtomicInt(&g_TTSBusy, 1);
+    SDL_SignalCondition(g_TTSWake);
+    SDL_UnlockMutex(g_TTSMutex);
 }
 
-extern "C" void Accessibility_Shutdown(void)
+static int SDLCALL TTS_WorkerThread(void* data)
 {
-    if (!g_AccessibilityInitialized) {
-        return;
-    }
+    TTS_MESSAGE msg;
+    (void)data;
+
+    g_TTSBackend = TTS_SelectBackend();
+    if (!g_TTSBackend) {
+        /* Anything queued while the backends were tried will never be spoken */
+        SDL_LockMutex(g_TTSMutex);
+        g_TTSRunning = 0;
+        g_TTSQueueCount = 0;
+        SDL_SetAtomicInt(&g_TTSBusy, 0);
+        SDL_SetAtomicInt(&g_TTSFailed, 1);
+        SDL_UnlockMutex(g_TTSMutex);
+    }
+    SDL_SignalSemaphore(g_TTSReady);
+    if (!g_TTSBackend) return 0;
+
+    SDL_LockMutex(g_TTSMutex);
+    while (g_TTSRunning) {
+        if (g_TTSSilenceRequested) {
+            g_TTSSilenceRequested = 0;
+            SDL_UnlockMutex(g_TTSMutex);
+            g_TTSBackend->silence();
+            SDL_LockMutex(g_TTSMutex);
+            continue;
+        }
 
-    LOG_INF("=== Accessibility System Shutting Down ===");
+        int next = TTS_FindNext();
+        int talking = 0;
+        if (next >= 0 && !g_TTSQueue[next].interrupt) {
+            SDL_UnlockMutex(g_TTSMutex);
+            talking = g_TTSBackend->is_speaking();
+            SDL_LockMutex(g_TTSMutex);
+            if (!g_TTSRunning) break;
+            if (SDL_GetTicks() < g_TTSClipUntil) talking = 1;
+            next = TTS_FindNext();   /* The queue may have changed meanwhile */
+            if (next >= 0 && g_TTSQueue[next].interrupt) talking = 0;
+        }
 
-    TTS_Stop();
-    TTS_ShutdownTolk();
-    RadarTone_Shutdown();
-    PitchTone_Shutdown();
+        if (next < 0 || talking) {
+            if (next < 0) {
+                SDL_UnlockMutex(g_TTSMutex);
+                talking = g_TTSBackend->is_speaking();
+                SDL_LockMutex(g_TTSMutex);
+                if (SDL_GetTicks() < g_TTSClipUntil) talking = 1;
+                if (g_TTSQueueCount == 0 && !g_TTSSilenceRequested) {
+                    SDL_SetAtomicInt(&g_TTSBusy, talking);
+                }
+            }
+            SDL_WaitConditionTimeout(g_TTSWake, g_TTSMutex, TTS_POLL_INTERVAL_MS);
+            continue;
+        }
 
-    g_AccessibilityInitialized = 0;
+        msg = g_TTSQueue[next];
+        TTS_RemoveAt(next);
+        if (g_TTSDropped) {
+            LOG_WRN("TTS queue full, %d message(s) dropped", g_TTSDropped);
+            g_TTSDropped = 0;
+        }
+        if (g_TTSExpired) {
+            LOG_DBG("TTS: %d stale message(s) expired unspoken", g_TTSExpired);
+            g_TTSExpired = 0;
+        }
+        SDL_UnlockMutex(g_TTSMutex);
 
-    LOG_INF("Accessibility system shutdown complete");
-    Log_Shutdown();
+        g_TTSBackend->speak(msg.text, msg.interrupt);
+
+        SDL_LockMutex(g_TTSMutex);
+    }
+    SDL_UnlockMutex(g_TTSMutex);
+
+    g_TTSBackend->shutdown();
+    g_TTSBackend = NULL;
+    return 0;
 }
 
-extern "C" int Accessibility_IsAvailable(void)
+static void TTS_DestroyPrimitives(void)
 {
-    return g_AccessibilityInitialized && AccessibilitySettings.enabled;
+    if (g_TTSReady) { SDL_DestroySemaphore(g_TTSReady); g_TTSReady = NULL; }
+    if (g_TTSWake) { SDL_DestroyCondition(g_TTSWake); g_TTSWake = NULL; }
+    if (g_TTSMutex) { SDL_DestroyMutex(g_TTSMutex); g_TTSMutex = NULL; }
 }
 
-/* ============================================
- * Direction and Distance Utilities
- * ============================================ */
+/* Start the speech thread and wait for its backend to come up */
+static int TTS_Init(void)
+{
+    if (g_TTSThread) return 1;
+
+    g_TTSMutex = SDL_CreateMutex();
+    g_TTSWake = SDL_CreateCondition();
+    g_TTSReady = SDL_CreateSemaphore(0);
+    if (!g_TTSMutex || !g_TTSWake || !g_TTSReady) {
+        LOG_ERR("TTS: failed to create thread primitives: %s", SDL_GetError());
+        TTS_DestroyPrimitives();
+        return 0;
+    }
 
-extern "C" AUDIO_DIRECTION Accessibility_GetDirection(int px, int py, int pz,
-                                                       int tx, int ty, int tz,
-                                                       int player_yaw)
+    g_TTSQueueCount = 0;
+    g_TTSSilenceRequested = 0;
+    g_TTSRunning = 1;
+    SDL_SetAtomicInt(&g_TTSBusy, 0);
+    SDL_SetAtomicInt(&g_TTSFailed, 0);
+
+    g_TTSThread = SDL_CreateThread(TTS_WorkerThread, "AccessibilityTTS", NULL);
+    if (!g_TTSThread) {
+        LOG_ERR("TTS: failed to create speech thread: %s", SDL_GetError());
+        g_TTSRunning = 0;
+        TTS_DestroyPrimitives();
+        return 0;
+    }
+
+    if (!SDL_WaitSemaphoreTimeout(g_TTSReady, TTS_INIT_TIMEOUT_MS)) {
+        LOG_WRN("TTS backend still initializing after %d ms", TTS_INIT_TIMEOUT_MS);
+        return 1;   /* Messages queue up until it is ready */
+    }
+    if (!g_TTSBackend) {
+        SDL_WaitThread(g_TTSThread, NULL);
+        g_TTSThread = NULL;
+        TTS_DestroyPrimitives();
+        return 0;
+    }
+    return 1;
+}
+
+static void TTS_Shutdown(void)
 {
-    /* Calculate relative position */
-    int dx = tx - px;
-    int dy = ty - py;
-    int dz = tz - pz;
+    if (g_TTSThread) {
+        SDL_LockMutex(g_TTSMutex);
+        g_TTSRunning = 0;
+        g_TTSQueueCount = 0;
+        SDL_SignalCondition(g_TTSWake);
+        SDL_UnlockMutex(g_TTSMutex);
 
-    /* Check vertical first */
-    int horiz_dist = (int)sqrt((double)(dx*dx + dz*dz));
-    if (abs(dy) > horiz_dist) {
-        return (dy < 0) ? DIR_ABOVE : DIR_BELOW;
+        SDL_WaitThread(g_TTSThread, NULL);
+        g_TTSThread = NULL;
     }
 
-    /* Calculate angle to target */
-    double angle = atan2((double)dx, (double)dz);
-    angle = angle * 180.0 / 3.14159265358979323846;
+    TTS_DestroyPrimitives();
+}
 
-    /* Adjust for player's facing direction */
-    /* player_yaw is typically in 0-4096 range (12-bit angle) */
-    double player_angle = (player_yaw / 4096.0) * 360.0;
-    angle = angle - player_angle;
+/* ============================================
+ * Speech Clip Cache
+ * ============================================ */
 
-    /* Normalize to -180 to 180 */
-    while (angle > 180.0) angle -= 360.0;
-    while (angle < -180.0) angle += 360.0;
+/*
+ * Optional fast path for the fixed phrases behind the most time-critical
+ * cues. A background thread renders each phrase in the table once with the
+ * espeak-ng command-line synth, at the current speech rate, and keeps the
+ * PCM in a cache file so later runs only render new or changed phrases.
+ * The game thread then plays a phrase straight through OpenAL, like the
+ * radar tones, instead of waiting on the screen reader. Any other text, and
+ * any phrase whose clip is missing or was rendered at another rate, still
+ * goes to live TTS.
+ *
+ * A clip takes the same slot in the speech queue a live message would: an
+ * interrupting clip flushes and silences the backend, a queued one only
+ * plays when nothing else is pending or talking, and the speech thread
+ * holds queued messages back until the clip has finished.
+ */
+#define SPEECH_CLIP_MAX 48
+#define SPEECH_CLIP_MAX_TEXT 64
+#define SPEECH_CLIP_MAX_SAMPLES (22050 * 10)
+#define SPEECH_CLIP_SILENCE 256             /* Trimmed from both ends */
+#define SPEECH_CLIP_MAGIC "AVPCLIP1"
 
-    /* Convert to direction enum */
-    if (angle >= -22.5 && angle < 22.5) return DIR_FRONT;
-    if (angle >= 22.5 && angle < 67.5) return DIR_FRONT_RIGHT;
-    if (angle >= 67.5 && angle < 112.5) return DIR_RIGHT;
-    if (angle >= 112.5 && angle < 157.5) return DIR_BACK_RIGHT;
-    if (angle >= 157.5 || angle < -157.5) return DIR_BACK;
-    if (angle >= -157.5 && angle < -112.5) return DIR_BACK_LEFT;
-    if (angle >= -112.5 && angle < -67.5) return DIR_LEFT;
-    if (angle >= -67.5 && angle < -22.5) return DIR_FRONT_LEFT;
+typedef struct {
+    char text[SPEECH_CLIP_MAX_TEXT];
+    int rate;                    /* tts_rate it was rendered at */
+    Sint16* samples;             /* Mono 16-bit, freed once uploaded */
+    Uint32 sampleCount;
+    Uint32 sampleRate;
+    ALuint buffer;
+} SPEECH_CLIP;
+
+/* The fixed prompts; the door and interaction prompts built from a class
+ * name come from SpeechClips_PromptPhrase */
+static const char* const g_SpeechClipDefaults[] = {
+    "Target reached.",
+    "Navigation stalled.",
+    "Moving away from target.",
+    "Rerouting.",
+    "Clear ahead.",
+    "Jump ahead.",
+    "Drop ahead.",
+    "Backing up.",
+    "Trying wall follow left.",
+    "Trying wall follow right.",
+    "Trying wide path left.",
+    "Trying wide path right.",
+    "Retrying direct path.",
+    "Cannot reach target. Try manual navigation.",
+    "Scanning for interactive elements...",
+    "No interactive elements detected nearby.",
+    "Reloading.",
+    "Weapon jammed!",
+    "Out of ammo!",
+    "Cloak on.",
+    "Cloak off.",
+};
 
-    return DIR_FRONT;
+static int SpeechClips_PromptPhrase(int index, char* phrase, size_t size);
+
+static int g_ClipsEnabled = 0;
+static char g_ClipPhrasePath[MAX_PATH] = {0};
+static char g_ClipCachePath[MAX_PATH] = "accessibility_clips.bin";
+
+static SPEECH_CLIP g_Clips[SPEECH_CLIP_MAX];
+static int g_ClipCount = 0;
+static SDL_Thread* g_ClipThread = NULL;
+static SDL_AtomicInt g_ClipsReady;          /* Set by the clip thread once g_Clips is final */
+static SDL_AtomicInt g_ClipsCancel;
+static ALuint g_ClipSource = 0;
+static int g_ClipsUploadFailed = 0;
+
+static SPEECH_CLIP* SpeechClips_Find(const char* text)
+{
+    for (int i = 0; i < g_ClipCount; i++) {
+        if (g_Clips[i].text[0] == text[0] && strcmp(g_Clips[i].text, text) == 0) return &g_Clips[i];
+    }
+    return NULL;
 }
 
-extern "C" int Accessibility_GetDistance(int x1, int y1, int z1,
-                                         int x2, int y2, int z2)
+static void SpeechClips_AddPhrase(const char* text)
 {
-    int dx = x2 - x1;
-    int dy = y2 - y1;
-    int dz = z2 - z1;
-    return (int)sqrt((double)(dx*dx + dy*dy + dz*dz));
+    size_t length = strlen(text);
+
+    if (length == 0 || length >= SPEECH_CLIP_MAX_TEXT || g_ClipCount >= SPEECH_CLIP_MAX) return;
+    if (SpeechClips_Find(text)) return;
+
+    SPEECH_CLIP* clip = &g_Clips[g_ClipCount++];
+    memset(clip, 0, sizeof(*clip));
+    memcpy(clip->text, text, length + 1);
+    clip->rate = AccessibilitySettings.tts_rate;
 }
 
-extern "C" const char* Accessibility_FormatDistance(int distance)
+/* The phrase file replaces the defaults: one phrase per line, '#' starts a comment */
+static void SpeechClips_LoadPhrases(void)
 {
-    static char buffer[64];
+    FILE* file = g_ClipPhrasePath[0] ? fopen(g_ClipPhrasePath, "r") : NULL;
+    char line[256];
 
-    /* Convert game units to approximate meters (rough estimate) */
-    int meters = distance / 1000;
+    if (!file) {
+        char phrase[SPEECH_CLIP_MAX_TEXT];
 
-    if (meters < 2) {
-        return "very close";
-    } else if (meters < 5) {
-        return "close";
-    } else if (meters < 10) {
-        snprintf(buffer, sizeof(buffer), "%d meters", meters);
-    } else if (meters < 20) {
-        return "medium range";
-    } else if (meters < 50) {
-        return "far";
-    } else {
-        return "very far";
+        if (g_ClipPhrasePath[0]) LOG_WRN("Speech clips: cannot open %s, using defaults", g_ClipPhrasePath);
+        for (size_t i = 0; i < sizeof(g_SpeechClipDefaults) / sizeof(g_SpeechClipDefaults[0]); i++) {
+            SpeechClips_AddPhrase(g_SpeechClipDefaults[i]);
+        }
+        for (int i = 0; SpeechClips_PromptPhrase(i, phrase, sizeof(phrase)); i++) {
+            SpeechClips_AddPhrase(phrase);
+        }
+        return;
     }
 
-    return buffer;
+    while (fgets(line, sizeof(line), file)) {
+        size_t length = strlen(line);
+        while (length > 0 && isspace((unsigned char)line[length - 1])) line[--length] = '\0';
+        if (line[0] != '#') SpeechClips_AddPhrase(line);
+    }
+    fclose(file);
 }
 
-extern "C" const char* AudioRadar_GetDirectionName(AUDIO_DIRECTION dir)
+/* Every fixed AutoNav and interaction prompt should have a clip; name any
+ * that will go to live TTS (a phrase file without them, or a full table) */
+static void SpeechClips_CheckPrompts(void)
 {
-    switch (dir) {
-        case DIR_FRONT: return "ahead";
-        case DIR_FRONT_LEFT: return "front left";
-        case DIR_LEFT: return "left";
-        case DIR_BACK_LEFT: return "behind left";
-        case DIR_BACK: return "behind";
-        case DIR_BACK_RIGHT: return "behind right";
-        case DIR_RIGHT: return "right";
-        case DIR_FRONT_RIGHT: return "front right";
-        case DIR_ABOVE: return "above";
-        case DIR_BELOW: return "below";
-        default: return "unknown";
+    char phrase[SPEECH_CLIP_MAX_TEXT];
+    int missing = 0;
+
+    for (size_t i = 0; i < sizeof(g_SpeechClipDefaults) / sizeof(g_SpeechClipDefaults[0]); i++) {
+        if (!SpeechClips_Find(g_SpeechClipDefaults[i])) {
+            LOG_WRN("Speech clips: no clip for \"%s\"", g_SpeechClipDefaults[i]);
+            missing++;
+        }
+    }
+    for (int i = 0; SpeechClips_PromptPhrase(i, phrase, sizeof(phrase)); i++) {
+        if (!SpeechClips_Find(phrase)) {
+            LOG_WRN("Speech clips: no clip for \"%s\"", phrase);
+            missing++;
+        }
     }
+    if (missing) LOG_WRN("Speech clips: %d prompts will use live TTS", missing);
 }
 
-extern "C" const char* AudioRadar_GetEntityTypeName(RADAR_ENTITY_TYPE type)
+/* Cache layout: magic, count, then per clip: text length, text, rate, sample rate, sample count, samples */
+static void SpeechClips_LoadCache(void)
 {
-    switch (type) {
-        case RADAR_ENTITY_ALIEN: return "alien";
-        case RADAR_ENTITY_PREDATOR: return "predator";
-        case RADAR_ENTITY_MARINE: return "marine";
-        case RADAR_ENTITY_FACEHUGGER: return "facehugger";
-        case RADAR_ENTITY_XENOBORG: return "xenoborg";
-        case RADAR_ENTITY_QUEEN: return "queen";
-        case RADAR_ENTITY_ITEM_HEALTH: return "health pickup";
-        case RADAR_ENTITY_ITEM_AMMO: return "ammo";
-        case RADAR_ENTITY_ITEM_WEAPON: return "weapon";
-        case RADAR_ENTITY_DOOR: return "door";
-        case RADAR_ENTITY_LIFT: return "lift";
-        case RADAR_ENTITY_SWITCH: return "switch";
-        case RADAR_ENTITY_GENERATOR: return "generator";
-        case RADAR_ENTITY_TERMINAL: return "terminal";
-        default: return "unknown";
+    FILE* file = fopen(g_ClipCachePath, "rb");
+    char magic[8];
+    Uint32 count;
+
+    if (!file) return;
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, SPEECH_CLIP_MAGIC, sizeof(magic)) != 0 ||
+        fread(&count, sizeof(count), 1, file) != 1) {
+        LOG_WRN("Speech clips: ignoring unrecognised cache %s", g_ClipCachePath);
+        fclose(file);
+        return;
     }
-}
 
-/* ============================================
- * Audio Radar Implementation
- * ============================================ */
+    for (Uint32 i = 0; i < count; i++) {
+        char text[SPEECH_CLIP_MAX_TEXT];
+        Uint16 textLength;
+        Sint32 rate;
+        Uint32 sampleRate, sampleCount;
 
-static RADAR_ENTITY_TYPE GetRadarEntityType(AVP_BEHAVIOUR_TYPE bhvr)
-{
-    switch (bhvr) {
-        case I_BehaviourAlien:
-            return RADAR_ENTITY_ALIEN;
-        case I_BehaviourQueenAlien:
-            return RADAR_ENTITY_QUEEN;
-        case I_BehaviourFaceHugger:
-            return RADAR_ENTITY_FACEHUGGER;
-        case I_BehaviourPredator:
-            return RADAR_ENTITY_PREDATOR;
-        case I_BehaviourXenoborg:
-            return RADAR_ENTITY_XENOBORG;
-        case I_BehaviourMarine:
-        case I_BehaviourSeal:
-            return RADAR_ENTITY_MARINE;
-        case I_BehaviourProximityDoor:
-        case I_BehaviourLiftDoor:
-        case I_BehaviourSwitchDoor:
-            return RADAR_ENTITY_DOOR;
-        case I_BehaviourLift:
-            return RADAR_ENTITY_LIFT;
-        case I_BehaviourBinarySwitch:
-        case I_BehaviourLinkSwitch:
-            return RADAR_ENTITY_SWITCH;
-        case I_BehaviourGenerator:
-            return RADAR_ENTITY_GENERATOR;
-        case I_BehaviourDatabase:
-            return RADAR_ENTITY_TERMINAL;
-        default:
-            return RADAR_ENTITY_UNKNOWN;
+        if (fread(&textLength, sizeof(textLength), 1, file) != 1 || textLength >= sizeof(text) ||
+            fread(text, 1, textLength, file) != textLength ||
+            fread(&rate, sizeof(rate), 1, file) != 1 ||
+            fread(&sampleRate, sizeof(sampleRate), 1, file) != 1 ||
+            fread(&sampleCount, sizeof(sampleCount), 1, file) != 1 ||
+            sampleCount > SPEECH_CLIP_MAX_SAMPLES) {
+            break;
+        }
+        text[textLength] = '\0';
+
+        SPEECH_CLIP* clip = SpeechClips_Find(text);
+        if (clip && !clip->samples && clip->rate == rate && sampleCount > 0) {
+            clip->samples = (Sint16*)SDL_malloc(sampleCount * sizeof(Sint16));
+            if (!clip->samples) break;
+            if (fread(clip->samples, sizeof(Sint16), sampleCount, file) != sampleCount) {
+                SDL_free(clip->samples);
+                clip->samples = NULL;
+                break;
+            }
+            clip->sampleCount = sampleCount;
+            clip->sampleRate = sampleRate;
+        } else if (fseek(file, (long)(sampleCount * sizeof(Sint16)), SEEK_CUR) != 0) {
+            break;
+        }
     }
+    fclose(file);
 }
 
-static int IsEntityThreat(AVP_BEHAVIOUR_TYPE bhvr, I_PLAYER_TYPE playerType)
+static void SpeechClips_SaveCache(void)
 {
-    switch (bhvr) {
-        case I_BehaviourAlien:
-        case I_BehaviourQueenAlien:
-        case I_BehaviourFaceHugger:
-            /* Aliens are threats to Marines and Predators */
-            return (playerType == I_Marine || playerType == I_Predator);
+    FILE* file = fopen(g_ClipCachePath, "wb");
+    Uint32 count = 0;
 
-        case I_BehaviourPredator:
-            /* Predators are threats to Marines and Aliens */
-            return (playerType == I_Marine || playerType == I_Alien);
+    if (!file) {
+        LOG_WRN("Speech clips: cannot write %s", g_ClipCachePath);
+        return;
+    }
 
-        case I_BehaviourMarine:
-        case I_BehaviourSeal:
-            /* Marines are threats to Aliens and Predators */
-            return (playerType == I_Alien || playerType == I_Predator);
+    for (int i = 0; i < g_ClipCount; i++) {
+        if (g_Clips[i].samples) count++;
+    }
+    fwrite(SPEECH_CLIP_MAGIC, 1, 8, file);
+    fwrite(&count, sizeof(count), 1, file);
 
-        case I_BehaviourXenoborg:
-            /* Xenoborgs are threats to everyone */
-            return 1;
+    for (int i = 0; i < g_ClipCount; i++) {
+        const SPEECH_CLIP* clip = &g_Clips[i];
+        Uint16 textLength = (Uint16)strlen(clip->text);
+        Sint32 rate = clip->rate;
 
-        default:
-            return 0;
+        if (!clip->samples) continue;
+        fwrite(&textLength, sizeof(textLength), 1, file);
+        fwrite(clip->text, 1, textLength, file);
+        fwrite(&rate, sizeof(rate), 1, file);
+        fwrite(&clip->sampleRate, sizeof(clip->sampleRate), 1, file);
+        fwrite(&clip->sampleCount, sizeof(clip->sampleCount), 1, file);
+        fwrite(clip->samples, sizeof(Sint16), clip->sampleCount, file);
     }
+    fclose(file);
 }
 
-extern "C" void AudioRadar_Update(void)
+/* Render one phrase through espeak-ng into wavPath and keep it as trimmed mono 16-bit PCM */
+static int SpeechClips_Render(SPEECH_CLIP* clip, const char* wavPath)
 {
-    if (!Accessibility_IsAvailable() || !AccessibilitySettings.audio_radar_enabled) {
-        return;
+    char rate[16];
+    const char* args[] = { "espeak-ng", "-s", rate, "-w", wavPath, clip->text, NULL };
+    SDL_AudioSpec spec, mono;
+    Uint8* data = NULL;
+    Uint32 length = 0;
+    int exitCode = -1;
+
+    /* Same mapping as the espeak backend: 175 wpm default, 15 wpm per rate step */
+    snprintf(rate, sizeof(rate), "%d", 175 + clip->rate * 15);
+
+    SDL_Process* process = SDL_CreateProcess(args, false);
+    if (!process) return 0;
+    SDL_WaitProcess(process, true, &exitCode);
+    SDL_DestroyProcess(process);
+    if (exitCode != 0 || !SDL_LoadWAV(wavPath, &spec, &data, &length)) return 0;
+
+    if (spec.format != SDL_AUDIO_S16 || spec.channels != 1) {
+        Uint8* converted = NULL;
+        int convertedLength = 0;
+
+        mono.format = SDL_AUDIO_S16;
+        mono.channels = 1;
+        mono.freq = spec.freq;
+        if (!SDL_ConvertAudioSamples(&spec, data, (int)length, &mono, &converted, &convertedLength)) {
+            SDL_free(data);
+            return 0;
+        }
+        SDL_free(data);
+        data = converted;
+        length = (Uint32)convertedLength;
+    }
+
+    /* The synth pads with silence; every millisecond of it is latency */
+    Sint16* samples = (Sint16*)data;
+    Uint32 first = 0, last = length / sizeof(Sint16);
+    while (first < last && abs(samples[first]) < SPEECH_CLIP_SILENCE) first++;
+    while (last > first && abs(samples[last - 1]) < SPEECH_CLIP_SILENCE) last--;
+    if (last == first || last - first > SPEECH_CLIP_MAX_SAMPLES) {
+        SDL_free(data);
+        return 0;
     }
+    memmove(samples, samples + first, (last - first) * sizeof(Sint16));
 
-    /* Check if enough time has passed since last update */
-    static int frameCount = 0;
-    frameCount++;
+    clip->samples = samples;
+    clip->sampleCount = last - first;
+    clip->sampleRate = (Uint32)spec.freq;
+    return 1;
+}
 
-    /* Update roughly every 30 frames (0.5 seconds at 60fps) */
-    if (frameCount < 30) {
-        return;
+static int SDLCALL SpeechClips_Thread(void* data)
+{
+    char wavPath[MAX_PATH + 8];
+    int rendered = 0, ready = 0;
+    (void)data;
+
+    SpeechClips_LoadCache();
+
+    snprintf(wavPath, sizeof(wavPath), "%s.wav", g_ClipCachePath);
+    for (int i = 0; i < g_ClipCount && !SDL_GetAtomicInt(&g_ClipsCancel); i++) {
+        if (g_Clips[i].samples) continue;
+        if (!SpeechClips_Render(&g_Clips[i], wavPath)) {
+            /* Usually espeak-ng is not installed; don't spawn it once per phrase */
+            LOG_WRN("Speech clips: espeak-ng could not render \"%s\"", g_Clips[i].text);
+            break;
+        }
+        rendered++;
     }
-    frameCount = 0;
+    SDL_RemovePath(wavPath);
 
-    /* Check priority system - radar is LOW priority, skip during cooldowns */
-    if (!Announcement_IsAllowed(ANNOUNCE_PRIORITY_LOW)) {
-        return;
+    if (rendered) SpeechClips_SaveCache();
+
+    for (int i = 0; i < g_ClipCount; i++) {
+        if (g_Clips[i].samples) ready++;
     }
+    LOG_INF("Speech clips: %d of %d phrases ready (%d rendered)", ready, g_ClipCount, rendered);
 
-    /* Scan for nearby threats */
-    AudioRadar_AnnounceNearestThreat();
+    SDL_SetAtomicInt(&g_ClipsReady, 1);
+    return 0;
 }
 
-extern "C" void AudioRadar_ScanNow(void)
+/* Load the phrase table and start rendering in the background */
+static void SpeechClips_Start(void)
 {
-    AudioRadar_AnnounceAll();
+    const char* env;
+
+    env = SDL_getenv("AVP_TTS_CLIPS");
+    if (env && env[0]) g_ClipsEnabled = atoi(env);
+    env = SDL_getenv("AVP_TTS_CLIP_PHRASES");
+    if (env && env[0]) {
+        strncpy(g_ClipPhrasePath, env, sizeof(g_ClipPhrasePath) - 1);
+        g_ClipPhrasePath[sizeof(g_ClipPhrasePath) - 1] = '\0';
+    }
+
+    if (!g_ClipsEnabled || g_ClipThread) return;
+
+    /* A bare file name puts the cache (and the scratch wav next to it) with
+     * the game's user files, as files.c finds them, rather than wherever the
+     * game was started from */
+    if (!strchr(g_ClipCachePath, '/') && !strchr(g_ClipCachePath, '\\')) {
+        char name[MAX_PATH];
+        char* userDir = SDL_GetPrefPath("", "AliensVsPredator");
+        if (!userDir) {
+            LOG_WRN("Speech clips: no user directory (%s), clips disabled", SDL_GetError());
+            return;
+        }
+        strncpy(name, g_ClipCachePath[0] ? g_ClipCachePath : "accessibility_clips.bin", sizeof(name) - 1);
+        name[sizeof(name) - 1] = '\0';
+        snprintf(g_ClipCachePath, sizeof(g_ClipCachePath), "%s%s", userDir, name);
+        SDL_free(userDir);
+    }
+
+    g_ClipCount = 0;
+    g_ClipsUploadFailed = 0;
+    SDL_SetAtomicInt(&g_ClipsReady, 0);
+    SDL_SetAtomicInt(&g_ClipsCancel, 0);
+    SpeechClips_LoadPhrases();
+    SpeechClips_CheckPrompts();
+
+    g_ClipThread = SDL_CreateThread(SpeechClips_Thread, "AccessibilityClips", NULL);
+    if (!g_ClipThread) LOG_ERR("Speech clips: failed to create thread: %s", SDL_GetError());
 }
 
-extern "C" void AudioRadar_AnnounceNearestThreat(void)
+/* Game thread: move the rendered clips into OpenAL buffers on first use */
+static int SpeechClips_Upload(void)
 {
-    if (!Accessibility_IsAvailable() || !Player || !Player->ObStrategyBlock) {
-        return;
-    }
+    if (g_ClipSource) return 1;
+    if (g_ClipsUploadFailed) return 0;
 
-    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
-    if (!playerDyn) return;
+    alGetError();
+    alGenSources(1, &g_ClipSource);
+    if (alGetError() != AL_NO_ERROR) {
+        g_ClipSource = 0;
+        g_ClipsUploadFailed = 1;
+        LOG_WRN("Speech clips: no OpenAL source, using live TTS");
+        return 0;
+    }
+    alSourcei(g_ClipSource, AL_SOURCE_RELATIVE, AL_TRUE);
+    alSource3f(g_ClipSource, AL_POSITION, 0.0f, 0.0f, 0.0f);
 
-    int playerX = playerDyn->Position.vx;
-    int playerY = playerDyn->Position.vy;
-    int playerZ = playerDyn->Position.vz;
+    for (int i = 0; i < g_ClipCount; i++) {
+        SPEECH_CLIP* clip = &g_Clips[i];
+        if (!clip->samples) continue;
 
-    /* Get player facing direction from view matrix */
-    int playerYaw = 0;
-    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
-    if (Global_VDB_Ptr) {
-        /* Extract yaw from matrix - simplified */
-        playerYaw = (int)(atan2((double)Global_VDB_Ptr->VDB_Mat.mat13,
-                                (double)Global_VDB_Ptr->VDB_Mat.mat33) * 2048.0 / 3.14159265);
+        alGenBuffers(1, &clip->buffer);
+        if (alGetError() == AL_NO_ERROR) {
+            alBufferData(clip->buffer, AL_FORMAT_MONO16, clip->samples,
+                         (ALsizei)(clip->sampleCount * sizeof(Sint16)), (ALsizei)clip->sampleRate);
+            if (alGetError() != AL_NO_ERROR) {
+                alDeleteBuffers(1, &clip->buffer);
+                clip->buffer = 0;
+            }
+        } else {
+            clip->buffer = 0;
+        }
+        SDL_free(clip->samples);
+        clip->samples = NULL;
     }
+    return 1;
+}
 
-    int nearestDist = AccessibilitySettings.radar_range;
-    STRATEGYBLOCK* nearestSB = NULL;
-
-    /* Scan all active strategy blocks */
-    extern int NumActiveStBlocks;
-    extern STRATEGYBLOCK* ActiveStBlockList[];
+static void SpeechClips_Stop(void)
+{
+    if (!g_ClipSource) return;
 
-    for (int i = 0; i < NumActiveStBlocks; i++) {
-        STRATEGYBLOCK* sb = ActiveStBlockList[i];
-        if (!sb || !sb->DynPtr) continue;
+    alSourceStop(g_ClipSource);
+    SDL_LockMutex(g_TTSMutex);
+    g_TTSClipUntil = 0;
+    SDL_UnlockMutex(g_TTSMutex);
+}
 
-        /* Skip non-threat entities */
-        if (!IsEntityThreat(sb->I_SBtype, AvP.PlayerType)) continue;
+/* Play text from its clip if there is one. Returns 0 to leave it to live TTS. */
+static int SpeechClips_Play(const char* text, int priority, int interrupt)
+{
+    if (!g_ClipsEnabled || !SDL_GetAtomicInt(&g_ClipsReady)) return 0;
 
-        int dist = Accessibility_GetDistance(
-            playerX, playerY, playerZ,
-            sb->DynPtr->Position.vx,
-            sb->DynPtr->Position.vy,
-            sb->DynPtr->Position.vz
-        );
+    SPEECH_CLIP* clip = SpeechClips_Find(text);
+    if (!clip || clip->rate != AccessibilitySettings.tts_rate || !SpeechClips_Upload() || !clip->buffer) {
+        return 0;
+    }
 
-        if (dist < nearestDist) {
-            nearestDist = dist;
-            nearestSB = sb;
+    Uint64 now = SDL_GetTicks();
+    SDL_LockMutex(g_TTSMutex);
+    if (!g_TTSRunning) {
+        SDL_UnlockMutex(g_TTSMutex);
+        return 0;
+    }
+    if (interrupt) {
+        for (int i = g_TTSQueueCount - 1; i >= 0; i--) {
+            if (g_TTSQueue[i].priority <= priority) TTS_RemoveAt(i);
         }
+        g_TTSSilenceRequested = 1;
+    } else if (g_TTSQueueCount > 0 || SDL_GetAtomicInt(&g_TTSBusy) || now < g_TTSClipUntil) {
+        SDL_UnlockMutex(g_TTSMutex);
+        return 0;   /* Wait its turn in the queue */
     }
+    g_TTSClipUntil = now + (Uint64)clip->sampleCount * 1000 / clip->sampleRate;
+    SDL_SetAtomicInt(&g_TTSBusy, 1);
+    SDL_SignalCondition(g_TTSWake);
+    SDL_UnlockMutex(g_TTSMutex);
 
-    /* Play directional tone for nearest threat with enemy-specific pitch */
-    if (nearestSB && nearestSB->DynPtr) {
-        RadarTone_PlayDirectional(
-            nearestSB->DynPtr->Position.vx,
-            nearestSB->DynPtr->Position.vy,
-            nearestSB->DynPtr->Position.vz,
-            playerX, playerY, playerZ,
-            playerYaw,
-            nearestSB->I_SBtype  /* Pass entity type for distinct tone */
-        );
-    }
-}
+    alSourceStop(g_ClipSource);
+    alSourcei(g_ClipSource, AL_BUFFER, clip->buffer);
+    alSourcef(g_ClipSource, AL_GAIN, AccessibilitySettings.tts_volume / 100.0f);
+    alSourcePlay(g_ClipSource);
 
-extern "C" void AudioRadar_AnnounceAll(void)
+    strncpy(g_LastSpokenText, text, sizeof(g_LastSpokenText) - 1);
+    g_LastSpokenText[sizeof(g_LastSpokenText) - 1] = '\0';
+    return 1;
+}
+
+static void SpeechClips_Shutdown(void)
 {
-    if (!Accessibility_IsAvailable() || !Player || !Player->ObStrategyBlock) {
-        return;
+    if (g_ClipThread) {
+        SDL_SetAtomicInt(&g_ClipsCancel, 1);
+        SDL_WaitThread(g_ClipThread, NULL);
+        g_ClipThread = NULL;
     }
+    SDL_SetAtomicInt(&g_ClipsReady, 0);
 
-    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
-    if (!playerDyn) return;
-
-    int playerX = playerDyn->Position.vx;
-    int playerY = playerDyn->Position.vy;
-    int playerZ = playerDyn->Position.vz;
-
-    int playerYaw = 0;
-    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
-    if (Global_VDB_Ptr) {
-        playerYaw = (int)(atan2((double)Global_VDB_Ptr->VDB_Mat.mat13,
-                                (double)Global_VDB_Ptr->VDB_Mat.mat33) * 2048.0 / 3.14159265);
+    if (g_ClipSource) {
+        alSourceStop(g_ClipSource);
+        alDeleteSources(1, &g_ClipSource);
+        g_ClipSource = 0;
     }
+    for (int i = 0; i < g_ClipCount; i++) {
+        if (g_Clips[i].buffer) alDeleteBuffers(1, &g_Clips[i].buffer);
+        SDL_free(g_Clips[i].samples);
+    }
+    memset(g_Clips, 0, sizeof(g_Clips));
+    g_ClipCount = 0;
+}
 
-    extern int NumActiveStBlocks;
-    extern STRATEGYBLOCK* ActiveStBlockList[];
+/* ============================================
+ * Announcement Arbitration
+ * ============================================ */
 
-    int enemyCount = 0;
-    char fullAnnouncement[1024] = "Radar scan: ";
-    char buffer[128];
+/*
+ * Every announcement passes through one arbitration stage on the game
+ * thread before it reaches the speech queue. A message's identity is a
+ * hash of its category and text. Each category has a rule that sets:
+ *   - the speech priority the message is queued at;
+ *   - whether a newer message supersedes a pending one of the same category;
+ *   - how long it may wait in the queue before it is stale;
+ *   - how soon the same identity may be repeated;
+ *   - a token bucket that limits how often the category may speak.
+ * Shaped categories also observe the priority cooldowns and share a global
+ * bucket, so under heavy combat the queue holds a few current messages
+ * instead of falling seconds behind the game. Direct speech (menus, key
+ * commands) is only recorded, never held back.
+ */
 
-    for (int i = 0; i < NumActiveStBlocks && enemyCount < AccessibilitySettings.radar_max_enemies; i++) {
-        STRATEGYBLOCK* sb = ActiveStBlockList[i];
-        if (!sb || !sb->DynPtr) continue;
+/* Priority levels for announcements */
+typedef enum {
+    ANNOUNCE_PRIORITY_CRITICAL = 0,  /* Damage, health critical - always plays, triggers cooldown */
+    ANNOUNCE_PRIORITY_HIGH = 1,      /* Obstruction warnings, interaction prompts */
+    ANNOUNCE_PRIORITY_NORMAL = 2,    /* Weapon changes, pickups */
+    ANNOUNCE_PRIORITY_LOW = 3,       /* Radar, navigation updates */
+    ANNOUNCE_PRIORITY_COUNT
+} ANNOUNCE_PRIORITY;
 
-        RADAR_ENTITY_TYPE type = GetRadarEntityType(sb->I_SBtype);
-        if (type == RADAR_ENTITY_UNKNOWN) continue;
+/* Cooldown durations in milliseconds */
+#define COOLDOWN_AFTER_CRITICAL_MS 600   /* Suppress non-critical for 600ms after damage */
+#define COOLDOWN_AFTER_HIGH_MS 400       /* Suppress lower priorities for 400ms after high */
+#define COOLDOWN_BETWEEN_SAME_MS 200     /* Suppress low priority for 200ms after normal */
 
-        /* Skip non-threats for this scan unless they're items */
-        int isThreat = IsEntityThreat(sb->I_SBtype, AvP.PlayerType);
-        if (!isThreat && type != RADAR_ENTITY_DOOR && type != RADAR_ENTITY_LIFT) continue;
+#define ANNOUNCE_STICKY 0xFFFFFFFFu      /* repeatMs: suppressed until the identity changes */
+#define ANNOUNCE_HISTORY_SIZE 32
+#define ANNOUNCE_GLOBAL_REFILL_MS 400    /* Shaped speech overall: one message per 400ms... */
+#define ANNOUNCE_GLOBAL_BURST 4          /* ...after a burst of four */
 
-        int dist = Accessibility_GetDistance(
-            playerX, playerY, playerZ,
-            sb->DynPtr->Position.vx,
-            sb->DynPtr->Position.vy,
-            sb->DynPtr->Position.vz
-        );
+typedef struct {
+    const char* category;
+    ANNOUNCE_PRIORITY priority;
+    TTS_PRIORITY speech;
+    int interrupt;          /* -1 = follow the tts_interrupt setting */
+    int replace;            /* Supersedes a pending message of the same category */
+    int shaped;             /* Subject to cooldowns and the global bucket */
+    unsigned int ttlMs;     /* Discarded unspoken after this long, 0 = never */
+    unsigned int repeatMs;  /* Same identity suppressed for this long */
+    unsigned int refillMs;  /* One token per refillMs, 0 = no category bucket */
+    int burst;
+} ANNOUNCE_RULE;
 
-        if (dist > AccessibilitySettings.radar_range) continue;
+typedef struct {
+    unsigned int tokens;    /* Thousandths of a token */
+    unsigned int lastRefill;
+} ANNOUNCE_BUCKET;
 
-        AUDIO_DIRECTION dir = Accessibility_GetDirection(
-            playerX, playerY, playerZ,
-            sb->DynPtr->Position.vx,
-            sb->DynPtr->Position.vy,
-            sb->DynPtr->Position.vz,
-            playerYaw
-        );
+typedef struct {
+    unsigned int identity;  /* Last admitted identity */
+    ANNOUNCE_BUCKET bucket;
+} ANNOUNCE_STATE;
+
+static const ANNOUNCE_RULE g_AnnounceRules[] = {
+    { "damage",       ANNOUNCE_PRIORITY_CRITICAL,  TTS_PRIORITY_URGENT,  1,  1, 1, 1500, 0,               0,    0 },
+    { "health",       ANNOUNCE_PRIORITY_CRITICAL,  TTS_PRIORITY_URGENT,  1,  1, 1, 3000, 5000,            0,    0 },
+    { "alert",        ANNOUNCE_PRIORITY_HIGH,      TTS_PRIORITY_URGENT,  1,  1, 1, 1500, 2000,            1000, 2 },
+    { "interaction",  ANNOUNCE_PRIORITY_HIGH,      TTS_PRIORITY_NORMAL,  -1, 1, 1, 2000, 0,               1000, 2 },
+    { "obstruction",  ANNOUNCE_PRIORITY_HIGH,      TTS_PRIORITY_QUEUED,  0,  1, 1, 1000, 0,               1000, 2 },
+    { "nav_link",     ANNOUNCE_PRIORITY_HIGH,      TTS_PRIORITY_QUEUED,  0,  1, 1, 1500, 0,               500,  2 },
+    { "weapon",       ANNOUNCE_PRIORITY_NORMAL,    TTS_PRIORITY_NORMAL,  0,  1, 1, 2000, 1000,            250,  3 },
+    { "cloak",        ANNOUNCE_PRIORITY_NORMAL,    TTS_PRIORITY_QUEUED,  0,  1, 1, 2000, 0,               500,  2 },
+    { "vision",       ANNOUNCE_PRIORITY_NORMAL,    TTS_PRIORITY_QUEUED,  0,  1, 1, 2000, 0,               500,  2 },
+    { "energy",       ANNOUNCE_PRIORITY_NORMAL,    TTS_PRIORITY_QUEUED,  0,  1, 1, 3000, 5000,            1000, 1 },
+    { "hud",          ANNOUNCE_PRIORITY_NORMAL,    TTS_PRIORITY_QUEUED,  0,  0, 1, 5000, 2000,            500,  4 },
+    { "nav_progress", ANNOUNCE_PRIORITY_LOW,       TTS_PRIORITY_QUEUED,  0,  1, 1, 3000, 0,               1000, 2 },
+    { "nav_recovery", ANNOUNCE_PRIORITY_LOW,       TTS_PRIORITY_QUEUED,  0,  1, 1, 3000, 0,               1500, 2 },
+    { "menu",         ANNOUNCE_PRIORITY_HIGH,      TTS_PRIORITY_NORMAL,  -1, 1, 0, 0,    ANNOUNCE_STICKY, 0,    0 },
+    { "location",     ANNOUNCE_PRIORITY_NORMAL,    TTS_PRIORITY_NORMAL,  -1, 1, 0, 0,    ANNOUNCE_STICKY, 0,    0 },
+};
 
-        snprintf(buffer, sizeof(buffer), "%s %s. ",
-                 AudioRadar_GetEntityTypeName(type),
-                 AudioRadar_GetDirectionName(dir));
+#define ANNOUNCE_RULE_COUNT ((int)(sizeof(g_AnnounceRules) / sizeof(g_AnnounceRules[0])))
 
-        strncat(fullAnnouncement, buffer, sizeof(fullAnnouncement) - strlen(fullAnnouncement) - 1);
-        enemyCount++;
-    }
+/* Direct speech, and categories without a rule of their own */
+static const ANNOUNCE_RULE g_AnnounceDirectRule =
+    { NULL, ANNOUNCE_PRIORITY_NORMAL, TTS_PRIORITY_NORMAL, -1, 0, 0, 0, 0, 0, 0 };
+static const ANNOUNCE_RULE g_AnnounceOtherRule =
+    { NULL, ANNOUNCE_PRIORITY_LOW, TTS_PRIORITY_QUEUED, 0, 1, 0, 0, 0, 0, 0 };
 
-    if (enemyCount == 0) {
-        strcat(fullAnnouncement, "no contacts nearby.");
-    }
+static ANNOUNCE_STATE g_AnnounceStates[ANNOUNCE_RULE_COUNT];
+static ANNOUNCE_BUCKET g_AnnounceGlobalBucket;
+static unsigned int g_AnnounceLastTime[ANNOUNCE_PRIORITY_COUNT];
+static unsigned int g_AnnounceHistory[ANNOUNCE_HISTORY_SIZE];
+static unsigned int g_AnnounceHistoryTime[ANNOUNCE_HISTORY_SIZE];
+static int g_AnnounceHistoryNext = 0;
 
-    TTS_Speak(fullAnnouncement);
+static unsigned int Announce_Identity(const char* category, const char* text)
+{
+    unsigned int h = 2166136261u;
+    if (category) {
+        for (const char* c = category; *c; c++) h = (h ^ (unsigned char)*c) * 16777619u;
+    }
+    h = (h ^ 0xFFu) * 16777619u;   /* Separator, so "a"+"bc" differs from "ab"+"c" */
+    for (const char* c = text; *c; c++) h = (h ^ (unsigned char)*c) * 16777619u;
+    return h ? h : 1;              /* Zero marks an empty history slot */
 }
 
-/* ============================================
- * Player State Implementation
- * ============================================ */
-
-extern "C" void PlayerState_Update(void)
+static int Announce_FindRule(const char* category)
 {
-    if (!Accessibility_IsAvailable() || !AccessibilitySettings.state_announcements_enabled) {
-        return;
+    if (!category || !category[0]) return -1;
+    for (int i = 0; i < ANNOUNCE_RULE_COUNT; i++) {
+        if (strcmp(g_AnnounceRules[i].category, category) == 0) return i;
     }
+    return -1;
+}
 
-    if (!Player || !Player->ObStrategyBlock) return;
-
-    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-    if (!ps) return;
-
-    /* Convert from 16.16 fixed point to integer percentage */
-    int currentHealth = (ps->Health >> 16);
-    int currentArmor = (ps->Armour >> 16);
-    int currentWeapon = (int)ps->SelectedWeaponSlot;
+static const ANNOUNCE_RULE* Announce_GetRule(int index, const char* category)
+{
+    if (index >= 0) return &g_AnnounceRules[index];
+    return (category && category[0]) ? &g_AnnounceOtherRule : &g_AnnounceDirectRule;
+}
 
-    /* Check for significant health change - lowered threshold from 10 to 5 */
-    if (g_LastHealth >= 0 && currentHealth != g_LastHealth) {
-        int healthLost = g_LastHealth - currentHealth;
-        if (healthLost > 5) {
-            char buffer[64];
-            snprintf(buffer, sizeof(buffer), "Taking damage! Health %d", currentHealth);
-            TTS_SpeakPriority(buffer);
-            Announcement_RecordTime(ANNOUNCE_PRIORITY_CRITICAL);  /* Triggers cooldown */
-        }
-    }
+/* Top the bucket up for the time elapsed; a new bucket starts full */
+static void Announce_Refill(ANNOUNCE_BUCKET* bucket, unsigned int refillMs, int burst, unsigned int now)
+{
+    unsigned int full = (unsigned int)burst * 1000;
+    unsigned int elapsed = now - bucket->lastRefill;
 
-    /* Low health warning */
-    if (currentHealth > 0 && currentHealth <= AccessibilitySettings.health_warning_threshold) {
-        if (!g_HealthWarningGiven) {
-            TTS_SpeakPriority("Warning! Health critical!");
-            Announcement_RecordTime(ANNOUNCE_PRIORITY_CRITICAL);
-            g_HealthWarningGiven = 1;
-        }
+    if (!bucket->lastRefill || elapsed >= refillMs * (unsigned int)burst) {
+        bucket->tokens = full;
     } else {
-        g_HealthWarningGiven = 0;
-    }
-
-    /* Weapon change announcement - NORMAL priority, skip during damage cooldown */
-    if (g_LastWeaponSlot >= 0 && currentWeapon != g_LastWeaponSlot &&
-        Announcement_IsAllowed(ANNOUNCE_PRIORITY_NORMAL)) {
-        PlayerState_AnnounceWeapon();
-        Announcement_RecordTime(ANNOUNCE_PRIORITY_NORMAL);
-    }
-
-    /* ============================================
-     * Predator Equipment Tracking
-     * ============================================ */
-    if (AvP.PlayerType == I_Predator) {
-        /* Cloak state tracking */
-        int currentCloak = ps->cloakOn;
-        if (g_LastCloakOn >= 0 && currentCloak != g_LastCloakOn &&
-            Announcement_IsAllowed(ANNOUNCE_PRIORITY_NORMAL)) {
-            if (currentCloak) {
-                TTS_SpeakQueued("Cloak on.");
-            } else {
-                TTS_SpeakQueued("Cloak off.");
-            }
-            Announcement_RecordTime(ANNOUNCE_PRIORITY_NORMAL);
-        }
-        g_LastCloakOn = currentCloak;
-
-        /* Vision mode tracking */
-        int currentVision = (int)CurrentVisionMode;
-        if (g_LastVisionMode >= 0 && currentVision != g_LastVisionMode &&
-            Announcement_IsAllowed(ANNOUNCE_PRIORITY_NORMAL)) {
-            const char* modeName = "Normal vision";
-            switch (CurrentVisionMode) {
-                case VISION_MODE_NORMAL: modeName = "Normal vision"; break;
-                case VISION_MODE_PRED_THERMAL: modeName = "Thermal vision"; break;
-                case VISION_MODE_PRED_SEEALIENS: modeName = "Alien vision"; break;
-                case VISION_MODE_PRED_SEEPREDTECH: modeName = "Tech vision"; break;
-                default: modeName = "Vision mode changed"; break;
-            }
-            TTS_SpeakQueued(modeName);
-            Announcement_RecordTime(ANNOUNCE_PRIORITY_NORMAL);
-        }
-        g_LastVisionMode = currentVision;
-
-        /* Field charge (energy) tracking - announce on significant changes */
-        int currentChargePercent = (ps->FieldCharge * 100) / PLAYERCLOAK_MAXENERGY;
-        if (g_LastFieldChargePercent >= 0) {
-            /* Announce when crossing 25%, 50%, 75% thresholds or hitting low */
-            int lastQuarter = g_LastFieldChargePercent / 25;
-            int currentQuarter = currentChargePercent / 25;
-
-            if (currentQuarter != lastQuarter && currentChargePercent < g_LastFieldChargePercent &&
-                Announcement_IsAllowed(ANNOUNCE_PRIORITY_NORMAL)) {
-                char buffer[64];
-                if (currentChargePercent <= 10) {
-                    snprintf(buffer, sizeof(buffer), "Energy critical! %d percent.", currentChargePercent);
-                    TTS_SpeakPriority(buffer);
-                    Announcement_RecordTime(ANNOUNCE_PRIORITY_HIGH);
-                } else if (currentChargePercent <= 25) {
-                    snprintf(buffer, sizeof(buffer), "Energy low. %d percent.", currentChargePercent);
-                    TTS_SpeakQueued(buffer);
-                    Announcement_RecordTime(ANNOUNCE_PRIORITY_NORMAL);
-                }
-            }
-        }
-        g_LastFieldChargePercent = currentChargePercent;
+        bucket->tokens += elapsed * 1000 / refillMs;
+        if (bucket->tokens > full) bucket->tokens = full;
     }
-
-    /* Update tracked values */
-    g_LastHealth = currentHealth;
-    g_LastArmor = currentArmor;
-    g_LastWeaponSlot = currentWeapon;
+    bucket->lastRefill = now;
 }
 
-extern "C" void PlayerState_AnnounceHealth(void)
+static int Announce_SeenWithin(unsigned int identity, unsigned int now, unsigned int windowMs)
 {
-    if (!Player || !Player->ObStrategyBlock) return;
-
-    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-    if (!ps) return;
-
-    int health = (ps->Health >> 16);
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer), "Health: %d percent", health);
-    TTS_Speak(buffer);
+    for (int i = 0; i < ANNOUNCE_HISTORY_SIZE; i++) {
+        if (g_AnnounceHistory[i] == identity && (now - g_AnnounceHistoryTime[i]) < windowMs) return 1;
+    }
+    return 0;
 }
 
-extern "C" void PlayerState_AnnounceArmor(void)
+/* Check if an announcement at given priority is allowed based on cooldowns */
+static int Announcement_IsAllowed(ANNOUNCE_PRIORITY priority)
 {
-    if (!Player || !Player->ObStrategyBlock) return;
-
-    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-    if (!ps) return;
-
-    int armor = (ps->Armour >> 16);
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer), "Armor: %d percent", armor);
-    TTS_Speak(buffer);
-}
+    unsigned int currentTime = GetTickCount();
 
-/* Announce Predator energy cell / field charge status */
-extern "C" void Accessibility_AnnounceEnergy(void)
-{
-    if (!Player || !Player->ObStrategyBlock) return;
+    /* Critical announcements always allowed */
+    if (priority == ANNOUNCE_PRIORITY_CRITICAL) return 1;
 
-    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-    if (!ps) return;
+    /* Everything else waits out the critical cooldown */
+    if ((currentTime - g_AnnounceLastTime[ANNOUNCE_PRIORITY_CRITICAL]) < COOLDOWN_AFTER_CRITICAL_MS) {
+        return 0;
+    }
+    if (priority == ANNOUNCE_PRIORITY_HIGH) return 1;
 
-    char buffer[128];
+    /* Normal and low wait out the high cooldown */
+    if ((currentTime - g_AnnounceLastTime[ANNOUNCE_PRIORITY_HIGH]) < COOLDOWN_AFTER_HIGH_MS) {
+        return 0;
+    }
+    if (priority == ANNOUNCE_PRIORITY_NORMAL) return 1;
 
-    /* Only Predator has energy cells */
-    if (AvP.PlayerType == I_Predator) {
-        int energyPercent = (ps->FieldCharge * 100) / PLAYERCLOAK_MAXENERGY;
-        snprintf(buffer, sizeof(buffer), "Energy: %d percent", energyPercent);
-        TTS_Speak(buffer);
-    } else if (AvP.PlayerType == I_Marine) {
-        /* Marines don't have energy cells */
-        TTS_Speak("Marines do not have energy cells.");
-    } else if (AvP.PlayerType == I_Alien) {
-        /* Aliens don't have energy cells */
-        TTS_Speak("Aliens do not have energy cells.");
+    /* Low waits out the normal cooldown too */
+    if ((currentTime - g_AnnounceLastTime[ANNOUNCE_PRIORITY_NORMAL]) < COOLDOWN_BETWEEN_SAME_MS) {
+        return 0;
     }
+    return 1;
 }
 
-extern "C" void PlayerState_AnnounceWeapon(void)
+/* Decide whether a message goes to the speech queue, and record it if so */
+static int Announce_Admit(int ruleIndex, const ANNOUNCE_RULE* rule, const char* category, const char* text)
 {
-    if (!Player || !Player->ObStrategyBlock) return;
+    ANNOUNCE_STATE* state = ruleIndex >= 0 ? &g_AnnounceStates[ruleIndex] : NULL;
+    unsigned int now = GetTickCount();
+    unsigned int identity = Announce_Identity(category, text);
+    const char* reason = NULL;
 
-    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-    if (!ps) return;
+    if (rule->repeatMs == ANNOUNCE_STICKY) {
+        if (state && state->identity == identity) reason = "unchanged";
+    } else if (rule->repeatMs && Announce_SeenWithin(identity, now, rule->repeatMs)) {
+        reason = "repeat";
+    }
 
-    /* Weapon names based on player type and slot */
-    const char* weaponName = "unknown weapon";
+    if (!reason && rule->shaped) {
+        int critical = rule->priority == ANNOUNCE_PRIORITY_CRITICAL;
 
-    /* This is simplified - would need full weapon name lookup */
-    switch (AvP.PlayerType) {
-        case I_Marine:
-            switch (ps->SelectedWeaponSlot) {
-                case 0: weaponName = "Pulse Rifle"; break;
-                case 1: weaponName = "Smartgun"; break;
-                case 2: weaponName = "Flamethrower"; break;
-                case 3: weaponName = "Shotgun"; break;
-                case 4: weaponName = "Grenade Launcher"; break;
-                case 5: weaponName = "Minigun"; break;
-                case 6: weaponName = "SADAR Rocket Launcher"; break;
-                default: weaponName = "Unknown Marine Weapon"; break;
+        if (!Announcement_IsAllowed(rule->priority)) {
+            reason = "cooldown";
+        } else {
+            if (state && rule->refillMs) {
+                Announce_Refill(&state->bucket, rule->refillMs, rule->burst, now);
             }
-            break;
-
-        case I_Predator:
-            switch (ps->SelectedWeaponSlot) {
-                case 0: weaponName = "Wristblades"; break;
-                case 1: weaponName = "Speargun"; break;
-                case 2: weaponName = "Plasma Caster"; break;
-                case 3: weaponName = "Disc"; break;
-                case 4: weaponName = "Medicomp"; break;
-                default: weaponName = "Unknown Predator Weapon"; break;
+            if (!critical) {
+                Announce_Refill(&g_AnnounceGlobalBucket, ANNOUNCE_GLOBAL_REFILL_MS, ANNOUNCE_GLOBAL_BURST, now);
             }
-            break;
-
-        case I_Alien:
-            switch (ps->SelectedWeaponSlot) {
-                case 0: weaponName = "Claws"; break;
-                case 1: weaponName = "Tail"; break;
-                case 2: weaponName = "Jaw"; break;
-                default: weaponName = "Unknown Alien Attack"; break;
+            if ((state && rule->refillMs && state->bucket.tokens < 1000) ||
+                (!critical && g_AnnounceGlobalBucket.tokens < 1000)) {
+                reason = "rate";
+            } else {
+                if (state && rule->refillMs) state->bucket.tokens -= 1000;
+                if (!critical) g_AnnounceGlobalBucket.tokens -= 1000;
             }
-            break;
+        }
     }
 
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer), "Weapon: %s", weaponName);
-    TTS_Speak(buffer);
+    if (reason) {
+        LOG_DBG("Announce: %s suppressed (%s): %s", category ? category : "direct", reason, text);
+        return 0;
+    }
+
+    if (state) state->identity = identity;
+    g_AnnounceHistory[g_AnnounceHistoryNext] = identity;
+    g_AnnounceHistoryTime[g_AnnounceHistoryNext] = now;
+    g_AnnounceHistoryNext = (g_AnnounceHistoryNext + 1) % ANNOUNCE_HISTORY_SIZE;
+    if (rule->shaped) g_AnnounceLastTime[rule->priority] = now;
+    return 1;
 }
 
-extern "C" void PlayerState_AnnounceAmmo(void)
+/* Arbitrate, then queue. Returns nonzero if the message was queued. */
+static int TTS_Enqueue(const char* text, const char* category, int priority, int interrupt)
 {
-    if (!Player || !Player->ObStrategyBlock) return;
-
-    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-    if (!ps) return;
-
-    /* Aliens don't have ammo */
-    if (AvP.PlayerType == I_Alien) {
-        TTS_Speak("Alien attacks don't require ammunition");
-        return;
-    }
+    Uint64 start = Prof_Begin();
+    int admitted = 0;
 
-    int slot = (int)ps->SelectedWeaponSlot;
-    if (slot >= 0 && slot < MAX_NO_OF_WEAPON_SLOTS) {
-        int ammo = ps->WeaponSlot[slot].PrimaryRoundsRemaining +
-                   ps->WeaponSlot[slot].SecondaryRoundsRemaining;
+    if (g_TTSThread && !SDL_GetAtomicInt(&g_TTSFailed) && text && text[0] && AccessibilitySettings.tts_enabled) {
+        int ruleIndex = Announce_FindRule(category);
+        const ANNOUNCE_RULE* rule = Announce_GetRule(ruleIndex, category);
 
-        char buffer[64];
-        if (ammo > 0) {
-            snprintf(buffer, sizeof(buffer), "Ammo: %d rounds", ammo);
-        } else {
-            snprintf(buffer, sizeof(buffer), "Out of ammo!");
+        admitted = Announce_Admit(ruleIndex, rule, category, text);
+        if (admitted && !SpeechClips_Play(text, priority, interrupt)) {
+            if (interrupt) SpeechClips_Stop();
+            TTS_EnqueueMessage(text, category, priority, interrupt, rule->replace, rule->ttlMs);
         }
-        TTS_Speak(buffer);
     }
+
+    Prof_End(PROF_ZONE_TTS_DISPATCH, start);
+    return admitted;
 }
 
-extern "C" void PlayerState_AnnounceAll(void)
+/* Speak through a category's rule. Returns nonzero if it was queued. */
+static int Announce(const char* category, const char* text)
 {
-    PlayerState_AnnounceHealth();
-    PlayerState_AnnounceArmor();
-    PlayerState_AnnounceWeapon();
-    PlayerState_AnnounceAmmo();
+    if (!AccessibilitySettings.enabled) return 0;
+
+    const ANNOUNCE_RULE* rule = Announce_GetRule(Announce_FindRule(category), category);
+    int interrupt = rule->interrupt < 0 ? (AccessibilitySettings.tts_interrupt ? 1 : 0) : rule->interrupt;
+    return TTS_Enqueue(text, category, rule->speech, interrupt);
 }
 
 /* ============================================
- * Navigation Implementation
+ * Public TTS Functions
  * ============================================ */
 
-extern "C" void Navigation_Update(void)
+extern "C" void TTS_Speak(const char* text)
 {
-    if (!Accessibility_IsAvailable() || !AccessibilitySettings.navigation_cues_enabled) {
-        return;
-    }
+    if (!AccessibilitySettings.enabled) return;
 
-    /* Navigation updates happen less frequently */
-    static int frameCount = 0;
-    frameCount++;
-    if (frameCount < 60) return;  /* Every ~1 second */
-    frameCount = 0;
+    /* Interrupt previous speech if configured */
+    TTS_Enqueue(text, NULL, TTS_PRIORITY_NORMAL, AccessibilitySettings.tts_interrupt ? 1 : 0);
 
-    Navigation_CheckDoors();
+    LOG_INF("TTS: %s", text);
 }
 
-extern "C" void Navigation_CheckWalls(void)
+extern "C" void TTS_SpeakQueued(const char* text)
 {
-    /* Would require collision/raycast implementation */
-    /* For now, this is a placeholder */
-    TTS_Speak("Wall detection not yet implemented");
+    if (!AccessibilitySettings.enabled) return;
+
+    /* Don't interrupt - queue after current speech */
+    TTS_Enqueue(text, NULL, TTS_PRIORITY_QUEUED, 0);
 }
 
-extern "C" void Navigation_CheckDoors(void)
+extern "C" void TTS_SpeakPriority(const char* text)
 {
-    if (!Player || !Player->ObStrategyBlock) return;
+    if (!AccessibilitySettings.enabled) return;
 
-    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
-    if (!playerDyn) return;
+    /* Always interrupt previous speech */
+    TTS_Enqueue(text, NULL, TTS_PRIORITY_URGENT, 1);
+}
 
-    extern int NumActiveStBlocks;
-    extern STRATEGYBLOCK* ActiveStBlockList[];
+extern "C" void TTS_SpeakCategory(const char* category, const char* text)
+{
+    /* Priority, merging and rate limits come from the category's rule */
+    Announce(category, text);
+}
 
-    for (int i = 0; i < NumActiveStBlocks; i++) {
-        STRATEGYBLOCK* sb = ActiveStBlockList[i];
-        if (!sb || !sb->DynPtr) continue;
+extern "C" void TTS_Stop(void)
+{
+    if (!g_TTSThread) return;
+
+    SpeechClips_Stop();
+    SDL_LockMutex(g_TTSMutex);
+    g_TTSQueueCount = 0;
+    g_TTSSilenceRequested = 1;
+    SDL_SignalCondition(g_TTSWake);
+    SDL_UnlockMutex(g_TTSMutex);
+}
 
-        /* Check for doors */
-        if (sb->I_SBtype == I_BehaviourProximityDoor ||
-            sb->I_SBtype == I_BehaviourLiftDoor ||
-            sb->I_SBtype == I_BehaviourSwitchDoor) {
+extern "C" int TTS_IsSpeaking(void)
+{
+    return g_TTSThread && !SDL_GetAtomicInt(&g_TTSFailed) && SDL_GetAtomicInt(&g_TTSBusy) ? 1 : 0;
+}
 
-            int dist = Accessibility_GetDistance(
-                playerDyn->Position.vx, playerDyn->Position.vy, playerDyn->Position.vz,
-                sb->DynPtr->Position.vx, sb->DynPtr->Position.vy, sb->DynPtr->Position.vz
-            );
-
-            /* Announce doors within close range */
-            if (dist < 5000) {  /* ~5 meters */
-                int playerYaw = 0;
-                extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
-                if (Global_VDB_Ptr) {
-                    playerYaw = (int)(atan2((double)Global_VDB_Ptr->VDB_Mat.mat13,
-                                           (double)Global_VDB_Ptr->VDB_Mat.mat33) * 2048.0 / 3.14159265);
-                }
+extern "C" void TTS_SetRate(int rate)
+{
+    /* Applied by speechd/espeak on the next utterance; Tolk uses the screen reader's settings */
+    if (rate < -10) rate = -10;
+    if (rate > 10) rate = 10;
+    AccessibilitySettings.tts_rate = rate;
+}
 
-                AUDIO_DIRECTION dir = Accessibility_GetDirection(
-                    playerDyn->Position.vx, playerDyn->Position.vy, playerDyn->Position.vz,
-                    sb->DynPtr->Position.vx, sb->DynPtr->Position.vy, sb->DynPtr->Position.vz,
-                    playerYaw
-                );
+extern "C" void TTS_SetVolume(int volume)
+{
+    /* Applied by speechd/espeak on the next utterance; Tolk uses the screen reader's settings */
+    if (volume < 0) volume = 0;
+    if (volume > 100) volume = 100;
+    AccessibilitySettings.tts_volume = volume;
+}
 
-                char buffer[128];
-                snprintf(buffer, sizeof(buffer), "Door %s", AudioRadar_GetDirectionName(dir));
-                TTS_SpeakQueued(buffer);
-                return;  /* Only announce one door at a time */
-            }
+/* ============================================
+ * Frame Scheduler
+ * Runs the per-frame updates at fixed real-time rates, staggered across
+ * frames and held to a per-frame time budget
+ * ============================================ */
+
+#define SCHED_DEFAULT_BUDGET_US 2000
+#define SCHED_MAX_TASKS_PER_FRAME 2     /* Periodic tasks started per frame; every-frame ones don't count */
+#define SCHED_STATS_INTERVAL_MS 5000
+
+typedef enum {
+    SCHED_CRITICAL,     /* Every frame, never deferred */
+    SCHED_NORMAL,       /* Deferred when over budget, forced once badly late */
+    SCHED_LOW           /* Deferred when over budget, forced only when very late */
+} SCHED_PRIORITY;
+
+typedef struct {
+    const char* name;
+    void (*run)(void);
+    int periodMs;               /* 0 = every frame */
+    SCHED_PRIORITY priority;
+    PROF_ZONE zone;
+    int* active;                /* Optional: not run while *active is zero */
+    Uint64 nextDueUs;
+    Uint64 costUs;              /* Running average of recent run times */
+    unsigned int deferrals;     /* Put off because it would have gone over the budget */
+    unsigned int capDeferrals;  /* Put off by SCHED_MAX_TASKS_PER_FRAME */
+} SCHED_TASK;
+
+/* How late a deferred task may get before it runs regardless of the budget */
+static const Uint64 g_SchedForceLateUs[] = { 0, 250000, 1000000 };
+
+static void Events_Dispatch(void);
+static void PathDist_Update(void);
+
+static SCHED_TASK g_SchedTasks[] = {
+    { "autonav",     AutoNav_Update,                  0,    SCHED_CRITICAL, PROF_ZONE_AUTONAV },
+    { "input",       Accessibility_ProcessInput,      0,    SCHED_CRITICAL, PROF_ZONE_INPUT },
+    { "voices",      AudioRadar_UpdateVoices,         0,    SCHED_CRITICAL, PROF_ZONE_RADAR_VOICES },
+    { "events",      Events_Dispatch,                 0,    SCHED_CRITICAL, PROF_ZONE_EVENTS, &g_EventsPending },
+    { "obstruction", Obstruction_Update,              166,  SCHED_NORMAL,   PROF_ZONE_OBSTRUCTION },
+    { "interaction", Accessibility_CheckInteraction,  250,  SCHED_NORMAL,   PROF_ZONE_INTERACTION },
+    { "pitch",       PitchIndicator_Update,           333,  SCHED_NORMAL,   PROF_ZONE_PITCH },
+    { "radar",       AudioRadar_Update,               500,  SCHED_LOW,      PROF_ZONE_RADAR },
+    { "navigation",  Navigation_Update,               1000, SCHED_LOW,      PROF_ZONE_NAVIGATION },
+    { "environment", Environment_UpdateSweep,         0,    SCHED_NORMAL,   PROF_ZONE_ENVIRONMENT, &g_EnvSweepActive },
+    { "pathdist",    PathDist_Update,                 0,    SCHED_NORMAL,   PROF_ZONE_PATH_DISTANCE },
+};
+
+#define SCHED_TASK_COUNT ((int)(sizeof(g_SchedTasks) / sizeof(g_SchedTasks[0])))
+
+static int g_SchedBudgetUs = SCHED_DEFAULT_BUDGET_US;
+static int g_SchedStarted = 0;
+static unsigned int g_SchedFrames = 0;
+static unsigned int g_SchedOverBudget = 0;
+static unsigned int g_SchedLastStats = 0;
+
+static Uint64 Sched_NowUs(void)
+{
+    return SDL_GetTicksNS() / 1000;
+}
+
+/* For work inside a task that runs less often than the task itself */
+static int Sched_IntervalElapsed(unsigned int* lastMs, unsigned int intervalMs)
+{
+    unsigned int now = GetTickCount();
+    if (now - *lastMs < intervalMs) return 0;
+    *lastMs = now;
+    return 1;
+}
+
+/* Spread the first run of each periodic task across its period so tasks
+ * with related rates don't keep landing on the same frame */
+static void Sched_Start(Uint64 now)
+{
+    int periodic = 0;
+    for (int i = 0; i < SCHED_TASK_COUNT; i++) {
+        if (g_SchedTasks[i].periodMs > 0) periodic++;
+    }
+
+    int slot = 0;
+    for (int i = 0; i < SCHED_TASK_COUNT; i++) {
+        SCHED_TASK* task = &g_SchedTasks[i];
+        if (task->run == AudioRadar_Update && AccessibilitySettings.radar_update_interval_ms > 0) {
+            task->periodMs = AccessibilitySettings.radar_update_interval_ms;  /* [Radar] UpdateInterval */
         }
+        task->costUs = 0;
+        task->deferrals = 0;
+        task->capDeferrals = 0;
+        if (task->periodMs <= 0) continue;
+        task->nextDueUs = now + (Uint64)task->periodMs * 1000 * slot / periodic;
+        slot++;
     }
+
+    g_SchedLastStats = GetTickCount();
+    g_SchedStarted = 1;
 }
 
-extern "C" void Navigation_AnnounceLocation(void)
+static void Sched_Run(SCHED_TASK* task)
 {
-    /* Announce current level - with redundancy prevention */
-    const char* levelName = "Unknown Location";
+    Uint64 start = Prof_Begin();
+    task->run();
+    Uint64 cost = Prof_End(task->zone, start) / 1000;
+    task->costUs = (task->costUs * 3 + cost) / 4;
+}
 
-    extern ELO* Env_List[];
-    if (AvP.CurrentEnv >= 0 && AvP.CurrentEnv < I_Num_Environments && Env_List[AvP.CurrentEnv]) {
-        levelName = Env_List[AvP.CurrentEnv]->main;
+static void Sched_ReportStats(void)
+{
+    if (!Sched_IntervalElapsed(&g_SchedLastStats, SCHED_STATS_INTERVAL_MS)) return;
+
+    if (g_SchedOverBudget > 0) {
+        LOG_DBG("Scheduler: %u of %u frames over %dus budget", g_SchedOverBudget, g_SchedFrames, g_SchedBudgetUs);
+    }
+    for (int i = 0; i < SCHED_TASK_COUNT; i++) {
+        SCHED_TASK* task = &g_SchedTasks[i];
+        if (task->deferrals == 0 && task->capDeferrals == 0) continue;
+        LOG_DBG("Scheduler:   %s deferred %u times over budget, %u by the start cap (avg %uus)",
+                task->name, task->deferrals, task->capDeferrals, (unsigned int)task->costUs);
+        task->deferrals = 0;
+        task->capDeferrals = 0;
     }
+    g_SchedFrames = 0;
+    g_SchedOverBudget = 0;
+}
 
-    char buffer[128];
-    snprintf(buffer, sizeof(buffer), "Current location: %s", levelName);
+extern "C" void Accessibility_Update(void)
+{
+    Uint64 profStart = Prof_Begin();
+    Uint64 frameStart = Sched_NowUs();
+    if (!g_SchedStarted) Sched_Start(frameStart);
+
+    for (int i = 0; i < SCHED_TASK_COUNT; i++) {
+        SCHED_TASK* task = &g_SchedTasks[i];
+        if (task->priority == SCHED_CRITICAL && (!task->active || *task->active)) Sched_Run(task);
+    }
+
+    /* Due periodic tasks, most important and then most overdue first */
+    SCHED_TASK* due[SCHED_TASK_COUNT];
+    int dueCount = 0;
+    for (int i = 0; i < SCHED_TASK_COUNT; i++) {
+        SCHED_TASK* task = &g_SchedTasks[i];
+        if (task->active && !*task->active) {
+            task->nextDueUs = frameStart;  /* Idle jobs aren't late when they start */
+            continue;
+        }
+        if (task->priority == SCHED_CRITICAL || frameStart < task->nextDueUs) continue;
+
+        int pos = dueCount++;
+        while (pos > 0 && (due[pos - 1]->priority > task->priority ||
+                           (due[pos - 1]->priority == task->priority &&
+                            due[pos - 1]->nextDueUs > task->nextDueUs))) {
+            due[pos] = due[pos - 1];
+            pos--;
+        }
+        due[pos] = task;
+    }
+
+    int started = 0;
+    int overBudget = 0;
+    for (int i = 0; i < dueCount; i++) {
+        SCHED_TASK* task = due[i];
+        Uint64 late = frameStart - task->nextDueUs;
+        Uint64 elapsed = Sched_NowUs() - frameStart;
+
+        /* Only a deferral for time makes the frame count as over budget;
+         * the start cap just spreads periodic tasks out */
+        int wouldOverrun = elapsed + task->costUs > (Uint64)g_SchedBudgetUs;
+        int capped = task->periodMs > 0 && started >= SCHED_MAX_TASKS_PER_FRAME;
+        if ((wouldOverrun || capped) && late < g_SchedForceLateUs[task->priority]) {
+            if (wouldOverrun) {
+                task->deferrals++;
+                overBudget = 1;
+            } else {
+                task->capDeferrals++;
+            }
+            continue;
+        }
 
-    /* Only announce if different from last time */
-    if (strcmp(buffer, g_LastLocationText) != 0) {
-        TTS_Speak(buffer);
-        strncpy(g_LastLocationText, buffer, sizeof(g_LastLocationText) - 1);
-        g_LastLocationText[sizeof(g_LastLocationText) - 1] = '\0';
+        Sched_Run(task);
+        if (task->periodMs > 0) started++;
+
+        /* Keep the phase while on time; after a long stall start afresh
+         * rather than running the task on several frames in a row */
+        task->nextDueUs += (Uint64)task->periodMs * 1000;
+        if (task->nextDueUs <= frameStart) {
+            task->nextDueUs = frameStart + (Uint64)task->periodMs * 1000;
+        }
     }
+
+    g_SchedFrames++;
+    if (overBudget || Sched_NowUs() - frameStart > (Uint64)g_SchedBudgetUs) g_SchedOverBudget++;
+    Sched_ReportStats();
+
+    Prof_End(PROF_ZONE_FRAME, profStart);
+    Prof_Update();
 }
 
 /* ============================================
- * Pitch Indicator (View Angle Feedback)
+ * Configuration File Support
  * ============================================ */
 
-extern "C" void PitchIndicator_Update(void)
+#ifdef _WIN32
+static void LoadConfigFile(void)
 {
-    if (!Accessibility_IsAvailable() || !g_PitchIndicatorEnabled) {
+    char iniPath[MAX_PATH];
+    char buffer[64];
+
+    /* Try to find accessibility.ini in current directory */
+    GetCurrentDirectoryA(MAX_PATH, iniPath);
+    strcat(iniPath, "\\accessibility.ini");
+
+    /* Check if file exists */
+    DWORD attrs = GetFileAttributesA(iniPath);
+    if (attrs == INVALID_FILE_ATTRIBUTES) {
+        Accessibility_Log("No accessibility.ini found, using defaults\n");
         return;
     }
 
-    /* Only update every ~20 frames to avoid constant beeping */
-    static int frameCount = 0;
-    frameCount++;
-    if (frameCount < 20) return;
-    frameCount = 0;
+    Accessibility_Log("Loading config from %s\n", iniPath);
 
-    /* Get player's view pitch angle */
-    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
-    if (!Global_VDB_Ptr) return;
+    /* General settings */
+    AccessibilitySettings.enabled = GetPrivateProfileIntA("General", "Enabled", 1, iniPath);
+    AccessibilitySettings.tts_enabled = GetPrivateProfileIntA("General", "TTSEnabled", 1, iniPath);
+    AccessibilitySettings.audio_radar_enabled = GetPrivateProfileIntA("General", "RadarEnabled", 1, iniPath);
+    AccessibilitySettings.navigation_cues_enabled = GetPrivateProfileIntA("General", "NavigationCues", 1, iniPath);
+    AccessibilitySettings.state_announcements_enabled = GetPrivateProfileIntA("General", "StateAnnouncements", 1, iniPath);
+    AccessibilitySettings.menu_narration_enabled = GetPrivateProfileIntA("General", "MenuNarration", 1, iniPath);
 
-    int pitchAngle = Global_VDB_Ptr->VDB_MatrixEuler.EulerX;
+    /* TTS settings */
+    AccessibilitySettings.tts_rate = GetPrivateProfileIntA("TTS", "Rate", 0, iniPath);
+    if (AccessibilitySettings.tts_rate < -10) AccessibilitySettings.tts_rate = -10;
+    if (AccessibilitySettings.tts_rate > 10) AccessibilitySettings.tts_rate = 10;
 
-    /* Determine pitch zone: -1 = looking down, 0 = level, 1 = looking up */
-    /* Threshold: ~15 degrees (about 170 in game units assuming 4096 = 360 degrees) */
-    int pitchZone = 0;
-    int threshold = 170;
+    AccessibilitySettings.tts_volume = GetPrivateProfileIntA("TTS", "Volume", 100, iniPath);
+    if (AccessibilitySettings.tts_volume < 0) AccessibilitySettings.tts_volume = 0;
+    if (AccessibilitySettings.tts_volume > 100) AccessibilitySettings.tts_volume = 100;
 
-    if (pitchAngle > threshold) {
-        pitchZone = 1;  /* Looking up */
-    } else if (pitchAngle < -threshold) {
-        pitchZone = -1; /* Looking down */
-    }
+    AccessibilitySettings.tts_interrupt = GetPrivateProfileIntA("TTS", "Interrupt", 1, iniPath);
+    GetPrivateProfileStringA("TTS", "Backend", "auto", g_TTSBackendName, sizeof(g_TTSBackendName), iniPath);
+    GetPrivateProfileStringA("TTS", "Sink", "", g_TTSSinkPath, sizeof(g_TTSSinkPath), iniPath);
+    g_ClipsEnabled = GetPrivateProfileIntA("TTS", "Clips", 0, iniPath);
+    GetPrivateProfileStringA("TTS", "ClipPhrases", "", g_ClipPhrasePath, sizeof(g_ClipPhrasePath), iniPath);
+    GetPrivateProfileStringA("TTS", "ClipCache", "accessibility_clips.bin", g_ClipCachePath, sizeof(g_ClipCachePath), iniPath);
 
-    /* Only play tone when pitch zone changes and is not level */
-    if (pitchZone != g_LastPitchZone) {
-        g_LastPitchZone = pitchZone;
+    /* Scheduler settings */
+    g_SchedBudgetUs = GetPrivateProfileIntA("Scheduler", "BudgetMicroseconds", SCHED_DEFAULT_BUDGET_US, iniPath);
+    if (g_SchedBudgetUs < 100) g_SchedBudgetUs = 100;
 
-        if (pitchZone != 0) {
-            /* Play the pitch indicator tone */
-            PitchTone_Play(pitchAngle);
+    /* Profiling settings */
+    g_ProfDumpIntervalMs = GetPrivateProfileIntA("Profiling", "DumpInterval", 0, iniPath) * 1000;
+    GetPrivateProfileStringA("Profiling", "DumpFile", "accessibility_profile.txt", g_ProfDumpPath, sizeof(g_ProfDumpPath), iniPath);
 
-            /* Optionally announce on first entry to extreme pitch */
-            if (pitchZone == 1 && pitchAngle > 500) {
-                /* Very steep up - don't spam TTS, just use tone */
-            } else if (pitchZone == -1 && pitchAngle < -500) {
-                /* Very steep down - don't spam TTS, just use tone */
-            }
-        }
-    }
-    /* If still in same non-level zone, play periodic tone */
-    else if (pitchZone != 0) {
-        static int toneCount = 0;
-        toneCount++;
-        if (toneCount >= 3) {  /* Play tone every ~60 frames when looking up/down */
-            toneCount = 0;
-            PitchTone_Play(pitchAngle);
-        }
-    }
+    /* Radar settings */
+    AccessibilitySettings.radar_update_interval_ms = GetPrivateProfileIntA("Radar", "UpdateInterval", 500, iniPath);
+    AccessibilitySettings.radar_max_enemies = GetPrivateProfileIntA("Radar", "MaxEnemies", 5, iniPath);
+    AccessibilitySettings.radar_range = GetPrivateProfileIntA("Radar", "Range", 50000, iniPath);
+
+    /* Warning thresholds */
+    AccessibilitySettings.health_warning_threshold = GetPrivateProfileIntA("Warnings", "HealthThreshold", 25, iniPath);
+    AccessibilitySettings.ammo_warning_threshold = GetPrivateProfileIntA("Warnings", "AmmoThreshold", 10, iniPath);
+
+    /* Logging settings */
+    g_LoggingEnabled = GetPrivateProfileIntA("Logging", "Enabled", 1, iniPath);
+
+    char levelStr[32];
+    GetPrivateProfileStringA("Logging", "Level", "DEBUG", levelStr, sizeof(levelStr), iniPath);
+    if (_stricmp(levelStr, "DEBUG") == 0) g_LogLevel = LOG_DEBUG;
+    else if (_stricmp(levelStr, "INFO") == 0) g_LogLevel = LOG_INFO;
+    else if (_stricmp(levelStr, "WARNING") == 0) g_LogLevel = LOG_WARNING;
+    else if (_stricmp(levelStr, "ERROR") == 0) g_LogLevel = LOG_ERROR;
+
+    LOG_INF("Config loaded successfully");
 }
+#else
+static void LoadConfigFile(void) { /* No-op on non-Windows */ }
+#endif
 
 /* ============================================
- * Menu Accessibility
+ * Initialization and Shutdown
  * ============================================ */
 
-/* Track when menu was last announced to prevent render hook from double-announcing */
-static unsigned int g_LastMenuAnnouncementTime = 0;
-#define MENU_ANNOUNCEMENT_COOLDOWN_MS 2000  /* Don't re-announce within 2 seconds */
+static void PlayerEvents_Subscribe(void);
 
-extern "C" void Menu_OnTextDisplayed(const char* text, int isSelected)
+extern "C" int Accessibility_Init(void)
 {
-    if (!Accessibility_IsAvailable() || !AccessibilitySettings.menu_narration_enabled) {
-        return;
+    if (g_AccessibilityInitialized) {
+        return 1;
     }
 
-    if (!text || strlen(text) == 0) return;
+    /* Initialize logging first */
+    Log_Init();
+    LOG_INF("=== Accessibility System Starting ===");
 
-    /* Check cooldown - if explicit announcement was made recently, skip render hook */
-    unsigned int currentTime = GetTickCount();
-    if ((currentTime - g_LastMenuAnnouncementTime) < MENU_ANNOUNCEMENT_COOLDOWN_MS) {
-        return;  /* Recent explicit announcement, skip this render-triggered one */
-    }
+    /* Load configuration from INI file */
+    LoadConfigFile();
 
-    /* Only announce if text changed and is selected */
-    if (isSelected && strcmp(text, g_LastMenuText) != 0) {
-        TTS_Speak(text);
-        strncpy(g_LastMenuText, text, sizeof(g_LastMenuText) - 1);
-        g_LastMenuText[sizeof(g_LastMenuText) - 1] = '\0';
-        g_LastMenuAnnouncementTime = currentTime;
+    LOG_INF("Initializing accessibility system...");
+
+    /* Start the speech thread (Tolk, speech-dispatcher, espeak-ng or a sink) */
+    if (!TTS_Init()) {
+        Accessibility_Log("Warning: TTS initialization failed\n");
+        AccessibilitySettings.tts_enabled = 0;
+    } else {
+        SpeechClips_Start();
     }
-}
 
-/* Called by explicit menu announcement functions to set cooldown
- * This prevents render hooks from double-announcing after explicit TTS */
-extern "C" void Menu_SetAnnouncementCooldown(void)
-{
-    g_LastMenuAnnouncementTime = GetTickCount();
+    PlayerEvents_Subscribe();
+
+    g_AccessibilityInitialized = 1;
+
+    /* Announce startup */
+    TTS_Speak("Accessibility features enabled");
+
+    return 1;
 }
 
-extern "C" void Menu_AnnounceCurrentItem(void)
+extern "C" void Accessibility_Shutdown(void)
 {
-    if (strlen(g_LastMenuText) > 0) {
-        TTS_Speak(g_LastMenuText);
+    if (!g_AccessibilityInitialized) {
+        return;
     }
-}
 
-extern "C" void Menu_OnNavigate(int direction)
-{
-    if (!Accessibility_IsAvailable()) return;
+    LOG_INF("=== Accessibility System Shutting Down ===");
 
-    switch (direction) {
-        case -1: /* Up */
-            /* Item will be announced by Menu_OnTextDisplayed */
-            break;
-        case 1:  /* Down */
-            /* Item will be announced by Menu_OnTextDisplayed */
-            break;
-        case 0:  /* Select */
-            TTS_SpeakQueued("Selected");
-            break;
-    }
-}
+    TTS_Stop();
+    TTS_Shutdown();
+    SpeechClips_Shutdown();
+    RadarTone_Shutdown();
+    PitchTone_Shutdown();
 
-/* ============================================
- * Debug and Logging
- * ============================================ */
+    g_AccessibilityInitialized = 0;
 
-extern "C" void Accessibility_SetDebugMode(int enabled)
-{
-    g_DebugMode = enabled;
+    LOG_INF("Accessibility system shutdown complete");
+    Log_Shutdown();
 }
 
-extern "C" void Accessibility_Log(const char* format, ...)
+extern "C" int Accessibility_IsAvailable(void)
 {
-    if (!g_DebugMode) return;
-
-    va_list args;
-    va_start(args, format);
-
-    fprintf(stderr, "[Accessibility] ");
-    vfprintf(stderr, format, args);
-
-    va_end(args);
+    return g_AccessibilityInitialized && AccessibilitySettings.enabled;
 }
 
 /* ============================================
- * Input Processing
+ * Direction and Distance Utilities
  * ============================================ */
 
-extern "C" void Accessibility_ProcessInput(void)
+extern "C" AUDIO_DIRECTION Accessibility_GetDirection(int px, int py, int pz,
+                                                       int tx, int ty, int tz,
+                                                       int player_yaw)
+{
+    /* Calculate relative position */
+    int dx = tx - px;
+    int dy = ty - py;
+    int dz = tz - pz;
+
+    /* Check vertical first */
+    int horiz_dist = (int)sqrt((double)(dx*dx + dz*dz));
+    if (abs(dy) > horiz_dist) {
+        return (dy < 0) ? DIR_ABOVE : DIR_BELOW;
+    }
+
+    /* Calculate angle to target */
+    double angle = atan2((double)dx, (double)dz);
+    angle = angle * 180.0 / 3.14159265358979323846;
+
+    /* Adjust for player's facing direction */
+    /* player_yaw is typically in 0-4096 range (12-bit angle) */
+    double player_angle = (player_yaw / 4096.0) * 360.0;
+    angle = angle - player_angle;
+
+    /* Normalize to -180 to 180 */
+    while (angle > 180.0) angle -= 360.0;
+    while (angle < -180.0) angle += 360.0;
+
+    /* Convert to direction enum */
+    if (angle >= -22.5 && angle < 22.5) return DIR_FRONT;
+    if (angle >= 22.5 && angle < 67.5) return DIR_FRONT_RIGHT;
+    if (angle >= 67.5 && angle < 112.5) return DIR_RIGHT;
+    if (angle >= 112.5 && angle < 157.5) return DIR_BACK_RIGHT;
+    if (angle >= 157.5 || angle < -157.5) return DIR_BACK;
+    if (angle >= -157.5 && angle < -112.5) return DIR_BACK_LEFT;
+    if (angle >= -112.5 && angle < -67.5) return DIR_LEFT;
+    if (angle >= -67.5 && angle < -22.5) return DIR_FRONT_LEFT;
+
+    return DIR_FRONT;
+}
+
+extern "C" int Accessibility_GetDistance(int x1, int y1, int z1,
+                                         int x2, int y2, int z2)
+{
+    int dx = x2 - x1;
+    int dy = y2 - y1;
+    int dz = z2 - z1;
+    return (int)sqrt((double)(dx*dx + dy*dy + dz*dz));
+}
+
+extern "C" const char* Accessibility_FormatDistance(int distance)
+{
+    static char buffer[64];
+
+    /* Convert game units to approximate meters (rough estimate) */
+    int meters = distance / 1000;
+
+    if (meters < 2) {
+        return "very close";
+    } else if (meters < 5) {
+        return "close";
+    } else if (meters < 10) {
+        snprintf(buffer, sizeof(buffer), "%d meters", meters);
+    } else if (meters < 20) {
+        return "medium range";
+    } else if (meters < 50) {
+        return "far";
+    } else {
+        return "very far";
+    }
+
+    return buffer;
+}
+
+extern "C" const char* AudioRadar_GetDirectionName(AUDIO_DIRECTION dir)
+{
+    switch (dir) {
+        case DIR_FRONT: return "ahead";
+        case DIR_FRONT_LEFT: return "front left";
+        case DIR_LEFT: return "left";
+        case DIR_BACK_LEFT: return "behind left";
+        case DIR_BACK: return "behind";
+        case DIR_BACK_RIGHT: return "behind right";
+        case DIR_RIGHT: return "right";
+        case DIR_FRONT_RIGHT: return "front right";
+        case DIR_ABOVE: return "above";
+        case DIR_BELOW: return "below";
+        default: return "unknown";
+    }
+}
+
+extern "C" const char* AudioRadar_GetEntityTypeName(RADAR_ENTITY_TYPE type)
+{
+    switch (type) {
+        case RADAR_ENTITY_ALIEN: return "alien";
+        case RADAR_ENTITY_PREDATOR: return "predator";
+        case RADAR_ENTITY_MARINE: return "marine";
+        case RADAR_ENTITY_FACEHUGGER: return "facehugger";
+        case RADAR_ENTITY_XENOBORG: return "xenoborg";
+        case RADAR_ENTITY_QUEEN: return "queen";
+        case RADAR_ENTITY_ITEM_HEALTH: return "health pickup";
+        case RADAR_ENTITY_ITEM_AMMO: return "ammo";
+        case RADAR_ENTITY_ITEM_WEAPON: return "weapon";
+        case RADAR_ENTITY_DOOR: return "door";
+        case RADAR_ENTITY_LIFT: return "lift";
+        case RADAR_ENTITY_SWITCH: return "switch";
+        case RADAR_ENTITY_GENERATOR: return "generator";
+        case RADAR_ENTITY_TERMINAL: return "terminal";
+        default: return "unknown";
+    }
+}
+
+/* ============================================
+ * Audio Radar Implementation
+ * ============================================ */
+
+static RADAR_ENTITY_TYPE GetRadarEntityType(AVP_BEHAVIOUR_TYPE bhvr)
+{
+    switch (bhvr) {
+        case I_BehaviourAlien:
+            return RADAR_ENTITY_ALIEN;
+        case I_BehaviourQueenAlien:
+            return RADAR_ENTITY_QUEEN;
+        case I_BehaviourFaceHugger:
+            return RADAR_ENTITY_FACEHUGGER;
+        case I_BehaviourPredator:
+            return RADAR_ENTITY_PREDATOR;
+        case I_BehaviourXenoborg:
+            return RADAR_ENTITY_XENOBORG;
+        case I_BehaviourMarine:
+        case I_BehaviourSeal:
+            return RADAR_ENTITY_MARINE;
+        case I_BehaviourProximityDoor:
+        case I_BehaviourLiftDoor:
+        case I_BehaviourSwitchDoor:
+            return RADAR_ENTITY_DOOR;
+        case I_BehaviourLift:
+            return RADAR_ENTITY_LIFT;
+        case I_BehaviourBinarySwitch:
+        case I_BehaviourLinkSwitch:
+            return RADAR_ENTITY_SWITCH;
+        case I_BehaviourGenerator:
+            return RADAR_ENTITY_GENERATOR;
+        case I_BehaviourDatabase:
+            return RADAR_ENTITY_TERMINAL;
+        default:
+            return RADAR_ENTITY_UNKNOWN;
+    }
+}
+
+static int IsEntityThreat(AVP_BEHAVIOUR_TYPE bhvr, I_PLAYER_TYPE playerType)
+{
+    switch (bhvr) {
+        case I_BehaviourAlien:
+        case I_BehaviourQueenAlien:
+        case I_BehaviourFaceHugger:
+            /* Aliens are threats to Marines and Predators */
+            return (playerType == I_Marine || playerType == I_Predator);
+
+        case I_BehaviourPredator:
+            /* Predators are threats to Marines and Aliens */
+            return (playerType == I_Marine || playerType == I_Alien);
+
+        case I_BehaviourMarine:
+        case I_BehaviourSeal:
+            /* Marines are threats to Aliens and Predators */
+            return (playerType == I_Alien || playerType == I_Predator);
+
+        case I_BehaviourXenoborg:
+            /* Xenoborgs are threats to everyone */
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+/* ============================================
+ * Bounded Top-K Selection
+ * Scans only ever speak their first few results, so rather than sorting
+ * every candidate they keep the best k in a heap as they go: O(n log k)
+ * ============================================ */
+
+#define TOPK_MAX_ITEM_SIZE 64
+
+/* qsort-style ranking: negative when a should be reported before b */
+typedef int (*TOPK_COMPARE)(const void* a, const void* b);
+
+typedef struct {
+    unsigned char* items;   /* Caller's storage for k items; a heap with the worst kept item on top */
+    int itemSize;
+    int k;
+    int count;
+    int offered;            /* Every candidate seen, kept or not */
+    TOPK_COMPARE compare;
+} TOPK;
+
+static void TopK_Init(TOPK* topk, void* storage, int itemSize, int k, TOPK_COMPARE compare)
+{
+    topk->items = (unsigned char*)storage;
+    topk->itemSize = itemSize;
+    topk->k = k;
+    topk->count = 0;
+    topk->offered = 0;
+    topk->compare = compare;
+}
+
+static void* TopK_Item(TOPK* topk, int index)
+{
+    return topk->items + (size_t)index * topk->itemSize;
+}
+
+static void TopK_Swap(TOPK* topk, int a, int b)
+{
+    unsigned char tmp[TOPK_MAX_ITEM_SIZE];
+    memcpy(tmp, TopK_Item(topk, a), topk->itemSize);
+    memcpy(TopK_Item(topk, a), TopK_Item(topk, b), topk->itemSize);
+    memcpy(TopK_Item(topk, b), tmp, topk->itemSize);
+}
+
+static void TopK_SiftDown(TOPK* topk, int index, int count)
+{
+    for (;;) {
+        int worst = index;
+        int left = index * 2 + 1;
+        int right = left + 1;
+        if (left < count && topk->compare(TopK_Item(topk, left), TopK_Item(topk, worst)) > 0) worst = left;
+        if (right < count && topk->compare(TopK_Item(topk, right), TopK_Item(topk, worst)) > 0) worst = right;
+        if (worst == index) return;
+        TopK_Swap(topk, index, worst);
+        index = worst;
+    }
+}
+
+/* Keep the item if it ranks among the best k seen so far */
+static void TopK_Offer(TOPK* topk, const void* item)
+{
+    topk->offered++;
+    if (topk->k <= 0 || topk->itemSize > TOPK_MAX_ITEM_SIZE) return;
+
+    if (topk->count < topk->k) {
+        int index = topk->count++;
+        memcpy(TopK_Item(topk, index), item, topk->itemSize);
+        while (index > 0) {
+            int parent = (index - 1) / 2;
+            if (topk->compare(TopK_Item(topk, index), TopK_Item(topk, parent)) <= 0) break;
+            TopK_Swap(topk, index, parent);
+            index = parent;
+        }
+    } else if (topk->compare(item, TopK_Item(topk, 0)) < 0) {
+        memcpy(TopK_Item(topk, 0), item, topk->itemSize);
+        TopK_SiftDown(topk, 0, topk->count);
+    }
+}
+
+/* Sort the kept items best first in the caller's storage; returns how many */
+static int TopK_Finish(TOPK* topk)
+{
+    for (int end = topk->count - 1; end > 0; end--) {
+        TopK_Swap(topk, 0, end);
+        TopK_SiftDown(topk, 0, end);
+    }
+    return topk->count;
+}
+
+/* ============================================
+ * Spatial Index of Strategy Blocks
+ * Uniform XZ grid rebuilt once per frame so the radar, autonav and
+ * interaction scans don't each walk the whole ActiveStBlockList
+ * ============================================ */
+
+#define SPATIAL_CELL_SHIFT 13                       /* 8192 units (~8m) per cell */
+#define SPATIAL_CELL_SIZE (1 << SPATIAL_CELL_SHIFT)
+#define SPATIAL_GRID_BUCKETS 256                    /* Hashed cell buckets (power of 2) */
+#define SPATIAL_BLOCK_BUCKETS 1024                  /* Buckets by block pointer (power of 2) */
+#define SPATIAL_MAX_ENTRIES maxstblocks
+
+/* Which blocks a query considers */
+#define SPATIAL_DYNAMIC_BLOCKS 0    /* Only blocks with a DynPtr */
+#define SPATIAL_ALL_BLOCKS 1        /* Also fixed ones placed by their module (doors) */
+
+/* Filter callback for queries - return nonzero to accept the block */
+typedef int (*SPATIAL_FILTER)(STRATEGYBLOCK* sb, void* context);
+
+typedef struct {
+    STRATEGYBLOCK* sb;
+    int x, y, z;            /* Position snapshot taken at rebuild */
+    int cellX, cellZ;       /* Unhashed cell coordinates (buckets are shared) */
+    int dynamic;            /* Has a DynPtr; the others only match SPATIAL_ALL_BLOCKS */
+    int next;               /* Next entry in the same bucket, -1 terminates */
+    int nextBlock;          /* Next entry in the same block pointer bucket, -1 terminates */
+} SPATIAL_ENTRY;
+
+/* Query result */
+typedef struct {
+    STRATEGYBLOCK* sb;
+    int distance;
+} SPATIAL_HIT;
+
+static SPATIAL_ENTRY g_SpatialEntries[SPATIAL_MAX_ENTRIES];
+static int g_SpatialBuckets[SPATIAL_GRID_BUCKETS];
+static int g_SpatialBlockBuckets[SPATIAL_BLOCK_BUCKETS];
+static int g_SpatialEntryCount = 0;
+static int g_SpatialIndexFrame = -1;
+
+extern "C" int GlobalFrameCounter;
+
+static int SpatialIndex_CellCoord(int v)
+{
+    return v >> SPATIAL_CELL_SHIFT;  /* Arithmetic shift floors negative coordinates */
+}
+
+static int SpatialIndex_Bucket(int cellX, int cellZ)
+{
+    unsigned int h = (unsigned int)cellX * 73856093u ^ (unsigned int)cellZ * 19349663u;
+    return (int)(h & (SPATIAL_GRID_BUCKETS - 1));
+}
+
+static int SpatialIndex_BlockBucket(STRATEGYBLOCK* sb)
+{
+    unsigned int h = (unsigned int)((size_t)sb >> 4) * 2654435761u;
+    return (int)(h >> 22) & (SPATIAL_BLOCK_BUCKETS - 1);
+}
+
+/* Distance without the int overflow of squaring level-sized deltas */
+static int SpatialIndex_Distance(int x1, int y1, int z1, int x2, int y2, int z2)
+{
+    double dx = (double)(x2 - x1);
+    double dy = (double)(y2 - y1);
+    double dz = (double)(z2 - z1);
+    return (int)sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+extern "C" void Accessibility_UpdateSpatialIndex(void)
+{
+    for (int i = 0; i < SPATIAL_GRID_BUCKETS; i++) {
+        g_SpatialBuckets[i] = -1;
+    }
+    for (int i = 0; i < SPATIAL_BLOCK_BUCKETS; i++) {
+        g_SpatialBlockBuckets[i] = -1;
+    }
+    g_SpatialEntryCount = 0;
+
+    for (int i = 0; i < NumActiveStBlocks && g_SpatialEntryCount < SPATIAL_MAX_ENTRIES; i++) {
+        STRATEGYBLOCK* sb = ActiveStBlockList[i];
+        if (!sb) continue;
+
+        VECTORCH* position;
+        if (sb->DynPtr) {
+            position = &sb->DynPtr->Position;
+        } else if (sb->SBmoptr) {
+            position = &sb->SBmoptr->m_world;
+        } else {
+            continue;
+        }
+
+        SPATIAL_ENTRY* entry = &g_SpatialEntries[g_SpatialEntryCount];
+        entry->sb = sb;
+        entry->x = position->vx;
+        entry->y = position->vy;
+        entry->z = position->vz;
+        entry->dynamic = sb->DynPtr != NULL;
+        entry->cellX = SpatialIndex_CellCoord(entry->x);
+        entry->cellZ = SpatialIndex_CellCoord(entry->z);
+
+        int bucket = SpatialIndex_Bucket(entry->cellX, entry->cellZ);
+        entry->next = g_SpatialBuckets[bucket];
+        g_SpatialBuckets[bucket] = g_SpatialEntryCount;
+
+        bucket = SpatialIndex_BlockBucket(sb);
+        entry->nextBlock = g_SpatialBlockBuckets[bucket];
+        g_SpatialBlockBuckets[bucket] = g_SpatialEntryCount;
+        g_SpatialEntryCount++;
+    }
+
+    g_SpatialIndexFrame = GlobalFrameCounter;
+}
+
+/* Rebuild if the per-frame update hasn't run yet this frame (e.g. hotkey on first frame) */
+static void SpatialIndex_EnsureCurrent(void)
+{
+    if (g_SpatialIndexFrame != GlobalFrameCounter) {
+        Accessibility_UpdateSpatialIndex();
+    }
+}
+
+/* The index's entry for a block, or NULL if it isn't active. The index is
+ * rebuilt after destroyed blocks are removed, so this is exact for the
+ * rest of the frame. */
+static SPATIAL_ENTRY* SpatialIndex_FindBlock(STRATEGYBLOCK* sb)
+{
+    SpatialIndex_EnsureCurrent();
+
+    int idx = g_SpatialBlockBuckets[SpatialIndex_BlockBucket(sb)];
+    for (; idx >= 0; idx = g_SpatialEntries[idx].nextBlock) {
+        if (g_SpatialEntries[idx].sb == sb) return &g_SpatialEntries[idx];
+    }
+    return NULL;
+}
+
+/* Insert a hit into a distance-sorted array of at most maxHits entries */
+static int SpatialIndex_InsertSorted(SPATIAL_HIT* hits, int count, int maxHits,
+                                     STRATEGYBLOCK* sb, int distance)
+{
+    if (count == maxHits) {
+        if (distance >= hits[count - 1].distance) return count;
+        count--;  /* Drop the current farthest */
+    }
+
+    int pos = count;
+    while (pos > 0 && hits[pos - 1].distance > distance) {
+        hits[pos] = hits[pos - 1];
+        pos--;
+    }
+    hits[pos].sb = sb;
+    hits[pos].distance = distance;
+    return count + 1;
+}
+
+/* Test one entry against a query; returns distance, or -1 if rejected */
+static int SpatialIndex_TestEntry(SPATIAL_ENTRY* entry, int x, int y, int z, int radius,
+                                  int blocks, SPATIAL_FILTER filter, void* context)
+{
+    if (!entry->dynamic && blocks != SPATIAL_ALL_BLOCKS) return -1;
+
+    int dist = SpatialIndex_Distance(x, y, z, entry->x, entry->y, entry->z);
+    if (dist > radius) return -1;
+    if (filter && !filter(entry->sb, context)) return -1;
+    return dist;
+}
+
+/* Called for each block a query accepts; return zero to end the query early */
+typedef int (*SPATIAL_VISIT)(STRATEGYBLOCK* sb, int distance, void* visitContext);
+
+/* Visit every block within radius that passes the filter, in no particular order */
+static void SpatialIndex_Visit(int x, int y, int z, int radius, int blocks,
+                               SPATIAL_FILTER filter, void* context,
+                               SPATIAL_VISIT visit, void* visitContext)
+{
+    SpatialIndex_EnsureCurrent();
+
+    int minCX = SpatialIndex_CellCoord(x - radius);
+    int maxCX = SpatialIndex_CellCoord(x + radius);
+    int minCZ = SpatialIndex_CellCoord(z - radius);
+    int maxCZ = SpatialIndex_CellCoord(z + radius);
+
+    /* Large radius covers more cells than there are buckets - a linear pass is cheaper */
+    if ((double)(maxCX - minCX + 1) * (double)(maxCZ - minCZ + 1) > SPATIAL_GRID_BUCKETS) {
+        for (int i = 0; i < g_SpatialEntryCount; i++) {
+            int dist = SpatialIndex_TestEntry(&g_SpatialEntries[i], x, y, z, radius, blocks, filter, context);
+            if (dist < 0) continue;
+            if (!visit(g_SpatialEntries[i].sb, dist, visitContext)) return;
+        }
+        return;
+    }
+
+    for (int cx = minCX; cx <= maxCX; cx++) {
+        for (int cz = minCZ; cz <= maxCZ; cz++) {
+            int idx = g_SpatialBuckets[SpatialIndex_Bucket(cx, cz)];
+            for (; idx >= 0; idx = g_SpatialEntries[idx].next) {
+                SPATIAL_ENTRY* entry = &g_SpatialEntries[idx];
+                if (entry->cellX != cx || entry->cellZ != cz) continue;  /* Hash neighbour */
+
+                int dist = SpatialIndex_TestEntry(entry, x, y, z, radius, blocks, filter, context);
+                if (dist < 0) continue;
+                if (!visit(entry->sb, dist, visitContext)) return;
+            }
+        }
+    }
+}
+
+typedef struct {
+    SPATIAL_HIT* hits;
+    int count;
+    int maxHits;
+} SPATIAL_COLLECT;
+
+static int SpatialIndex_Collect(STRATEGYBLOCK* sb, int distance, void* visitContext)
+{
+    SPATIAL_COLLECT* collect = (SPATIAL_COLLECT*)visitContext;
+    collect->hits[collect->count].sb = sb;
+    collect->hits[collect->count].distance = distance;
+    return ++collect->count < collect->maxHits;
+}
+
+/* Find all blocks within radius that pass the filter (unordered).
+ * Returns the number stored in hits (at most maxHits).
+ */
+static int SpatialIndex_QueryRadius(int x, int y, int z, int radius,
+                                    SPATIAL_FILTER filter, void* context,
+                                    SPATIAL_HIT* hits, int maxHits)
+{
+    SPATIAL_COLLECT collect = { hits, 0, maxHits };
+    if (maxHits <= 0) return 0;
+    SpatialIndex_Visit(x, y, z, radius, SPATIAL_DYNAMIC_BLOCKS, filter, context, SpatialIndex_Collect, &collect);
+    return collect.count;
+}
+
+static int SpatialIndex_OfferTopK(STRATEGYBLOCK* sb, int distance, void* visitContext)
+{
+    SPATIAL_HIT hit;
+    hit.sb = sb;
+    hit.distance = distance;
+    TopK_Offer((TOPK*)visitContext, &hit);
+    return 1;
+}
+
+/* Rank every block within radius that passes the filter and keep the best
+ * k, sorted best first. Returns the number kept; *total (if given) gets the
+ * number that matched.
+ */
+static int SpatialIndex_QueryBest(int x, int y, int z, int radius,
+                                  SPATIAL_FILTER filter, void* context, TOPK_COMPARE rank,
+                                  SPATIAL_HIT* hits, int k, int* total)
+{
+    TOPK topk;
+    TopK_Init(&topk, hits, sizeof(SPATIAL_HIT), k, rank);
+    SpatialIndex_Visit(x, y, z, radius, SPATIAL_DYNAMIC_BLOCKS, filter, context, SpatialIndex_OfferTopK, &topk);
+    if (total) *total = topk.offered;
+    return TopK_Finish(&topk);
+}
+
+static int SpatialIndex_OfferWalkTopK(STRATEGYBLOCK* sb, int distance, void* visitContext)
+{
+    SPATIAL_HIT hit;
+    hit.sb = sb;
+    hit.distance = PathDist_ToBlock(sb, distance);
+    TopK_Offer((TOPK*)visitContext, &hit);
+    return 1;
+}
+
+/* As SpatialIndex_QueryBest, but each hit's distance is how far it is to
+ * walk from the player rather than from (x, y, z) in a straight line.
+ * Walking is never shorter, so radius still bounds the search. */
+static int SpatialIndex_QueryBestWalk(int x, int y, int z, int radius,
+                                      SPATIAL_FILTER filter, void* context, TOPK_COMPARE rank,
+                                      SPATIAL_HIT* hits, int k)
+{
+    TOPK topk;
+    TopK_Init(&topk, hits, sizeof(SPATIAL_HIT), k, rank);
+    SpatialIndex_Visit(x, y, z, radius, SPATIAL_DYNAMIC_BLOCKS, filter, context, SpatialIndex_OfferWalkTopK, &topk);
+    return TopK_Finish(&topk);
+}
+
+/* Find the k nearest blocks within radius that pass the filter.
+ * Results are sorted nearest first; returns the number found (at most k).
+ * Searches outward ring by ring and stops once no closer cell can remain.
+ */
+static int SpatialIndex_QueryNearest(int x, int y, int z, int radius,
+                                     SPATIAL_FILTER filter, void* context,
+                                     SPATIAL_HIT* hits, int k)
+{
+    SpatialIndex_EnsureCurrent();
+
+    if (k <= 0) return 0;
+
+    int count = 0;
+    int centreX = SpatialIndex_CellCoord(x);
+    int centreZ = SpatialIndex_CellCoord(z);
+    int cellsVisited = 0;
+
+    for (int ring = 0; ; ring++) {
+        /* Everything in this ring is at least (ring - 1) cells away horizontally */
+        double ringMinDist = (double)(ring - 1) * SPATIAL_CELL_SIZE;
+        if (ring > 0 && ringMinDist > (double)radius) break;
+        if (count == k && ringMinDist >= (double)hits[k - 1].distance) break;
+
+        /* Rings beyond the bucket count revisit the same buckets - finish linearly */
+        cellsVisited += (ring == 0) ? 1 : ring * 8;
+        if (cellsVisited > SPATIAL_GRID_BUCKETS) {
+            count = 0;
+            for (int i = 0; i < g_SpatialEntryCount; i++) {
+                int dist = SpatialIndex_TestEntry(&g_SpatialEntries[i], x, y, z, radius,
+                                                  SPATIAL_DYNAMIC_BLOCKS, filter, context);
+                if (dist < 0) continue;
+                count = SpatialIndex_InsertSorted(hits, count, k, g_SpatialEntries[i].sb, dist);
+            }
+            return count;
+        }
+
+        for (int cx = centreX - ring; cx <= centreX + ring; cx++) {
+            for (int cz = centreZ - ring; cz <= centreZ + ring; cz++) {
+                /* Only the perimeter of the ring */
+                if (cx != centreX - ring && cx != centreX + ring &&
+                    cz != centreZ - ring && cz != centreZ + ring) continue;
+
+                int idx = g_SpatialBuckets[SpatialIndex_Bucket(cx, cz)];
+                for (; idx >= 0; idx = g_SpatialEntries[idx].next) {
+                    SPATIAL_ENTRY* entry = &g_SpatialEntries[idx];
+                    if (entry->cellX != cx || entry->cellZ != cz) continue;
+
+                    int dist = SpatialIndex_TestEntry(entry, x, y, z, radius,
+                                                      SPATIAL_DYNAMIC_BLOCKS, filter, context);
+                    if (dist < 0) continue;
+                    count = SpatialIndex_InsertSorted(hits, count, k, entry->sb, dist);
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+/* Query filters */
+static int SpatialFilter_Threat(STRATEGYBLOCK* sb, void* context)
+{
+    (void)context;
+    return IsEntityThreat(sb->I_SBtype, AvP.PlayerType);
+}
+
+static int SpatialFilter_RadarContact(STRATEGYBLOCK* sb, void* context)
+{
+    (void)context;
+    RADAR_ENTITY_TYPE type = GetRadarEntityType(sb->I_SBtype);
+    if (type == RADAR_ENTITY_UNKNOWN) return 0;
+
+    /* Threats, plus doors and lifts for orientation */
+    return IsEntityThreat(sb->I_SBtype, AvP.PlayerType) ||
+           type == RADAR_ENTITY_DOOR || type == RADAR_ENTITY_LIFT;
+}
+
+static int SpatialFilter_Door(STRATEGYBLOCK* sb, void* context)
+{
+    (void)context;
+    return (sb->I_SBtype == I_BehaviourProximityDoor ||
+            sb->I_SBtype == I_BehaviourLiftDoor ||
+            sb->I_SBtype == I_BehaviourSwitchDoor);
+}
+
+/* Query rankings for SpatialIndex_QueryBest */
+static int SpatialRank_Nearest(const void* a, const void* b)
+{
+    return ((const SPATIAL_HIT*)a)->distance - ((const SPATIAL_HIT*)b)->distance;
+}
+
+/* Threats before doors and lifts, nearest first within each */
+static int SpatialRank_RadarContact(const void* a, const void* b)
+{
+    const SPATIAL_HIT* hitA = (const SPATIAL_HIT*)a;
+    const SPATIAL_HIT* hitB = (const SPATIAL_HIT*)b;
+    int threatA = IsEntityThreat(hitA->sb->I_SBtype, AvP.PlayerType);
+    int threatB = IsEntityThreat(hitB->sb->I_SBtype, AvP.PlayerType);
+
+    if (threatA != threatB) return threatB - threatA;
+    return hitA->distance - hitB->distance;
+}
+
+/* Hand the voices to the current nearest threats: tracked contacts keep
+ * their voice, lost ones free it and new ones take a free voice. Each
+ * tracked contact then pings once, nearest first, a short gap apart. */
+static void RadarTone_TrackContacts(SPATIAL_HIT* hits, int count)
+{
+    for (int i = 0; i < g_RadarVoiceCount; i++) {
+        RADAR_VOICE* voice = &g_RadarVoices[i];
+        if (!voice->sb) continue;
+
+        int stillTracked = 0;
+        for (int j = 0; j < count; j++) {
+            if (hits[j].sb == voice->sb) {
+                stillTracked = 1;
+                break;
+            }
+        }
+        if (!stillTracked) RadarTone_ReleaseVoice(voice);
+    }
+
+    unsigned int now = GetTickCount();
+    for (int j = 0; j < count; j++) {
+        RADAR_VOICE* voice = RadarTone_FindVoice(hits[j].sb);
+        if (!voice) {
+            voice = RadarTone_FindVoice(NULL);
+            if (!voice) break;
+
+            /* Free voices are stopped, so the buffer can be swapped */
+            RadarTone_SetTone(voice, RadarTone_VoiceKind(hits[j].sb->I_SBtype), voice->variant);
+            voice->sb = hits[j].sb;
+        }
+
+        voice->pingPending = 1;
+        voice->pingAtMs = now + (unsigned int)j * RADAR_PING_STAGGER_MS;
+    }
+}
+
+static int RadarTone_ContactAlive(STRATEGYBLOCK* sb)
+{
+    SPATIAL_ENTRY* entry = SpatialIndex_FindBlock(sb);
+    return entry && entry->dynamic;
+}
+
+extern "C" void AudioRadar_UpdateVoices(void)
+{
+    if (!g_RadarToneInitialized) return;
+
+    if (!Accessibility_IsAvailable() || !AccessibilitySettings.audio_radar_enabled ||
+        !Player || !Player->ObStrategyBlock || !Player->ObStrategyBlock->DynPtr) {
+        for (int i = 0; i < g_RadarVoiceCount; i++) {
+            if (g_RadarVoices[i].sb) RadarTone_ReleaseVoice(&g_RadarVoices[i]);
+        }
+        return;
+    }
+
+    int active = 0;
+    for (int i = 0; i < g_RadarVoiceCount; i++) {
+        if (g_RadarVoices[i].sb) active++;
+    }
+    if (active == 0) return;
+
+    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
+
+    /* Get player facing direction from view matrix */
+    int playerYaw = 0;
+    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
+    if (Global_VDB_Ptr) {
+        playerYaw = (int)(atan2((double)Global_VDB_Ptr->VDB_Mat.mat13,
+                                (double)Global_VDB_Ptr->VDB_Mat.mat33) * 2048.0 / 3.14159265);
+    }
+
+    unsigned int now = GetTickCount();
+    ALuint pings[RADAR_MAX_VOICES];
+    int pingCount = 0;
+
+    RadarTone_BeginBatch();
+    for (int i = 0; i < g_RadarVoiceCount; i++) {
+        RADAR_VOICE* voice = &g_RadarVoices[i];
+        if (!voice->sb) continue;
+
+        if (!RadarTone_ContactAlive(voice->sb)) {
+            RadarTone_ReleaseVoice(voice);
+            continue;
+        }
+
+        DYNAMICSBLOCK* dyn = voice->sb->DynPtr;
+        RadarTone_PlaceVoice(voice, dyn->Position.vx, dyn->Position.vy, dyn->Position.vz,
+                             playerDyn->Position.vx, playerDyn->Position.vy, playerDyn->Position.vz,
+                             playerYaw);
+
+        if (voice->pingPending && (int)(now - voice->pingAtMs) >= 0) {
+            /* The last ping has long finished; stopping makes the swap safe regardless */
+            RADAR_TONE_VARIANT variant = RadarTone_ContactVariant(voice->sb);
+            if (variant != voice->variant) {
+                alSourceStop(voice->source);
+                RadarTone_SetTone(voice, voice->kind, variant);
+            }
+            pings[pingCount++] = voice->source;
+            voice->pingPending = 0;
+        }
+    }
+    RadarTone_EndBatch();
+
+    /* Start pings once their positions have been applied */
+    if (pingCount > 0) {
+        alSourceRewindv(pingCount, pings);
+        alSourcePlayv(pingCount, pings);
+    }
+}
+
+extern "C" void AudioRadar_Update(void)
+{
+    if (!Accessibility_IsAvailable() || !AccessibilitySettings.audio_radar_enabled) {
+        return;
+    }
+
+    /* Check priority system - radar is LOW priority, skip during cooldowns */
+    if (!Announcement_IsAllowed(ANNOUNCE_PRIORITY_LOW)) {
+        return;
+    }
+
+    /* Scan for nearby threats */
+    AudioRadar_AnnounceNearestThreat();
+}
+
+extern "C" void AudioRadar_ScanNow(void)
+{
+    AudioRadar_AnnounceAll();
+}
+
+extern "C" void AudioRadar_AnnounceNearestThreat(void)
+{
+    if (!Accessibility_IsAvailable() || !Player || !Player->ObStrategyBlock) {
+        return;
+    }
+
+    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
+    if (!playerDyn) return;
+
+    int playerX = playerDyn->Position.vx;
+    int playerY = playerDyn->Position.vy;
+    int playerZ = playerDyn->Position.vz;
+
+    if (!RadarTone_Init()) return;
+
+    /* Threats within radar range nearest to walk to, one voice each */
+    int maxContacts = AccessibilitySettings.radar_max_enemies;
+    if (maxContacts > g_RadarVoiceCount) maxContacts = g_RadarVoiceCount;
+    if (maxContacts < 1) maxContacts = 1;
+
+    SPATIAL_HIT nearest[RADAR_MAX_VOICES];
+    int found = SpatialIndex_QueryBestWalk(playerX, playerY, playerZ, AccessibilitySettings.radar_range,
+                                           SpatialFilter_Threat, NULL, SpatialRank_Nearest,
+                                           nearest, maxContacts);
+
+    /* Voices follow their contacts and ping from AudioRadar_UpdateVoices */
+    RadarTone_TrackContacts(nearest, found);
+}
+
+extern "C" void AudioRadar_AnnounceAll(void)
+{
+    if (!Accessibility_IsAvailable() || !Player || !Player->ObStrategyBlock) {
+        return;
+    }
+
+    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
+    if (!playerDyn) return;
+
+    int playerX = playerDyn->Position.vx;
+    int playerY = playerDyn->Position.vy;
+    int playerZ = playerDyn->Position.vz;
+
+    int playerYaw = 0;
+    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
+    if (Global_VDB_Ptr) {
+        playerYaw = (int)(atan2((double)Global_VDB_Ptr->VDB_Mat.mat13,
+                                (double)Global_VDB_Ptr->VDB_Mat.mat33) * 2048.0 / 3.14159265);
+    }
+
+    int enemyCount = 0;
+    char fullAnnouncement[1024] = "Radar scan: ";
+    char buffer[128];
+
+    /* Threats, doors and lifts within radar range - the nearest threats to walk to first */
+    static SPATIAL_HIT contacts[SPATIAL_MAX_ENTRIES];
+    int maxContacts = AccessibilitySettings.radar_max_enemies;
+    if (maxContacts > SPATIAL_MAX_ENTRIES) maxContacts = SPATIAL_MAX_ENTRIES;
+    int numContacts = SpatialIndex_QueryBestWalk(playerX, playerY, playerZ,
+                                                 AccessibilitySettings.radar_range,
+                                                 SpatialFilter_RadarContact, NULL, SpatialRank_RadarContact,
+                                                 contacts, maxContacts);
+
+    for (int i = 0; i < numContacts; i++) {
+        STRATEGYBLOCK* sb = contacts[i].sb;
+        RADAR_ENTITY_TYPE type = GetRadarEntityType(sb->I_SBtype);
+
+        AUDIO_DIRECTION dir = Accessibility_GetDirection(
+            playerX, playerY, playerZ,
+            sb->DynPtr->Position.vx,
+            sb->DynPtr->Position.vy,
+            sb->DynPtr->Position.vz,
+            playerYaw
+        );
+
+        snprintf(buffer, sizeof(buffer), "%s %s. ",
+                 AudioRadar_GetEntityTypeName(type),
+                 AudioRadar_GetDirectionName(dir));
+
+        strncat(fullAnnouncement, buffer, sizeof(fullAnnouncement) - strlen(fullAnnouncement) - 1);
+        enemyCount++;
+    }
+
+    if (enemyCount == 0) {
+        strcat(fullAnnouncement, "no contacts nearby.");
+    }
+
+    TTS_Speak(fullAnnouncement);
+}
+
+/* ============================================
+ * Player Event Bus
+ * ============================================ */
+
+/*
+ * The engine posts changes where they happen (damage, weapon state machine,
+ * pickups, cloak, vision) and subscribers hear about them on the next
+ * accessibility update, in order. Nothing is polled: with the queue empty
+ * the dispatch task does not run at all.
+ */
+#define EVENT_QUEUE_SIZE 64         /* Power of two */
+#define EVENT_MAX_HANDLERS 4        /* Per event type */
+
+typedef struct {
+    ACCESS_EVENT_TYPE type;
+    int value;
+    int previous;
+} ACCESS_EVENT;
+
+typedef void (*ACCESS_EVENT_HANDLER)(const ACCESS_EVENT* event);
+
+static ACCESS_EVENT g_EventQueue[EVENT_QUEUE_SIZE];
+static unsigned int g_EventHead = 0;        /* Next to dispatch */
+static unsigned int g_EventTail = 0;        /* Next free slot */
+static unsigned int g_EventsDropped = 0;
+static ACCESS_EVENT_HANDLER g_EventHandlers[ACCESS_EVENT_COUNT][EVENT_MAX_HANDLERS];
+
+static int Events_Subscribe(ACCESS_EVENT_TYPE type, ACCESS_EVENT_HANDLER handler)
+{
+    for (int i = 0; i < EVENT_MAX_HANDLERS; i++) {
+        if (g_EventHandlers[type][i] == handler) return 1;
+        if (!g_EventHandlers[type][i]) {
+            g_EventHandlers[type][i] = handler;
+            return 1;
+        }
+    }
+    LOG_ERR("Events: too many handlers for event %d", (int)type);
+    return 0;
+}
+
+extern "C" void Accessibility_PostEvent(ACCESS_EVENT_TYPE type, int value, int previous)
+{
+    if (!Accessibility_IsAvailable() || type < 0 || type >= ACCESS_EVENT_COUNT) return;
+
+    /* Full: keep the older events, they are already late */
+    if (g_EventTail - g_EventHead >= EVENT_QUEUE_SIZE) {
+        g_EventsDropped++;
+        return;
+    }
+
+    ACCESS_EVENT* event = &g_EventQueue[g_EventTail & (EVENT_QUEUE_SIZE - 1)];
+    event->type = type;
+    event->value = value;
+    event->previous = previous;
+    g_EventTail++;
+    g_EventsPending = 1;
+}
+
+static void Events_Dispatch(void)
+{
+    /* Handlers may post more; those wait for the next frame */
+    unsigned int tail = g_EventTail;
+
+    while (g_EventHead != tail) {
+        ACCESS_EVENT event = g_EventQueue[g_EventHead & (EVENT_QUEUE_SIZE - 1)];
+        g_EventHead++;
+        for (int i = 0; i < EVENT_MAX_HANDLERS && g_EventHandlers[event.type][i]; i++) {
+            g_EventHandlers[event.type][i](&event);
+        }
+    }
+    g_EventsPending = (g_EventHead != g_EventTail);
+
+    if (g_EventsDropped) {
+        LOG_WRN("Events: queue full, %u dropped", g_EventsDropped);
+        g_EventsDropped = 0;
+    }
+}
+
+/* ============================================
+ * Player State Implementation
+ * ============================================ */
+
+static int PlayerState_Announcing(void)
+{
+    return Accessibility_IsAvailable() && AccessibilitySettings.state_announcements_enabled &&
+           Player && Player->ObStrategyBlock && Player->ObStrategyBlock->SBdataptr;
+}
+
+static void PlayerState_OnDamage(const ACCESS_EVENT* event)
+{
+    int health = event->value;
+    int threshold = AccessibilitySettings.health_warning_threshold;
+
+    if (!PlayerState_Announcing()) return;
+
+    if (event->previous - health > 5) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "Taking damage! Health %d", health);
+        Announce("damage", buffer);  /* Triggers cooldown */
+    }
+
+    /* Low health warning, once each time health drops below the threshold */
+    if (health > 0 && health <= threshold && event->previous > threshold) {
+        Announce("health", "Warning! Health critical!");
+    }
+}
+
+/* Medikits and armour: say where that left the player */
+static void PlayerState_OnPickup(const ACCESS_EVENT* event)
+{
+    if (!PlayerState_Announcing()) return;
+
+    if (event->value == IOT_Health) {
+        PlayerState_AnnounceHealth();
+    } else if (event->value == IOT_Armour) {
+        PlayerState_AnnounceArmor();
+    }
+}
+
+/* ============================================
+ * Predator Equipment Tracking
+ * ============================================ */
+
+static void PlayerState_OnCloak(const ACCESS_EVENT* event)
+{
+    if (!PlayerState_Announcing()) return;
+    Announce("cloak", event->value ? "Cloak on." : "Cloak off.");
+}
+
+static void PlayerState_OnVision(const ACCESS_EVENT* event)
+{
+    const char* modeName;
+
+    if (!PlayerState_Announcing()) return;
+
+    switch ((enum VISION_MODE_ID)event->value) {
+        case VISION_MODE_NORMAL: modeName = "Normal vision"; break;
+        case VISION_MODE_PRED_THERMAL: modeName = "Thermal vision"; break;
+        case VISION_MODE_PRED_SEEALIENS: modeName = "Alien vision"; break;
+        case VISION_MODE_PRED_SEEPREDTECH: modeName = "Tech vision"; break;
+        default: modeName = "Vision mode changed"; break;
+    }
+    Announce("vision", modeName);
+}
+
+/* Energy draining past 25% or 10% */
+static void PlayerState_OnFieldCharge(const ACCESS_EVENT* event)
+{
+    int percent = event->value;
+    char buffer[64];
+
+    if (!PlayerState_Announcing()) return;
+    if (percent >= event->previous || percent / 25 == event->previous / 25) return;
+
+    if (percent <= 10) {
+        snprintf(buffer, sizeof(buffer), "Energy critical! %d percent.", percent);
+        Announce("alert", buffer);
+    } else if (percent <= 25) {
+        snprintf(buffer, sizeof(buffer), "Energy low. %d percent.", percent);
+        Announce("energy", buffer);
+    }
+}
+
+extern "C" void PlayerState_AnnounceHealth(void)
+{
+    if (!Player || !Player->ObStrategyBlock) return;
+
+    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
+    if (!ps) return;
+
+    int health = (ps->Health >> 16);
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "Health: %d percent", health);
+    TTS_Speak(buffer);
+}
+
+extern "C" void PlayerState_AnnounceArmor(void)
+{
+    if (!Player || !Player->ObStrategyBlock) return;
+
+    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
+    if (!ps) return;
+
+    int armor = (ps->Armour >> 16);
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "Armor: %d percent", armor);
+    TTS_Speak(buffer);
+}
+
+/* Announce Predator energy cell / field charge status */
+extern "C" void Accessibility_AnnounceEnergy(void)
+{
+    if (!Player || !Player->ObStrategyBlock) return;
+
+    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
+    if (!ps) return;
+
+    char buffer[128];
+
+    /* Only Predator has energy cells */
+    if (AvP.PlayerType == I_Predator) {
+        int energyPercent = (ps->FieldCharge * 100) / PLAYERCLOAK_MAXENERGY;
+        snprintf(buffer, sizeof(buffer), "Energy: %d percent", energyPercent);
+        TTS_Speak(buffer);
+    } else if (AvP.PlayerType == I_Marine) {
+        /* Marines don't have energy cells */
+        TTS_Speak("Marines do not have energy cells.");
+    } else if (AvP.PlayerType == I_Alien) {
+        /* Aliens don't have energy cells */
+        TTS_Speak("Aliens do not have energy cells.");
+    }
+}
+
+extern "C" void PlayerState_AnnounceWeapon(void)
+{
+    if (!Player || !Player->ObStrategyBlock) return;
+
+    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
+    if (!ps) return;
+
+    /* Weapon names based on player type and slot */
+    const char* weaponName = "unknown weapon";
+
+    /* This is simplified - would need full weapon name lookup */
+    switch (AvP.PlayerType) {
+        case I_Marine:
+            switch (ps->SelectedWeaponSlot) {
+                case 0: weaponName = "Pulse Rifle"; break;
+                case 1: weaponName = "Smartgun"; break;
+                case 2: weaponName = "Flamethrower"; break;
+                case 3: weaponName = "Shotgun"; break;
+                case 4: weaponName = "Grenade Launcher"; break;
+                case 5: weaponName = "Minigun"; break;
+                case 6: weaponName = "SADAR Rocket Launcher"; break;
+                default: weaponName = "Unknown Marine Weapon"; break;
+            }
+            break;
+
+        case I_Predator:
+            switch (ps->SelectedWeaponSlot) {
+                case 0: weaponName = "Wristblades"; break;
+                case 1: weaponName = "Speargun"; break;
+                case 2: weaponName = "Plasma Caster"; break;
+                case 3: weaponName = "Disc"; break;
+                case 4: weaponName = "Medicomp"; break;
+                default: weaponName = "Unknown Predator Weapon"; break;
+            }
+            break;
+
+        case I_Alien:
+            switch (ps->SelectedWeaponSlot) {
+                case 0: weaponName = "Claws"; break;
+                case 1: weaponName = "Tail"; break;
+                case 2: weaponName = "Jaw"; break;
+                default: weaponName = "Unknown Alien Attack"; break;
+            }
+            break;
+    }
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "Weapon: %s", weaponName);
+    TTS_Speak(buffer);
+}
+
+extern "C" void PlayerState_AnnounceAmmo(void)
+{
+    if (!Player || !Player->ObStrategyBlock) return;
+
+    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
+    if (!ps) return;
+
+    /* Aliens don't have ammo */
+    if (AvP.PlayerType == I_Alien) {
+        TTS_Speak("Alien attacks don't require ammunition");
+        return;
+    }
+
+    int slot = (int)ps->SelectedWeaponSlot;
+    if (slot >= 0 && slot < MAX_NO_OF_WEAPON_SLOTS) {
+        int ammo = ps->WeaponSlot[slot].PrimaryRoundsRemaining +
+                   ps->WeaponSlot[slot].SecondaryRoundsRemaining;
+
+        char buffer[64];
+        if (ammo > 0) {
+            snprintf(buffer, sizeof(buffer), "Ammo: %d rounds", ammo);
+        } else {
+            snprintf(buffer, sizeof(buffer), "Out of ammo!");
+        }
+        TTS_Speak(buffer);
+    }
+}
+
+extern "C" void PlayerState_AnnounceAll(void)
+{
+    PlayerState_AnnounceHealth();
+    PlayerState_AnnounceArmor();
+    PlayerState_AnnounceWeapon();
+    PlayerState_AnnounceAmmo();
+}
+
+/* ============================================
+ * Navigation Implementation
+ * ============================================ */
+
+extern "C" void Navigation_Update(void)
+{
+    if (!Accessibility_IsAvailable() || !AccessibilitySettings.navigation_cues_enabled) {
+        return;
+    }
+
+    Navigation_CheckDoors();
+}
+
+extern "C" void Navigation_CheckWalls(void)
+{
+    /* Would require collision/raycast implementation */
+    /* For now, this is a placeholder */
+    TTS_Speak("Wall detection not yet implemented");
+}
+
+extern "C" void Navigation_CheckDoors(void)
+{
+    if (!Player || !Player->ObStrategyBlock) return;
+
+    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
+    if (!playerDyn) return;
+
+    /* Announce the nearest door within close range (~5 meters) */
+    SPATIAL_HIT door;
+    if (SpatialIndex_QueryNearest(playerDyn->Position.vx, playerDyn->Position.vy, playerDyn->Position.vz,
+                                  4999, SpatialFilter_Door, NULL, &door, 1) == 0) {
+        return;
+    }
+
+    STRATEGYBLOCK* sb = door.sb;
+
+    int playerYaw = 0;
+    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
+    if (Global_VDB_Ptr) {
+        playerYaw = (int)(atan2((double)Global_VDB_Ptr->VDB_Mat.mat13,
+                               (double)Global_VDB_Ptr->VDB_Mat.mat33) * 2048.0 / 3.14159265);
+    }
+
+    AUDIO_DIRECTION dir = Accessibility_GetDirection(
+        playerDyn->Position.vx, playerDyn->Position.vy, playerDyn->Position.vz,
+        sb->DynPtr->Position.vx, sb->DynPtr->Position.vy, sb->DynPtr->Position.vz,
+        playerYaw
+    );
+
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "Door %s", AudioRadar_GetDirectionName(dir));
+    TTS_SpeakQueued(buffer);
+}
+
+extern "C" void Navigation_AnnounceLocation(void)
+{
+    /* Announce current level - with redundancy prevention */
+    const char* levelName = "Unknown Location";
+
+    extern ELO* Env_List[];
+    if (AvP.CurrentEnv >= 0 && AvP.CurrentEnv < I_Num_Environments && Env_List[AvP.CurrentEnv]) {
+        levelName = Env_List[AvP.CurrentEnv]->main;
+    }
+
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "Current location: %s", levelName);
+
+    /* Only announced if different from last time */
+    Announce("location", buffer);
+}
+
+/* ============================================
+ * Pitch Indicator (View Angle Feedback)
+ * ============================================ */
+
+extern "C" void PitchIndicator_Update(void)
+{
+    if (!Accessibility_IsAvailable() || !g_PitchIndicatorEnabled) {
+        return;
+    }
+
+    /* Get player's view pitch angle */
+    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
+    if (!Global_VDB_Ptr) return;
+
+    int pitchAngle = Global_VDB_Ptr->VDB_MatrixEuler.EulerX;
+
+    /* Determine pitch zone: -1 = looking down, 0 = level, 1 = looking up */
+    /* Threshold: ~15 degrees (about 170 in game units assuming 4096 = 360 degrees) */
+    int pitchZone = 0;
+    int threshold = 170;
+
+    if (pitchAngle > threshold) {
+        pitchZone = 1;  /* Looking up */
+    } else if (pitchAngle < -threshold) {
+        pitchZone = -1; /* Looking down */
+    }
+
+    /* Only play tone when pitch zone changes and is not level */
+    if (pitchZone != g_LastPitchZone) {
+        g_LastPitchZone = pitchZone;
+
+        if (pitchZone != 0) {
+            /* Play the pitch indicator tone */
+            PitchTone_Play(pitchAngle);
+
+            /* Optionally announce on first entry to extreme pitch */
+            if (pitchZone == 1 && pitchAngle > 500) {
+                /* Very steep up - don't spam TTS, just use tone */
+            } else if (pitchZone == -1 && pitchAngle < -500) {
+                /* Very steep down - don't spam TTS, just use tone */
+            }
+        }
+    }
+    /* If still in same non-level zone, play periodic tone */
+    else if (pitchZone != 0) {
+        static int toneCount = 0;
+        toneCount++;
+        if (toneCount >= 3) {  /* Play tone every third update (~1 second) when looking up/down */
+            toneCount = 0;
+            PitchTone_Play(pitchAngle);
+        }
+    }
+}
+
+/* ============================================
+ * Menu Accessibility
+ * ============================================ */
+
+/* Track when menu was last announced to prevent render hook from double-announcing */
+static unsigned int g_LastMenuAnnouncementTime = 0;
+#define MENU_ANNOUNCEMENT_COOLDOWN_MS 2000  /* Don't re-announce within 2 seconds */
+
+extern "C" void Menu_OnTextDisplayed(const char* text, int isSelected)
+{
+    if (!Accessibility_IsAvailable() || !AccessibilitySettings.menu_narration_enabled) {
+        return;
+    }
+
+    if (!text || strlen(text) == 0) return;
+
+    /* Check cooldown - if explicit announcement was made recently, skip render hook */
+    unsigned int currentTime = GetTickCount();
+    if ((currentTime - g_LastMenuAnnouncementTime) < MENU_ANNOUNCEMENT_COOLDOWN_MS) {
+        return;  /* Recent explicit announcement, skip this render-triggered one */
+    }
+
+    /* Only announce if text changed and is selected */
+    if (isSelected && Announce("menu", text)) {
+        strncpy(g_LastMenuText, text, sizeof(g_LastMenuText) - 1);
+        g_LastMenuText[sizeof(g_LastMenuText) - 1] = '\0';
+        g_LastMenuAnnouncementTime = currentTime;
+    }
+}
+
+/* Called by explicit menu announcement functions to set cooldown
+ * This prevents render hooks from double-announcing after explicit TTS */
+extern "C" void Menu_SetAnnouncementCooldown(void)
+{
+    g_LastMenuAnnouncementTime = GetTickCount();
+}
+
+extern "C" void Menu_AnnounceCurrentItem(void)
+{
+    if (strlen(g_LastMenuText) > 0) {
+        TTS_Speak(g_LastMenuText);
+    }
+}
+
+extern "C" void Menu_OnNavigate(int direction)
+{
+    if (!Accessibility_IsAvailable()) return;
+
+    switch (direction) {
+        case -1: /* Up */
+            /* Item will be announced by Menu_OnTextDisplayed */
+            break;
+        case 1:  /* Down */
+            /* Item will be announced by Menu_OnTextDisplayed */
+            break;
+        case 0:  /* Select */
+            TTS_SpeakQueued("Selected");
+            break;
+    }
+}
+
+/* ============================================
+ * Debug and Logging
+ * ============================================ */
+
+extern "C" void Accessibility_SetDebugMode(int enabled)
+{
+    g_DebugMode = enabled;
+}
+
+extern "C" void Accessibility_Log(const char* format, ...)
+{
+    if (!g_DebugMode) return;
+
+    va_list args;
+    va_start(args, format);
+
+    fprintf(stderr, "[Accessibility] ");
+    vfprintf(stderr, format, args);
+
+    va_end(args);
+}
+
+/* ============================================
+ * Input Processing
+ * ============================================ */
+
+extern "C" void Accessibility_ProcessInput(void)
+{
+    /* This would be called from the input handler */
+    /* Check for accessibility hotkeys */
+
+    extern unsigned char KeyboardInput[];
+    extern unsigned char DebouncedKeyboardInput[];
+
+    /* F1 - Toggle accessibility */
+    if (DebouncedKeyboardInput[KEY_F1]) {
+        AccessibilitySettings.enabled = !AccessibilitySettings.enabled;
+        TTS_SpeakPriority(AccessibilitySettings.enabled ?
+                          "Accessibility enabled" : "Accessibility disabled");
+    }
+
+    /* F2 - Toggle audio radar */
+    if (DebouncedKeyboardInput[KEY_F2]) {
+        AccessibilitySettings.audio_radar_enabled = !AccessibilitySettings.audio_radar_enabled;
+        TTS_Speak(AccessibilitySettings.audio_radar_enabled ?
+                  "Audio radar enabled" : "Audio radar disabled");
+    }
+
+    /* F3 - Announce health/armor */
+    if (DebouncedKeyboardInput[KEY_F3]) {
+        PlayerState_AnnounceHealth();
+        PlayerState_AnnounceArmor();
+    }
+
+    /* F4 - Announce weapon/ammo */
+    if (DebouncedKeyboardInput[KEY_F4]) {
+        PlayerState_AnnounceWeapon();
+        PlayerState_AnnounceAmmo();
+    }
+
+    /* F5 - Full radar scan */
+    if (DebouncedKeyboardInput[KEY_F5]) {
+        AudioRadar_ScanNow();
+    }
+
+    /* F6 - Announce location */
+    if (DebouncedKeyboardInput[KEY_F6]) {
+        Navigation_AnnounceLocation();
+    }
+
+    /* F7 - Repeat last announcement */
+    if (DebouncedKeyboardInput[KEY_F7]) {
+        if (strlen(g_LastSpokenText) > 0) {
+            TTS_Speak(g_LastSpokenText);
+        }
+    }
+
+    /* F8 - Toggle TTS */
+    if (DebouncedKeyboardInput[KEY_F8]) {
+        AccessibilitySettings.tts_enabled = !AccessibilitySettings.tts_enabled;
+        /* Can't announce this if TTS is now disabled! */
+        if (AccessibilitySettings.tts_enabled) {
+            TTS_Speak("Text to speech enabled");
+        }
+    }
+
+    /* F9 - Announce mission objectives */
+    if (DebouncedKeyboardInput[KEY_F9]) {
+        Mission_AnnounceObjectives();
+    }
+
+    /* F10 - Toggle pitch indicator */
+    if (DebouncedKeyboardInput[KEY_F10]) {
+        g_PitchIndicatorEnabled = !g_PitchIndicatorEnabled;
+        TTS_Speak(g_PitchIndicatorEnabled ?
+                  "Pitch indicator enabled" : "Pitch indicator disabled");
+    }
+
+    /* F11 - Scan for interactive elements (switches, doors, lifts) */
+    if (DebouncedKeyboardInput[KEY_F11]) {
+        Interactive_ScanAndAnnounce();
+    }
+
+    /* F12 - Full status announcement */
+    if (DebouncedKeyboardInput[KEY_F12]) {
+        Accessibility_AnnounceFullStatus();
+    }
+
+    /* ============================================
+     * Autonavigation Controls (Insert/Home/End/PgUp/PgDown)
+     * ============================================ */
+
+    /* Insert - Toggle autonavigation on/off */
+    if (DebouncedKeyboardInput[KEY_INS]) {
+        AutoNav_Toggle();
+    }
+
+    /* Home - Toggle auto-rotation toward target */
+    if (DebouncedKeyboardInput[KEY_HOME]) {
+        AutoNav_ToggleRotation();
+    }
+
+    /* End - Toggle auto-movement toward target */
+    if (DebouncedKeyboardInput[KEY_END]) {
+        AutoNav_ToggleMovement();
+    }
+
+    /* PageUp - Cycle target type (interactive/NPC/exit/item) */
+    if (DebouncedKeyboardInput[KEY_PAGEUP]) {
+        AutoNav_CycleTargetType();
+    }
+
+    /* PageDown - Find nearest target and announce */
+    if (DebouncedKeyboardInput[KEY_PAGEDOWN]) {
+        AutoNav_FindTarget();
+        AutoNav_AnnounceTarget();
+    }
+
+    /* ============================================
+     * Obstruction Detection Controls (Del/Backslash/Grave)
+     * ============================================ */
+
+    /* Delete - Announce what's directly ahead */
+    if (DebouncedKeyboardInput[KEY_DEL]) {
+        Obstruction_AnnounceAhead();
+    }
+
+    /* Backslash - Announce surroundings (all directions) */
+    if (DebouncedKeyboardInput[KEY_BACKSLASH]) {
+        Obstruction_AnnounceSurroundings();
+    }
+
+    /* Grave/Tilde (~) - Toggle obstruction alerts */
+    if (DebouncedKeyboardInput[KEY_GRAVE]) {
+        Obstruction_Toggle();
+    }
+
+    /* Tab - Environment description */
+    if (DebouncedKeyboardInput[KEY_TAB]) {
+        Environment_Describe();
+    }
+
+    /* H - Health announcement (all characters) */
+    if (DebouncedKeyboardInput[KEY_H]) {
+        PlayerState_AnnounceHealth();
+    }
+
+    /* C - Energy cell status (Predator only) */
+    if (DebouncedKeyboardInput[KEY_C]) {
+        Accessibility_AnnounceEnergy();
+    }
+
+    /* M - Mission objectives */
+    if (DebouncedKeyboardInput[KEY_M]) {
+        Mission_AnnounceObjectives();
+    }
+
+    /* ============================================
+     * IJKL / Numpad - Rotation and Vertical Look Control
+     * J/Numpad4 = Rotate Left, L/Numpad6 = Rotate Right
+     * I/Numpad8 = Look Up, K/Numpad2 = Look Down
+     * ============================================ */
+
+    /* Only process look keys when in-game (not in menus) */
+    if (Player && Player->ObStrategyBlock && Player->ObStrategyBlock->DynPtr) {
+        DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
+        PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
+
+        if (ps) {
+            /* J / Numpad4 - Rotate left */
+            if (KeyboardInput[KEY_J] || KeyboardInput[KEY_NUMPAD4]) {
+                playerDyn->AngVelocity.EulerY = -ARROW_ROTATION_SPEED;
+            }
+            /* L / Numpad6 - Rotate right */
+            else if (KeyboardInput[KEY_L] || KeyboardInput[KEY_NUMPAD6]) {
+                playerDyn->AngVelocity.EulerY = ARROW_ROTATION_SPEED;
+            }
+
+            /* I / Numpad8 - Look up */
+            if (KeyboardInput[KEY_I] || KeyboardInput[KEY_NUMPAD8]) {
+                ps->ViewPanX -= ARROW_PITCH_SPEED;
+                /* Clamp pitch to prevent extreme angles */
+                if (ps->ViewPanX < -1536) ps->ViewPanX = -1536;  /* Max look up */
+            }
+            /* K / Numpad2 - Look down */
+            else if (KeyboardInput[KEY_K] || KeyboardInput[KEY_NUMPAD2]) {
+                ps->ViewPanX += ARROW_PITCH_SPEED;
+                /* Clamp pitch to prevent extreme angles */
+                if (ps->ViewPanX > 1536) ps->ViewPanX = 1536;  /* Max look down */
+            }
+
+            /* Centering tone detection - play tone when pitch returns to center */
+            int currentPitchCentered = (ps->ViewPanX >= -PITCH_CENTER_THRESHOLD &&
+                                        ps->ViewPanX <= PITCH_CENTER_THRESHOLD);
+            unsigned int currentTime = GetTickCount();
+
+            /* If pitch was off-center and now it's centered, play centering tone */
+            if (g_WasPitchOffCenter && currentPitchCentered) {
+                /* Debounce: only play if 300ms since last centering tone */
+                if ((currentTime - g_LastCenteringToneTime) > 300) {
+                    CenteringTone_Play();
+                    g_LastCenteringToneTime = currentTime;
+                }
+            }
+
+            /* Update off-center tracking */
+            g_WasPitchOffCenter = !currentPitchCentered;
+        }
+    }
+}
+
+/* ============================================
+ * Interactive Element Scanning
+ * ============================================ */
+
+/* Check if an entity type is an interactive element */
+static int IsInteractiveElement(AVP_BEHAVIOUR_TYPE bhvr)
+{
+    switch (bhvr) {
+        case I_BehaviourProximityDoor:
+        case I_BehaviourLiftDoor:
+        case I_BehaviourSwitchDoor:
+        case I_BehaviourLift:
+        case I_BehaviourBinarySwitch:
+        case I_BehaviourLinkSwitch:
+        case I_BehaviourGenerator:
+        case I_BehaviourDatabase:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int SpatialFilter_Interactive(STRATEGYBLOCK* sb, void* context)
+{
+    (void)context;
+    return IsInteractiveElement(sb->I_SBtype);
+}
+
+extern "C" void Interactive_ScanAndAnnounce(void)
+{
+    if (!Accessibility_IsAvailable() || !Player || !Player->ObStrategyBlock) {
+        TTS_Speak("Cannot scan: player not available");
+        return;
+    }
+
+    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
+    if (!playerDyn) {
+        TTS_Speak("Cannot scan: player position unavailable");
+        return;
+    }
+
+    int playerX = playerDyn->Position.vx;
+    int playerY = playerDyn->Position.vy;
+    int playerZ = playerDyn->Position.vz;
+
+    /* Get player facing direction */
+    int playerYaw = 0;
+    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
+    if (Global_VDB_Ptr) {
+        playerYaw = (int)(atan2((double)Global_VDB_Ptr->VDB_Mat.mat13,
+                                (double)Global_VDB_Ptr->VDB_Mat.mat33) * 2048.0 / 3.14159265);
+    }
+
+    /* Extended range for interactive elements (mission objectives might be far) */
+    int scanRange = AccessibilitySettings.radar_range * 2;
+
+    /* Announce up to 8 nearest elements */
+    #define MAX_ANNOUNCED_INTERACTIVE 8
+    SPATIAL_HIT elements[MAX_ANNOUNCED_INTERACTIVE];
+    int elementCount = 0;
+    int announceCount = SpatialIndex_QueryBest(playerX, playerY, playerZ, scanRange,
+                                               SpatialFilter_Interactive, NULL, SpatialRank_Nearest,
+                                               elements, MAX_ANNOUNCED_INTERACTIVE, &elementCount);
+
+    if (announceCount == 0) {
+        TTS_Speak("No interactive elements detected nearby.");
+        return;
+    }
+
+    /* Build announcement */
+    char announcement[1024] = "Interactive elements: ";
+    char buffer[128];
+
+    for (int i = 0; i < announceCount; i++) {
+        STRATEGYBLOCK* sb = elements[i].sb;
+        AUDIO_DIRECTION direction = Accessibility_GetDirection(
+            playerX, playerY, playerZ,
+            sb->DynPtr->Position.vx,
+            sb->DynPtr->Position.vy,
+            sb->DynPtr->Position.vz,
+            playerYaw
+        );
+        const char* typeName = AudioRadar_GetEntityTypeName(GetRadarEntityType(sb->I_SBtype));
+        const char* dirName = AudioRadar_GetDirectionName(direction);
+        const char* distName = Accessibility_FormatDistance(elements[i].distance);
+
+        snprintf(buffer, sizeof(buffer), "%s %s, %s. ",
+                 typeName, dirName, distName);
+
+        strncat(announcement, buffer, sizeof(announcement) - strlen(announcement) - 1);
+    }
+
+    if (elementCount > announceCount) {
+        snprintf(buffer, sizeof(buffer), "And %d more.", elementCount - announceCount);
+        strncat(announcement, buffer, sizeof(announcement) - strlen(announcement) - 1);
+    }
+
+    TTS_Speak(announcement);
+}
+
+/* ============================================
+ * Mission Objectives
+ * ============================================ */
+
+extern "C" void Mission_AnnounceObjectives(void)
 {
-    /* This would be called from the input handler */
-    /* Check for accessibility hotkeys */
+    if (!Accessibility_IsAvailable()) return;
 
-    extern unsigned char KeyboardInput[];
-    extern unsigned char DebouncedKeyboardInput[];
+    static char objectivesBuffer[2048];
+    int count = GetMissionObjectivesText(objectivesBuffer, sizeof(objectivesBuffer));
 
-    /* F1 - Toggle accessibility */
-    if (DebouncedKeyboardInput[KEY_F1]) {
-        AccessibilitySettings.enabled = !AccessibilitySettings.enabled;
-        TTS_SpeakPriority(AccessibilitySettings.enabled ?
-                          "Accessibility enabled" : "Accessibility disabled");
+    if (count > 0) {
+        char announcement[2100];
+        snprintf(announcement, sizeof(announcement), "Mission objectives: %s", objectivesBuffer);
+        TTS_Speak(announcement);
+
+        /* After announcing objectives, also announce nearby interactive elements
+         * This provides directional guidance even though objectives don't have positions */
+        TTS_SpeakQueued("Scanning for interactive elements...");
+
+        /* Brief delay for TTS queue, then announce interactives */
+        Interactive_ScanAndAnnounce();
+    } else {
+        TTS_Speak(objectivesBuffer);  /* Will say "No active objectives." */
+
+        /* Still scan for interactive elements as guidance */
+        TTS_SpeakQueued("Scanning for interactive elements...");
+        Interactive_ScanAndAnnounce();
     }
+}
 
-    /* F2 - Toggle audio radar */
-    if (DebouncedKeyboardInput[KEY_F2]) {
-        AccessibilitySettings.audio_radar_enabled = !AccessibilitySettings.audio_radar_enabled;
-        TTS_Speak(AccessibilitySettings.audio_radar_enabled ?
-                  "Audio radar enabled" : "Audio radar disabled");
+/* ============================================
+ * On-Screen Message Hook
+ * ============================================ */
+
+/* Called when a message is displayed on screen - announce via TTS */
+extern "C" void Accessibility_OnScreenMessage(const char* message)
+{
+    if (!Accessibility_IsAvailable() || !message || strlen(message) == 0) {
+        return;
+    }
+
+    /* Repeats of the same message within a couple of seconds are dropped */
+    Announce("hud", message);
+}
+
+/* ============================================
+ * Interaction Detection System
+ * ============================================ */
+
+/* Activation ranges from triggers.c */
+#define ACTIVATION_Z_RANGE 3000
+#define ACTIVATION_X_RANGE 1000
+#define ACTIVATION_Y_RANGE 1000
+
+/* Check if an object is an operable/interactive type */
+static int IsOperableObject(AVP_BEHAVIOUR_TYPE behaviour)
+{
+    return (behaviour == I_BehaviourBinarySwitch ||
+            behaviour == I_BehaviourLinkSwitch ||
+            behaviour == I_BehaviourAutoGun ||
+            behaviour == I_BehaviourDatabase);
+}
+
+/* Operable objects that are currently drawn/collidable */
+static int SpatialFilter_Operable(STRATEGYBLOCK* sb, void* context)
+{
+    (void)context;
+    return IsOperableObject(sb->I_SBtype) && sb->SBdptr != NULL;
+}
+
+/* Get a friendly name for the interactive object type */
+static const char* GetInteractiveTypeName(AVP_BEHAVIOUR_TYPE behaviour)
+{
+    switch (behaviour) {
+        case I_BehaviourBinarySwitch: return "switch";
+        case I_BehaviourLinkSwitch: return "switch";
+        case I_BehaviourAutoGun: return "turret control";
+        case I_BehaviourDatabase: return "terminal";
+        default: return "object";
+    }
+}
+
+/* The prompt for an operable object in reach; also rendered as a speech clip */
+static void Interaction_Prompt(AVP_BEHAVIOUR_TYPE behaviour, char* msg, size_t size)
+{
+    snprintf(msg, size, "%s nearby. Press SPACE to interact.", GetInteractiveTypeName(behaviour));
+}
+
+typedef struct {
+    VECTORCH* viewPos;
+    MATRIXCH* viewMat;
+    DISPLAYBLOCK* nearestObjectPtr;
+    int nearestMagnitude;
+    AVP_BEHAVIOUR_TYPE nearestBehaviour;
+} INTERACTION_SEARCH;
+
+/* Same test as the engine's activation check, in view space: keep the
+ * object in the activation box nearest the centre of view */
+static int Interaction_TestObject(STRATEGYBLOCK* sb, int distance, void* visitContext)
+{
+    INTERACTION_SEARCH* search = (INTERACTION_SEARCH*)visitContext;
+    DISPLAYBLOCK* objectPtr = sb->SBdptr;
+    VECTORCH view;
+    (void)distance;
+
+    MakeVector(&objectPtr->ObWorld, search->viewPos, &view);
+    RotateVector(&view, search->viewMat);
+
+    /* Is it in range? */
+    if (view.vz > 0 && view.vz < ACTIVATION_Z_RANGE) {
+        int absX = view.vx;
+        int absY = view.vy;
+
+        if (absX < 0) absX = -absX;
+        if (absY < 0) absY = -absY;
+
+        if (absX < ACTIVATION_X_RANGE && absY < ACTIVATION_Y_RANGE) {
+            int magnitude = (absX * absX + absY * absY);
+
+            if (search->nearestMagnitude > magnitude) {
+                search->nearestMagnitude = magnitude;
+                search->nearestObjectPtr = objectPtr;
+                search->nearestBehaviour = sb->I_SBtype;
+            }
+        }
+    }
+    return 1;
+}
+
+/* Check for nearby interactive objects and announce "Press SPACE" */
+extern "C" void Accessibility_CheckInteraction(void)
+{
+    if (!Accessibility_IsAvailable() || !AccessibilitySettings.navigation_cues_enabled) {
+        return;
+    }
+
+    /* Check if player exists */
+    if (!Player || !Player->ObStrategyBlock) {
+        return;
+    }
+
+    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
+    if (!Global_VDB_Ptr) return;
+
+    /* Every operable object near the viewpoint is tested, so none can be
+     * missed; the activation box is at most this far away */
+    INTERACTION_SEARCH search;
+    search.viewPos = &Global_VDB_Ptr->VDB_World;
+    search.viewMat = &Global_VDB_Ptr->VDB_Mat;
+    search.nearestObjectPtr = NULL;
+    search.nearestMagnitude = ACTIVATION_X_RANGE * ACTIVATION_X_RANGE + ACTIVATION_Y_RANGE * ACTIVATION_Y_RANGE;
+    search.nearestBehaviour = I_BehaviourNull;
+    SpatialIndex_Visit(search.viewPos->vx, search.viewPos->vy, search.viewPos->vz,
+                       ACTIVATION_Z_RANGE + ACTIVATION_X_RANGE + ACTIVATION_Y_RANGE, SPATIAL_DYNAMIC_BLOCKS,
+                       SpatialFilter_Operable, NULL, Interaction_TestObject, &search);
+
+    DISPLAYBLOCK* nearestObjectPtr = search.nearestObjectPtr;
+    AVP_BEHAVIOUR_TYPE nearestBehaviour = search.nearestBehaviour;
+
+    /* Check if we found something */
+    if (nearestObjectPtr) {
+        /* Verify line of sight */
+        if (IsThisObjectVisibleFromThisPosition_WithIgnore(Player, nearestObjectPtr,
+                &nearestObjectPtr->ObWorld, 10000)) {
+            const char* typeName = GetInteractiveTypeName(nearestBehaviour);
+
+            /* Only announce if this is a new interactive or type changed, AND priority allows */
+            if (!g_LastInteractiveNearby || strcmp(typeName, g_LastInteractiveType) != 0) {
+                char announcement[128];
+                Interaction_Prompt(nearestBehaviour, announcement, sizeof(announcement));
+                if (Announce("interaction", announcement)) {
+                    strncpy(g_LastInteractiveType, typeName, sizeof(g_LastInteractiveType) - 1);
+                    g_LastInteractiveType[sizeof(g_LastInteractiveType) - 1] = '\0';
+                }
+            }
+            g_LastInteractiveNearby = 1;
+            return;
+        }
+    }
+
+    /* No interactive nearby - reset state */
+    if (g_LastInteractiveNearby) {
+        g_LastInteractiveNearby = 0;
+        g_LastInteractiveType[0] = '\0';
+    }
+}
+
+/* ============================================
+ * Weapon State Tracking
+ * ============================================ */
+
+/* Get weapon name from weapon ID */
+static const char* GetWeaponNameFromID(int weaponID, I_PLAYER_TYPE playerType)
+{
+    switch (playerType) {
+        case I_Marine:
+            switch (weaponID) {
+                case WEAPON_PULSERIFLE: return "Pulse Rifle";
+                case WEAPON_AUTOSHOTGUN: return "Shotgun";
+                case WEAPON_SMARTGUN: return "Smartgun";
+                case WEAPON_FLAMETHROWER: return "Flamethrower";
+                case WEAPON_PLASMAGUN: return "Plasma Gun";
+                case WEAPON_SADAR: return "SADAR Rocket Launcher";
+                case WEAPON_GRENADELAUNCHER: return "Grenade Launcher";
+                case WEAPON_MINIGUN: return "Minigun";
+                case WEAPON_MARINE_PISTOL: return "Pistol";
+                case WEAPON_TWO_PISTOLS: return "Dual Pistols";
+                case WEAPON_CUDGEL: return "Cudgel";
+                default: return "Unknown Weapon";
+            }
+        case I_Predator:
+            switch (weaponID) {
+                case WEAPON_PRED_WRISTBLADE: return "Wristblades";
+                case WEAPON_PRED_PISTOL: return "Speargun";
+                case WEAPON_PRED_RIFLE: return "Speargun Rifle";
+                case WEAPON_PRED_SHOULDERCANNON: return "Plasma Caster";
+                case WEAPON_PRED_DISC: return "Smart Disc";
+                case WEAPON_PRED_MEDICOMP: return "Medicomp";
+                case WEAPON_PRED_STAFF: return "Combi-Stick";
+                default: return "Unknown Weapon";
+            }
+        case I_Alien:
+            switch (weaponID) {
+                case WEAPON_ALIEN_CLAW: return "Claws";
+                case WEAPON_ALIEN_GRAB: return "Grab Attack";
+                case WEAPON_ALIEN_SPIT: return "Acid Spit";
+                default: return "Claws";
+            }
+        default:
+            return "Unknown";
+    }
+}
+
+/* Selected weapon, or NULL */
+static PLAYER_WEAPON_DATA* WeaponState_Current(void)
+{
+    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
+    int slot = (int)ps->SelectedWeaponSlot;
+
+    if (slot < 0 || slot >= MAX_NO_OF_WEAPON_SLOTS) return NULL;
+    return &ps->WeaponSlot[slot];
+}
+
+static void WeaponState_OnSwitch(const ACCESS_EVENT* event)
+{
+    PLAYER_WEAPON_DATA* weaponPtr;
+    char announcement[128];
+
+    (void)event;
+    if (!PlayerState_Announcing() || !(weaponPtr = WeaponState_Current())) return;
+
+    const char* weaponName = GetWeaponNameFromID(weaponPtr->WeaponIDNumber, AvP.PlayerType);
+    int primaryRounds = weaponPtr->PrimaryRoundsRemaining >> 16;
+
+    /* Include ammo info for Marines and Predators */
+    if (AvP.PlayerType != I_Alien && primaryRounds >= 0) {
+        snprintf(announcement, sizeof(announcement), "%s. %d rounds.", weaponName, primaryRounds);
+    } else {
+        snprintf(announcement, sizeof(announcement), "%s.", weaponName);
+    }
+    Announce("weapon", announcement);
+}
+
+static void WeaponState_OnState(const ACCESS_EVENT* event)
+{
+    if (!PlayerState_Announcing()) return;
+
+    if (event->value == WEAPONSTATE_RELOAD_PRIMARY) {
+        Announce("weapon", "Reloading.");
+    } else if (event->value == WEAPONSTATE_JAMMED) {
+        Announce("alert", "Weapon jammed!");
+    }
+}
+
+/* The magazine running dry other than by reloading */
+static void WeaponState_OnAmmo(const ACCESS_EVENT* event)
+{
+    PLAYER_WEAPON_DATA* weaponPtr;
+
+    if (!PlayerState_Announcing() || AvP.PlayerType == I_Alien) return;
+    if (!(event->previous > 0 && event->value == 0)) return;
+    if (!(weaponPtr = WeaponState_Current()) || weaponPtr->CurrentState == WEAPONSTATE_RELOAD_PRIMARY) return;
+
+    Announce("alert", "Out of ammo!");
+}
+
+static void PlayerEvents_Subscribe(void)
+{
+    Events_Subscribe(ACCESS_EVENT_DAMAGE, PlayerState_OnDamage);
+    Events_Subscribe(ACCESS_EVENT_PICKUP, PlayerState_OnPickup);
+    Events_Subscribe(ACCESS_EVENT_CLOAK, PlayerState_OnCloak);
+    Events_Subscribe(ACCESS_EVENT_VISION, PlayerState_OnVision);
+    Events_Subscribe(ACCESS_EVENT_FIELD_CHARGE, PlayerState_OnFieldCharge);
+    Events_Subscribe(ACCESS_EVENT_WEAPON_SWITCH, WeaponState_OnSwitch);
+    Events_Subscribe(ACCESS_EVENT_WEAPON_STATE, WeaponState_OnState);
+    Events_Subscribe(ACCESS_EVENT_AMMO, WeaponState_OnAmmo);
+}
+
+/* ============================================
+ * Comprehensive Status Announcement (F12)
+ * ============================================ */
+
+extern "C" void Accessibility_AnnounceFullStatus(void)
+{
+    if (!Accessibility_IsAvailable()) return;
+
+    if (!Player || !Player->ObStrategyBlock) {
+        TTS_Speak("Status unavailable.");
+        return;
     }
 
-    /* F3 - Announce health/armor */
-    if (DebouncedKeyboardInput[KEY_F3]) {
-        PlayerState_AnnounceHealth();
-        PlayerState_AnnounceArmor();
+    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
+    if (!ps) return;
+
+    char announcement[512];
+    int health = (ps->Health >> 16);
+    int armor = (ps->Armour >> 16);
+
+    int currentSlot = (int)ps->SelectedWeaponSlot;
+    const char* weaponName = "Unknown";
+    int ammo = 0;
+    int magazines = 0;
+
+    if (currentSlot >= 0 && currentSlot < MAX_NO_OF_WEAPON_SLOTS) {
+        PLAYER_WEAPON_DATA* weaponPtr = &ps->WeaponSlot[currentSlot];
+        weaponName = GetWeaponNameFromID(weaponPtr->WeaponIDNumber, AvP.PlayerType);
+        ammo = weaponPtr->PrimaryRoundsRemaining >> 16;
+        magazines = weaponPtr->PrimaryMagazinesRemaining;
     }
 
-    /* F4 - Announce weapon/ammo */
-    if (DebouncedKeyboardInput[KEY_F4]) {
-        PlayerState_AnnounceWeapon();
-        PlayerState_AnnounceAmmo();
+    if (AvP.PlayerType == I_Alien) {
+        snprintf(announcement, sizeof(announcement),
+            "Status: Health %d percent. Weapon: %s.",
+            health, weaponName);
+    } else {
+        snprintf(announcement, sizeof(announcement),
+            "Status: Health %d percent. Armor %d percent. Weapon: %s. Ammo: %d rounds, %d magazines.",
+            health, armor, weaponName, ammo, magazines);
     }
 
-    /* F5 - Full radar scan */
-    if (DebouncedKeyboardInput[KEY_F5]) {
-        AudioRadar_ScanNow();
-    }
+    TTS_Speak(announcement);
+}
 
-    /* F6 - Announce location */
-    if (DebouncedKeyboardInput[KEY_F6]) {
-        Navigation_AnnounceLocation();
-    }
+/* ============================================
+ * Auto-Navigation System Implementation
+ * ============================================ */
 
-    /* F7 - Repeat last announcement */
-    if (DebouncedKeyboardInput[KEY_F7]) {
-        if (strlen(g_LastSpokenText) > 0) {
-            TTS_Speak(g_LastSpokenText);
-        }
-    }
+/* Global autonavigation state */
+AUTONAV_STATE AutoNavState = {
+    0,      /* enabled */
+    0,      /* auto_rotate */
+    0,      /* auto_move */
+    NAV_TARGET_INTERACTIVE,  /* default target type */
+    0, 0, 0,  /* target position */
+    0,      /* target_distance */
+    NULL    /* target_name */
+};
 
-    /* F8 - Toggle TTS */
-    if (DebouncedKeyboardInput[KEY_F8]) {
-        AccessibilitySettings.tts_enabled = !AccessibilitySettings.tts_enabled;
-        /* Can't announce this if TTS is now disabled! */
-        if (AccessibilitySettings.tts_enabled) {
-            TTS_Speak("Text to speech enabled");
-        }
-    }
+/* Navigation tone system */
+#define NAV_TONE_SAMPLE_RATE 44100
+#define NAV_TONE_DURATION_MS 80
+#define NAV_TONE_SAMPLES (NAV_TONE_SAMPLE_RATE * NAV_TONE_DURATION_MS / 1000)
+#define NAV_TONE_GAIN_RANGE 30000   /* Distance at which the tone is quietest */
+#define NAV_BASE_FREQUENCY 660.0f  /* E5 note - distinct from radar */
 
-    /* F9 - Announce mission objectives */
-    if (DebouncedKeyboardInput[KEY_F9]) {
-        Mission_AnnounceObjectives();
-    }
+static ALuint g_NavToneBuffer = 0;
+static ALuint g_NavToneSource = 0;
+static int g_NavToneInitialized = 0;
+static unsigned int g_NavTargetRefreshTime = 0;
 
-    /* F10 - Toggle pitch indicator */
-    if (DebouncedKeyboardInput[KEY_F10]) {
-        g_PitchIndicatorEnabled = !g_PitchIndicatorEnabled;
-        TTS_Speak(g_PitchIndicatorEnabled ?
-                  "Pitch indicator enabled" : "Pitch indicator disabled");
+/* Generate navigation guidance tone buffer */
+static int NavTone_GenerateBuffer(void)
+{
+    if (g_NavToneBuffer != 0) {
+        return 1;
     }
 
-    /* F11 - Scan for interactive elements (switches, doors, lifts) */
-    if (DebouncedKeyboardInput[KEY_F11]) {
-        Interactive_ScanAndAnnounce();
-    }
+    short* samples = (short*)malloc(NAV_TONE_SAMPLES * sizeof(short));
+    if (!samples) return 0;
 
-    /* F12 - Full status announcement */
-    if (DebouncedKeyboardInput[KEY_F12]) {
-        Accessibility_AnnounceFullStatus();
-    }
+    /* Generate a pleasant sine wave with quick attack/decay */
+    for (int i = 0; i < NAV_TONE_SAMPLES; i++) {
+        float t = (float)i / NAV_TONE_SAMPLE_RATE;
+        float phase = 2.0f * 3.14159265f * NAV_BASE_FREQUENCY * t;
+        float sample = sinf(phase);
 
-    /* ============================================
-     * Autonavigation Controls (Insert/Home/End/PgUp/PgDown)
-     * ============================================ */
+        /* Quick envelope */
+        float envelope = 1.0f;
+        float fadeLen = NAV_TONE_SAMPLES * 0.1f;
+        if (i < (int)fadeLen) {
+            envelope = (float)i / fadeLen;
+        } else if (i > NAV_TONE_SAMPLES - (int)fadeLen) {
+            envelope = (float)(NAV_TONE_SAMPLES - i) / fadeLen;
+        }
 
-    /* Insert - Toggle autonavigation on/off */
-    if (DebouncedKeyboardInput[KEY_INS]) {
-        AutoNav_Toggle();
+        samples[i] = (short)(sample * envelope * 20000.0f);
     }
 
-    /* Home - Toggle auto-rotation toward target */
-    if (DebouncedKeyboardInput[KEY_HOME]) {
-        AutoNav_ToggleRotation();
+    alGenBuffers(1, &g_NavToneBuffer);
+    if (alGetError() != AL_NO_ERROR) {
+        free(samples);
+        return 0;
     }
 
-    /* End - Toggle auto-movement toward target */
-    if (DebouncedKeyboardInput[KEY_END]) {
-        AutoNav_ToggleMovement();
-    }
+    alBufferData(g_NavToneBuffer, AL_FORMAT_MONO16, samples,
+                 NAV_TONE_SAMPLES * sizeof(short), NAV_TONE_SAMPLE_RATE);
 
-    /* PageUp - Cycle target type (interactive/NPC/exit/item) */
-    if (DebouncedKeyboardInput[KEY_PAGEUP]) {
-        AutoNav_CycleTargetType();
-    }
+    free(samples);
 
-    /* PageDown - Find nearest target and announce */
-    if (DebouncedKeyboardInput[KEY_PAGEDOWN]) {
-        AutoNav_FindTarget();
-        AutoNav_AnnounceTarget();
+    if (alGetError() != AL_NO_ERROR) {
+        alDeleteBuffers(1, &g_NavToneBuffer);
+        g_NavToneBuffer = 0;
+        return 0;
     }
 
-    /* ============================================
-     * Obstruction Detection Controls (Del/Backslash/Grave)
-     * ============================================ */
+    return 1;
+}
 
-    /* Delete - Announce what's directly ahead */
-    if (DebouncedKeyboardInput[KEY_DEL]) {
-        Obstruction_AnnounceAhead();
+static int NavTone_Init(void)
+{
+    if (g_NavToneInitialized) {
+        return 1;
     }
 
-    /* Backslash - Announce surroundings (all directions) */
-    if (DebouncedKeyboardInput[KEY_BACKSLASH]) {
-        Obstruction_AnnounceSurroundings();
+    if (!NavTone_GenerateBuffer()) {
+        return 0;
     }
 
-    /* Grave/Tilde (~) - Toggle obstruction alerts */
-    if (DebouncedKeyboardInput[KEY_GRAVE]) {
-        Obstruction_Toggle();
+    alGenSources(1, &g_NavToneSource);
+    if (alGetError() != AL_NO_ERROR) {
+        return 0;
     }
 
-    /* Tab - Environment description */
-    if (DebouncedKeyboardInput[KEY_TAB]) {
-        Environment_Describe();
-    }
+    alSourcei(g_NavToneSource, AL_BUFFER, g_NavToneBuffer);
+    alSourcef(g_NavToneSource, AL_GAIN, 0.5f);
+    alSourcei(g_NavToneSource, AL_SOURCE_RELATIVE, AL_FALSE);
 
-    /* H - Health announcement (all characters) */
-    if (DebouncedKeyboardInput[KEY_H]) {
-        PlayerState_AnnounceHealth();
-    }
+    g_NavToneInitialized = 1;
+    return 1;
+}
 
-    /* C - Energy cell status (Predator only) */
-    if (DebouncedKeyboardInput[KEY_C]) {
-        Accessibility_AnnounceEnergy();
+/* Play navigation tone with stereo panning and vertical pitch variation
+ * angleOffset: -1.0 = hard left, 0 = center, 1.0 = hard right
+ * verticalRatio: -1.0 = below, 0 = same level, 1.0 = above
+ * distance: how far the target is to walk; nearer is louder
+ */
+static void NavTone_PlayDirectional(float angleOffset, float verticalRatio, int distance)
+{
+    if (!g_NavToneInitialized) {
+        if (!NavTone_Init()) return;
     }
 
-    /* M - Mission objectives */
-    if (DebouncedKeyboardInput[KEY_M]) {
-        Mission_AnnounceObjectives();
+    /* Check if source is already playing - if so, let it finish (allows parallel sounds) */
+    ALint state;
+    alGetSourcei(g_NavToneSource, AL_SOURCE_STATE, &state);
+    if (state == AL_PLAYING) {
+        return;  /* Let current sound finish, don't interrupt */
     }
 
-    /* ============================================
-     * IJKL / Numpad - Rotation and Vertical Look Control
-     * J/Numpad4 = Rotate Left, L/Numpad6 = Rotate Right
-     * I/Numpad8 = Look Up, K/Numpad2 = Look Down
-     * ============================================ */
-
-    /* Only process look keys when in-game (not in menus) */
-    if (Player && Player->ObStrategyBlock && Player->ObStrategyBlock->DynPtr) {
-        DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
-        PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-
-        if (ps) {
-            /* J / Numpad4 - Rotate left */
-            if (KeyboardInput[KEY_J] || KeyboardInput[KEY_NUMPAD4]) {
-                playerDyn->AngVelocity.EulerY = -ARROW_ROTATION_SPEED;
-            }
-            /* L / Numpad6 - Rotate right */
-            else if (KeyboardInput[KEY_L] || KeyboardInput[KEY_NUMPAD6]) {
-                playerDyn->AngVelocity.EulerY = ARROW_ROTATION_SPEED;
-            }
+    /* Use SOURCE_RELATIVE for consistent UI audio that doesn't interfere with game 3D sounds */
+    alSourcei(g_NavToneSource, AL_SOURCE_RELATIVE, AL_TRUE);
 
-            /* I / Numpad8 - Look up */
-            if (KeyboardInput[KEY_I] || KeyboardInput[KEY_NUMPAD8]) {
-                ps->ViewPanX -= ARROW_PITCH_SPEED;
-                /* Clamp pitch to prevent extreme angles */
-                if (ps->ViewPanX < -1536) ps->ViewPanX = -1536;  /* Max look up */
-            }
-            /* K / Numpad2 - Look down */
-            else if (KeyboardInput[KEY_K] || KeyboardInput[KEY_NUMPAD2]) {
-                ps->ViewPanX += ARROW_PITCH_SPEED;
-                /* Clamp pitch to prevent extreme angles */
-                if (ps->ViewPanX > 1536) ps->ViewPanX = 1536;  /* Max look down */
-            }
+    /* Map to 3D position for stereo panning */
+    float posX = angleOffset * 2.0f;
+    float posZ = -1.0f;  /* In front */
 
-            /* Centering tone detection - play tone when pitch returns to center */
-            int currentPitchCentered = (ps->ViewPanX >= -PITCH_CENTER_THRESHOLD &&
-                                        ps->ViewPanX <= PITCH_CENTER_THRESHOLD);
-            unsigned int currentTime = GetTickCount();
+    alSource3f(g_NavToneSource, AL_POSITION, posX, 0.0f, posZ);
 
-            /* If pitch was off-center and now it's centered, play centering tone */
-            if (g_WasPitchOffCenter && currentPitchCentered) {
-                /* Debounce: only play if 300ms since last centering tone */
-                if ((currentTime - g_LastCenteringToneTime) > 300) {
-                    CenteringTone_Play();
-                    g_LastCenteringToneTime = currentTime;
-                }
-            }
+    /* Calculate pitch based on both horizontal alignment AND vertical offset:
+     * - Base pitch 1.0
+     * - Higher when on target horizontally (+0.15 to +0.3)
+     * - Vertical variation: above = higher pitch, below = lower pitch (+/- 0.5)
+     */
+    float pitch = 1.0f;
 
-            /* Update off-center tracking */
-            g_WasPitchOffCenter = !currentPitchCentered;
-        }
+    /* Horizontal alignment bonus */
+    float absAngle = (angleOffset < 0) ? -angleOffset : angleOffset;
+    if (absAngle < 0.1f) {
+        pitch += 0.3f;  /* Higher pitch when on target */
+    } else if (absAngle < 0.3f) {
+        pitch += 0.15f;
     }
-}
 
-/* ============================================
- * Interactive Element Scanning
- * ============================================ */
+    /* Vertical variation: above = higher pitch, below = lower pitch */
+    pitch += verticalRatio * 0.5f;
 
-/* Check if an entity type is an interactive element */
-static int IsInteractiveElement(AVP_BEHAVIOUR_TYPE bhvr)
-{
-    switch (bhvr) {
-        case I_BehaviourProximityDoor:
-        case I_BehaviourLiftDoor:
-        case I_BehaviourSwitchDoor:
-        case I_BehaviourLift:
-        case I_BehaviourBinarySwitch:
-        case I_BehaviourLinkSwitch:
-        case I_BehaviourGenerator:
-        case I_BehaviourDatabase:
-            return 1;
-        default:
-            return 0;
-    }
-}
+    /* Clamp pitch to reasonable range */
+    if (pitch < 0.5f) pitch = 0.5f;
+    if (pitch > 2.0f) pitch = 2.0f;
 
-/* Structure to hold interactive element info for sorting */
-typedef struct {
-    RADAR_ENTITY_TYPE type;
-    AUDIO_DIRECTION direction;
-    int distance;
-    int posX, posY, posZ;
-} INTERACTIVE_ELEMENT_INFO;
+    alSourcef(g_NavToneSource, AL_PITCH, pitch);
 
-/* Compare function for sorting by distance (nearest first) */
-static int CompareByDistance(const void* a, const void* b)
-{
-    const INTERACTIVE_ELEMENT_INFO* elemA = (const INTERACTIVE_ELEMENT_INFO*)a;
-    const INTERACTIVE_ELEMENT_INFO* elemB = (const INTERACTIVE_ELEMENT_INFO*)b;
-    return elemA->distance - elemB->distance;
+    /* Set a moderate gain that won't overpower game sounds, dropping to
+     * half for distant targets */
+    float volumeScale = 1.0f - (float)distance / NAV_TONE_GAIN_RANGE;
+    if (volumeScale < 0.5f) volumeScale = 0.5f;
+    if (volumeScale > 1.0f) volumeScale = 1.0f;
+    alSourcef(g_NavToneSource, AL_GAIN, 0.4f * volumeScale);
+
+    alSourceRewind(g_NavToneSource);
+    alSourcePlay(g_NavToneSource);
 }
 
-extern "C" void Interactive_ScanAndAnnounce(void)
+extern "C" void AutoNav_Init(void)
 {
-    if (!Accessibility_IsAvailable() || !Player || !Player->ObStrategyBlock) {
-        TTS_Speak("Cannot scan: player not available");
-        return;
-    }
-
-    DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
-    if (!playerDyn) {
-        TTS_Speak("Cannot scan: player position unavailable");
-        return;
-    }
+    AutoNavState.enabled = 0;
+    AutoNavState.auto_rotate = 0;
+    AutoNavState.auto_move = 0;
+    AutoNavState.target_type = NAV_TARGET_INTERACTIVE;
+    AutoNavState.target_x = 0;
+    AutoNavState.target_y = 0;
+    AutoNavState.target_z = 0;
+    AutoNavState.target_distance = 0;
+    AutoNavState.target_name = NULL;
+    AutoNavState.target_sb = NULL;
 
-    int playerX = playerDyn->Position.vx;
-    int playerY = playerDyn->Position.vy;
-    int playerZ = playerDyn->Position.vz;
+    /* Initialize position history */
+    AutoNavState.history_index = 0;
+    AutoNavState.history_count = 0;
+    memset(AutoNavState.position_history, 0, sizeof(AutoNavState.position_history));
 
-    /* Get player facing direction */
-    int playerYaw = 0;
-    extern VIEWDESCRIPTORBLOCK* Global_VDB_Ptr;
-    if (Global_VDB_Ptr) {
-        playerYaw = (int)(atan2((double)Global_VDB_Ptr->VDB_Mat.mat13,
-                                (double)Global_VDB_Ptr->VDB_Mat.mat33) * 2048.0 / 3.14159265);
-    }
+    /* Initialize progress tracking */
+    AutoNavState.last_announced_distance = 0;
+    AutoNavState.closest_achieved = 999999;
+    AutoNavState.last_progress_time = 0;
 
-    extern int NumActiveStBlocks;
-    extern STRATEGYBLOCK* ActiveStBlockList[];
+    /* Initialize strategy management */
+    AutoNavState.current_strategy = NAV_STRATEGY_DIRECT;
+    AutoNavState.strategy_ms = 0;
+    AutoNavState.strategy_failures = 0;
 
-    /* Collect interactive elements (max 20) */
-    #define MAX_INTERACTIVE_ELEMENTS 20
-    INTERACTIVE_ELEMENT_INFO elements[MAX_INTERACTIVE_ELEMENTS];
-    int elementCount = 0;
+    /* Initialize door/lift tracking */
+    AutoNavState.door_wait.doorSB = NULL;
+    AutoNavState.door_wait.lastState = 0;
+    AutoNavState.door_wait.waitStartTime = 0;
+    AutoNavState.door_wait.announced = 0;
+    AutoNavState.lift_track.liftSB = NULL;
+    AutoNavState.lift_track.lastState = 0;
+    AutoNavState.lift_track.playerOnLift = 0;
+    AutoNavState.lift_track.rideStartTime = 0;
 
-    /* Extended range for interactive elements (mission objectives might be far) */
-    int scanRange = AccessibilitySettings.radar_range * 2;
+    /* Initialize arrival handling */
+    AutoNavState.arrival_announced = 0;
+    AutoNavState.target_reached = 0;
+}
 
-    for (int i = 0; i < NumActiveStBlocks && elementCount < MAX_INTERACTIVE_ELEMENTS; i++) {
-        STRATEGYBLOCK* sb = ActiveStBlockList[i];
-        if (!sb || !sb->DynPtr) continue;
+/* ============================================
+ * Spatial Awareness State
+ * ============================================ */
 
-        /* Only include interactive elements */
-        if (!IsInteractiveElement(sb->I_SBtype)) continue;
+SPATIAL_AWARENESS_STATE SpatialState = {0};
 
-        int dist = Accessibility_GetDistance(
-            playerX, playerY, playerZ,
-            sb->DynPtr->Position.vx,
-            sb->DynPtr->Position.vy,
-            sb->DynPtr->Position.vz
-        );
+/* ============================================
+ * Pathfinding Helper Functions
+ * ============================================ */
 
-        if (dist > scanRange) continue;
+/* Record current position in history (AutoNav_Update calls this every ~166ms) */
+extern "C" void PathFind_RecordPosition(int x, int y, int z)
+{
+    POSITION_RECORD* rec = &AutoNavState.position_history[AutoNavState.history_index];
+    rec->x = x;
+    rec->y = y;
+    rec->z = z;
+    rec->timestamp = GetTickCount();
 
-        /* Store element info */
-        elements[elementCount].type = GetRadarEntityType(sb->I_SBtype);
-        elements[elementCount].distance = dist;
-        elements[elementCount].posX = sb->DynPtr->Position.vx;
-        elements[elementCount].posY = sb->DynPtr->Position.vy;
-        elements[elementCount].posZ = sb->DynPtr->Position.vz;
-        elements[elementCount].direction = Accessibility_GetDirection(
-            playerX, playerY, playerZ,
-            sb->DynPtr->Position.vx,
-            sb->DynPtr->Position.vy,
-            sb->DynPtr->Position.vz,
-            playerYaw
-        );
-        elementCount++;
+    AutoNavState.history_index = (AutoNavState.history_index + 1) % NAV_POSITION_HISTORY_SIZE;
+    if (AutoNavState.history_count < NAV_POSITION_HISTORY_SIZE) {
+        AutoNavState.history_count++;
     }
+}
 
-    if (elementCount == 0) {
-        TTS_Speak("No interactive elements detected nearby.");
-        return;
+/* Detect if player is oscillating (moving back and forth) */
+extern "C" int PathFind_DetectOscillation(void)
+{
+    if (AutoNavState.history_count < 6) return 0;
+
+    /* Look at last 6 positions (~1 second) */
+    int sumX = 0, sumZ = 0;
+    int sumX2 = 0, sumZ2 = 0;
+    int count = 0;
+
+    for (int i = 0; i < 6; i++) {
+        int idx = (AutoNavState.history_index - 1 - i + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
+        POSITION_RECORD* rec = &AutoNavState.position_history[idx];
+        sumX += rec->x;
+        sumZ += rec->z;
+        sumX2 += rec->x * rec->x;
+        sumZ2 += rec->z * rec->z;
+        count++;
     }
 
-    /* Sort by distance (nearest first) */
-    qsort(elements, elementCount, sizeof(INTERACTIVE_ELEMENT_INFO), CompareByDistance);
+    /* Calculate variance */
+    int meanX = sumX / count;
+    int meanZ = sumZ / count;
+    int varX = (sumX2 / count) - (meanX * meanX);
+    int varZ = (sumZ2 / count) - (meanZ * meanZ);
 
-    /* Build announcement */
-    char announcement[1024] = "Interactive elements: ";
-    char buffer[128];
+    /* Low variance in position but movement detected = oscillating */
+    /* Check if total movement is significant but variance is low */
+    int oldest = (AutoNavState.history_index - 6 + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
+    int newest = (AutoNavState.history_index - 1 + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
+    int dx = AutoNavState.position_history[newest].x - AutoNavState.position_history[oldest].x;
+    int dz = AutoNavState.position_history[newest].z - AutoNavState.position_history[oldest].z;
+    int totalMovement = dx * dx + dz * dz;
 
-    /* Announce up to 8 nearest elements */
-    int announceCount = (elementCount > 8) ? 8 : elementCount;
+    /* Oscillating if variance is high (lots of back-and-forth) but net movement is low */
+    if ((varX + varZ) > 500000 && totalMovement < 1000000) {
+        return 1;
+    }
 
-    for (int i = 0; i < announceCount; i++) {
-        const char* typeName = AudioRadar_GetEntityTypeName(elements[i].type);
-        const char* dirName = AudioRadar_GetDirectionName(elements[i].direction);
-        const char* distName = Accessibility_FormatDistance(elements[i].distance);
+    return 0;
+}
 
-        snprintf(buffer, sizeof(buffer), "%s %s, %s. ",
-                 typeName, dirName, distName);
+/* Detect if player has returned to a previous position (loop) */
+extern "C" int PathFind_DetectLoop(int* loopSize)
+{
+    if (AutoNavState.history_count < 18) return 0;  /* Need 3+ seconds of history */
 
-        strncat(announcement, buffer, sizeof(announcement) - strlen(announcement) - 1);
-    }
+    int currentIdx = (AutoNavState.history_index - 1 + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
+    POSITION_RECORD* current = &AutoNavState.position_history[currentIdx];
 
-    if (elementCount > announceCount) {
-        snprintf(buffer, sizeof(buffer), "And %d more.", elementCount - announceCount);
-        strncat(announcement, buffer, sizeof(announcement) - strlen(announcement) - 1);
+    /* Check positions from 3+ seconds ago */
+    for (int i = 18; i < AutoNavState.history_count; i++) {
+        int oldIdx = (AutoNavState.history_index - 1 - i + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
+        POSITION_RECORD* old = &AutoNavState.position_history[oldIdx];
+
+        int dx = current->x - old->x;
+        int dz = current->z - old->z;
+        int distSq = dx * dx + dz * dz;
+
+        /* Within 1000 units = same position (loop detected) */
+        if (distSq < 1000000) {
+            if (loopSize) *loopSize = i;
+            return 1;
+        }
     }
 
-    TTS_Speak(announcement);
+    return 0;
 }
 
-/* ============================================
- * Mission Objectives
- * ============================================ */
-
-extern "C" void Mission_AnnounceObjectives(void)
+/* Escalate to next navigation strategy */
+extern "C" void PathFind_EscalateStrategy(void)
 {
-    if (!Accessibility_IsAvailable()) return;
+    AutoNavState.strategy_ms = 0;
 
-    static char objectivesBuffer[2048];
-    int count = GetMissionObjectivesText(objectivesBuffer, sizeof(objectivesBuffer));
+    switch (AutoNavState.current_strategy) {
+        case NAV_STRATEGY_DIRECT:
+            AutoNavState.current_strategy = NAV_STRATEGY_WALL_FOLLOW_LEFT;
+            TTS_SpeakCategory("nav_recovery", "Trying wall follow left.");
+            LOG_INF("Strategy: Wall follow left");
+            break;
 
-    if (count > 0) {
-        char announcement[2100];
-        snprintf(announcement, sizeof(announcement), "Mission objectives: %s", objectivesBuffer);
-        TTS_Speak(announcement);
+        case NAV_STRATEGY_WALL_FOLLOW_LEFT:
+            AutoNavState.current_strategy = NAV_STRATEGY_WALL_FOLLOW_RIGHT;
+            TTS_SpeakCategory("nav_recovery", "Trying wall follow right.");
+            LOG_INF("Strategy: Wall follow right");
+            break;
 
-        /* After announcing objectives, also announce nearby interactive elements
-         * This provides directional guidance even though objectives don't have positions */
-        TTS_SpeakQueued("Scanning for interactive elements...");
+        case NAV_STRATEGY_WALL_FOLLOW_RIGHT:
+            AutoNavState.current_strategy = NAV_STRATEGY_BACKTRACK;
+            TTS_SpeakCategory("nav_recovery", "Backing up.");
+            LOG_INF("Strategy: Backtrack");
+            break;
 
-        /* Brief delay for TTS queue, then announce interactives */
-        Interactive_ScanAndAnnounce();
-    } else {
-        TTS_Speak(objectivesBuffer);  /* Will say "No active objectives." */
+        case NAV_STRATEGY_BACKTRACK:
+            /* After backtrack, try wide around */
+            AutoNavState.current_strategy = NAV_STRATEGY_WIDE_AROUND_LEFT;
+            TTS_SpeakCategory("nav_recovery", "Trying wide path left.");
+            LOG_INF("Strategy: Wide around left");
+            break;
 
-        /* Still scan for interactive elements as guidance */
-        TTS_SpeakQueued("Scanning for interactive elements...");
-        Interactive_ScanAndAnnounce();
+        case NAV_STRATEGY_WIDE_AROUND_LEFT:
+            AutoNavState.current_strategy = NAV_STRATEGY_WIDE_AROUND_RIGHT;
+            TTS_SpeakCategory("nav_recovery", "Trying wide path right.");
+            LOG_INF("Strategy: Wide around right");
+            break;
+
+        case NAV_STRATEGY_WIDE_AROUND_RIGHT:
+            /* All strategies exhausted */
+            AutoNavState.strategy_failures++;
+            if (AutoNavState.strategy_failures >= 2) {
+                TTS_Speak("Cannot reach target. Try manual navigation.");
+                AutoNavState.auto_move = 0;
+                AutoNavState.current_strategy = NAV_STRATEGY_DIRECT;
+                LOG_WRN("All navigation strategies failed");
+            } else {
+                /* Reset and try again */
+                AutoNavState.current_strategy = NAV_STRATEGY_DIRECT;
+                TTS_SpeakCategory("nav_recovery", "Retrying direct path.");
+                LOG_INF("Strategy: Reset to direct");
+            }
+            break;
     }
 }
 
 /* ============================================
- * On-Screen Message Hook
+ * Module Graph Path Planner
  * ============================================ */
 
-/* Called when a message is displayed on screen - announce via TTS */
-extern "C" void Accessibility_OnScreenMessage(const char* message)
-{
-    if (!Accessibility_IsAvailable() || !message || strlen(message) == 0) {
-        return;
-    }
+/*
+ * A* over the AI module graph. Search nodes are the far entry points
+ * (FALLP_EntryPoints): node "n from m" is where a route crossing from
+ * module m into module n enters n, so leg costs are measured between
+ * actual portal positions rather than module centres. Adjacency comes
+ * from m_link_ptrs + GetAIModuleEP and is flattened once per level.
+ *
+ * Entering a door module adds a cost depending on its type and whether it
+ * is open; portals the player got stuck at are penalised for a while.
+ * Routes are cached per (source module, target module) and reused until
+ * a door changes state or a portal is penalised.
+ */
+#define NAVPLAN_MAX_ROUTE           64
+#define NAVPLAN_CACHE_SIZE          8
+#define NAVPLAN_DOOR_COST           1000    /* Opens on approach, or already open */
+#define NAVPLAN_LIFT_COST           15000   /* Closed lift door: call and wait for the lift */
+#define NAVPLAN_LOCKED_DOOR_COST    40000   /* Closed security door: needs its switch */
+#define NAVPLAN_BLOCKED_COST        60000
+#define NAVPLAN_BLOCKED_MS          15000
 
-    /* Prevent duplicate announcements of the same message */
-    if (strcmp(message, g_LastOnScreenMessage) == 0) {
-        return;
-    }
+typedef struct {
+    int module;             /* AI module entered at this waypoint */
+    VECTORCH position;      /* World position of the entry point */
+    int remaining;          /* Route length from here to the goal */
+} NAVPLAN_WAYPOINT;
 
-    /* Store for duplicate prevention */
-    strncpy(g_LastOnScreenMessage, message, sizeof(g_LastOnScreenMessage) - 1);
-    g_LastOnScreenMessage[sizeof(g_LastOnScreenMessage) - 1] = '\0';
+typedef struct {
+    int src, dst;
+    unsigned int signature; /* Door states + penalties when planned */
+    unsigned int lastUsed;
+    int length;             /* Waypoints; 0 = same module, -1 = unreachable */
+    NAVPLAN_WAYPOINT waypoints[NAVPLAN_MAX_ROUTE];
+} NAVPLAN_ROUTE;
 
-    /* Announce the message */
-    TTS_SpeakQueued(message);
-}
+typedef struct {
+    int module;             /* Module this entry point leads into */
+    int from;               /* Module it is entered from */
+    VECTORCH position;      /* World space */
+    int alienOnly;
+} NAVPLAN_NODE;
 
-/* ============================================
- * Interaction Detection System
- * ============================================ */
+/* Indexed binary min-heap over node ids; pos[node] is -1 when not queued */
+typedef struct {
+    int* nodes;
+    int* keys;
+    int* pos;
+    int size;
+} NAVPLAN_HEAP;
+
+/* Graph, rebuilt lazily after AutoNav_ResetPlanner */
+static int g_NavPlanBuilt = 0;
+static int g_NavPlanNodeCount = 0;
+static NAVPLAN_NODE* g_NavPlanNodes = NULL;
+static int* g_NavPlanOutStart = NULL;       /* Per module: its outgoing portals are nodes [start, next start) */
+static int* g_NavPlanInStart = NULL;        /* Per module: first portal into it in g_NavPlanIn */
+static int* g_NavPlanIn = NULL;             /* Portal nodes grouped by the module they lead into */
+static STRATEGYBLOCK** g_NavPlanDoorSB = NULL;  /* Per module: door behaviour, or NULL */
+static int* g_NavPlanDoorModules = NULL;
+static int g_NavPlanDoorCount = 0;
+static unsigned int* g_NavPlanBlockedUntil = NULL;  /* Per node: penalty expiry tick */
+static unsigned int g_NavPlanPenaltyEpoch = 0;
+
+/* Search scratch, stamped so it never needs clearing */
+static int* g_NavPlanCost = NULL;
+static int* g_NavPlanParent = NULL;
+static unsigned int* g_NavPlanStamp = NULL;
+static unsigned int g_NavPlanSearch = 0;
+static NAVPLAN_HEAP g_NavPlanOpen;          /* Keyed on f = cost + heuristic */
+
+static NAVPLAN_ROUTE g_NavPlanCache[NAVPLAN_CACHE_SIZE];
+static unsigned int g_NavPlanUseCounter = 0;
+
+static void NavField_Free(void);
+static void NavField_PortalPenalised(int node);
+static void PathDist_Free(void);
+static void NavMeshSteer_Free(void);
+static void RayCache_Flush(void);
+
+/* Heap storage for up to capacity nodes */
+static int NavPlan_HeapAlloc(NAVPLAN_HEAP* heap, int capacity)
+{
+    heap->nodes = (int*)malloc(capacity * sizeof(int));
+    heap->keys = (int*)malloc(capacity * sizeof(int));
+    heap->pos = (int*)malloc(capacity * sizeof(int));
+    heap->size = 0;
+    if (!heap->nodes || !heap->keys || !heap->pos) return 0;
+    for (int i = 0; i < capacity; i++) heap->pos[i] = -1;
+    return 1;
+}
 
-/* Activation ranges from triggers.c */
-#define ACTIVATION_Z_RANGE 3000
-#define ACTIVATION_X_RANGE 1000
-#define ACTIVATION_Y_RANGE 1000
+static void NavPlan_HeapFree(NAVPLAN_HEAP* heap)
+{
+    free(heap->nodes);
+    free(heap->keys);
+    free(heap->pos);
+    memset(heap, 0, sizeof(*heap));
+}
 
-/* Check if an object is an operable/interactive type */
-static int IsOperableObject(AVP_BEHAVIOUR_TYPE behaviour)
+static void NavPlan_HeapSet(NAVPLAN_HEAP* heap, int i, int node, int key)
 {
-    return (behaviour == I_BehaviourBinarySwitch ||
-            behaviour == I_BehaviourLinkSwitch ||
-            behaviour == I_BehaviourAutoGun ||
-            behaviour == I_BehaviourDatabase);
+    heap->nodes[i] = node;
+    heap->keys[i] = key;
+    heap->pos[node] = i;
 }
 
-/* Get a friendly name for the interactive object type */
-static const char* GetInteractiveTypeName(AVP_BEHAVIOUR_TYPE behaviour)
+static void NavPlan_HeapSift(NAVPLAN_HEAP* heap, int i)
 {
-    switch (behaviour) {
-        case I_BehaviourBinarySwitch: return "switch";
-        case I_BehaviourLinkSwitch: return "switch";
-        case I_BehaviourAutoGun: return "turret control";
-        case I_BehaviourDatabase: return "terminal";
-        default: return "object";
+    int node = heap->nodes[i], key = heap->keys[i];
+
+    /* Up */
+    while (i > 0) {
+        int parent = (i - 1) >> 1;
+        if (heap->keys[parent] <= key) break;
+        NavPlan_HeapSet(heap, i, heap->nodes[parent], heap->keys[parent]);
+        i = parent;
     }
+    /* Down */
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= heap->size) break;
+        if (child + 1 < heap->size && heap->keys[child + 1] < heap->keys[child]) child++;
+        if (heap->keys[child] >= key) break;
+        NavPlan_HeapSet(heap, i, heap->nodes[child], heap->keys[child]);
+        i = child;
+    }
+    NavPlan_HeapSet(heap, i, node, key);
 }
 
-/* Check for nearby interactive objects and announce "Press SPACE" */
-extern "C" void Accessibility_CheckInteraction(void)
+/* Insert a node, or move one already queued to its new key */
+static void NavPlan_HeapUpdate(NAVPLAN_HEAP* heap, int node, int key)
 {
-    if (!Accessibility_IsAvailable() || !AccessibilitySettings.navigation_cues_enabled) {
-        return;
-    }
+    int i = heap->pos[node];
+    if (i < 0) i = heap->size++;
+    NavPlan_HeapSet(heap, i, node, key);
+    NavPlan_HeapSift(heap, i);
+}
 
-    /* Only check every 15 frames to avoid spam */
-    g_InteractionCheckFrames++;
-    if (g_InteractionCheckFrames < 15) {
-        return;
-    }
-    g_InteractionCheckFrames = 0;
+static void NavPlan_HeapRemove(NAVPLAN_HEAP* heap, int node)
+{
+    int i = heap->pos[node];
+    if (i < 0) return;
 
-    /* Check if player exists */
-    if (!Player || !Player->ObStrategyBlock) {
-        return;
+    heap->pos[node] = -1;
+    heap->size--;
+    if (i < heap->size) {
+        NavPlan_HeapSet(heap, i, heap->nodes[heap->size], heap->keys[heap->size]);
+        NavPlan_HeapSift(heap, i);
     }
+}
 
-    int numberOfObjects = NumOnScreenBlocks;
-    DISPLAYBLOCK* nearestObjectPtr = NULL;
-    int nearestMagnitude = ACTIVATION_X_RANGE * ACTIVATION_X_RANGE + ACTIVATION_Y_RANGE * ACTIVATION_Y_RANGE;
-    AVP_BEHAVIOUR_TYPE nearestBehaviour = I_BehaviourNull;
+static int NavPlan_HeapPop(NAVPLAN_HEAP* heap)
+{
+    int top = heap->nodes[0];
+    NavPlan_HeapRemove(heap, top);
+    return top;
+}
 
-    while (numberOfObjects) {
-        DISPLAYBLOCK* objectPtr = OnScreenBlockList[--numberOfObjects];
-        if (!objectPtr) continue;
+extern "C" void AutoNav_ResetPlanner(void)
+{
+    free(g_NavPlanNodes);       g_NavPlanNodes = NULL;
+    free(g_NavPlanOutStart);    g_NavPlanOutStart = NULL;
+    free(g_NavPlanInStart);     g_NavPlanInStart = NULL;
+    free(g_NavPlanIn);          g_NavPlanIn = NULL;
+    free(g_NavPlanDoorSB);      g_NavPlanDoorSB = NULL;
+    free(g_NavPlanDoorModules); g_NavPlanDoorModules = NULL;
+    free(g_NavPlanBlockedUntil); g_NavPlanBlockedUntil = NULL;
+    free(g_NavPlanCost);        g_NavPlanCost = NULL;
+    free(g_NavPlanParent);      g_NavPlanParent = NULL;
+    free(g_NavPlanStamp);       g_NavPlanStamp = NULL;
+    NavPlan_HeapFree(&g_NavPlanOpen);
+    NavField_Free();
+    PathDist_Free();
+    NavMeshSteer_Free();
+    RayCache_Flush();  /* Cached hits point at this level's display blocks */
+
+    g_NavPlanNodeCount = 0;
+    g_NavPlanDoorCount = 0;
+    g_NavPlanBuilt = 0;
+    memset(g_NavPlanCache, 0, sizeof(g_NavPlanCache));
+}
 
-        /* Does object have a strategy block? */
-        if (objectPtr->ObStrategyBlock) {
-            AVP_BEHAVIOUR_TYPE behaviour = objectPtr->ObStrategyBlock->I_SBtype;
+static int NavPlan_Distance(const VECTORCH* a, const VECTORCH* b)
+{
+    double dx = (double)a->vx - b->vx;
+    double dy = (double)a->vy - b->vy;
+    double dz = (double)a->vz - b->vz;
+    return (int)sqrt(dx * dx + dy * dy + dz * dz);
+}
 
-            /* Is it operable? */
-            if (IsOperableObject(behaviour)) {
-                /* Is it in range? */
-                if (objectPtr->ObView.vz > 0 && objectPtr->ObView.vz < ACTIVATION_Z_RANGE) {
-                    int absX = objectPtr->ObView.vx;
-                    int absY = objectPtr->ObView.vy;
+/* The door the AI treats this module as (see AIModuleIsADoor), if any */
+static STRATEGYBLOCK* NavPlan_FindDoorSB(AIMODULE* module)
+{
+    if (!module->m_module_ptrs || AIModuleIsADoor(module) == MDT_NotADoor) return NULL;
 
-                    if (absX < 0) absX = -absX;
-                    if (absY < 0) absY = -absY;
+    for (MODULE** render = module->m_module_ptrs; *render; render++) {
+        if (ModuleIsADoor(*render) != MDT_NotADoor) return (*render)->m_sbptr;
+    }
+    return NULL;
+}
 
-                    if (absX < ACTIVATION_X_RANGE && absY < ACTIVATION_Y_RANGE) {
-                        int magnitude = (absX * absX + absY * absY);
+/* Flatten entry points and adjacency for the current level */
+static int NavPlan_Build(void)
+{
+    int numModules = AIModuleArraySize;
+    int numOut = 0;
 
-                        if (nearestMagnitude > magnitude) {
-                            nearestMagnitude = magnitude;
-                            nearestObjectPtr = objectPtr;
-                            nearestBehaviour = behaviour;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    if (g_NavPlanBuilt) return g_NavPlanNodeCount > 0;
+    g_NavPlanBuilt = 1;
 
-    /* Check if we found something */
-    if (nearestObjectPtr) {
-        /* Verify line of sight */
-        if (IsThisObjectVisibleFromThisPosition_WithIgnore(Player, nearestObjectPtr,
-                &nearestObjectPtr->ObWorld, 10000)) {
-            const char* typeName = GetInteractiveTypeName(nearestBehaviour);
+    if (!AIModuleArray || numModules <= 0 || !FALLP_EntryPoints) return 0;
 
-            /* Only announce if this is a new interactive or type changed, AND priority allows */
-            if ((!g_LastInteractiveNearby || strcmp(typeName, g_LastInteractiveType) != 0) &&
-                Announcement_IsAllowed(ANNOUNCE_PRIORITY_HIGH)) {
-                char announcement[128];
-                snprintf(announcement, sizeof(announcement), "%s nearby. Press SPACE to interact.", typeName);
-                TTS_Speak(announcement);
-                Announcement_RecordTime(ANNOUNCE_PRIORITY_HIGH);
+    g_NavPlanOutStart = (int*)malloc((numModules + 1) * sizeof(int));
+    g_NavPlanDoorSB = (STRATEGYBLOCK**)calloc(numModules, sizeof(STRATEGYBLOCK*));
+    g_NavPlanDoorModules = (int*)malloc(numModules * sizeof(int));
+    if (!g_NavPlanOutStart || !g_NavPlanDoorSB || !g_NavPlanDoorModules) goto fail;
 
-                strncpy(g_LastInteractiveType, typeName, sizeof(g_LastInteractiveType) - 1);
-                g_LastInteractiveType[sizeof(g_LastInteractiveType) - 1] = '\0';
-            }
-            g_LastInteractiveNearby = 1;
-            return;
+    /* Count portals: one per (module, adjacent module) pair that has an entry point */
+    for (int m = 0; m < numModules; m++) {
+        g_NavPlanOutStart[m] = numOut;
+        for (AIMODULE** link = AIModuleArray[m].m_link_ptrs; link && *link; link++) {
+            if (GetAIModuleEP(*link, &AIModuleArray[m])) numOut++;
+        }
+        if (AIModuleArray[m].m_module_ptrs) {
+            g_NavPlanDoorSB[m] = NavPlan_FindDoorSB(&AIModuleArray[m]);
+            if (g_NavPlanDoorSB[m]) g_NavPlanDoorModules[g_NavPlanDoorCount++] = m;
+        }
+    }
+    g_NavPlanOutStart[numModules] = numOut;
+    if (numOut == 0) goto fail;
+
+    /* Each portal is its own search node, numbered in module order */
+    g_NavPlanNodeCount = numOut;
+    g_NavPlanNodes = (NAVPLAN_NODE*)malloc(numOut * sizeof(NAVPLAN_NODE));
+    g_NavPlanBlockedUntil = (unsigned int*)calloc(numOut, sizeof(unsigned int));
+    g_NavPlanCost = (int*)malloc(numOut * sizeof(int));
+    g_NavPlanParent = (int*)malloc(numOut * sizeof(int));
+    g_NavPlanStamp = (unsigned int*)calloc(numOut, sizeof(unsigned int));
+    g_NavPlanInStart = (int*)calloc(numModules + 1, sizeof(int));
+    g_NavPlanIn = (int*)malloc(numOut * sizeof(int));
+    if (!g_NavPlanNodes || !g_NavPlanBlockedUntil || !g_NavPlanCost || !g_NavPlanParent ||
+        !g_NavPlanStamp || !g_NavPlanInStart || !g_NavPlanIn || !NavPlan_HeapAlloc(&g_NavPlanOpen, numOut)) {
+        goto fail;
+    }
+
+    for (int m = 0, node = 0; m < numModules; m++) {
+        for (AIMODULE** link = AIModuleArray[m].m_link_ptrs; link && *link; link++) {
+            FARENTRYPOINT* ep = GetAIModuleEP(*link, &AIModuleArray[m]);
+            if (!ep) continue;
+
+            /* Entry point positions are relative to the module they lead into */
+            g_NavPlanNodes[node].module = (*link)->m_index;
+            g_NavPlanNodes[node].from = m;
+            g_NavPlanNodes[node].position.vx = ep->position.vx + (*link)->m_world.vx;
+            g_NavPlanNodes[node].position.vy = ep->position.vy + (*link)->m_world.vy;
+            g_NavPlanNodes[node].position.vz = ep->position.vz + (*link)->m_world.vz;
+            g_NavPlanNodes[node].alienOnly = ep->alien_only;
+            g_NavPlanInStart[(*link)->m_index + 1]++;
+            node++;
         }
     }
 
-    /* No interactive nearby - reset state */
-    if (g_LastInteractiveNearby) {
-        g_LastInteractiveNearby = 0;
-        g_LastInteractiveType[0] = '\0';
+    /* Reverse adjacency: portals grouped by the module they enter */
+    for (int m = 0; m < numModules; m++) {
+        g_NavPlanInStart[m + 1] += g_NavPlanInStart[m];
+    }
+    {
+        int* fill = (int*)malloc(numModules * sizeof(int));
+        if (!fill) goto fail;
+        memcpy(fill, g_NavPlanInStart, numModules * sizeof(int));
+        for (int node = 0; node < numOut; node++) {
+            g_NavPlanIn[fill[g_NavPlanNodes[node].module]++] = node;
+        }
+        free(fill);
     }
-}
 
-/* ============================================
- * Weapon State Tracking
- * ============================================ */
+    g_NavPlanSearch = 0;
+    LOG_INF("NavPlan: graph built, %d modules, %d portals, %d doors",
+            numModules, g_NavPlanNodeCount, g_NavPlanDoorCount);
+    return 1;
 
-/* Get weapon name from weapon ID */
-static const char* GetWeaponNameFromID(int weaponID, I_PLAYER_TYPE playerType)
+fail:
+    LOG_WRN("NavPlan: no module graph available");
+    AutoNav_ResetPlanner();
+    g_NavPlanBuilt = 1;     /* Don't retry every frame */
+    return 0;
+}
+
+/* Summary of everything that affects edge costs */
+static unsigned int NavPlan_Signature(void)
 {
-    switch (playerType) {
-        case I_Marine:
-            switch (weaponID) {
-                case WEAPON_PULSERIFLE: return "Pulse Rifle";
-                case WEAPON_AUTOSHOTGUN: return "Shotgun";
-                case WEAPON_SMARTGUN: return "Smartgun";
-                case WEAPON_FLAMETHROWER: return "Flamethrower";
-                case WEAPON_PLASMAGUN: return "Plasma Gun";
-                case WEAPON_SADAR: return "SADAR Rocket Launcher";
-                case WEAPON_GRENADELAUNCHER: return "Grenade Launcher";
-                case WEAPON_MINIGUN: return "Minigun";
-                case WEAPON_MARINE_PISTOL: return "Pistol";
-                case WEAPON_TWO_PISTOLS: return "Dual Pistols";
-                case WEAPON_CUDGEL: return "Cudgel";
-                default: return "Unknown Weapon";
-            }
-        case I_Predator:
-            switch (weaponID) {
-                case WEAPON_PRED_WRISTBLADE: return "Wristblades";
-                case WEAPON_PRED_PISTOL: return "Speargun";
-                case WEAPON_PRED_RIFLE: return "Speargun Rifle";
-                case WEAPON_PRED_SHOULDERCANNON: return "Plasma Caster";
-                case WEAPON_PRED_DISC: return "Smart Disc";
-                case WEAPON_PRED_MEDICOMP: return "Medicomp";
-                case WEAPON_PRED_STAFF: return "Combi-Stick";
-                default: return "Unknown Weapon";
-            }
-        case I_Alien:
-            switch (weaponID) {
-                case WEAPON_ALIEN_CLAW: return "Claws";
-                case WEAPON_ALIEN_GRAB: return "Grab Attack";
-                case WEAPON_ALIEN_SPIT: return "Acid Spit";
-                default: return "Claws";
-            }
-        default:
-            return "Unknown";
+    unsigned int sig = g_NavPlanPenaltyEpoch * 2654435761u;
+    for (int i = 0; i < g_NavPlanDoorCount; i++) {
+        if (GetState(g_NavPlanDoorSB[g_NavPlanDoorModules[i]])) {
+            sig = (sig ^ (unsigned int)(i + 1)) * 16777619u;
+        }
     }
+    return sig;
 }
 
-/* Track weapon state changes and announce */
-extern "C" void Accessibility_WeaponStateUpdate(void)
+/* Extra cost for entering a node's module, on top of distance */
+static int NavPlan_EdgeCost(int node, unsigned int now)
 {
-    if (!Accessibility_IsAvailable() || !AccessibilitySettings.state_announcements_enabled) {
-        return;
+    int cost = 0;
+    STRATEGYBLOCK* door = g_NavPlanDoorSB[g_NavPlanNodes[node].module];
+
+    if (door) {
+        if (door->I_SBtype == I_BehaviourProximityDoor || GetState(door)) {
+            cost += NAVPLAN_DOOR_COST;
+        } else if (door->I_SBtype == I_BehaviourLiftDoor) {
+            cost += NAVPLAN_LIFT_COST;
+        } else {
+            cost += NAVPLAN_LOCKED_DOOR_COST;
+        }
     }
+    if ((int)(g_NavPlanBlockedUntil[node] - now) > 0) {
+        cost += NAVPLAN_BLOCKED_COST;
+    }
+    return cost;
+}
 
-    if (!Player || !Player->ObStrategyBlock) return;
+/* Relax one portal, reached from fromPos with fromCost spent so far */
+static void NavPlan_Relax(int node, int parent, int fromCost, const VECTORCH* fromPos,
+                          const VECTORCH* goal, int alienPlayer, unsigned int now)
+{
+    int seen = (g_NavPlanStamp[node] == g_NavPlanSearch);
+    int cost;
 
-    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-    if (!ps) return;
+    if (g_NavPlanNodes[node].alienOnly && !alienPlayer) return;
+    if (seen && g_NavPlanOpen.pos[node] < 0) return;    /* Closed */
 
-    int currentSlot = (int)ps->SelectedWeaponSlot;
-    if (currentSlot < 0 || currentSlot >= MAX_NO_OF_WEAPON_SLOTS) return;
+    cost = fromCost + NavPlan_Distance(fromPos, &g_NavPlanNodes[node].position) + NavPlan_EdgeCost(node, now);
+    if (seen && cost >= g_NavPlanCost[node]) return;
 
-    PLAYER_WEAPON_DATA* weaponPtr = &ps->WeaponSlot[currentSlot];
-    if (!weaponPtr) return;
+    g_NavPlanStamp[node] = g_NavPlanSearch;
+    g_NavPlanCost[node] = cost;
+    g_NavPlanParent[node] = parent;
+    NavPlan_HeapUpdate(&g_NavPlanOpen, node, cost + NavPlan_Distance(&g_NavPlanNodes[node].position, goal));
+}
 
-    int weaponID = weaponPtr->WeaponIDNumber;
-    int weaponState = weaponPtr->CurrentState;
-    int primaryRounds = weaponPtr->PrimaryRoundsRemaining >> 16;
-    int secondaryRounds = weaponPtr->SecondaryRoundsRemaining >> 16;
+static void NavPlan_Search(NAVPLAN_ROUTE* route, const VECTORCH* from, const VECTORCH* goal)
+{
+    int alienPlayer = (AvP.PlayerType == I_Alien);
+    unsigned int now = GetTickCount();
+    int found = -1;
 
-    /* Check for weapon switch */
-    if (g_LastWeaponSlot != currentSlot && g_LastWeaponSlot >= 0) {
-        const char* weaponName = GetWeaponNameFromID(weaponID, AvP.PlayerType);
-        char announcement[128];
+    route->length = -1;
 
-        /* Include ammo info for Marines and Predators */
-        if (AvP.PlayerType != I_Alien && primaryRounds >= 0) {
-            snprintf(announcement, sizeof(announcement), "%s. %d rounds.", weaponName, primaryRounds);
-        } else {
-            snprintf(announcement, sizeof(announcement), "%s.", weaponName);
+    g_NavPlanSearch++;
+    if (g_NavPlanSearch == 0) {
+        memset(g_NavPlanStamp, 0, g_NavPlanNodeCount * sizeof(unsigned int));
+        g_NavPlanSearch = 1;
+    }
+    while (g_NavPlanOpen.size > 0) NavPlan_HeapPop(&g_NavPlanOpen);
+
+    /* Seed with the portals out of the player's module */
+    for (int i = g_NavPlanOutStart[route->src]; i < g_NavPlanOutStart[route->src + 1]; i++) {
+        NavPlan_Relax(i, -1, 0, from, goal, alienPlayer, now);
+    }
+
+    while (g_NavPlanOpen.size > 0) {
+        int node = NavPlan_HeapPop(&g_NavPlanOpen);
+        int module = g_NavPlanNodes[node].module;
+
+        /* The heuristic is straight-line distance and every leg costs at least
+         * that, so the first portal into the target module to leave the heap
+         * is on the cheapest route */
+        if (module == route->dst) {
+            found = node;
+            break;
         }
-        TTS_Speak(announcement);
+
+        for (int i = g_NavPlanOutStart[module]; i < g_NavPlanOutStart[module + 1]; i++) {
+            NavPlan_Relax(i, node, g_NavPlanCost[node], &g_NavPlanNodes[node].position,
+                          goal, alienPlayer, now);
+        }
+    }
+
+    if (found < 0) return;
+
+    /* Walk back to the start; keep the first NAVPLAN_MAX_ROUTE portals */
+    int count = 0;
+    for (int node = found; node >= 0; node = g_NavPlanParent[node]) count++;
+
+    int total = g_NavPlanCost[found] + NavPlan_Distance(&g_NavPlanNodes[found].position, goal);
+    int index = count - 1;
+    for (int node = found; node >= 0; node = g_NavPlanParent[node], index--) {
+        if (index >= NAVPLAN_MAX_ROUTE) continue;
+        route->waypoints[index].module = g_NavPlanNodes[node].module;
+        route->waypoints[index].position = g_NavPlanNodes[node].position;
+        route->waypoints[index].remaining = total - g_NavPlanCost[node];
     }
+    route->length = (count < NAVPLAN_MAX_ROUTE) ? count : NAVPLAN_MAX_ROUTE;
+}
+
+/* Cached route from module src (player at from) to module dst (goal position) */
+static const NAVPLAN_ROUTE* NavPlan_GetRoute(int src, const VECTORCH* from, int dst, const VECTORCH* goal)
+{
+    NAVPLAN_ROUTE* route = NULL;
+    unsigned int signature;
+
+    if (!NavPlan_Build()) return NULL;
+    if (src < 0 || src >= AIModuleArraySize || dst < 0 || dst >= AIModuleArraySize) return NULL;
 
-    /* Check for reload start */
-    if (g_LastWeaponState != WEAPONSTATE_RELOAD_PRIMARY &&
-        weaponState == WEAPONSTATE_RELOAD_PRIMARY) {
-        TTS_SpeakQueued("Reloading.");
+    signature = NavPlan_Signature();
+    g_NavPlanUseCounter++;
+
+    for (int i = 0; i < NAVPLAN_CACHE_SIZE; i++) {
+        NAVPLAN_ROUTE* entry = &g_NavPlanCache[i];
+        if (entry->lastUsed && entry->src == src && entry->dst == dst) {
+            if (entry->signature == signature) {
+                entry->lastUsed = g_NavPlanUseCounter;
+                return entry;
+            }
+            route = entry;  /* Stale: replan in place */
+            break;
+        }
     }
 
-    /* Check for out of ammo (when trying to fire with no ammo) */
-    if (g_LastPrimaryRounds > 0 && primaryRounds == 0 &&
-        weaponState != WEAPONSTATE_RELOAD_PRIMARY) {
-        if (AvP.PlayerType != I_Alien) {
-            TTS_SpeakPriority("Out of ammo!");
+    if (!route) {
+        route = &g_NavPlanCache[0];
+        for (int i = 1; i < NAVPLAN_CACHE_SIZE; i++) {
+            if (g_NavPlanCache[i].lastUsed < route->lastUsed) route = &g_NavPlanCache[i];
         }
     }
 
-    /* Check for weapon jammed */
-    if (g_LastWeaponState != WEAPONSTATE_JAMMED &&
-        weaponState == WEAPONSTATE_JAMMED) {
-        TTS_SpeakPriority("Weapon jammed!");
+    route->src = src;
+    route->dst = dst;
+    route->signature = signature;
+    route->lastUsed = g_NavPlanUseCounter;
+
+    if (src == dst) {
+        route->length = 0;
+    } else {
+        NavPlan_Search(route, from, goal);
     }
 
-    /* Update tracking variables */
-    g_LastWeaponSlot = currentSlot;
-    g_LastWeaponState = weaponState;
-    g_LastPrimaryRounds = primaryRounds;
-    g_LastSecondaryRounds = secondaryRounds;
+    LOG_DBG("NavPlan: route %d -> %d: %d portals", src, dst, route->length);
+    return route;
+}
+
+/* Penalise a portal the player could not get through */
+static void NavPlan_BlockPortal(int module, int fromModule)
+{
+    if (!g_NavPlanNodes || fromModule < 0 || fromModule >= AIModuleArraySize) return;
+
+    for (int i = g_NavPlanOutStart[fromModule]; i < g_NavPlanOutStart[fromModule + 1]; i++) {
+        if (g_NavPlanNodes[i].module == module) {
+            g_NavPlanBlockedUntil[i] = GetTickCount() + NAVPLAN_BLOCKED_MS;
+            g_NavPlanPenaltyEpoch++;
+            NavField_PortalPenalised(i);
+            LOG_INF("NavPlan: portal %d -> %d penalised", fromModule, module);
+            return;
+        }
+    }
 }
 
 /* ============================================
- * Comprehensive Status Announcement (F12)
+ * Navigation Flow Field
  * ============================================ */
 
-extern "C" void Accessibility_AnnounceFullStatus(void)
+/*
+ * Cost-to-target for every portal node, maintained incrementally
+ * (LPA*-style, without a heuristic): each node keeps its settled cost g
+ * and a one-step lookahead rhs. A door changing state, a penalised portal
+ * or the target moving only makes the nodes they touch inconsistent, and
+ * only that frontier is re-expanded, a bounded number of steps per frame.
+ *
+ * As with PlayerPheromoneSystem, readers only see the read buffer. Work
+ * goes into the write buffer and the two are swapped once the frontier is
+ * empty, so AutoNav never steers by a half-updated field. The exit to take
+ * is picked from the player's position among their module's portals, so
+ * the per-frame lookup is O(out-degree).
+ */
+#define NAVFIELD_INFINITY           0x3fffffff
+#define NAVFIELD_STEPS_PER_FRAME    256
+#define NAVFIELD_GOAL_SLOP          500     /* Target movement that re-seeds the goal */
+
+static int* g_NavField1 = NULL;
+static int* g_NavField2 = NULL;
+static int* g_NavField_ReadBuf = NULL;
+static int* g_NavField_WriteBuf = NULL;
+static int* g_NavFieldRhs = NULL;
+static unsigned char* g_NavFieldDirty = NULL;   /* Per node: g changed since the last swap */
+static int* g_NavFieldChanged = NULL;
+static int g_NavFieldChangedCount = 0;
+static int g_NavFieldFullPublish = 0;       /* Every node changed (new target) */
+static unsigned char* g_NavFieldDoorOpen = NULL;    /* Per door: state last seen */
+static NAVPLAN_HEAP g_NavFieldOpen;         /* Keyed on min(g, rhs) */
+static int g_NavFieldTarget = -1;           /* Module the write buffer is converging toward */
+static int g_NavFieldReadTarget = -1;       /* Module the read buffer is valid for */
+static VECTORCH g_NavFieldGoal;
+static int* g_NavFieldPenalised = NULL;     /* Penalised nodes awaiting expiry, each once */
+static int g_NavFieldPenaltyCount = 0;
+
+static void NavField_Free(void)
 {
-    if (!Accessibility_IsAvailable()) return;
+    free(g_NavField1);          g_NavField1 = NULL;
+    free(g_NavField2);          g_NavField2 = NULL;
+    free(g_NavFieldRhs);        g_NavFieldRhs = NULL;
+    free(g_NavFieldPenalised);  g_NavFieldPenalised = NULL;
+    free(g_NavFieldDirty);      g_NavFieldDirty = NULL;
+    free(g_NavFieldChanged);    g_NavFieldChanged = NULL;
+    free(g_NavFieldDoorOpen);   g_NavFieldDoorOpen = NULL;
+    NavPlan_HeapFree(&g_NavFieldOpen);
+
+    g_NavField_ReadBuf = g_NavField_WriteBuf = NULL;
+    g_NavFieldChangedCount = 0;
+    g_NavFieldPenaltyCount = 0;
+    g_NavFieldTarget = g_NavFieldReadTarget = -1;
+}
 
-    if (!Player || !Player->ObStrategyBlock) {
-        TTS_Speak("Status unavailable.");
-        return;
+static int NavField_Alloc(void)
+{
+    int nodes = g_NavPlanNodeCount;
+
+    if (g_NavField1) return 1;
+
+    g_NavField1 = (int*)malloc(nodes * sizeof(int));
+    g_NavField2 = (int*)malloc(nodes * sizeof(int));
+    g_NavFieldRhs = (int*)malloc(nodes * sizeof(int));
+    g_NavFieldPenalised = (int*)malloc(nodes * sizeof(int));
+    g_NavFieldDirty = (unsigned char*)calloc(nodes, 1);
+    g_NavFieldChanged = (int*)malloc(nodes * sizeof(int));
+    g_NavFieldDoorOpen = (unsigned char*)calloc(g_NavPlanDoorCount + 1, 1);
+    if (!g_NavField1 || !g_NavField2 || !g_NavFieldRhs || !g_NavFieldPenalised || !g_NavFieldDirty ||
+        !g_NavFieldChanged || !g_NavFieldDoorOpen || !NavPlan_HeapAlloc(&g_NavFieldOpen, nodes)) {
+        NavField_Free();
+        return 0;
     }
 
-    PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
-    if (!ps) return;
-
-    char announcement[512];
-    int health = (ps->Health >> 16);
-    int armor = (ps->Armour >> 16);
+    g_NavField_ReadBuf = g_NavField1;
+    g_NavField_WriteBuf = g_NavField2;
+    for (int i = 0; i < g_NavPlanDoorCount; i++) {
+        g_NavFieldDoorOpen[i] = GetState(g_NavPlanDoorSB[g_NavPlanDoorModules[i]]) ? 1 : 0;
+    }
+    return 1;
+}
 
-    int currentSlot = (int)ps->SelectedWeaponSlot;
-    const char* weaponName = "Unknown";
-    int ammo = 0;
-    int magazines = 0;
+/* rhs: cost from this portal via its best successor, using the write buffer */
+static int NavField_Lookahead(int node, unsigned int now)
+{
+    const NAVPLAN_NODE* n = &g_NavPlanNodes[node];
+    int best = NAVFIELD_INFINITY;
 
-    if (currentSlot >= 0 && currentSlot < MAX_NO_OF_WEAPON_SLOTS) {
-        PLAYER_WEAPON_DATA* weaponPtr = &ps->WeaponSlot[currentSlot];
-        weaponName = GetWeaponNameFromID(weaponPtr->WeaponIDNumber, AvP.PlayerType);
-        ammo = weaponPtr->PrimaryRoundsRemaining >> 16;
-        magazines = weaponPtr->PrimaryMagazinesRemaining;
-    }
+    if (n->alienOnly && AvP.PlayerType != I_Alien) return NAVFIELD_INFINITY;
 
-    if (AvP.PlayerType == I_Alien) {
-        snprintf(announcement, sizeof(announcement),
-            "Status: Health %d percent. Weapon: %s.",
-            health, weaponName);
+    if (n->module == g_NavFieldTarget) {
+        best = NavPlan_Distance(&n->position, &g_NavFieldGoal);
     } else {
-        snprintf(announcement, sizeof(announcement),
-            "Status: Health %d percent. Armor %d percent. Weapon: %s. Ammo: %d rounds, %d magazines.",
-            health, armor, weaponName, ammo, magazines);
+        for (int q = g_NavPlanOutStart[n->module]; q < g_NavPlanOutStart[n->module + 1]; q++) {
+            if (g_NavField_WriteBuf[q] >= NAVFIELD_INFINITY) continue;
+            int cost = NavPlan_Distance(&n->position, &g_NavPlanNodes[q].position) + g_NavField_WriteBuf[q];
+            if (cost < best) best = cost;
+        }
+        if (best >= NAVFIELD_INFINITY) return NAVFIELD_INFINITY;
     }
 
-    TTS_Speak(announcement);
+    best += NavPlan_EdgeCost(node, now);
+    return (best < NAVFIELD_INFINITY) ? best : NAVFIELD_INFINITY;
 }
 
-/* ============================================
- * Auto-Navigation System Implementation
- * ============================================ */
-
-/* Global autonavigation state */
-AUTONAV_STATE AutoNavState = {
-    0,      /* enabled */
-    0,      /* auto_rotate */
-    0,      /* auto_move */
-    NAV_TARGET_INTERACTIVE,  /* default target type */
-    0, 0, 0,  /* target position */
-    0,      /* target_distance */
-    NULL    /* target_name */
-};
+/* Recompute rhs and (de)queue the node depending on whether it is consistent */
+static void NavField_UpdateNode(int node, unsigned int now)
+{
+    int g;
 
-/* Navigation tone system */
-#define NAV_TONE_SAMPLE_RATE 44100
-#define NAV_TONE_DURATION_MS 80
-#define NAV_TONE_SAMPLES (NAV_TONE_SAMPLE_RATE * NAV_TONE_DURATION_MS / 1000)
-#define NAV_BASE_FREQUENCY 660.0f  /* E5 note - distinct from radar */
+    g_NavFieldRhs[node] = NavField_Lookahead(node, now);
+    g = g_NavField_WriteBuf[node];
+    if (g != g_NavFieldRhs[node]) {
+        NavPlan_HeapUpdate(&g_NavFieldOpen, node, (g < g_NavFieldRhs[node]) ? g : g_NavFieldRhs[node]);
+    } else {
+        NavPlan_HeapRemove(&g_NavFieldOpen, node);
+    }
+}
 
-static ALuint g_NavToneBuffer = 0;
-static ALuint g_NavToneSource = 0;
-static int g_NavToneInitialized = 0;
-static int g_NavToneFrameCounter = 0;
+/* Every portal into a module depends on the portals out of it */
+static void NavField_UpdateEntries(int module, unsigned int now)
+{
+    for (int i = g_NavPlanInStart[module]; i < g_NavPlanInStart[module + 1]; i++) {
+        NavField_UpdateNode(g_NavPlanIn[i], now);
+    }
+}
 
-/* Generate navigation guidance tone buffer */
-static int NavTone_GenerateBuffer(void)
+static void NavField_SetCost(int node, int g)
 {
-    if (g_NavToneBuffer != 0) {
-        return 1;
+    g_NavField_WriteBuf[node] = g;
+    if (!g_NavFieldDirty[node]) {
+        g_NavFieldDirty[node] = 1;
+        g_NavFieldChanged[g_NavFieldChangedCount++] = node;
     }
+}
 
-    short* samples = (short*)malloc(NAV_TONE_SAMPLES * sizeof(short));
-    if (!samples) return 0;
+/* Start converging on a new target module from scratch */
+static void NavField_Reset(int dst, const VECTORCH* goal, unsigned int now)
+{
+    while (g_NavFieldOpen.size > 0) NavPlan_HeapPop(&g_NavFieldOpen);
+    for (int i = 0; i < g_NavPlanNodeCount; i++) {
+        g_NavField_WriteBuf[i] = NAVFIELD_INFINITY;
+        g_NavFieldRhs[i] = NAVFIELD_INFINITY;
+        g_NavFieldDirty[i] = 0;
+    }
+    g_NavFieldChangedCount = 0;
+    g_NavFieldFullPublish = 1;
+    g_NavFieldTarget = dst;
+    g_NavFieldGoal = *goal;
+
+    NavField_UpdateEntries(dst, now);
+}
 
-    /* Generate a pleasant sine wave with quick attack/decay */
-    for (int i = 0; i < NAV_TONE_SAMPLES; i++) {
-        float t = (float)i / NAV_TONE_SAMPLE_RATE;
-        float phase = 2.0f * 3.14159265f * NAV_BASE_FREQUENCY * t;
-        float sample = sinf(phase);
+/* Frontier is empty: make the write buffer the one AutoNav reads */
+static void NavField_Publish(void)
+{
+    int* temp = g_NavField_ReadBuf;
+    g_NavField_ReadBuf = g_NavField_WriteBuf;
+    g_NavField_WriteBuf = temp;
+    g_NavFieldReadTarget = g_NavFieldTarget;
 
-        /* Quick envelope */
-        float envelope = 1.0f;
-        float fadeLen = NAV_TONE_SAMPLES * 0.1f;
-        if (i < (int)fadeLen) {
-            envelope = (float)i / fadeLen;
-        } else if (i > NAV_TONE_SAMPLES - (int)fadeLen) {
-            envelope = (float)(NAV_TONE_SAMPLES - i) / fadeLen;
+    if (g_NavFieldFullPublish) {
+        memcpy(g_NavField_WriteBuf, g_NavField_ReadBuf, g_NavPlanNodeCount * sizeof(int));
+    } else {
+        /* Bring the new write buffer up to date */
+        for (int i = 0; i < g_NavFieldChangedCount; i++) {
+            g_NavField_WriteBuf[g_NavFieldChanged[i]] = g_NavField_ReadBuf[g_NavFieldChanged[i]];
         }
+    }
 
-        samples[i] = (short)(sample * envelope * 20000.0f);
+    for (int i = 0; i < g_NavFieldChangedCount; i++) g_NavFieldDirty[g_NavFieldChanged[i]] = 0;
+    LOG_DBG("NavField: published for module %d (%d portals changed%s)", g_NavFieldReadTarget,
+            g_NavFieldChangedCount, g_NavFieldFullPublish ? ", full" : "");
+    g_NavFieldChangedCount = 0;
+    g_NavFieldFullPublish = 0;
+}
+
+/* Advance the field toward target module dst; call once per frame */
+static void NavField_Update(int dst, const VECTORCH* goal)
+{
+    unsigned int now = GetTickCount();
+
+    if (!NavPlan_Build() || !NavField_Alloc()) return;
+
+    if (dst != g_NavFieldTarget) {
+        NavField_Reset(dst, goal, now);
+    } else if (abs(goal->vx - g_NavFieldGoal.vx) + abs(goal->vy - g_NavFieldGoal.vy) +
+               abs(goal->vz - g_NavFieldGoal.vz) > NAVFIELD_GOAL_SLOP) {
+        g_NavFieldGoal = *goal;
+        NavField_UpdateEntries(dst, now);
     }
 
-    alGenBuffers(1, &g_NavToneBuffer);
-    if (alGetError() != AL_NO_ERROR) {
-        free(samples);
-        return 0;
+    /* Doors opening or closing change the cost of entering their module */
+    for (int i = 0; i < g_NavPlanDoorCount; i++) {
+        int module = g_NavPlanDoorModules[i];
+        unsigned char open = GetState(g_NavPlanDoorSB[module]) ? 1 : 0;
+        if (open != g_NavFieldDoorOpen[i]) {
+            g_NavFieldDoorOpen[i] = open;
+            NavField_UpdateEntries(module, now);
+        }
     }
 
-    alBufferData(g_NavToneBuffer, AL_FORMAT_MONO16, samples,
-                 NAV_TONE_SAMPLES * sizeof(short), NAV_TONE_SAMPLE_RATE);
+    /* Expired portal penalties */
+    for (int i = g_NavFieldPenaltyCount - 1; i >= 0; i--) {
+        int node = g_NavFieldPenalised[i];
+        if ((int)(g_NavPlanBlockedUntil[node] - now) <= 0) {
+            g_NavFieldPenalised[i] = g_NavFieldPenalised[--g_NavFieldPenaltyCount];
+            NavField_UpdateNode(node, now);
+        }
+    }
 
-    free(samples);
+    for (int steps = 0; steps < NAVFIELD_STEPS_PER_FRAME && g_NavFieldOpen.size > 0; steps++) {
+        int node = NavPlan_HeapPop(&g_NavFieldOpen);
+        int module = g_NavPlanNodes[node].from;
 
-    if (alGetError() != AL_NO_ERROR) {
-        alDeleteBuffers(1, &g_NavToneBuffer);
-        g_NavToneBuffer = 0;
-        return 0;
+        if (g_NavField_WriteBuf[node] > g_NavFieldRhs[node]) {
+            /* Cost went down: settle it */
+            NavField_SetCost(node, g_NavFieldRhs[node]);
+        } else {
+            /* Cost went up: forget it and let it be re-derived */
+            NavField_SetCost(node, NAVFIELD_INFINITY);
+            NavField_UpdateNode(node, now);
+        }
+        NavField_UpdateEntries(module, now);
     }
 
-    return 1;
+    if (g_NavFieldOpen.size == 0 && (g_NavFieldChangedCount > 0 || g_NavFieldFullPublish)) {
+        NavField_Publish();
+    }
 }
 
-static int NavTone_Init(void)
+/* Best portal out of module toward dst for someone standing at from, costed
+ * as the A* seeding does: -1 = none needed or none exists, -2 = field not
+ * yet converged for dst */
+static int NavField_NextPortal(int module, const VECTORCH* from, int dst)
 {
-    if (g_NavToneInitialized) {
-        return 1;
+    int best = -1, bestCost = NAVFIELD_INFINITY;
+
+    if (g_NavFieldReadTarget != dst || g_NavFieldReadTarget < 0) return -2;
+    if (module == dst) return -1;
+
+    for (int q = g_NavPlanOutStart[module]; q < g_NavPlanOutStart[module + 1]; q++) {
+        if (g_NavField_ReadBuf[q] >= NAVFIELD_INFINITY) continue;
+        int cost = NavPlan_Distance(from, &g_NavPlanNodes[q].position) + g_NavField_ReadBuf[q];
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = q;
+        }
     }
+    return best;
+}
 
-    if (!NavTone_GenerateBuffer()) {
-        return 0;
+/* Feed a new portal penalty into the field. The table has room for every
+ * node, so each penalty stays tracked until it expires. */
+static void NavField_PortalPenalised(int node)
+{
+    if (!g_NavField1 || g_NavFieldTarget < 0) return;
+
+    for (int i = 0; i < g_NavFieldPenaltyCount; i++) {
+        if (g_NavFieldPenalised[i] == node) {
+            NavField_UpdateNode(node, GetTickCount());
+            return;
+        }
     }
+    g_NavFieldPenalised[g_NavFieldPenaltyCount++] = node;
+    NavField_UpdateNode(node, GetTickCount());
+}
 
-    alGenSources(1, &g_NavToneSource);
-    if (alGetError() != AL_NO_ERROR) {
+/* ============================================
+ * Walking Distance Field
+ * ============================================ */
+
+/*
+ * How far every portal node is to walk from the player: a multi-source
+ * Dijkstra over the module graph, seeded with the straight-line distance
+ * from the player to each portal out of the player's module. A contact's
+ * walking distance is then the cheapest portal into its module plus the
+ * leg from there, so an alien behind a wall no longer sounds closer than
+ * one down the corridor.
+ *
+ * Costs are plain distance: doors and alien-only portals are not
+ * penalised, since what moves through them is usually the contact. The
+ * expansion is re-seeded when the player changes module (or wanders far
+ * within one) and runs a bounded number of steps per frame into a write
+ * buffer; readers keep the last finished field until the swap.
+ */
+#define PATHDIST_INFINITY           0x3fffffff
+#define PATHDIST_STEPS_PER_FRAME    512
+#define PATHDIST_RESEED_DIST        2000    /* Player movement within a module that re-seeds */
+
+static struct {
+    int* field1;
+    int* field2;
+    int* read;              /* Last finished field, valid for readModule */
+    int* write;             /* Field being expanded */
+    NAVPLAN_HEAP open;
+    int readModule;         /* Player module the read field was seeded from, -1 = none */
+    int module;             /* Player module the write field is seeded from */
+    VECTORCH origin;        /* Player position the write field is seeded from */
+    int pending;            /* Expansion still running */
+} g_PathDist = {NULL, NULL, NULL, NULL, {NULL, NULL, NULL, 0}, -1, -1, {0, 0, 0}, 0};
+
+static void PathDist_Free(void)
+{
+    free(g_PathDist.field1);    g_PathDist.field1 = NULL;
+    free(g_PathDist.field2);    g_PathDist.field2 = NULL;
+    NavPlan_HeapFree(&g_PathDist.open);
+
+    g_PathDist.read = g_PathDist.write = NULL;
+    g_PathDist.readModule = g_PathDist.module = -1;
+    g_PathDist.pending = 0;
+}
+
+static int PathDist_Alloc(void)
+{
+    int nodes = g_NavPlanNodeCount;
+
+    if (g_PathDist.field1) return 1;
+
+    g_PathDist.field1 = (int*)malloc(nodes * sizeof(int));
+    g_PathDist.field2 = (int*)malloc(nodes * sizeof(int));
+    if (!g_PathDist.field1 || !g_PathDist.field2 || !NavPlan_HeapAlloc(&g_PathDist.open, nodes)) {
+        PathDist_Free();
         return 0;
     }
 
-    alSourcei(g_NavToneSource, AL_BUFFER, g_NavToneBuffer);
-    alSourcef(g_NavToneSource, AL_GAIN, 0.5f);
-    alSourcei(g_NavToneSource, AL_SOURCE_RELATIVE, AL_FALSE);
-
-    g_NavToneInitialized = 1;
+    g_PathDist.read = g_PathDist.field1;
+    g_PathDist.write = g_PathDist.field2;
     return 1;
 }
 
-/* Play navigation tone with stereo panning and vertical pitch variation
- * angleOffset: -1.0 = hard left, 0 = center, 1.0 = hard right
- * verticalRatio: -1.0 = below, 0 = same level, 1.0 = above
- */
-static void NavTone_PlayDirectional(float angleOffset, float verticalRatio)
+/* Start a new expansion from the player's position in module */
+static void PathDist_Seed(int module, const VECTORCH* origin)
 {
-    if (!g_NavToneInitialized) {
-        if (!NavTone_Init()) return;
-    }
+    while (g_PathDist.open.size > 0) NavPlan_HeapPop(&g_PathDist.open);
+    for (int i = 0; i < g_NavPlanNodeCount; i++) g_PathDist.write[i] = PATHDIST_INFINITY;
 
-    /* Check if source is already playing - if so, let it finish (allows parallel sounds) */
-    ALint state;
-    alGetSourcei(g_NavToneSource, AL_SOURCE_STATE, &state);
-    if (state == AL_PLAYING) {
-        return;  /* Let current sound finish, don't interrupt */
+    for (int q = g_NavPlanOutStart[module]; q < g_NavPlanOutStart[module + 1]; q++) {
+        g_PathDist.write[q] = NavPlan_Distance(origin, &g_NavPlanNodes[q].position);
+        NavPlan_HeapUpdate(&g_PathDist.open, q, g_PathDist.write[q]);
     }
 
-    /* Use SOURCE_RELATIVE for consistent UI audio that doesn't interfere with game 3D sounds */
-    alSourcei(g_NavToneSource, AL_SOURCE_RELATIVE, AL_TRUE);
+    g_PathDist.module = module;
+    g_PathDist.origin = *origin;
+    g_PathDist.pending = 1;
+}
 
-    /* Map to 3D position for stereo panning */
-    float posX = angleOffset * 2.0f;
-    float posZ = -1.0f;  /* In front */
+/* Keep the field seeded from the player's module; runs every frame */
+static void PathDist_Update(void)
+{
+    if (!Player || !Player->ObStrategyBlock || !Player->ObStrategyBlock->DynPtr) return;
 
-    alSource3f(g_NavToneSource, AL_POSITION, posX, 0.0f, posZ);
+    STRATEGYBLOCK* playerSB = Player->ObStrategyBlock;
+    if (!playerSB->containingModule || !playerSB->containingModule->m_aimodule) return;
+    if (!NavPlan_Build() || !PathDist_Alloc()) return;
 
-    /* Calculate pitch based on both horizontal alignment AND vertical offset:
-     * - Base pitch 1.0
-     * - Higher when on target horizontally (+0.15 to +0.3)
-     * - Vertical variation: above = higher pitch, below = lower pitch (+/- 0.5)
-     */
-    float pitch = 1.0f;
+    int module = playerSB->containingModule->m_aimodule->m_index;
+    VECTORCH* position = &playerSB->DynPtr->Position;
 
-    /* Horizontal alignment bonus */
-    float absAngle = (angleOffset < 0) ? -angleOffset : angleOffset;
-    if (absAngle < 0.1f) {
-        pitch += 0.3f;  /* Higher pitch when on target */
-    } else if (absAngle < 0.3f) {
-        pitch += 0.15f;
+    /* A finished field is only re-seeded for movement; a module change restarts at once */
+    if (module != g_PathDist.module ||
+        (!g_PathDist.pending &&
+         NavPlan_Distance(position, &g_PathDist.origin) > PATHDIST_RESEED_DIST)) {
+        PathDist_Seed(module, position);
     }
+    if (!g_PathDist.pending) return;
 
-    /* Vertical variation: above = higher pitch, below = lower pitch */
-    pitch += verticalRatio * 0.5f;
-
-    /* Clamp pitch to reasonable range */
-    if (pitch < 0.5f) pitch = 0.5f;
-    if (pitch > 2.0f) pitch = 2.0f;
-
-    alSourcef(g_NavToneSource, AL_PITCH, pitch);
+    for (int steps = 0; steps < PATHDIST_STEPS_PER_FRAME && g_PathDist.open.size > 0; steps++) {
+        int node = NavPlan_HeapPop(&g_PathDist.open);
+        int entered = g_NavPlanNodes[node].module;
+        int cost = g_PathDist.write[node];
 
-    /* Set a moderate gain that won't overpower game sounds */
-    alSourcef(g_NavToneSource, AL_GAIN, 0.4f);
+        for (int q = g_NavPlanOutStart[entered]; q < g_NavPlanOutStart[entered + 1]; q++) {
+            int next = cost + NavPlan_Distance(&g_NavPlanNodes[node].position, &g_NavPlanNodes[q].position);
+            if (next < g_PathDist.write[q]) {
+                g_PathDist.write[q] = next;
+                NavPlan_HeapUpdate(&g_PathDist.open, q, next);
+            }
+        }
+    }
 
-    alSourceRewind(g_NavToneSource);
-    alSourcePlay(g_NavToneSource);
+    if (g_PathDist.open.size == 0) {
+        int* temp = g_PathDist.read;
+        g_PathDist.read = g_PathDist.write;
+        g_PathDist.write = temp;
+        g_PathDist.readModule = g_PathDist.module;
+        g_PathDist.pending = 0;
+    }
 }
 
-extern "C" void AutoNav_Init(void)
+/* Walking distance from the player to position in AI module `module`.
+ * straight is the straight-line distance, returned when the field cannot
+ * tell (no graph yet, same module); PATHDIST_INFINITY if no route exists. */
+static int PathDist_To(int module, const VECTORCH* position, int straight)
 {
-    AutoNavState.enabled = 0;
-    AutoNavState.auto_rotate = 0;
-    AutoNavState.auto_move = 0;
-    AutoNavState.target_type = NAV_TARGET_INTERACTIVE;
-    AutoNavState.target_x = 0;
-    AutoNavState.target_y = 0;
-    AutoNavState.target_z = 0;
-    AutoNavState.target_distance = 0;
-    AutoNavState.target_name = NULL;
-
-    /* Initialize position history */
-    AutoNavState.history_index = 0;
-    AutoNavState.history_count = 0;
-    memset(AutoNavState.position_history, 0, sizeof(AutoNavState.position_history));
+    int best = PATHDIST_INFINITY;
 
-    /* Initialize progress tracking */
-    AutoNavState.last_announced_distance = 0;
-    AutoNavState.closest_achieved = 999999;
-    AutoNavState.last_progress_time = 0;
+    if (!g_PathDist.read || g_PathDist.readModule < 0) return straight;
+    if (module < 0 || module >= AIModuleArraySize || module == g_PathDist.readModule) return straight;
 
-    /* Initialize strategy management */
-    AutoNavState.current_strategy = NAV_STRATEGY_DIRECT;
-    AutoNavState.strategy_frames = 0;
-    AutoNavState.strategy_failures = 0;
+    for (int i = g_NavPlanInStart[module]; i < g_NavPlanInStart[module + 1]; i++) {
+        int entry = g_NavPlanIn[i];
+        if (g_PathDist.read[entry] >= PATHDIST_INFINITY) continue;
+        int cost = g_PathDist.read[entry] + NavPlan_Distance(&g_NavPlanNodes[entry].position, position);
+        if (cost < best) best = cost;
+    }
 
-    /* Initialize door/lift tracking */
-    AutoNavState.door_wait.doorSB = NULL;
-    AutoNavState.door_wait.lastState = 0;
-    AutoNavState.door_wait.waitStartTime = 0;
-    AutoNavState.door_wait.announced = 0;
-    AutoNavState.lift_track.liftSB = NULL;
-    AutoNavState.lift_track.lastState = 0;
-    AutoNavState.lift_track.playerOnLift = 0;
-    AutoNavState.lift_track.rideStartTime = 0;
+    /* Never nearer than in a straight line, even just after the player moved */
+    return (best < straight) ? straight : best;
+}
 
-    /* Initialize arrival handling */
-    AutoNavState.arrival_announced = 0;
-    AutoNavState.target_reached = 0;
+static int PathDist_ToBlock(STRATEGYBLOCK* sb, int straight)
+{
+    if (!sb->DynPtr || !sb->containingModule || !sb->containingModule->m_aimodule) return straight;
+    return PathDist_To(sb->containingModule->m_aimodule->m_index, &sb->DynPtr->Position, straight);
 }
 
 /* ============================================
- * Spatial Awareness State
+ * Navigation Mesh Steering
  * ============================================ */
 
-SPATIAL_AWARENESS_STATE SpatialState = {0};
-
-/* ============================================
- * Pathfinding Helper Functions
- * ============================================ */
+/*
+ * The portal route and the target are otherwise steered for in a straight
+ * line. When the level has a navigation mesh (baked in pfarlocs.c), A*
+ * over its floor polygons finds the step, ledge or jump that really leads
+ * to the steer point; AutoNav heads for where that link leaves the
+ * player's polygon and jumps when the link is a jump.
+ */
+#define NAVMESH_SEARCH_LIMIT    4096    /* Polygons expanded per plan */
+#define NAVMESH_REPLAN_MS       1000
+#define NAVMESH_STEP_COST       200
+#define NAVMESH_DROP_COST       1500
+#define NAVMESH_JUMP_COST       3000
+#define NAVMESH_GOAL_MOVE       500     /* Steer point movement that needs a new goal polygon */
+#define NAVMESH_ARRIVE_DIST     400     /* At a link's exit: head on through it */
+#define NAVMESH_JUMP_DIST       1200    /* Jump when this close to a jump link */
+#define NAVMESH_ANNOUNCE_DIST   3000
+
+static struct {
+    int capacity;           /* Polygons the scratch below is sized for */
+    int* cost;
+    int* parent;            /* Polygon a polygon was reached from, -1 for the start */
+    int* parentLink;        /* Link it was reached by */
+    unsigned int* stamp;
+    unsigned int search;
+    NAVPLAN_HEAP open;
+
+    int startPoly, goalPoly;
+    VECTORCH goalPos;       /* Steer point goalPoly was looked up for */
+    int plannedLink;        /* First link of the last plan, -1 if none */
+    int link;               /* Link being headed for this frame, -1 if none */
+    int announcedLink;
+    unsigned int planTime;
+} g_NavMeshSteer = {0, NULL, NULL, NULL, NULL, 0, {NULL, NULL, NULL, 0}, -1, -1, {0, 0, 0}, -1, -1, -1, 0};
+
+static void NavMeshSteer_Free(void)
+{
+    free(g_NavMeshSteer.cost);          g_NavMeshSteer.cost = NULL;
+    free(g_NavMeshSteer.parent);        g_NavMeshSteer.parent = NULL;
+    free(g_NavMeshSteer.parentLink);    g_NavMeshSteer.parentLink = NULL;
+    free(g_NavMeshSteer.stamp);         g_NavMeshSteer.stamp = NULL;
+    NavPlan_HeapFree(&g_NavMeshSteer.open);
+
+    g_NavMeshSteer.capacity = 0;
+    g_NavMeshSteer.search = 0;
+    g_NavMeshSteer.startPoly = g_NavMeshSteer.goalPoly = -1;
+    g_NavMeshSteer.plannedLink = g_NavMeshSteer.link = g_NavMeshSteer.announcedLink = -1;
+}
 
-/* Record current position in history (call every 10 frames) */
-extern "C" void PathFind_RecordPosition(int x, int y, int z)
+static int NavMeshSteer_Alloc(int numPolys)
 {
-    POSITION_RECORD* rec = &AutoNavState.position_history[AutoNavState.history_index];
-    rec->x = x;
-    rec->y = y;
-    rec->z = z;
-    rec->timestamp = GetTickCount();
+    if (g_NavMeshSteer.capacity == numPolys) return 1;
+
+    NavMeshSteer_Free();
+    g_NavMeshSteer.cost = (int*)malloc(numPolys * sizeof(int));
+    g_NavMeshSteer.parent = (int*)malloc(numPolys * sizeof(int));
+    g_NavMeshSteer.parentLink = (int*)malloc(numPolys * sizeof(int));
+    g_NavMeshSteer.stamp = (unsigned int*)calloc(numPolys, sizeof(unsigned int));
+    if (!g_NavMeshSteer.cost || !g_NavMeshSteer.parent || !g_NavMeshSteer.parentLink ||
+        !g_NavMeshSteer.stamp ||
+        !NavPlan_HeapAlloc(&g_NavMeshSteer.open, numPolys)) {
+        NavMeshSteer_Free();
+        return 0;
+    }
+    g_NavMeshSteer.capacity = numPolys;
+    return 1;
+}
 
-    AutoNavState.history_index = (AutoNavState.history_index + 1) % NAV_POSITION_HISTORY_SIZE;
-    if (AutoNavState.history_count < NAV_POSITION_HISTORY_SIZE) {
-        AutoNavState.history_count++;
+static int NavMeshSteer_LinkCost(const NAVMESHLINK* link)
+{
+    switch (link->type) {
+        case NML_Step: return NAVMESH_STEP_COST;
+        case NML_Drop: return NAVMESH_DROP_COST;
+        case NML_Jump: return NAVMESH_JUMP_COST;
+        default:       return 0;
     }
 }
 
-/* Detect if player is oscillating (moving back and forth) */
-extern "C" int PathFind_DetectOscillation(void)
+/* First link on the cheapest way from the player's polygon to the goal's, or -1 */
+static int NavMeshSteer_Plan(int start, const VECTORCH* from, int goal, const VECTORCH* goalPos)
 {
-    if (AutoNavState.history_count < 6) return 0;
+    int expanded = 0;
 
-    /* Look at last 6 positions (~1 second) */
-    int sumX = 0, sumZ = 0;
-    int sumX2 = 0, sumZ2 = 0;
-    int count = 0;
+    if (!NavMeshSteer_Alloc(FarNavMesh.header->numPolys)) return -1;
 
-    for (int i = 0; i < 6; i++) {
-        int idx = (AutoNavState.history_index - 1 - i + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
-        POSITION_RECORD* rec = &AutoNavState.position_history[idx];
-        sumX += rec->x;
-        sumZ += rec->z;
-        sumX2 += rec->x * rec->x;
-        sumZ2 += rec->z * rec->z;
-        count++;
+    g_NavMeshSteer.search++;
+    if (g_NavMeshSteer.search == 0) {
+        memset(g_NavMeshSteer.stamp, 0, g_NavMeshSteer.capacity * sizeof(unsigned int));
+        g_NavMeshSteer.search = 1;
     }
+    while (g_NavMeshSteer.open.size > 0) NavPlan_HeapPop(&g_NavMeshSteer.open);
 
-    /* Calculate variance */
-    int meanX = sumX / count;
-    int meanZ = sumZ / count;
-    int varX = (sumX2 / count) - (meanX * meanX);
-    int varZ = (sumZ2 / count) - (meanZ * meanZ);
+    g_NavMeshSteer.stamp[start] = g_NavMeshSteer.search;
+    g_NavMeshSteer.cost[start] = 0;
+    g_NavMeshSteer.parent[start] = -1;
+    g_NavMeshSteer.parentLink[start] = -1;
+    NavPlan_HeapUpdate(&g_NavMeshSteer.open, start, NavPlan_Distance(from, goalPos));
 
-    /* Low variance in position but movement detected = oscillating */
-    /* Check if total movement is significant but variance is low */
-    int oldest = (AutoNavState.history_index - 6 + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
-    int newest = (AutoNavState.history_index - 1 + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
-    int dx = AutoNavState.position_history[newest].x - AutoNavState.position_history[oldest].x;
-    int dz = AutoNavState.position_history[newest].z - AutoNavState.position_history[oldest].z;
-    int totalMovement = dx * dx + dz * dz;
+    while (g_NavMeshSteer.open.size > 0 && expanded++ < NAVMESH_SEARCH_LIMIT) {
+        int poly = NavPlan_HeapPop(&g_NavMeshSteer.open);
+        const NAVMESHPOLY* p = &FarNavMesh.polys[poly];
+        const VECTORCH* at = (poly == start) ? from : &p->centre;
 
-    /* Oscillating if variance is high (lots of back-and-forth) but net movement is low */
-    if ((varX + varZ) > 500000 && totalMovement < 1000000) {
-        return 1;
-    }
+        if (poly == goal) {
+            /* Walk back to the link out of the start polygon */
+            while (poly != start && g_NavMeshSteer.parent[poly] != start) {
+                poly = g_NavMeshSteer.parent[poly];
+            }
+            return g_NavMeshSteer.parentLink[poly];
+        }
 
-    return 0;
+        for (int i = p->firstLink; i < p->firstLink + p->numLinks; i++) {
+            const NAVMESHLINK* link = &FarNavMesh.links[i];
+            int target = link->target;
+            int seen = (g_NavMeshSteer.stamp[target] == g_NavMeshSteer.search);
+            int cost;
+
+            if (seen && g_NavMeshSteer.open.pos[target] < 0) continue;    /* Closed */
+
+            cost = g_NavMeshSteer.cost[poly] + NavPlan_Distance(at, &link->position) +
+                   NavPlan_Distance(&link->position, &FarNavMesh.polys[target].centre) +
+                   NavMeshSteer_LinkCost(link);
+            if (seen && cost >= g_NavMeshSteer.cost[target]) continue;
+
+            g_NavMeshSteer.stamp[target] = g_NavMeshSteer.search;
+            g_NavMeshSteer.cost[target] = cost;
+            g_NavMeshSteer.parent[target] = poly;
+            g_NavMeshSteer.parentLink[target] = i;
+            NavPlan_HeapUpdate(&g_NavMeshSteer.open, target,
+                               cost + NavPlan_Distance(&FarNavMesh.polys[target].centre, goalPos));
+        }
+    }
+    return -1;
 }
 
-/* Detect if player has returned to a previous position (loop) */
-extern "C" int PathFind_DetectLoop(int* loopSize)
+/* Turn the steer point toward the next link on the mesh. The distance to it
+ * is kept, so arrival and speed decisions still see the real distance */
+static void AutoNav_SteerOnMesh(STRATEGYBLOCK* playerSB, VECTORCH* steer)
 {
-    if (AutoNavState.history_count < 18) return 0;  /* Need 3+ seconds of history */
+    VECTORCH* position = &playerSB->DynPtr->Position;
+    unsigned int now = GetTickCount();
+    int start;
 
-    int currentIdx = (AutoNavState.history_index - 1 + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
-    POSITION_RECORD* current = &AutoNavState.position_history[currentIdx];
+    g_NavMeshSteer.link = -1;
+    if (!FarNavMesh.header || FarNavMesh.header->numPolys <= 0) return;
 
-    /* Check positions from 3+ seconds ago */
-    for (int i = 18; i < AutoNavState.history_count; i++) {
-        int oldIdx = (AutoNavState.history_index - 1 - i + NAV_POSITION_HISTORY_SIZE) % NAV_POSITION_HISTORY_SIZE;
-        POSITION_RECORD* old = &AutoNavState.position_history[oldIdx];
+    start = NavMeshPolyAt(position, playerSB->containingModule);
+    if (start < 0) return;
 
-        int dx = current->x - old->x;
-        int dz = current->z - old->z;
-        int distSq = dx * dx + dz * dz;
+    if (g_NavMeshSteer.goalPoly < 0 || NavPlan_Distance(steer, &g_NavMeshSteer.goalPos) > NAVMESH_GOAL_MOVE) {
+        g_NavMeshSteer.goalPos = *steer;
+        g_NavMeshSteer.goalPoly = NavMeshPolyAt(steer, ModuleFromPosition(steer, playerSB->containingModule));
+        g_NavMeshSteer.planTime = 0;
+    }
+    if (g_NavMeshSteer.goalPoly < 0) return;
 
-        /* Within 1000 units = same position (loop detected) */
-        if (distSq < 1000000) {
-            if (loopSize) *loopSize = i;
-            return 1;
-        }
+    if (start != g_NavMeshSteer.startPoly || (now - g_NavMeshSteer.planTime) > NAVMESH_REPLAN_MS) {
+        g_NavMeshSteer.startPoly = start;
+        g_NavMeshSteer.planTime = now;
+        g_NavMeshSteer.plannedLink = NavMeshSteer_Plan(start, position, g_NavMeshSteer.goalPoly, steer);
     }
+    if (g_NavMeshSteer.plannedLink < 0) return;
 
-    return 0;
+    const NAVMESHLINK* link = &FarNavMesh.links[g_NavMeshSteer.plannedLink];
+    const VECTORCH* via = &link->position;
+    float dx = (float)(via->vx - position->vx);
+    float dz = (float)(via->vz - position->vz);
+    float viaDist = sqrtf(dx * dx + dz * dz);
+
+    /* At the edge already: carry on across to the next polygon */
+    if (viaDist < NAVMESH_ARRIVE_DIST) {
+        via = &FarNavMesh.polys[link->target].centre;
+        dx = (float)(via->vx - position->vx);
+        dz = (float)(via->vz - position->vz);
+        viaDist = sqrtf(dx * dx + dz * dz);
+        if (viaDist < 1.0f) return;
+    }
+
+    g_NavMeshSteer.link = g_NavMeshSteer.plannedLink;
+
+    if ((link->type == NML_Jump || link->type == NML_Drop) &&
+        g_NavMeshSteer.plannedLink != g_NavMeshSteer.announcedLink && viaDist < NAVMESH_ANNOUNCE_DIST &&
+        Announce("nav_link", link->type == NML_Jump ? "Jump ahead." : "Drop ahead.")) {
+        g_NavMeshSteer.announcedLink = g_NavMeshSteer.plannedLink;
+    }
+
+    float sx = (float)(steer->vx - position->vx);
+    float sz = (float)(steer->vz - position->vz);
+    float steerDist = sqrtf(sx * sx + sz * sz);
+
+    steer->vx = position->vx + (int)(dx / viaDist * steerDist);
+    steer->vz = position->vz + (int)(dz / viaDist * steerDist);
 }
 
-/* Escalate to next navigation strategy */
-extern "C" void PathFind_EscalateStrategy(void)
+/* Is the player at the take-off point of a jump on the mesh route */
+static int AutoNav_MeshWantsJump(void)
 {
-    AutoNavState.strategy_frames = 0;
+    if (g_NavMeshSteer.link < 0 || !Player || !Player->ObStrategyBlock) return 0;
 
-    switch (AutoNavState.current_strategy) {
-        case NAV_STRATEGY_DIRECT:
-            AutoNavState.current_strategy = NAV_STRATEGY_WALL_FOLLOW_LEFT;
-            TTS_SpeakQueued("Trying wall follow left.");
-            LOG_INF("Strategy: Wall follow left");
-            break;
+    const NAVMESHLINK* link = &FarNavMesh.links[g_NavMeshSteer.link];
+    if (link->type != NML_Jump) return 0;
 
-        case NAV_STRATEGY_WALL_FOLLOW_LEFT:
-            AutoNavState.current_strategy = NAV_STRATEGY_WALL_FOLLOW_RIGHT;
-            TTS_SpeakQueued("Trying wall follow right.");
-            LOG_INF("Strategy: Wall follow right");
-            break;
+    VECTORCH* position = &Player->ObStrategyBlock->DynPtr->Position;
+    float dx = (float)(link->position.vx - position->vx);
+    float dz = (float)(link->position.vz - position->vz);
+    return (dx * dx + dz * dz) < (float)NAVMESH_JUMP_DIST * NAVMESH_JUMP_DIST;
+}
 
-        case NAV_STRATEGY_WALL_FOLLOW_RIGHT:
-            AutoNavState.current_strategy = NAV_STRATEGY_BACKTRACK;
-            TTS_SpeakQueued("Backing up.");
-            LOG_INF("Strategy: Backtrack");
-            break;
+/* Route AutoNav is currently following */
+static struct {
+    int active;             /* Steering toward waypoints rather than the target */
+    int src, dst;
+    NAVPLAN_WAYPOINT next;  /* Next portal to head for */
+    int remaining;          /* Route length from the player to the target */
+} g_NavRoute = {0, -1, -1};
 
-        case NAV_STRATEGY_BACKTRACK:
-            /* After backtrack, try wide around */
-            AutoNavState.current_strategy = NAV_STRATEGY_WIDE_AROUND_LEFT;
-            TTS_SpeakQueued("Trying wide path left.");
-            LOG_INF("Strategy: Wide around left");
-            break;
+static int AutoNav_ModuleIndexOf(STRATEGYBLOCK* sb, VECTORCH* position, MODULE* hint)
+{
+    MODULE* module = sb ? sb->containingModule : NULL;
+    if (!module && position) module = ModuleFromPosition(position, hint);
+    return (module && module->m_aimodule) ? module->m_aimodule->m_index : -1;
+}
 
-        case NAV_STRATEGY_WIDE_AROUND_LEFT:
-            AutoNavState.current_strategy = NAV_STRATEGY_WIDE_AROUND_RIGHT;
-            TTS_SpeakQueued("Trying wide path right.");
-            LOG_INF("Strategy: Wide around right");
-            break;
+/* Pick the point AutoNav should steer toward this frame */
+static void AutoNav_UpdateRoute(STRATEGYBLOCK* playerSB, VECTORCH* steer)
+{
+    static void* lastTargetSB = NULL;
+    static MODULE* lastTargetContaining = NULL;
+    static VECTORCH lastTargetGoal;
+    static int lastTargetModule = -1;
+    int wasActive = g_NavRoute.active;
+    VECTORCH goal;
+
+    goal.vx = AutoNavState.target_x;
+    goal.vy = AutoNavState.target_y;
+    goal.vz = AutoNavState.target_z;
+    *steer = goal;
+    g_NavRoute.active = 0;
+
+    int src = AutoNav_ModuleIndexOf(playerSB, NULL, NULL);
+    if (src < 0) return;
+
+    /* Module lookups by position walk the module list, so only redo one when
+     * the target moves or changes module. Comparing the module and position
+     * as well as the pointer also catches an SB slot reused for a new target. */
+    STRATEGYBLOCK* targetSB = (STRATEGYBLOCK*)AutoNavState.target_sb;
+    MODULE* targetContaining = targetSB ? targetSB->containingModule : NULL;
+    if (targetSB != lastTargetSB || targetContaining != lastTargetContaining ||
+        goal.vx != lastTargetGoal.vx || goal.vy != lastTargetGoal.vy || goal.vz != lastTargetGoal.vz ||
+        lastTargetModule < 0) {
+        lastTargetSB = targetSB;
+        lastTargetContaining = targetContaining;
+        lastTargetGoal = goal;
+        lastTargetModule = AutoNav_ModuleIndexOf(targetSB, &goal, playerSB->containingModule);
+    }
+    int dst = lastTargetModule;
+    if (dst < 0) return;
+
+    NAVPLAN_WAYPOINT next;
+    int portal;
+
+    g_NavRoute.src = src;
+    g_NavRoute.dst = dst;
+
+    /* The flow field answers from the player's module once converged;
+     * until then (new target) fall back to a one-off A* route */
+    NavField_Update(dst, &goal);
+    portal = NavField_NextPortal(src, &playerSB->DynPtr->Position, dst);
+    if (portal == -1) {
+        return;     /* Already in the target's module, or no way there */
+    } else if (portal >= 0) {
+        next.module = g_NavPlanNodes[portal].module;
+        next.position = g_NavPlanNodes[portal].position;
+        next.remaining = g_NavField_ReadBuf[portal];
+    } else {
+        const NAVPLAN_ROUTE* route = NavPlan_GetRoute(src, &playerSB->DynPtr->Position, dst, &goal);
+        if (!route || route->length <= 0) return;
+        next = route->waypoints[0];
+    }
 
-        case NAV_STRATEGY_WIDE_AROUND_RIGHT:
-            /* All strategies exhausted */
-            AutoNavState.strategy_failures++;
-            if (AutoNavState.strategy_failures >= 2) {
-                TTS_Speak("Cannot reach target. Try manual navigation.");
-                AutoNavState.auto_move = 0;
-                AutoNavState.current_strategy = NAV_STRATEGY_DIRECT;
-                LOG_WRN("All navigation strategies failed");
-            } else {
-                /* Reset and try again */
-                AutoNavState.current_strategy = NAV_STRATEGY_DIRECT;
-                TTS_SpeakQueued("Retrying direct path.");
-                LOG_INF("Strategy: Reset to direct");
-            }
-            break;
+    if (!wasActive || next.module != g_NavRoute.next.module) {
+        LOG_DBG("AutoNav: heading for module %d (%d to go, %s)", next.module, next.remaining,
+                portal >= 0 ? "flow field" : "A*");
     }
+
+    g_NavRoute.active = 1;
+    g_NavRoute.next = next;
+    g_NavRoute.remaining = NavPlan_Distance(&playerSB->DynPtr->Position, &next.position) + next.remaining;
+    *steer = next.position;
+}
+
+/* Distance left to travel: along the route when there is one */
+static int AutoNav_RemainingDistance(void)
+{
+    return g_NavRoute.active ? g_NavRoute.remaining : AutoNavState.target_distance;
+}
+
+/* The player is stuck on the current route: avoid that portal and replan */
+static void AutoNav_Reroute(void)
+{
+    NavPlan_BlockPortal(g_NavRoute.next.module, g_NavRoute.src);
+    TTS_SpeakCategory("nav_recovery", "Rerouting.");
 }
 
 /* ============================================
@@ -2873,7 +6812,7 @@ extern "C" void AutoNav_CheckProgress(void)
 {
     if (!AutoNavState.enabled || !AutoNavState.auto_move) return;
 
-    int currentDist = AutoNavState.target_distance;
+    int currentDist = AutoNav_RemainingDistance();
     int lastDist = AutoNavState.last_announced_distance;
     unsigned int now = GetTickCount();
 
@@ -2892,7 +6831,7 @@ extern "C" void AutoNav_CheckProgress(void)
         int meters = currentDist / 1000;
         if (meters > 0) {
             snprintf(msg, sizeof(msg), "%d meters.", meters);
-            TTS_SpeakQueued(msg);
+            TTS_SpeakCategory("nav_progress", msg);
         }
         AutoNavState.last_announced_distance = currentDist;
         AutoNavState.last_progress_time = now;
@@ -2900,14 +6839,14 @@ extern "C" void AutoNav_CheckProgress(void)
     }
     else if (distanceChange <= -PROGRESS_MOVING_AWAY_THRESHOLD && timeSince > 5000) {
         /* Moving away from target */
-        TTS_SpeakQueued("Moving away from target.");
+        TTS_SpeakCategory("nav_progress", "Moving away from target.");
         AutoNavState.last_announced_distance = currentDist;
         AutoNavState.last_progress_time = now;
         LOG_INF("Moving away from target");
     }
     else if (timeSince > PROGRESS_ANNOUNCE_TIME_MS && abs(distanceChange) < 2000) {
         /* No significant progress in 10 seconds */
-        TTS_SpeakQueued("Navigation stalled.");
+        TTS_SpeakCategory("nav_progress", "Navigation stalled.");
         AutoNavState.last_progress_time = now;
         LOG_WRN("Navigation stalled");
     }
@@ -2992,6 +6931,11 @@ static int IsNavTarget(AVP_BEHAVIOUR_TYPE bhvr, NAV_TARGET_TYPE targetType)
     }
 }
 
+static int SpatialFilter_NavTarget(STRATEGYBLOCK* sb, void* context)
+{
+    return IsNavTarget(sb->I_SBtype, *(NAV_TARGET_TYPE*)context);
+}
+
 /* Get name for a specific target */
 static const char* GetNavTargetName(AVP_BEHAVIOUR_TYPE bhvr)
 {
@@ -3019,12 +6963,14 @@ extern "C" void AutoNav_FindTarget(void)
 {
     if (!Player || !Player->ObStrategyBlock) {
         AutoNavState.target_name = NULL;
+        AutoNavState.target_sb = NULL;
         return;
     }
 
     DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
     if (!playerDyn) {
         AutoNavState.target_name = NULL;
+        AutoNavState.target_sb = NULL;
         return;
     }
 
@@ -3032,25 +6978,33 @@ extern "C" void AutoNav_FindTarget(void)
     int playerY = playerDyn->Position.vy;
     int playerZ = playerDyn->Position.vz;
 
-    extern int NumActiveStBlocks;
-    extern STRATEGYBLOCK* ActiveStBlockList[];
-
     int bestScore = 999999999;
     int nearestDist = 999999999;
     STRATEGYBLOCK* nearestSB = NULL;
 
-    for (int i = 0; i < NumActiveStBlocks; i++) {
-        STRATEGYBLOCK* sb = ActiveStBlockList[i];
-        if (!sb || !sb->DynPtr) continue;
+    /* Scores below reward threats/interactives by at most NAV_TARGET_MAX_BONUS, so the
+     * best candidate lies within that much of the nearest one - only score those */
+    #define NAV_TARGET_MAX_BONUS 5000
+    NAV_TARGET_TYPE targetType = AutoNavState.target_type;
+    SPATIAL_HIT closest;
+    if (SpatialIndex_QueryNearest(playerX, playerY, playerZ, 999999999,
+                                  SpatialFilter_NavTarget, &targetType, &closest, 1) == 0) {
+        AutoNavState.target_name = NULL;
+        AutoNavState.target_sb = NULL;
+        AutoNavState.target_distance = 0;
+        LOG_DBG("AutoNav: No target found for type %d", AutoNavState.target_type);
+        return;
+    }
 
-        if (!IsNavTarget(sb->I_SBtype, AutoNavState.target_type)) continue;
+    static SPATIAL_HIT candidates[SPATIAL_MAX_ENTRIES];
+    int numCandidates = SpatialIndex_QueryRadius(playerX, playerY, playerZ,
+                                                 closest.distance + NAV_TARGET_MAX_BONUS,
+                                                 SpatialFilter_NavTarget, &targetType,
+                                                 candidates, SPATIAL_MAX_ENTRIES);
 
-        int dist = Accessibility_GetDistance(
-            playerX, playerY, playerZ,
-            sb->DynPtr->Position.vx,
-            sb->DynPtr->Position.vy,
-            sb->DynPtr->Position.vz
-        );
+    for (int i = 0; i < numCandidates; i++) {
+        STRATEGYBLOCK* sb = candidates[i].sb;
+        int dist = candidates[i].distance;
 
         /* Score-based prioritization (lower is better):
          * - Threats get -5000 priority bonus
@@ -3085,11 +7039,13 @@ extern "C" void AutoNav_FindTarget(void)
         AutoNavState.target_z = nearestSB->DynPtr->Position.vz;
         AutoNavState.target_distance = nearestDist;
         AutoNavState.target_name = GetNavTargetName(nearestSB->I_SBtype);
+        AutoNavState.target_sb = nearestSB;
         LOG_DBG("AutoNav: Found target '%s' at dist=%d pos=(%d,%d,%d)",
                 AutoNavState.target_name, nearestDist,
                 AutoNavState.target_x, AutoNavState.target_y, AutoNavState.target_z);
     } else {
         AutoNavState.target_name = NULL;
+        AutoNavState.target_sb = NULL;
         AutoNavState.target_distance = 0;
         LOG_DBG("AutoNav: No target found for type %d", AutoNavState.target_type);
     }
@@ -3201,14 +7157,71 @@ extern "C" void AutoNav_CycleTargetType(void)
 }
 
 /* Forward declarations for structure identification system (defined later) */
+
+/* What a ray hit. Each class has a name, flags and guidance in g_ObstacleClasses */
+typedef enum {
+    OBSTACLE_CLEAR,
+    OBSTACLE_WALL,
+    /* Enemies */
+    OBSTACLE_ALIEN,
+    OBSTACLE_QUEEN_ALIEN,
+    OBSTACLE_FACEHUGGER,
+    OBSTACLE_PREDATOR,
+    OBSTACLE_XENOBORG,
+    OBSTACLE_MARINE,
+    OBSTACLE_AUTOGUN,
+    /* Doors */
+    OBSTACLE_PROXIMITY_DOOR,
+    OBSTACLE_LIFT_DOOR,
+    OBSTACLE_DOOR,
+    /* Interactive */
+    OBSTACLE_SWITCH,
+    OBSTACLE_LIFT,
+    OBSTACLE_GENERATOR,
+    OBSTACLE_TERMINAL,
+    OBSTACLE_POWER_CABLE,
+    OBSTACLE_FAN,
+    OBSTACLE_HAZARD,
+    OBSTACLE_SELF_DESTRUCT,
+    /* Projectiles */
+    OBSTACLE_GRENADE,
+    OBSTACLE_ROCKET,
+    /* Objects */
+    OBSTACLE_OBJECT,
+    OBSTACLE_DEBRIS,
+    OBSTACLE_CORPSE,
+    OBSTACLE_STRUCTURE,
+    OBSTACLE_SCREEN,
+    OBSTACLE_TRACK,
+    /* Untyped geometry, classified by size */
+    OBSTACLE_SMALL_OBJECT,
+    OBSTACLE_CRATE,
+    OBSTACLE_PILLAR,
+
+    OBSTACLE_CLASS_COUNT
+} OBSTACLE_CLASS;
+
+#define OBSTACLE_FLAG_DOOR          0x01    /* Opens with SPACE, AutoNav stops in front of it */
+#define OBSTACLE_FLAG_ENEMY         0x02    /* Hostile, avoided with a wider berth */
+#define OBSTACLE_FLAG_JUMPABLE      0x04    /* Low clutter the player can walk over */
+#define OBSTACLE_FLAG_INTERACTIVE   0x08    /* Can be operated or ridden */
+
 typedef struct {
     int distance;           /* Distance to hit (0 if no hit) */
     DISPLAYBLOCK* hitObj;   /* Object that was hit (NULL for world geometry) */
-    const char* typeName;   /* Friendly name for what was hit */
+    OBSTACLE_CLASS obstacleClass;   /* What was hit (OBSTACLE_CLEAR if nothing) */
+    int flags;              /* OBSTACLE_FLAG_* bits for obstacleClass */
+    VECTORCH hitPoint;      /* World position of the hit */
 } RAY_RESULT;
 
 static RAY_RESULT CastObstructionRayEx(VECTORCH* origin, VECTORCH* direction, int maxRange);
-static const char* GetObstacleTypeName(DISPLAYBLOCK* obj);
+static void CastObstructionFan(VECTORCH* origin, VECTORCH* directions, int count, int maxRange, RAY_RESULT* results);
+static const char* GetObstacleName(OBSTACLE_CLASS obstacleClass);
+static void AutoNav_DoorPrompt(OBSTACLE_CLASS obstacleClass, char* msg, size_t size);
+
+extern "C" int NormalFrameTime;
+
+#define AUTONAV_STUCK_MS 1500   /* Barely moving for this long counts as stuck */
 
 extern "C" void AutoNav_Update(void)
 {
@@ -3221,9 +7234,7 @@ extern "C" void AutoNav_Update(void)
     }
 
     /* Refresh target periodically */
-    g_NavToneFrameCounter++;
-    if (g_NavToneFrameCounter >= 30) {  /* Every ~0.5 seconds */
-        g_NavToneFrameCounter = 0;
+    if (Sched_IntervalElapsed(&g_NavTargetRefreshTime, 500)) {
         AutoNav_FindTarget();
     }
 
@@ -3236,29 +7247,32 @@ extern "C" void AutoNav_Update(void)
     int playerY = playerDyn->Position.vy;
     int playerZ = playerDyn->Position.vz;
 
-    /* Record position every 10 frames for loop detection */
-    static int positionRecordCounter = 0;
-    positionRecordCounter++;
-    if (positionRecordCounter >= 10) {
-        positionRecordCounter = 0;
+    /* Record position every ~166ms for loop detection */
+    static unsigned int positionRecordTime = 0;
+    if (Sched_IntervalElapsed(&positionRecordTime, 166)) {
         PathFind_RecordPosition(playerX, playerY, playerZ);
     }
 
-    /* Increment strategy frame counter */
-    AutoNavState.strategy_frames++;
+    /* Game time this frame; the stuck, avoidance and backtrack timers below
+     * count it so they last as long at any frame rate */
+    int frameMs = (int)(((long long)NormalFrameTime * 1000) >> ONE_FIXED_SHIFT);
+    AutoNavState.strategy_ms += frameMs;
 
-    /* Check progress toward target (every 60 frames) */
-    static int progressCheckCounter = 0;
-    progressCheckCounter++;
-    if (progressCheckCounter >= 60) {
-        progressCheckCounter = 0;
+    /* Check progress toward target (every second) */
+    static unsigned int progressCheckTime = 0;
+    if (Sched_IntervalElapsed(&progressCheckTime, 1000)) {
         AutoNav_CheckProgress();
     }
 
+    /* Steer for the next portal on the planned route, or the target itself */
+    VECTORCH steer;
+    AutoNav_UpdateRoute(Player->ObStrategyBlock, &steer);
+    AutoNav_SteerOnMesh(Player->ObStrategyBlock, &steer);
+
     /* Calculate direction to target (including vertical) */
-    float dx = (float)(AutoNavState.target_x - playerX);
-    float dy = (float)(AutoNavState.target_y - playerY);
-    float dz = (float)(AutoNavState.target_z - playerZ);
+    float dx = (float)(steer.vx - playerX);
+    float dy = (float)(steer.vy - playerY);
+    float dz = (float)(steer.vz - playerZ);
 
     /* Get player's forward direction from orientation matrix */
     float forwardX = (float)playerDyn->OrientMat.mat31 / 65536.0f;
@@ -3295,12 +7309,10 @@ extern "C" void AutoNav_Update(void)
         angleOffset = (cross >= 0) ? 1.0f : -1.0f;
     }
 
-    /* Play navigation tone every 20 frames with vertical pitch variation */
-    static int toneCounter = 0;
-    toneCounter++;
-    if (toneCounter >= 20) {
-        toneCounter = 0;
-        NavTone_PlayDirectional(angleOffset, verticalRatio);
+    /* Play navigation tone every ~333ms with vertical pitch variation */
+    static unsigned int toneTime = 0;
+    if (Sched_IntervalElapsed(&toneTime, 333)) {
+        NavTone_PlayDirectional(angleOffset, verticalRatio, AutoNav_RemainingDistance());
     }
 
     /* ============================================
@@ -3309,8 +7321,8 @@ extern "C" void AutoNav_Update(void)
 
     /* Cast a ray toward target to check for obstacles */
     static int avoidanceState = 0;  /* 0=none, 1=avoiding left, 2=avoiding right, 3=waiting at door */
-    static int avoidanceTimer = 0;
-    static int stuckCounter = 0;
+    static int avoidanceMs = 0;
+    static int stuckMs = 0;
     static int lastPlayerX = 0, lastPlayerZ = 0;
     static int doorAnnouncedThisStop = 0;
 
@@ -3325,19 +7337,10 @@ extern "C" void AutoNav_Update(void)
     /* Use extended ray cast for structure identification */
     RAY_RESULT obstacleResult = CastObstructionRayEx(&rayOrigin, &targetDir, 8000);
     int obstacleDistance = obstacleResult.distance;
-    const char* obstacleType = obstacleResult.typeName;
 
     /* Check if obstacle is a door - STOP and announce */
-    int isDoor = (strcmp(obstacleType, "door") == 0 ||
-                  strcmp(obstacleType, "proximity door") == 0 ||
-                  strcmp(obstacleType, "lift door") == 0);
-
-    int isEnemy = (strcmp(obstacleType, "alien") == 0 ||
-                   strcmp(obstacleType, "queen alien") == 0 ||
-                   strcmp(obstacleType, "facehugger") == 0 ||
-                   strcmp(obstacleType, "predator") == 0 ||
-                   strcmp(obstacleType, "xenoborg") == 0 ||
-                   strcmp(obstacleType, "marine") == 0);
+    int isDoor = (obstacleResult.flags & OBSTACLE_FLAG_DOOR) != 0;
+    int isEnemy = (obstacleResult.flags & OBSTACLE_FLAG_ENEMY) != 0;
 
     /* Enhanced stuck detection using position history */
     int movedX = playerX - lastPlayerX;
@@ -3352,37 +7355,47 @@ extern "C" void AutoNav_Update(void)
 
         /* Simple stuck check (barely moving) */
         if (distMoved < 10000) {
-            stuckCounter++;
+            stuckMs += frameMs;
         } else {
-            stuckCounter = 0;
+            stuckMs = 0;
         }
 
-        /* Escalate strategy if stuck, oscillating, or looping */
-        if (stuckCounter > 90) {  /* Stuck for ~1.5 seconds */
-            LOG_INF("AutoNav: Stuck detected (stuckCounter=%d), escalating strategy", stuckCounter);
+        /* On a planned route, getting stuck means the next portal is not
+         * passable from here: penalise it and let the planner pick another */
+        if (g_NavRoute.active && (stuckMs > AUTONAV_STUCK_MS || isOscillating || (isLooping && loopSize > 0))) {
+            LOG_INF("AutoNav: Stuck on route (stuck=%dms osc=%d loop=%d), rerouting",
+                    stuckMs, isOscillating, loopSize);
+            AutoNav_Reroute();
+            AutoNavState.current_strategy = NAV_STRATEGY_DIRECT;
+            AutoNavState.history_count = 0;     /* Judge the new route on fresh samples */
+            stuckMs = 0;
+        }
+        /* Otherwise escalate strategy if stuck, oscillating, or looping */
+        else if (stuckMs > AUTONAV_STUCK_MS) {
+            LOG_INF("AutoNav: Stuck detected (%dms), escalating strategy", stuckMs);
             PathFind_EscalateStrategy();
-            stuckCounter = 0;
+            stuckMs = 0;
 
             /* Apply strategy-specific behavior to avoidance state */
             switch (AutoNavState.current_strategy) {
                 case NAV_STRATEGY_WALL_FOLLOW_LEFT:
                     avoidanceState = 1;  /* Force left */
-                    avoidanceTimer = 180;  /* 3 seconds */
+                    avoidanceMs = 3000;
                     break;
                 case NAV_STRATEGY_WALL_FOLLOW_RIGHT:
                     avoidanceState = 2;  /* Force right */
-                    avoidanceTimer = 180;
+                    avoidanceMs = 3000;
                     break;
                 case NAV_STRATEGY_BACKTRACK:
                     avoidanceState = 0;  /* Will be handled separately */
                     break;
                 case NAV_STRATEGY_WIDE_AROUND_LEFT:
                     avoidanceState = 1;
-                    avoidanceTimer = 300;  /* 5 seconds */
+                    avoidanceMs = 5000;
                     break;
                 case NAV_STRATEGY_WIDE_AROUND_RIGHT:
                     avoidanceState = 2;
-                    avoidanceTimer = 300;
+                    avoidanceMs = 5000;
                     break;
                 default:
                     break;
@@ -3395,7 +7408,7 @@ extern "C" void AutoNav_Update(void)
             PathFind_EscalateStrategy();
         }
     } else {
-        stuckCounter = 0;
+        stuckMs = 0;
     }
     lastPlayerX = playerX;
     lastPlayerZ = playerZ;
@@ -3414,11 +7427,9 @@ extern "C" void AutoNav_Update(void)
 
         if (!doorAnnouncedThisStop) {
             char doorMsg[128];
-            snprintf(doorMsg, sizeof(doorMsg), "%s ahead. Press SPACE to open.",
-                    obstacleType);
-            if (doorMsg[0] >= 'a' && doorMsg[0] <= 'z') doorMsg[0] -= 32;
+            AutoNav_DoorPrompt(obstacleResult.obstacleClass, doorMsg, sizeof(doorMsg));
             TTS_SpeakQueued(doorMsg);
-            LOG_INF("AutoNav: Stopped at %s (dist=%d)", obstacleType, obstacleDistance);
+            LOG_INF("AutoNav: Stopped at %s (dist=%d)", GetObstacleName(obstacleResult.obstacleClass), obstacleDistance);
             doorAnnouncedThisStop = 1;
         }
     } else if (obstacleDistance > 0 && obstacleDistance < 4000) {
@@ -3439,13 +7450,11 @@ extern "C" void AutoNav_Update(void)
             rightDir.vy = 0;
             rightDir.vz = playerDyn->OrientMat.mat13;
 
-            LOS_Lambda = 8000;
-            FindPolygonInLineOfSight(&leftDir, &rayOrigin, 0, Player);
-            int leftClear = LOS_Lambda;
-
-            LOS_Lambda = 8000;
-            FindPolygonInLineOfSight(&rightDir, &rayOrigin, 0, Player);
-            int rightClear = LOS_Lambda;
+            VECTORCH sideDirs[2] = { leftDir, rightDir };
+            RAY_RESULT sideHits[2];
+            CastObstructionFan(&rayOrigin, sideDirs, 2, 8000, sideHits);
+            int leftClear = sideHits[0].distance > 0 ? sideHits[0].distance : 8000;
+            int rightClear = sideHits[1].distance > 0 ? sideHits[1].distance : 8000;
 
             /* Also consider which direction is closer to target */
             if (cross > 0.1f) {
@@ -3458,7 +7467,7 @@ extern "C" void AutoNav_Update(void)
                 /* Go toward the side with more room */
                 avoidanceState = (leftClear > rightClear) ? 1 : 2;
             }
-            avoidanceTimer = 30;  /* Avoid for ~0.5 seconds */
+            avoidanceMs = 500;
             LOG_DBG("AutoNav: Obstacle at %d, avoiding %s (L=%d R=%d)",
                     obstacleDistance, avoidanceState == 1 ? "LEFT" : "RIGHT", leftClear, rightClear);
         }
@@ -3478,9 +7487,9 @@ extern "C" void AutoNav_Update(void)
     }
 
     /* Decrement avoidance timer outside obstacle condition - so it always counts down */
-    if (avoidanceTimer > 0) {
-        avoidanceTimer--;
-        if (avoidanceTimer <= 0) {
+    if (avoidanceMs > 0) {
+        avoidanceMs -= frameMs;
+        if (avoidanceMs <= 0) {
             avoidanceState = 0;  /* End avoidance, reassess */
         }
     } else if (obstacleDistance == 0 || obstacleDistance >= 4000) {
@@ -3518,26 +7527,26 @@ extern "C" void AutoNav_Update(void)
     #define AUTONAV_FORWARD_SPEED 13000   /* Slower forward movement */
     #define AUTONAV_STRAFE_SPEED 8000     /* Slower strafe movement */
     #define AUTONAV_BACKTRACK_SPEED -8000 /* Backward movement for backtrack strategy */
-    #define BACKTRACK_DURATION_FRAMES 90  /* ~1.5 seconds of backing up */
+    #define BACKTRACK_DURATION_MS 1500
 
     /* Handle BACKTRACK strategy specially - move backward */
-    static int backtrackFrames = 0;
+    static int backtrackMs = 0;
     if (AutoNavState.current_strategy == NAV_STRATEGY_BACKTRACK) {
-        backtrackFrames++;
+        backtrackMs += frameMs;
         PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
         if (ps) {
             ps->Mvt_MotionIncrement = AUTONAV_BACKTRACK_SPEED;  /* Move backward */
             ps->Mvt_SideStepIncrement = 0;
         }
         /* After backing up enough, reset to direct strategy */
-        if (backtrackFrames > BACKTRACK_DURATION_FRAMES) {
+        if (backtrackMs > BACKTRACK_DURATION_MS) {
             AutoNavState.current_strategy = NAV_STRATEGY_DIRECT;
-            AutoNavState.strategy_frames = 0;
-            backtrackFrames = 0;
+            AutoNavState.strategy_ms = 0;
+            backtrackMs = 0;
             LOG_INF("AutoNav: Backtrack complete, returning to direct strategy");
         }
     } else if (AutoNavState.auto_move && targetDist > 3000) {
-        backtrackFrames = 0;  /* Reset backtrack counter */
+        backtrackMs = 0;  /* Reset backtrack timer */
         PLAYER_STATUS* ps = (PLAYER_STATUS*)(Player->ObStrategyBlock->SBdataptr);
         if (ps) {
             if (shouldMoveForward) {
@@ -3553,11 +7562,13 @@ extern "C" void AutoNav_Update(void)
                 ps->Mvt_SideStepIncrement = 0;  /* Stop strafing */
             }
 
-            /* Auto-jump: If obstruction detection found a jumpable obstacle ahead, jump! */
-            if (g_ObstructionState.forward_blocked &&
-                g_ObstructionState.forward_distance < 2500 &&  /* Within 2.5m */
-                g_ObstructionState.forward_is_clearable &&     /* Can be jumped */
-                !g_ObstructionState.forward_is_jumpable) {     /* Not a step (needs actual jump) */
+            /* Auto-jump: If obstruction detection found a jumpable obstacle ahead,
+             * or the mesh route jumps here, jump! */
+            if ((g_ObstructionState.forward_blocked &&
+                 g_ObstructionState.forward_distance < 2500 &&  /* Within 2.5m */
+                 g_ObstructionState.forward_is_clearable &&     /* Can be jumped */
+                 !g_ObstructionState.forward_is_jumpable) ||    /* Not a step (needs actual jump) */
+                AutoNav_MeshWantsJump()) {
                 /* Trigger jump by setting the jump request flag */
                 ps->Mvt_InputRequests.Flags.Rqst_Jump = 1;
             }
@@ -3580,7 +7591,6 @@ extern "C" void AutoNav_Update(void)
  * ============================================ */
 
 /* Constants for obstruction detection */
-#define OBSTRUCTION_CHECK_INTERVAL 10    /* Check every N frames */
 #define OBSTRUCTION_CLOSE_DIST 1500      /* 1.5m - very close warning */
 #define OBSTRUCTION_NEAR_DIST 3000       /* 3m - near warning */
 #define OBSTRUCTION_FAR_DIST 6000        /* 6m - far warning */
@@ -3594,11 +7604,88 @@ extern "C" void AutoNav_Update(void)
  * Structure Identification System
  * ============================================ */
 
-/* Get a friendly name for an obstacle based on its behavior type or geometry */
-static const char* GetObstacleTypeName(DISPLAYBLOCK* obj)
+/* Name, flags, Environment_Describe priority (lower is announced first) and
+ * the guidance Obstruction_AnnounceAhead gives, for each OBSTACLE_CLASS */
+typedef struct {
+    const char* name;
+    int flags;
+    int priority;
+    const char* guidance;   /* NULL to suggest a way around instead */
+} OBSTACLE_CLASS_INFO;
+
+static const OBSTACLE_CLASS_INFO g_ObstacleClasses[OBSTACLE_CLASS_COUNT] = {
+    { "clear",                 0,                                              3, NULL },
+    { "wall",                  0,                                              3, NULL },
+    { "alien",                 OBSTACLE_FLAG_ENEMY,                            0, NULL },
+    { "queen alien",           OBSTACLE_FLAG_ENEMY,                            0, NULL },
+    { "facehugger",            OBSTACLE_FLAG_ENEMY,                            0, NULL },
+    { "predator",              OBSTACLE_FLAG_ENEMY,                            0, NULL },
+    { "xenoborg",              OBSTACLE_FLAG_ENEMY,                            0, NULL },
+    { "marine",                OBSTACLE_FLAG_ENEMY,                            0, NULL },
+    { "autogun",               OBSTACLE_FLAG_ENEMY,                            0, NULL },
+    { "proximity door",        OBSTACLE_FLAG_DOOR | OBSTACLE_FLAG_INTERACTIVE, 1, "Press SPACE to operate." },
+    { "lift door",             OBSTACLE_FLAG_DOOR | OBSTACLE_FLAG_INTERACTIVE, 1, "Press SPACE to operate." },
+    { "door",                  OBSTACLE_FLAG_DOOR | OBSTACLE_FLAG_INTERACTIVE, 1, "Press SPACE to operate." },
+    { "switch",                OBSTACLE_FLAG_INTERACTIVE,                      1, "Press SPACE to operate." },
+    { "lift",                  OBSTACLE_FLAG_INTERACTIVE,                      1, "Step on to ride." },
+    { "generator",             OBSTACLE_FLAG_INTERACTIVE,                      1, "Press SPACE to interact." },
+    { "terminal",              OBSTACLE_FLAG_INTERACTIVE,                      1, "Press SPACE to interact." },
+    { "power cable",           0,                                              3, NULL },
+    { "fan",                   0,                                              3, NULL },
+    { "hazard",                0,                                              3, NULL },
+    { "self-destruct console", OBSTACLE_FLAG_INTERACTIVE,                      1, NULL },
+    { "grenade",               0,                                              3, NULL },
+    { "rocket",                0,                                              3, NULL },
+    { "object",                0,                                              2, NULL },
+    { "debris",                OBSTACLE_FLAG_JUMPABLE,                         3, NULL },
+    { "corpse",                OBSTACLE_FLAG_JUMPABLE,                         3, NULL },
+    { "structure",             0,                                              2, NULL },
+    { "screen",                0,                                              3, NULL },
+    { "track",                 0,                                              3, NULL },
+    { "small object",          OBSTACLE_FLAG_JUMPABLE,                         3, NULL },
+    { "crate",                 0,                                              2, NULL },
+    { "pillar",                0,                                              2, NULL },
+};
+
+/* Friendly name for an obstacle class, only needed when something is spoken or logged */
+static const char* GetObstacleName(OBSTACLE_CLASS obstacleClass)
+{
+    return g_ObstacleClasses[obstacleClass].name;
+}
+
+/* What AutoNav says when it stops in front of a door */
+static void AutoNav_DoorPrompt(OBSTACLE_CLASS obstacleClass, char* msg, size_t size)
+{
+    snprintf(msg, size, "%s ahead. Press SPACE to open.", GetObstacleName(obstacleClass));
+    if (msg[0] >= 'a' && msg[0] <= 'z') msg[0] -= 32;
+}
+
+/* The index'th prompt built from a class name: the door prompt for every
+ * door class, then the interaction prompt for every operable object.
+ * Returns 0 past the last one. */
+static int SpeechClips_PromptPhrase(int index, char* phrase, size_t size)
 {
-    if (!obj) return "wall";
+    static const AVP_BEHAVIOUR_TYPE operable[] = {
+        I_BehaviourBinarySwitch, I_BehaviourLinkSwitch, I_BehaviourAutoGun, I_BehaviourDatabase
+    };
+
+    for (int c = 0; c < OBSTACLE_CLASS_COUNT; c++) {
+        if (!(g_ObstacleClasses[c].flags & OBSTACLE_FLAG_DOOR)) continue;
+        if (index-- == 0) {
+            AutoNav_DoorPrompt((OBSTACLE_CLASS)c, phrase, size);
+            return 1;
+        }
+    }
+    if (index < (int)(sizeof(operable) / sizeof(operable[0]))) {
+        Interaction_Prompt(operable[index], phrase, size);
+        return 1;
+    }
+    return 0;
+}
 
+/* Classify an obstacle based on its behavior type or geometry */
+static OBSTACLE_CLASS ClassifyObstacle(DISPLAYBLOCK* obj)
+{
     /* If the object has a strategy block, identify by behavior type */
     if (obj->ObStrategyBlock) {
         AVP_BEHAVIOUR_TYPE bhvr = obj->ObStrategyBlock->I_SBtype;
@@ -3607,49 +7694,49 @@ static const char* GetObstacleTypeName(DISPLAYBLOCK* obj)
             /* Enemies */
             case I_BehaviourAlien:
             case I_BehaviourPredatorAlien:
-                return "alien";
+                return OBSTACLE_ALIEN;
             case I_BehaviourQueenAlien:
-                return "queen alien";
+                return OBSTACLE_QUEEN_ALIEN;
             case I_BehaviourFaceHugger:
-                return "facehugger";
+                return OBSTACLE_FACEHUGGER;
             case I_BehaviourPredator:
             case I_BehaviourDormantPredator:
-                return "predator";
+                return OBSTACLE_PREDATOR;
             case I_BehaviourXenoborg:
-                return "xenoborg";
+                return OBSTACLE_XENOBORG;
             case I_BehaviourMarine:
             case I_BehaviourSeal:
-                return "marine";
+                return OBSTACLE_MARINE;
             case I_BehaviourAutoGun:
-                return "autogun";
+                return OBSTACLE_AUTOGUN;
 
             /* Doors */
             case I_BehaviourProximityDoor:
-                return "proximity door";
+                return OBSTACLE_PROXIMITY_DOOR;
             case I_BehaviourLiftDoor:
-                return "lift door";
+                return OBSTACLE_LIFT_DOOR;
             case I_BehaviourSwitchDoor:
-                return "door";
+                return OBSTACLE_DOOR;
 
             /* Interactive */
             case I_BehaviourBinarySwitch:
             case I_BehaviourLinkSwitch:
-                return "switch";
+                return OBSTACLE_SWITCH;
             case I_BehaviourLift:
             case I_BehaviourPlatform:
-                return "lift";
+                return OBSTACLE_LIFT;
             case I_BehaviourGenerator:
-                return "generator";
+                return OBSTACLE_GENERATOR;
             case I_BehaviourDatabase:
-                return "terminal";
+                return OBSTACLE_TERMINAL;
             case I_BehaviourPowerCable:
-                return "power cable";
+                return OBSTACLE_POWER_CABLE;
             case I_BehaviourFan:
-                return "fan";
+                return OBSTACLE_FAN;
             case I_BehaviourDeathVolume:
-                return "hazard";
+                return OBSTACLE_HAZARD;
             case I_BehaviourSelfDestruct:
-                return "self-destruct console";
+                return OBSTACLE_SELF_DESTRUCT;
 
             /* Projectiles (shouldn't hit these usually) */
             case I_BehaviourGrenade:
@@ -3658,28 +7745,28 @@ static const char* GetObstacleTypeName(DISPLAYBLOCK* obj)
             case I_BehaviourFragmentationGrenade:
             case I_BehaviourProximityGrenade:
             case I_BehaviourClusterGrenade:
-                return "grenade";
+                return OBSTACLE_GRENADE;
             case I_BehaviourRocket:
-                return "rocket";
+                return OBSTACLE_ROCKET;
 
             /* Objects */
             case I_BehaviourInanimateObject:
-                return "object";
+                return OBSTACLE_OBJECT;
             case I_BehaviourFragment:
             case I_BehaviourHierarchicalFragment:
             case I_BehaviourAlienFragment:
-                return "debris";
+                return OBSTACLE_DEBRIS;
             case I_BehaviourNetCorpse:
-                return "corpse";
+                return OBSTACLE_CORPSE;
 
             /* Placed items */
             case I_BehaviourPlacedHierarchy:
             case I_BehaviourPlacedLight:
-                return "structure";
+                return OBSTACLE_STRUCTURE;
             case I_BehaviourVideoScreen:
-                return "screen";
+                return OBSTACLE_SCREEN;
             case I_BehaviourTrackObject:
-                return "track";
+                return OBSTACLE_TRACK;
 
             default:
                 break;
@@ -3694,56 +7781,251 @@ static const char* GetObstacleTypeName(DISPLAYBLOCK* obj)
 
         /* Very rough classification by size */
         if (maxExtent < 1000) {
-            return "small object";
+            return OBSTACLE_SMALL_OBJECT;
         } else if (maxExtent < 3000) {
-            return "crate";
+            return OBSTACLE_CRATE;
         } else if (maxExtent < 6000) {
-            return "pillar";
+            return OBSTACLE_PILLAR;
         }
     }
 
     /* Default to wall for static geometry */
-    return "wall";
+    return OBSTACLE_WALL;
+}
+
+/* Class of a hit object. An object's behaviour type never changes, so the
+ * class is worked out on the first hit and kept in the display block; the
+ * engine clears the block when it is reused for another object. */
+static OBSTACLE_CLASS GetObstacleClass(DISPLAYBLOCK* obj)
+{
+    if (!obj) return OBSTACLE_WALL;
+
+    int cached = obj->ObAccessClass - 1;
+    if (cached < 0 || cached >= OBSTACLE_CLASS_COUNT) {
+        cached = ClassifyObstacle(obj);
+        obj->ObAccessClass = cached + 1;
+    }
+    return (OBSTACLE_CLASS)cached;
 }
 
 /* Note: RAY_RESULT typedef is declared earlier (before AutoNav_Update) for forward reference */
 
-/* Cast a ray in a direction and return distance to hit (0 if no hit) */
-static int CastObstructionRay(VECTORCH* origin, VECTORCH* direction, int maxRange)
+/* ============================================
+ * Obstruction Ray Cache
+ * Fans cast from (nearly) the same spot, facing and module reuse the
+ * previous hits until something in range of the rays changes state
+ * ============================================ */
+
+#define RAYCACHE_ENTRIES 8
+#define RAYCACHE_MOVE_TOLERANCE 500         /* mm the origin may drift from the cached cast */
+#define RAYCACHE_DIR_TOLERANCE (ONE_FIXED / 32)  /* Per-component drift (~2 degrees) */
+#define RAYCACHE_MAX_AGE_MS 1000            /* Recast regardless after this long */
+#define RAYCACHE_OBJECT_MARGIN 4000         /* Objects this far beyond maxRange can't be hit */
+#define RAYCACHE_STATS_INTERVAL 1024
+
+typedef struct {
+    int used;
+    int module;                 /* AI module index of the player at cast time */
+    int count;
+    int maxRange;
+    unsigned int stamp;         /* RayCache_SceneStamp at cast time */
+    unsigned int time;
+    VECTORCH origin;
+    VECTORCH dirs[LOS_FAN_MAX_RAYS];
+    RAY_RESULT results[LOS_FAN_MAX_RAYS];
+} RAYCACHE_ENTRY;
+
+static RAYCACHE_ENTRY g_RayCache[RAYCACHE_ENTRIES];
+static unsigned int g_RayCacheLookups = 0;
+static unsigned int g_RayCacheHits = 0;
+
+static unsigned int RayCache_Mix(unsigned int h, unsigned int v)
+{
+    return (h ^ v) * 16777619u;
+}
+
+typedef struct {
+    unsigned int sum;
+    int count;
+} RAYCACHE_STAMP;
+
+/* Hash one block's state into the stamp. The per-block hashes are summed,
+ * so the order the index hands blocks over in doesn't matter. */
+static int RayCache_StampBlock(STRATEGYBLOCK* sb, int distance, void* visitContext)
+{
+    RAYCACHE_STAMP* stamp = (RAYCACHE_STAMP*)visitContext;
+    VECTORCH* pos = sb->DynPtr ? &sb->DynPtr->Position : &sb->SBmoptr->m_world;
+    unsigned int h = 2166136261u;
+    (void)distance;
+
+    if (sb == Player->ObStrategyBlock) return 1;
+
+    h = RayCache_Mix(h, (unsigned int)(size_t)sb);
+    h = RayCache_Mix(h, (unsigned int)(pos->vx >> 7));
+    h = RayCache_Mix(h, (unsigned int)(pos->vy >> 7));
+    h = RayCache_Mix(h, (unsigned int)(pos->vz >> 7));
+    h = RayCache_Mix(h, sb->SBmorphctrl ? (unsigned int)sb->SBmorphctrl->ObMorphCurrFrame : 0u);
+    h = RayCache_Mix(h, (unsigned int)(sb->SBDamageBlock.Health >> ONE_FIXED_SHIFT));
+    h = RayCache_Mix(h, sb->SBdptr ? 1u : 0u);
+    stamp->sum += h;
+    stamp->count++;
+    return 1;
+}
+
+/* Hash the state of everything that could change what the rays hit:
+ * doors (morph frame), lifts and characters (position), destructibles
+ * (health and whether they still have a display block). Anything that
+ * appears or disappears changes the count. Static geometry can't change,
+ * so it isn't included. Only blocks the spatial index has within reach
+ * of the rays are looked at. */
+static unsigned int RayCache_SceneStamp(VECTORCH* origin, int maxRange)
 {
-    /* Initialize LOS globals */
-    LOS_ObjectHitPtr = NULL;
-    LOS_Lambda = maxRange;
+    RAYCACHE_STAMP stamp = { 0u, 0 };
+
+    SpatialIndex_Visit(origin->vx, origin->vy, origin->vz, maxRange + RAYCACHE_OBJECT_MARGIN,
+                       SPATIAL_ALL_BLOCKS, NULL, NULL, RayCache_StampBlock, &stamp);
+    return RayCache_Mix(stamp.sum, (unsigned int)stamp.count);
+}
 
-    /* Cast the ray */
-    FindPolygonInLineOfSight(direction, origin, 0, Player);
+static int RayCache_PlayerModule(void)
+{
+    STRATEGYBLOCK* sb = Player->ObStrategyBlock;
+    if (!sb || !sb->containingModule || !sb->containingModule->m_aimodule) return -1;
+    return sb->containingModule->m_aimodule->m_index;
+}
 
-    if (LOS_ObjectHitPtr != NULL || LOS_Lambda < maxRange) {
-        LOG_DBG("Ray hit at distance %d (obj=%p)", LOS_Lambda, (void*)LOS_ObjectHitPtr);
-        return LOS_Lambda;
+/* Find an entry usable for this fan; on a hit the results are copied out with
+ * each distance corrected for how far the origin has moved along that ray */
+static int RayCache_Lookup(VECTORCH* origin, VECTORCH* directions, int count, int maxRange,
+                           int module, unsigned int stamp, unsigned int now, RAY_RESULT* results)
+{
+    for (int e = 0; e < RAYCACHE_ENTRIES; e++) {
+        RAYCACHE_ENTRY* entry = &g_RayCache[e];
+        if (!entry->used || entry->module != module || entry->count != count ||
+            entry->maxRange != maxRange || entry->stamp != stamp) continue;
+        if (now - entry->time > RAYCACHE_MAX_AGE_MS) continue;
+
+        int mx = origin->vx - entry->origin.vx;
+        int my = origin->vy - entry->origin.vy;
+        int mz = origin->vz - entry->origin.vz;
+        if (abs(mx) > RAYCACHE_MOVE_TOLERANCE || abs(my) > RAYCACHE_MOVE_TOLERANCE ||
+            abs(mz) > RAYCACHE_MOVE_TOLERANCE) continue;
+
+        int i;
+        for (i = 0; i < count; i++) {
+            if (abs(directions[i].vx - entry->dirs[i].vx) > RAYCACHE_DIR_TOLERANCE ||
+                abs(directions[i].vy - entry->dirs[i].vy) > RAYCACHE_DIR_TOLERANCE ||
+                abs(directions[i].vz - entry->dirs[i].vz) > RAYCACHE_DIR_TOLERANCE) break;
+        }
+        if (i < count) continue;
+
+        /* A hit we have walked past (or up to) can't be trusted - recast */
+        for (i = 0; i < count; i++) {
+            results[i] = entry->results[i];
+            if (results[i].distance <= 0) continue;
+
+            VECTORCH dir = directions[i];
+            Normalise(&dir);
+            VECTORCH move = {mx, my, mz};
+            results[i].distance -= DotProduct(&move, &dir);
+            if (results[i].distance <= 0) break;
+        }
+        if (i < count) {
+            entry->used = 0;
+            return 0;
+        }
+        return 1;
     }
-    return 0;  /* No obstruction within range */
+    return 0;
 }
 
-/* Cast a ray and return detailed result including what was hit */
-static RAY_RESULT CastObstructionRayEx(VECTORCH* origin, VECTORCH* direction, int maxRange)
+static void RayCache_Store(VECTORCH* origin, VECTORCH* directions, int count, int maxRange,
+                           int module, unsigned int stamp, unsigned int now, RAY_RESULT* results)
+{
+    /* Replace a free slot, else the oldest */
+    RAYCACHE_ENTRY* entry = &g_RayCache[0];
+    for (int e = 0; e < RAYCACHE_ENTRIES; e++) {
+        if (!g_RayCache[e].used) {
+            entry = &g_RayCache[e];
+            break;
+        }
+        if (now - g_RayCache[e].time > now - entry->time) entry = &g_RayCache[e];
+    }
+
+    entry->used = 1;
+    entry->module = module;
+    entry->count = count;
+    entry->maxRange = maxRange;
+    entry->stamp = stamp;
+    entry->time = now;
+    entry->origin = *origin;
+    for (int i = 0; i < count; i++) {
+        entry->dirs[i] = directions[i];
+        entry->results[i] = results[i];
+    }
+}
+
+static void RayCache_Flush(void)
+{
+    for (int e = 0; e < RAYCACHE_ENTRIES; e++) {
+        g_RayCache[e].used = 0;
+    }
+}
+
+/* Cast several rays from one point in a single pass over the scene.
+ * Each object and polygon is fetched once for the whole fan (see los.c),
+ * so this is much cheaper than one CastObstructionRayEx per direction.
+ * Results are reused from the ray cache while the player hasn't moved or
+ * turned much and nothing nearby has changed.
+ * Only hits within maxRange are reported. */
+static void CastObstructionFan(VECTORCH* origin, VECTORCH* directions, int count, int maxRange, RAY_RESULT* results)
 {
-    RAY_RESULT result = {0, NULL, "clear"};
+    LOS_RAY_RESULT hits[LOS_FAN_MAX_RAYS];
+    Uint64 profStart = Prof_Begin();
 
-    /* Initialize LOS globals */
-    LOS_ObjectHitPtr = NULL;
-    LOS_Lambda = maxRange;
+    if (count > LOS_FAN_MAX_RAYS) count = LOS_FAN_MAX_RAYS;
+
+    int module = RayCache_PlayerModule();
+    unsigned int stamp = RayCache_SceneStamp(origin, maxRange);
+    unsigned int now = GetTickCount();
 
-    /* Cast the ray */
-    FindPolygonInLineOfSight(direction, origin, 0, Player);
+    g_RayCacheLookups++;
+    if (RayCache_Lookup(origin, directions, count, maxRange, module, stamp, now, results)) {
+        g_RayCacheHits++;
+    } else {
+        FindPolygonsInLineOfSight_Fan(directions, count, origin, maxRange, 0, Player, hits);
+
+        for (int i = 0; i < count; i++) {
+            results[i].distance = 0;
+            results[i].hitObj = NULL;
+            results[i].obstacleClass = OBSTACLE_CLEAR;
+            results[i].flags = 0;
+            results[i].hitPoint = hits[i].Point;
+
+            if (hits[i].ObjectHitPtr != NULL) {
+                results[i].distance = hits[i].Lambda;
+                results[i].hitObj = hits[i].ObjectHitPtr;
+                results[i].obstacleClass = GetObstacleClass(hits[i].ObjectHitPtr);
+                results[i].flags = g_ObstacleClasses[results[i].obstacleClass].flags;
+                LOG_DBG("Fan ray %d hit '%s' at distance %d", i, GetObstacleName(results[i].obstacleClass), results[i].distance);
+            }
+        }
+        RayCache_Store(origin, directions, count, maxRange, module, stamp, now, results);
+    }
 
-    if (LOS_ObjectHitPtr != NULL || LOS_Lambda < maxRange) {
-        result.distance = LOS_Lambda;
-        result.hitObj = LOS_ObjectHitPtr;
-        result.typeName = GetObstacleTypeName(LOS_ObjectHitPtr);
-        LOG_DBG("RayEx hit '%s' at distance %d", result.typeName, result.distance);
+    if (g_RayCacheLookups % RAYCACHE_STATS_INTERVAL == 0) {
+        LOG_DBG("Ray cache: %u of last %u fans reused", g_RayCacheHits, (unsigned int)RAYCACHE_STATS_INTERVAL);
+        g_RayCacheHits = 0;
     }
 
+    Prof_End(PROF_ZONE_RAYCAST, profStart);
+}
+
+/* Cast a ray and return detailed result including what was hit */
+static RAY_RESULT CastObstructionRayEx(VECTORCH* origin, VECTORCH* direction, int maxRange)
+{
+    RAY_RESULT result;
+    CastObstructionFan(origin, direction, 1, maxRange, &result);
     return result;
 }
 
@@ -3784,12 +8066,6 @@ extern "C" void Obstruction_Update(void)
     if (!g_ObstructionState.enabled || !Accessibility_IsAvailable()) return;
     if (!Player || !Player->ObStrategyBlock || !Player->ObStrategyBlock->DynPtr) return;
 
-    /* Only check every N frames for performance */
-    static int frameCounter = 0;
-    frameCounter++;
-    if (frameCounter < OBSTRUCTION_CHECK_INTERVAL) return;
-    frameCounter = 0;
-
     DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
     VECTORCH playerPos = playerDyn->Position;
 
@@ -3816,17 +8092,24 @@ extern "C" void Obstruction_Update(void)
     up.vy = -ONE_FIXED;  /* Up in AVP coordinate system */
     up.vz = 0;
 
-    /* Cast rays in each direction */
+    VECTORCH right;
+    right.vx = -left.vx;
+    right.vy = -left.vy;
+    right.vz = -left.vz;
+
+    /* Cast forward, left and right as one fan */
     int maxRange = OBSTRUCTION_FAR_DIST * 2;
+    VECTORCH dirs[3] = { forward, left, right };
+    RAY_RESULT hits[3];
+    CastObstructionFan(&playerPos, dirs, 3, maxRange, hits);
 
     /* Forward ray */
-    int forwardDist = CastObstructionRay(&playerPos, &forward, maxRange);
-    if (forwardDist > 0) {
+    if (hits[0].distance > 0) {
         g_ObstructionState.forward_blocked = 1;
-        g_ObstructionState.forward_distance = forwardDist;
+        g_ObstructionState.forward_distance = hits[0].distance;
 
         /* Analyze if jumpable */
-        AnalyzeObstruction(&playerPos, &LOS_Point,
+        AnalyzeObstruction(&playerPos, &hits[0].hitPoint,
                           &g_ObstructionState.forward_is_jumpable,
                           &g_ObstructionState.forward_is_clearable);
     } else {
@@ -3834,15 +8117,8 @@ extern "C" void Obstruction_Update(void)
         g_ObstructionState.forward_distance = 0;
     }
 
-    /* Left ray */
-    g_ObstructionState.left_distance = CastObstructionRay(&playerPos, &left, maxRange);
-
-    /* Right ray */
-    VECTORCH right;
-    right.vx = -left.vx;
-    right.vy = -left.vy;
-    right.vz = -left.vz;
-    g_ObstructionState.right_distance = CastObstructionRay(&playerPos, &right, maxRange);
+    g_ObstructionState.left_distance = hits[1].distance;
+    g_ObstructionState.right_distance = hits[2].distance;
 
     /* Automatic alerts for very close obstructions */
     if (AccessibilitySettings.navigation_cues_enabled) {
@@ -3875,23 +8151,22 @@ extern "C" void Obstruction_Update(void)
             }
 
             /* Only announce after debounce threshold AND if type changed OR enough time passed (3 seconds)
-             * AND if priority system allows it (not during damage cooldown) */
+             * AND if the arbiter lets it through (not during damage cooldown) */
             if (debounceCounter >= 3 &&
-                Announcement_IsAllowed(ANNOUNCE_PRIORITY_HIGH) &&
                 (strcmp(alertType, lastAutoAlertType) != 0 ||
                  (currentTime - lastAutoAlertTime) > 3000)) {
+                const char* alertText = "Wall ahead.";
 
                 if (g_ObstructionState.forward_is_jumpable) {
-                    TTS_SpeakQueued("Step ahead.");
+                    alertText = "Step ahead.";
                 } else if (g_ObstructionState.forward_is_clearable) {
-                    TTS_SpeakQueued("Low obstacle. Jump.");
-                } else {
-                    TTS_SpeakQueued("Wall ahead.");
+                    alertText = "Low obstacle. Jump.";
                 }
 
-                Announcement_RecordTime(ANNOUNCE_PRIORITY_HIGH);
-                strncpy(lastAutoAlertType, alertType, sizeof(lastAutoAlertType) - 1);
-                lastAutoAlertTime = currentTime;
+                if (Announce("obstruction", alertText)) {
+                    strncpy(lastAutoAlertType, alertType, sizeof(lastAutoAlertType) - 1);
+                    lastAutoAlertTime = currentTime;
+                }
             }
             g_ObstructionState.last_announced_forward = g_ObstructionState.forward_distance;
         } else {
@@ -3911,21 +8186,8 @@ extern "C" void Obstruction_Update(void)
     }
 }
 
-/* Check if a type is an interactive object that can be operated */
-static int IsInteractiveType(const char* typeName)
-{
-    return (strcmp(typeName, "door") == 0 ||
-            strcmp(typeName, "proximity door") == 0 ||
-            strcmp(typeName, "lift door") == 0 ||
-            strcmp(typeName, "switch") == 0 ||
-            strcmp(typeName, "lift") == 0 ||
-            strcmp(typeName, "terminal") == 0 ||
-            strcmp(typeName, "generator") == 0 ||
-            strcmp(typeName, "self-destruct console") == 0);
-}
-
 /* Get navigation guidance string based on left/right clearance */
-static const char* GetNavigationGuidance(VECTORCH* playerPos, DYNAMICSBLOCK* playerDyn, const char* typeName)
+static const char* GetNavigationGuidance(VECTORCH* playerPos, DYNAMICSBLOCK* playerDyn, OBSTACLE_CLASS obstacleClass)
 {
     /* Cast rays left and right to check clearance */
     VECTORCH left, right;
@@ -3940,8 +8202,11 @@ static const char* GetNavigationGuidance(VECTORCH* playerPos, DYNAMICSBLOCK* pla
     Normalise(&right);
 
     int maxRange = 8000;  /* 8 meters */
-    int leftClear = CastObstructionRay(playerPos, &left, maxRange);
-    int rightClear = CastObstructionRay(playerPos, &right, maxRange);
+    VECTORCH dirs[2] = { left, right };
+    RAY_RESULT hits[2];
+    CastObstructionFan(playerPos, dirs, 2, maxRange, hits);
+    int leftClear = hits[0].distance;
+    int rightClear = hits[1].distance;
 
     /* Convert 0 (no hit) to max range for comparison */
     if (leftClear == 0) leftClear = maxRange;
@@ -3950,20 +8215,8 @@ static const char* GetNavigationGuidance(VECTORCH* playerPos, DYNAMICSBLOCK* pla
     LOG_DBG("Navigation guidance: L=%d R=%d", leftClear, rightClear);
 
     /* Interactive objects have special guidance */
-    if (IsInteractiveType(typeName)) {
-        if (strcmp(typeName, "door") == 0 ||
-            strcmp(typeName, "proximity door") == 0 ||
-            strcmp(typeName, "lift door") == 0 ||
-            strcmp(typeName, "switch") == 0) {
-            return "Press SPACE to operate.";
-        }
-        if (strcmp(typeName, "lift") == 0) {
-            return "Step on to ride.";
-        }
-        if (strcmp(typeName, "terminal") == 0 ||
-            strcmp(typeName, "generator") == 0) {
-            return "Press SPACE to interact.";
-        }
+    if (g_ObstacleClasses[obstacleClass].guidance) {
+        return g_ObstacleClasses[obstacleClass].guidance;
     }
 
     /* For non-interactive obstacles, suggest direction */
@@ -4019,10 +8272,10 @@ extern "C" void Obstruction_AnnounceAhead(void)
 
     if (result.distance > 0) {
         int isJumpable, isClearable;
-        AnalyzeObstruction(&playerPos, &LOS_Point, &isJumpable, &isClearable);
+        AnalyzeObstruction(&playerPos, &result.hitPoint, &isJumpable, &isClearable);
 
         const char* distDesc = GetDistanceDescription(result.distance);
-        const char* typeName = result.typeName;
+        const char* typeName = GetObstacleName(result.obstacleClass);
         const char* guidance = "";
 
         /* Log what was detected */
@@ -4031,7 +8284,7 @@ extern "C" void Obstruction_AnnounceAhead(void)
 
         /* Get navigation guidance for obstacles that can't be traversed */
         if (!isJumpable && !isClearable) {
-            guidance = GetNavigationGuidance(&playerPos, playerDyn, typeName);
+            guidance = GetNavigationGuidance(&playerPos, playerDyn, result.obstacleClass);
         }
 
         if (isJumpable) {
@@ -4055,7 +8308,7 @@ extern "C" void Obstruction_AnnounceAhead(void)
         }
 
         /* Play directional tone - centered since it's directly ahead */
-        NavTone_PlayDirectional(0.0f, 0.0f);
+        NavTone_PlayDirectional(0.0f, 0.0f, result.distance);
     } else {
         snprintf(announcement, sizeof(announcement), "Clear ahead.");
     }
@@ -4074,7 +8327,7 @@ extern "C" void Obstruction_AnnounceAhead(void)
     } else {
         /* Same announcement recently - just play tone without TTS */
         if (result.distance > 0) {
-            NavTone_PlayDirectional(0.0f, 0.0f);
+            NavTone_PlayDirectional(0.0f, 0.0f, result.distance);
         }
     }
 }
@@ -4114,10 +8367,13 @@ extern "C" void Obstruction_AnnounceSurroundings(void)
     int maxRange = OBSTRUCTION_FAR_DIST * 2;
 
     /* Use extended ray casts to get type information */
-    RAY_RESULT frontResult = CastObstructionRayEx(&playerPos, &forward, maxRange);
-    RAY_RESULT leftResult = CastObstructionRayEx(&playerPos, &left, maxRange);
-    RAY_RESULT rightResult = CastObstructionRayEx(&playerPos, &right, maxRange);
-    RAY_RESULT backResult = CastObstructionRayEx(&playerPos, &back, maxRange);
+    VECTORCH dirs[4] = { forward, left, right, back };
+    RAY_RESULT hits[4];
+    CastObstructionFan(&playerPos, dirs, 4, maxRange, hits);
+    RAY_RESULT frontResult = hits[0];
+    RAY_RESULT leftResult = hits[1];
+    RAY_RESULT rightResult = hits[2];
+    RAY_RESULT backResult = hits[3];
 
     char announcement[512];
     char* ptr = announcement;
@@ -4127,7 +8383,7 @@ extern "C" void Obstruction_AnnounceSurroundings(void)
     /* Front */
     if (frontResult.distance > 0 && frontResult.distance < maxRange) {
         written = snprintf(ptr, remaining, "Front: %s, %d meters. ",
-                          frontResult.typeName, frontResult.distance / 1000);
+                          GetObstacleName(frontResult.obstacleClass), frontResult.distance / 1000);
         ptr += written;
         remaining -= written;
     } else {
@@ -4139,7 +8395,7 @@ extern "C" void Obstruction_AnnounceSurroundings(void)
     /* Left */
     if (leftResult.distance > 0 && leftResult.distance < maxRange) {
         written = snprintf(ptr, remaining, "Left: %s, %d meters. ",
-                          leftResult.typeName, leftResult.distance / 1000);
+                          GetObstacleName(leftResult.obstacleClass), leftResult.distance / 1000);
         ptr += written;
         remaining -= written;
     } else {
@@ -4151,7 +8407,7 @@ extern "C" void Obstruction_AnnounceSurroundings(void)
     /* Right */
     if (rightResult.distance > 0 && rightResult.distance < maxRange) {
         written = snprintf(ptr, remaining, "Right: %s, %d meters. ",
-                          rightResult.typeName, rightResult.distance / 1000);
+                          GetObstacleName(rightResult.obstacleClass), rightResult.distance / 1000);
         ptr += written;
         remaining -= written;
     } else {
@@ -4163,16 +8419,16 @@ extern "C" void Obstruction_AnnounceSurroundings(void)
     /* Back */
     if (backResult.distance > 0 && backResult.distance < maxRange) {
         written = snprintf(ptr, remaining, "Back: %s, %d meters.",
-                          backResult.typeName, backResult.distance / 1000);
+                          GetObstacleName(backResult.obstacleClass), backResult.distance / 1000);
     } else {
         written = snprintf(ptr, remaining, "Back clear.");
     }
 
     LOG_INF("Surroundings: F=%s@%d L=%s@%d R=%s@%d B=%s@%d",
-            frontResult.typeName, frontResult.distance,
-            leftResult.typeName, leftResult.distance,
-            rightResult.typeName, rightResult.distance,
-            backResult.typeName, backResult.distance);
+            GetObstacleName(frontResult.obstacleClass), frontResult.distance,
+            GetObstacleName(leftResult.obstacleClass), leftResult.distance,
+            GetObstacleName(rightResult.obstacleClass), rightResult.distance,
+            GetObstacleName(backResult.obstacleClass), backResult.distance);
 
     TTS_Speak(announcement);
 }
@@ -4198,41 +8454,15 @@ static const char* GetSpatialDescription(int distance)
     return "in the distance";                       /* > 10m */
 }
 
-/* Priority for sorting - lower = more important (announced first) */
-static int GetFeaturePriority(const char* typeName)
-{
-    /* Enemies - highest priority */
-    if (strcmp(typeName, "alien") == 0 || strcmp(typeName, "queen alien") == 0 ||
-        strcmp(typeName, "facehugger") == 0 || strcmp(typeName, "predator") == 0 ||
-        strcmp(typeName, "xenoborg") == 0 || strcmp(typeName, "marine") == 0 ||
-        strcmp(typeName, "autogun") == 0) {
-        return 0;
-    }
-    /* Interactive elements - high priority */
-    if (strcmp(typeName, "door") == 0 || strcmp(typeName, "proximity door") == 0 ||
-        strcmp(typeName, "lift door") == 0 || strcmp(typeName, "switch") == 0 ||
-        strcmp(typeName, "lift") == 0 || strcmp(typeName, "terminal") == 0 ||
-        strcmp(typeName, "generator") == 0 || strcmp(typeName, "self-destruct console") == 0) {
-        return 1;
-    }
-    /* Notable objects */
-    if (strcmp(typeName, "crate") == 0 || strcmp(typeName, "pillar") == 0 ||
-        strcmp(typeName, "object") == 0 || strcmp(typeName, "structure") == 0) {
-        return 2;
-    }
-    /* Walls - lowest priority */
-    return 3;
-}
-
 /* Environment scan result */
 typedef struct {
     const char* direction;  /* "ahead", "to your left", etc. */
-    const char* typeName;   /* What's there */
+    OBSTACLE_CLASS obstacleClass;   /* What's there */
     int distance;           /* Distance in game units */
     int priority;           /* For sorting */
 } ENV_SCAN_ENTRY;
 
-/* Compare function for sorting environment entries */
+/* Ranking for the features worth announcing */
 static int CompareEnvEntries(const void* a, const void* b)
 {
     const ENV_SCAN_ENTRY* entryA = (const ENV_SCAN_ENTRY*)a;
@@ -4246,6 +8476,167 @@ static int CompareEnvEntries(const void* a, const void* b)
     return entryA->distance - entryB->distance;
 }
 
+/*
+ * The sweep runs as a scheduler task a couple of rays per frame rather
+ * than casting all ten on the frame the key is pressed. Directions are
+ * fixed from the pose at the key press and swept front first. What lies
+ * ahead and any enemy are spoken as soon as their ray is in; the most
+ * important of the remaining features follow once the sweep completes.
+ */
+#define ENV_SWEEP_DIRS 10
+#define ENV_SWEEP_RAYS_PER_RUN 2
+#define ENV_MAX_FEATURES 6          /* Features spoken per sweep */
+
+static const char* g_EnvDirNames[ENV_SWEEP_DIRS] = {
+    "ahead",
+    "ahead to your right",
+    "to your right",
+    "behind to your right",
+    "behind you",
+    "behind to your left",
+    "to your left",
+    "ahead to your left",
+    "above",
+    "below"
+};
+
+/* Front first, then the sides, then behind and vertical */
+static const int g_EnvSweepOrder[ENV_SWEEP_DIRS] = { 0, 1, 7, 2, 6, 3, 5, 4, 8, 9 };
+
+typedef struct {
+    int next;                       /* Position in g_EnvSweepOrder */
+    int spoken;                     /* Something has been said this sweep */
+    int maxRange;
+    VECTORCH origin;
+    VECTORCH dirs[ENV_SWEEP_DIRS];
+    ENV_SCAN_ENTRY entries[ENV_SWEEP_DIRS];
+    int entrySpoken[ENV_SWEEP_DIRS];
+    int numEntries;
+    int numSpoken;
+    int numClear;
+} ENV_SWEEP;
+
+static ENV_SWEEP g_EnvSweep;
+
+/* "Alien nearby to your left, 3 meters. " */
+static int Environment_FormatFeature(char* out, int size, const ENV_SCAN_ENTRY* entry)
+{
+    const char* spatial = GetSpatialDescription(entry->distance);
+    int distMeters = entry->distance / 1000;
+    int written;
+
+    if (distMeters < 1) distMeters = 1;
+
+    if (strlen(spatial) > 0) {
+        written = snprintf(out, size, "%s %s %s, %d meters. ",
+                           GetObstacleName(entry->obstacleClass), spatial, entry->direction, distMeters);
+    } else {
+        written = snprintf(out, size, "%s %s, %d meters. ",
+                           GetObstacleName(entry->obstacleClass), entry->direction, distMeters);
+    }
+    if (written < 0) return 0;
+    if (written >= size) written = size - 1;
+
+    /* Capitalize first letter of each sentence */
+    if (out[0] >= 'a' && out[0] <= 'z') {
+        out[0] -= 32;
+    }
+    return written;
+}
+
+/* The first part of a sweep replaces whatever was being said, the rest follows it */
+static void Environment_Speak(const char* text)
+{
+    if (!g_EnvSweep.spoken) {
+        TTS_Speak(text);
+    } else {
+        TTS_SpeakQueued(text);
+    }
+    g_EnvSweep.spoken = 1;
+}
+
+static void Environment_SpeakFeature(char* out, int size, int* used, int index)
+{
+    *used += Environment_FormatFeature(out + *used, size - *used, &g_EnvSweep.entries[index]);
+    g_EnvSweep.entrySpoken[index] = 1;
+    g_EnvSweep.numSpoken++;
+}
+
+/* Cast the next few rays; speak what can't wait and, at the end, the rest */
+extern "C" void Environment_UpdateSweep(void)
+{
+    if (!g_EnvSweepActive) return;
+
+    char announcement[1024];
+    int used = 0;
+    int firstNew = g_EnvSweep.numEntries;
+    int batch = ENV_SWEEP_DIRS - g_EnvSweep.next;
+    if (batch > ENV_SWEEP_RAYS_PER_RUN) batch = ENV_SWEEP_RAYS_PER_RUN;
+
+    VECTORCH dirs[ENV_SWEEP_RAYS_PER_RUN];
+    RAY_RESULT hits[ENV_SWEEP_RAYS_PER_RUN];
+    for (int i = 0; i < batch; i++) {
+        dirs[i] = g_EnvSweep.dirs[g_EnvSweepOrder[g_EnvSweep.next + i]];
+    }
+    CastObstructionFan(&g_EnvSweep.origin, dirs, batch, g_EnvSweep.maxRange, hits);
+
+    announcement[0] = '\0';
+    for (int i = 0; i < batch; i++) {
+        int dir = g_EnvSweepOrder[g_EnvSweep.next + i];
+
+        if (hits[i].distance > 0 && hits[i].distance < g_EnvSweep.maxRange) {
+            ENV_SCAN_ENTRY* entry = &g_EnvSweep.entries[g_EnvSweep.numEntries];
+            entry->direction = g_EnvDirNames[dir];
+            entry->obstacleClass = hits[i].obstacleClass;
+            entry->distance = hits[i].distance;
+            entry->priority = g_ObstacleClasses[hits[i].obstacleClass].priority;
+            g_EnvSweep.entrySpoken[g_EnvSweep.numEntries] = 0;
+            g_EnvSweep.numEntries++;
+        } else {
+            g_EnvSweep.numClear++;
+            if (dir == 0) {
+                used += snprintf(announcement + used, sizeof(announcement) - used, "Open path ahead. ");
+            }
+        }
+    }
+
+    /* Whatever blocks the way ahead, and enemies anywhere, are said at once */
+    for (int i = firstNew; i < g_EnvSweep.numEntries && g_EnvSweep.numSpoken < ENV_MAX_FEATURES; i++) {
+        if (g_EnvSweep.entries[i].direction == g_EnvDirNames[0] ||
+            (g_ObstacleClasses[g_EnvSweep.entries[i].obstacleClass].flags & OBSTACLE_FLAG_ENEMY)) {
+            Environment_SpeakFeature(announcement, sizeof(announcement), &used, i);
+        }
+    }
+
+    g_EnvSweep.next += batch;
+    if (g_EnvSweep.next >= ENV_SWEEP_DIRS) {
+        g_EnvSweepActive = 0;
+
+        /* The most important of the rest (priority, then distance) */
+        ENV_SCAN_ENTRY rest[ENV_MAX_FEATURES];
+        TOPK features;
+        TopK_Init(&features, rest, sizeof(ENV_SCAN_ENTRY), ENV_MAX_FEATURES - g_EnvSweep.numSpoken,
+                  CompareEnvEntries);
+        for (int i = 0; i < g_EnvSweep.numEntries; i++) {
+            if (!g_EnvSweep.entrySpoken[i]) TopK_Offer(&features, &g_EnvSweep.entries[i]);
+        }
+        int numRest = TopK_Finish(&features);
+        for (int i = 0; i < numRest; i++) {
+            used += Environment_FormatFeature(announcement + used, sizeof(announcement) - used, &rest[i]);
+        }
+
+        /* If nothing detected, mention all clear */
+        if (g_EnvSweep.numEntries == 0) {
+            snprintf(announcement + used, sizeof(announcement) - used, "Area is clear in all directions.");
+        }
+
+        LOG_INF("Environment scan: %d features detected, %d clear directions",
+                g_EnvSweep.numEntries, g_EnvSweep.numClear);
+    }
+
+    if (announcement[0]) Environment_Speak(announcement);
+}
+
 /* Describe the environment in all directions */
 extern "C" void Environment_Describe(void)
 {
@@ -4260,8 +8651,13 @@ extern "C" void Environment_Describe(void)
     }
 
     DYNAMICSBLOCK* playerDyn = Player->ObStrategyBlock->DynPtr;
-    VECTORCH playerPos = playerDyn->Position;
-    playerPos.vy -= 800;  /* Chest height */
+    VECTORCH* dirs = g_EnvSweep.dirs;
+
+    /* Pressing again restarts the sweep from the current pose */
+    memset(&g_EnvSweep, 0, sizeof(g_EnvSweep));
+    g_EnvSweep.origin = playerDyn->Position;
+    g_EnvSweep.origin.vy -= 800;  /* Chest height */
+    g_EnvSweep.maxRange = OBSTRUCTION_FAR_DIST * 3;  /* Extended range for environment scan */
 
     /* Get player's forward and right vectors */
     VECTORCH forward, right;
@@ -4275,21 +8671,6 @@ extern "C" void Environment_Describe(void)
     right.vz = playerDyn->OrientMat.mat13;
     Normalise(&right);
 
-    /* Define 8 horizontal directions + up + down */
-    VECTORCH dirs[10];
-    const char* dirNames[10] = {
-        "ahead",
-        "ahead to your right",
-        "to your right",
-        "behind to your right",
-        "behind you",
-        "behind to your left",
-        "to your left",
-        "ahead to your left",
-        "above",
-        "below"
-    };
-
     /* Calculate direction vectors */
     /* Forward (0 degrees) */
     dirs[0] = forward;
@@ -4341,83 +8722,5 @@ extern "C" void Environment_Describe(void)
     dirs[9].vy = ONE_FIXED;
     dirs[9].vz = 0;
 
-    /* Scan all directions */
-    int maxRange = OBSTRUCTION_FAR_DIST * 3;  /* Extended range for environment scan */
-    ENV_SCAN_ENTRY entries[10];
-    int numEntries = 0;
-    int numClearDirs = 0;
-    const char* clearDirections[10];
-
-    for (int i = 0; i < 10; i++) {
-        RAY_RESULT result = CastObstructionRayEx(&playerPos, &dirs[i], maxRange);
-
-        if (result.distance > 0 && result.distance < maxRange) {
-            entries[numEntries].direction = dirNames[i];
-            entries[numEntries].typeName = result.typeName;
-            entries[numEntries].distance = result.distance;
-            entries[numEntries].priority = GetFeaturePriority(result.typeName);
-            numEntries++;
-        } else {
-            /* Track clear directions */
-            clearDirections[numClearDirs++] = dirNames[i];
-        }
-    }
-
-    /* Sort entries by priority (important first) then distance */
-    if (numEntries > 1) {
-        qsort(entries, numEntries, sizeof(ENV_SCAN_ENTRY), CompareEnvEntries);
-    }
-
-    /* Build announcement */
-    char announcement[1024];
-    char* ptr = announcement;
-    int remaining = sizeof(announcement);
-    int written;
-
-    /* Start with clear paths (if any ahead) */
-    int hasOpenPath = 0;
-    for (int i = 0; i < numClearDirs; i++) {
-        if (strcmp(clearDirections[i], "ahead") == 0) {
-            written = snprintf(ptr, remaining, "Open path ahead. ");
-            ptr += written;
-            remaining -= written;
-            hasOpenPath = 1;
-            break;
-        }
-    }
-
-    /* Announce detected features (limit to 6 most important) */
-    int announced = 0;
-    for (int i = 0; i < numEntries && announced < 6; i++) {
-        const char* spatial = GetSpatialDescription(entries[i].distance);
-        int distMeters = entries[i].distance / 1000;
-
-        if (distMeters < 1) distMeters = 1;
-
-        if (strlen(spatial) > 0) {
-            written = snprintf(ptr, remaining, "%s %s %s, %d meters. ",
-                              entries[i].typeName, spatial, entries[i].direction, distMeters);
-        } else {
-            written = snprintf(ptr, remaining, "%s %s, %d meters. ",
-                              entries[i].typeName, entries[i].direction, distMeters);
-        }
-
-        /* Capitalize first letter of each sentence */
-        if (ptr[0] >= 'a' && ptr[0] <= 'z') {
-            ptr[0] -= 32;
-        }
-
-        ptr += written;
-        remaining -= written;
-        announced++;
-    }
-
-    /* If nothing detected, mention all clear */
-    if (numEntries == 0) {
-        snprintf(ptr, remaining, "Area is clear in all directions.");
-    }
-
-    LOG_INF("Environment scan: %d features detected, %d clear directions", numEntries, numClearDirs);
-
-    TTS_Speak(announcement);
+    g_EnvSweepActive = 1;
 }
@@ -2,7 +2,7 @@
  * AVP Accessibility Module
  *
  * Provides accessibility features for blind and visually impaired players:
- * - Text-to-Speech (TTS) using Windows SAPI
+ * - Text-to-Speech (TTS) via Tolk, speech-dispatcher or espeak-ng
  * - Audio radar for enemy/item detection
  * - Player state announcements (health, ammo, weapons)
  * - Navigation audio cues
@@ -60,6 +60,12 @@ int Accessibility_Init(void);
 /* Shutdown the accessibility system - call at game exit */
 void Accessibility_Shutdown(void);
 
+/* Run the per-frame accessibility updates - call once per game frame.
+ * Each update runs at its own fixed real-time rate; lower priority ones
+ * are deferred to a later frame when the frame's time budget is used up.
+ */
+void Accessibility_Update(void);
+
 /* Check if accessibility is available and initialized */
 int Accessibility_IsAvailable(void);
 
@@ -76,6 +82,12 @@ void TTS_SpeakQueued(const char* text);
 /* Speak with priority (always interrupts) */
 void TTS_SpeakPriority(const char* text);
 
+/* Speak through the category's announcement rule: its priority, whether it
+ * replaces a queued, not yet spoken message of the same category (e.g.
+ * successive distance updates), how long it stays current, and how often
+ * the category may speak. Unknown categories queue and replace. */
+void TTS_SpeakCategory(const char* category, const char* text);
+
 /* Stop all current speech */
 void TTS_Stop(void);
 
@@ -137,6 +149,9 @@ typedef struct {
 /* Update the audio radar - call each frame from game loop */
 void AudioRadar_Update(void);
 
+/* Move the radar voices with their contacts and start due pings - every frame */
+void AudioRadar_UpdateVoices(void);
+
 /* Force immediate radar scan and announcement */
 void AudioRadar_ScanNow(void);
 
@@ -153,11 +168,29 @@ const char* AudioRadar_GetDirectionName(AUDIO_DIRECTION dir);
 const char* AudioRadar_GetEntityTypeName(RADAR_ENTITY_TYPE type);
 
 /* ============================================
- * Player State Announcements
+ * Player Events
  * ============================================ */
 
-/* Update player state tracking - call each frame */
-void PlayerState_Update(void);
+/* Changes the engine reports as they happen: value is the new state,
+ * previous the old one */
+typedef enum {
+    ACCESS_EVENT_DAMAGE,            /* Health after the hit, health before (whole points) */
+    ACCESS_EVENT_PICKUP,            /* Object type (IOT_*), subtype */
+    ACCESS_EVENT_WEAPON_SWITCH,     /* New weapon slot, old slot */
+    ACCESS_EVENT_WEAPON_STATE,      /* WEAPONSTATE_* of the selected weapon */
+    ACCESS_EVENT_AMMO,              /* Rounds left in the selected weapon's magazine */
+    ACCESS_EVENT_CLOAK,             /* Predator cloak on/off */
+    ACCESS_EVENT_FIELD_CHARGE,      /* Predator field charge, percent */
+    ACCESS_EVENT_VISION,            /* VISION_MODE_* */
+    ACCESS_EVENT_COUNT
+} ACCESS_EVENT_TYPE;
+
+/* Queue an event; subscribers hear about it on the next Accessibility_Update */
+void Accessibility_PostEvent(ACCESS_EVENT_TYPE type, int value, int previous);
+
+/* ============================================
+ * Player State Announcements
+ * ============================================ */
 
 /* Force announce current health */
 void PlayerState_AnnounceHealth(void);
@@ -264,9 +297,6 @@ void Accessibility_CheckInteraction(void);
  * Weapon State Tracking
  * ============================================ */
 
-/* Track weapon state changes (reload, empty, jammed) and announce */
-void Accessibility_WeaponStateUpdate(void);
-
 /* Announce full player status (health, armor, weapon, ammo) */
 void Accessibility_AnnounceFullStatus(void);
 
@@ -326,6 +356,7 @@ typedef struct {
     int target_x, target_y, target_z;  /* Target world position */
     int target_distance;      /* Distance to target */
     const char* target_name;  /* Name for TTS */
+    void* target_sb;          /* STRATEGYBLOCK* - current target */
 
     /* Position history for loop detection */
     POSITION_RECORD position_history[NAV_POSITION_HISTORY_SIZE];
@@ -339,7 +370,7 @@ typedef struct {
 
     /* Strategy management */
     NAV_STRATEGY current_strategy;
-    int strategy_frames;          /* How long current strategy has been active */
+    int strategy_ms;              /* How long current strategy has been active */
     int strategy_failures;        /* How many times strategies have failed */
 
     /* Door/Lift awareness */
@@ -383,6 +414,10 @@ int PathFind_DetectOscillation(void);
 int PathFind_DetectLoop(int* loopSize);
 void PathFind_EscalateStrategy(void);
 
+/* Drop the module graph and cached routes (call when the level's
+ * far-module data is released; rebuilt on next use) */
+void AutoNav_ResetPlanner(void);
+
 /* Progress and arrival functions */
 void AutoNav_CheckProgress(void);
 void AutoNav_CheckArrival(void);
@@ -463,10 +498,38 @@ void Obstruction_Toggle(void);
 /* Describe the environment in all directions (8 horizontal + up/down)
  * Announces features sorted by priority (enemies first, then interactive, then walls)
  * Includes distance and spatial description (immediately, nearby, in the distance)
- * Bound to Tab key
+ * Bound to Tab key; starts a sweep that Environment_UpdateSweep carries out
  */
 void Environment_Describe(void);
 
+/* Cast the next few rays of a sweep started by Environment_Describe,
+ * speaking findings as they come in (run by the scheduler) */
+void Environment_UpdateSweep(void);
+
+/* ============================================
+ * Spatial Index
+ * ============================================ */
+
+/* Rebuild the grid of strategy block positions used by the accessibility scans.
+ * Call once per frame after ObjectDynamics (queries rebuild it lazily if this
+ * frame's update was missed).
+ */
+void Accessibility_UpdateSpatialIndex(void);
+
+/* ============================================
+ * Profiling
+ * ============================================ */
+
+/* Read out frame-time statistics for the accessibility layer: the whole
+ * update and the costliest zones on screen, every zone to the log (and the
+ * dump file when [Profiling] DumpInterval is set).
+ * Console command ACCESSIBILITY_PROFILE
+ */
+void Accessibility_ShowProfile(void);
+
+/* Discard collected timings - console command ACCESSIBILITY_PROFILE_RESET */
+void Accessibility_ResetProfile(void);
+
 /* ============================================
  * Utility Functions
  * ============================================ */
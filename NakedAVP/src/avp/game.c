@@ -47,6 +47,7 @@
 
 #include "kshape.h"
 #include "game.h"
+#include "accessibility.h"
 
 /* KJL 16:00:13 11/22/96 - One of my evil experiments....   */
 #define PENTIUM_PROFILING_ON 0
@@ -400,6 +401,9 @@ void UpdateGame(void)
 	ProfileStop("DYNAMICS");
 	#endif
 
+	/* Accessibility: index strategy block positions for the radar/navigation scans */
+	Accessibility_UpdateSpatialIndex();
+
 	// now for the env teleports
 	
 	if(RequestEnvChangeViaLift)
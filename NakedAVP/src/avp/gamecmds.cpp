@@ -40,6 +40,7 @@ extern "C"
 #include "avp_menus.h"
 #include "detaillevels.h"
 #include "savegame.h"
+#include "accessibility.h"
 
 
 int DebuggingCommandsActive=0;
@@ -553,6 +554,19 @@ void CreateGameSpecificConsoleCommands(void)
 		"ADD A BUG REPORT TO CONSOLELOG.TXT",
 		OutputBugReportToConsoleLogfile
 	);
+
+	ConsoleCommand::Make
+	(
+		"ACCESSIBILITY_PROFILE",
+		"SHOW HOW MUCH FRAME TIME THE ACCESSIBILITY FEATURES TAKE",
+		Accessibility_ShowProfile
+	);
+	ConsoleCommand::Make
+	(
+		"ACCESSIBILITY_PROFILE_RESET",
+		"CLEAR THE ACCESSIBILITY TIMINGS",
+		Accessibility_ResetProfile
+	);
 	ConsoleCommand::Make
 	(
 		"REMOVEDECALS",
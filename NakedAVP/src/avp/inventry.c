@@ -24,6 +24,7 @@ rounds fired etc etc etc*/
 #include "pldghost.h"
 
 #include "avp_userprofile.h"
+#include "accessibility.h"
 
 #define UseLocalAssert Yes
 #include "ourasert.h"
@@ -154,6 +155,11 @@ void MaintainPlayersInventory(void)
 
 					default: ;
 				}
+
+				/* Accessibility: picked up, whichever case took it */
+				if (collidedWith->SBflags.please_destroy_me || objStatPtr->respawnTimer) {
+					Accessibility_PostEvent(ACCESS_EVENT_PICKUP,objStatPtr->typeId,objStatPtr->subType);
+				}
 			}
 		} else if((collidedWith) && (collidedWith->I_SBtype == I_BehaviourNetGhost)) {
 			NETGHOSTDATABLOCK* ghostData = collidedWith->SBdataptr;
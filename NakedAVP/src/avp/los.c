@@ -26,6 +26,8 @@ int IsThisObjectVisibleFromThisPosition(DISPLAYBLOCK *dPtr,VECTORCH *positionPtr
 void CheckForVectorIntersectionWithHierarchicalObject(DISPLAYBLOCK *dPtr, VECTORCH *viewVectorAlphaPtr, VECTORCH *viewVectorBetaPtr);
 void CheckForRayIntersectionWithHierarchy(DISPLAYBLOCK *objectPtr, SECTION_DATA *sectionDataPtr);
 void CheckForRayIntersectionWithObject(DISPLAYBLOCK *dPtr);
+static void CheckForFanIntersectionWithHierarchy(DISPLAYBLOCK *objectPtr, SECTION_DATA *sectionDataPtr);
+static void CheckForFanIntersectionWithObject(DISPLAYBLOCK *dPtr);
 /*KJL****************************************************************************************
 * 										D E F I N E S 										*
 ****************************************************************************************KJL*/
@@ -129,6 +131,12 @@ extern DISPLAYBLOCK *ActiveBlockList[];
 static VECTORCH *ViewpointDirectionPtr;
 static VECTORCH *ViewpointPositionPtr;
 
+/* state for the fan being cast by FindPolygonsInLineOfSight_Fan */
+static VECTORCH *FanDirectionsPtr;
+static VECTORCH *FanPositionPtr;
+static LOS_RAY_RESULT *FanResultsPtr;
+static int FanNumberOfRays;
+
 
 /*KJL****************************************************************************************
 *                                     CODE STARTS HERE!                                     *
@@ -333,6 +341,36 @@ void FindPolygonInLineOfSight_TwoIgnores(VECTORCH *viewpointDirectionPtr, VECTOR
 	}
 }
 
+/* fill in a stand-in display block for one section of a hierarchical model */
+static void MakeSectionDisplayBlock(DISPLAYBLOCK *dummyPtr, DISPLAYBLOCK *objectPtr, SECTION_DATA *sectionDataPtr)
+{
+	SECTION *sectionPtr=sectionDataPtr->sempai;
+
+	dummyPtr->ObShape=sectionPtr->ShapeNum;
+	dummyPtr->ObShapeData=sectionPtr->Shape;
+	dummyPtr->ObWorld=sectionDataPtr->World_Offset;
+	dummyPtr->ObMat=sectionDataPtr->SecMat;
+
+	dummyPtr->ObRadius=0;
+	dummyPtr->ObMaxX=0;
+	dummyPtr->ObMinX=0;
+	dummyPtr->ObMaxY=0;
+	dummyPtr->ObMinY=0;
+	dummyPtr->ObMaxZ=0;
+	dummyPtr->ObMinZ=0;
+
+	dummyPtr->ObTxAnimCtrlBlks=NULL;
+	dummyPtr->ObEIDPtr=NULL;
+	dummyPtr->ObMorphCtrl=NULL;
+	dummyPtr->ObStrategyBlock=objectPtr->ObStrategyBlock;
+	dummyPtr->ShapeAnimControlBlock=sectionDataPtr->sac_ptr;
+	dummyPtr->HModelControlBlock=NULL; /* Don't even want to think about that. */
+	dummyPtr->ObMyModule=NULL;
+
+	/* KJL 21:12:11 12/11/98 - arg! ObFlags wasn't set */
+	dummyPtr->ObFlags = 0;
+}
+
 void CheckForRayIntersectionWithHierarchy(DISPLAYBLOCK *objectPtr, SECTION_DATA *sectionDataPtr)
 {
 	SECTION *sectionPtr;
@@ -347,29 +385,7 @@ void CheckForRayIntersectionWithHierarchy(DISPLAYBLOCK *objectPtr, SECTION_DATA
 	{
 		DISPLAYBLOCK dummy_displayblock;
 		
-		dummy_displayblock.ObShape=sectionPtr->ShapeNum;
-		dummy_displayblock.ObShapeData=sectionPtr->Shape;
-		dummy_displayblock.ObWorld=sectionDataPtr->World_Offset;
-		dummy_displayblock.ObMat=sectionDataPtr->SecMat;
-
-		dummy_displayblock.ObRadius=0;
-		dummy_displayblock.ObMaxX=0;
-		dummy_displayblock.ObMinX=0;
-		dummy_displayblock.ObMaxY=0;
-		dummy_displayblock.ObMinY=0;
-		dummy_displayblock.ObMaxZ=0;
-		dummy_displayblock.ObMinZ=0;
-
-		dummy_displayblock.ObTxAnimCtrlBlks=NULL;
-		dummy_displayblock.ObEIDPtr=NULL;
-		dummy_displayblock.ObMorphCtrl=NULL;
-		dummy_displayblock.ObStrategyBlock=objectPtr->ObStrategyBlock;
-		dummy_displayblock.ShapeAnimControlBlock=sectionDataPtr->sac_ptr;
-		dummy_displayblock.HModelControlBlock=NULL; /* Don't even want to think about that. */
-		dummy_displayblock.ObMyModule=NULL;
-
-		/* KJL 21:12:11 12/11/98 - arg! ObFlags wasn't set */
-		dummy_displayblock.ObFlags = 0;
+		MakeSectionDisplayBlock(&dummy_displayblock,objectPtr,sectionDataPtr);
 
 		if ( !(
 			(dummy_displayblock.ObWorld.vx<1000000 && dummy_displayblock.ObWorld.vx>-1000000)
@@ -680,6 +696,321 @@ void CheckForRayIntersectionWithObject(DISPLAYBLOCK *dPtr)
     return;
 }
 
+/* FindPolygonsInLineOfSight_Fan
+
+	Casts numberOfRays rays (at most LOS_FAN_MAX_RAYS) out from the same point in world
+	space, one along each of directionsPtr[], and finds the first polygon each of them hits.
+
+	This does the same job as calling FindPolygonInLineOfSight once per direction, but each
+	object is only considered once for the whole fan: its bounding test, transformation into
+	shape space and polygon data are shared, and only the plane tests are repeated per ray.
+	Those are done over flat per-ray arrays so that the compiler can vectorise them.
+
+	Nothing is written to the LOS_ globals. Instead resultsPtr[i] receives the hit for ray i;
+	if a ray hits nothing within maxRange its ObjectHitPtr is NULL and its Lambda is maxRange.
+*/
+void FindPolygonsInLineOfSight_Fan(VECTORCH *directionsPtr, int numberOfRays, VECTORCH *viewpointPositionPtr, int maxRange, int useOnScreenBlockList, DISPLAYBLOCK *objectToIgnorePtr, LOS_RAY_RESULT *resultsPtr)
+{
+	DISPLAYBLOCK **displayBlockList;
+	int numberOfObjects;
+	int i;
+
+	LOCALASSERT(numberOfRays<=LOS_FAN_MAX_RAYS);
+	if (numberOfRays>LOS_FAN_MAX_RAYS) numberOfRays = LOS_FAN_MAX_RAYS;
+
+	for (i=0; i<numberOfRays; i++)
+	{
+		resultsPtr[i].Point = *viewpointPositionPtr;
+		resultsPtr[i].Lambda = maxRange;
+		resultsPtr[i].ObjectHitPtr = 0;
+		resultsPtr[i].ObjectNormal.vx = 0;
+		resultsPtr[i].ObjectNormal.vy = 0;
+		resultsPtr[i].ObjectNormal.vz = 0;
+		resultsPtr[i].HModel_Section = 0;
+	}
+	if (numberOfRays<=0) return;
+
+   	if (useOnScreenBlockList)
+   	{
+		numberOfObjects = NumOnScreenBlocks;
+		displayBlockList = OnScreenBlockList;
+	}
+	else
+   	{
+   		numberOfObjects = NumActiveBlocks;
+		displayBlockList = ActiveBlockList;
+	}
+
+	FanDirectionsPtr = directionsPtr;
+	FanPositionPtr = viewpointPositionPtr;
+	FanResultsPtr = resultsPtr;
+	FanNumberOfRays = numberOfRays;
+
+   	while (numberOfObjects--)
+	{
+		DISPLAYBLOCK* objectPtr = displayBlockList[numberOfObjects];
+		
+		if (objectPtr == objectToIgnorePtr) continue;
+
+		if (objectPtr->HModelControlBlock)
+		{
+			SECTION_DATA *firstSectionPtr;
+		  	firstSectionPtr=objectPtr->HModelControlBlock->section_data;
+
+		  	LOCALASSERT(firstSectionPtr);
+			if ( !(
+				(objectPtr->ObWorld.vx<1000000 && objectPtr->ObWorld.vx>-1000000)
+			 &&	(objectPtr->ObWorld.vy<1000000 && objectPtr->ObWorld.vy>-1000000)
+			 &&	(objectPtr->ObWorld.vz<1000000 && objectPtr->ObWorld.vz>-1000000) 
+			 ) ) continue;
+
+		  	CheckForFanIntersectionWithHierarchy(objectPtr,firstSectionPtr);
+		}  
+		else
+		{
+			CheckForFanIntersectionWithObject(objectPtr);
+		}
+	}
+}
+
+static void CheckForFanIntersectionWithHierarchy(DISPLAYBLOCK *objectPtr, SECTION_DATA *sectionDataPtr)
+{
+	SECTION *sectionPtr=sectionDataPtr->sempai;
+
+	if (!(sectionDataPtr->flags&section_data_notreal) && (sectionPtr->Shape!=NULL))
+	{
+		DISPLAYBLOCK dummy_displayblock;
+		int i;
+
+		MakeSectionDisplayBlock(&dummy_displayblock,objectPtr,sectionDataPtr);
+		CheckForFanIntersectionWithObject(&dummy_displayblock);
+
+		for (i=0; i<FanNumberOfRays; i++)
+		{
+			if (FanResultsPtr[i].ObjectHitPtr == &dummy_displayblock)
+			{
+				FanResultsPtr[i].ObjectHitPtr = objectPtr;
+				FanResultsPtr[i].HModel_Section = sectionDataPtr;
+			}
+		}
+	}
+
+	{
+		SECTION_DATA *childrenListPtr = sectionDataPtr->First_Child;
+
+		while (childrenListPtr!=NULL)
+		{
+			CheckForFanIntersectionWithHierarchy(objectPtr,childrenListPtr);
+			childrenListPtr=childrenListPtr->Next_Sibling;
+		}
+	}
+}
+
+static void CheckForFanIntersectionWithObject(DISPLAYBLOCK *dPtr)
+{
+	/* the rays which pass close enough to hit this object, in shape space */
+	int rayIndex[LOS_FAN_MAX_RAYS];
+	int betaX[LOS_FAN_MAX_RAYS];
+	int betaY[LOS_FAN_MAX_RAYS];
+	int betaZ[LOS_FAN_MAX_RAYS];
+	int normDotBeta[LOS_FAN_MAX_RAYS];
+	int numberOfRays=0;
+	VECTORCH viewVectorAlpha = *FanPositionPtr;
+	VECTORCH position;
+	MATRIXCH toShapeSpace;
+	int numberOfItems;
+	int needToRotate;
+	int i;
+
+	/* same object rejection as CheckForRayIntersectionWithObject */
+	if((dPtr->ObFlags&ObFlag_NotVis)&&(dPtr!=Player)) return;
+	LOCALASSERT(dPtr->HModelControlBlock==NULL);
+	if (!dPtr->ObShape && dPtr->SfxPtr) return;
+	if (dPtr->ObStrategyBlock && dPtr->ObStrategyBlock->DynPtr)
+	{
+		if(dPtr->ObStrategyBlock->DynPtr->DynamicsType == DYN_TYPE_NO_COLLISIONS) return;
+	}
+	if(dPtr->ObWorld.vx>1000000 || dPtr->ObWorld.vx<-1000000) return;
+	if(dPtr->ObWorld.vy>1000000 || dPtr->ObWorld.vy<-1000000) return;
+	if(dPtr->ObWorld.vz>1000000 || dPtr->ObWorld.vz<-1000000) return;
+
+	if (dPtr==Player)
+	{
+		position = dPtr->ObStrategyBlock->DynPtr->Position;
+	}
+	else
+	{
+		position = dPtr->ObWorld;
+	}
+	viewVectorAlpha.vx -= position.vx;
+	viewVectorAlpha.vy -= position.vy;
+	viewVectorAlpha.vz -= position.vz;
+
+	needToRotate = (!dPtr->ObMyModule && dPtr!=Player);
+	if (needToRotate)
+	{
+		toShapeSpace = dPtr->ObMat;
+		TransposeMatrixCH(&toShapeSpace);
+	}
+
+	for (i=0; i<FanNumberOfRays; i++)
+	{
+		VECTORCH viewVectorBeta = FanDirectionsPtr[i];
+
+		if (dPtr!=Player)
+		{
+			if (MagnitudeOfCrossProduct(&viewVectorAlpha,&viewVectorBeta)>dPtr->ObShapeData->shaperadius)
+				continue;
+		}
+		if (needToRotate) RotateVector(&viewVectorBeta,&toShapeSpace);
+
+		rayIndex[numberOfRays] = i;
+		betaX[numberOfRays] = viewVectorBeta.vx;
+		betaY[numberOfRays] = viewVectorBeta.vy;
+		betaZ[numberOfRays] = viewVectorBeta.vz;
+		numberOfRays++;
+	}
+	if (!numberOfRays) return;
+
+	if (needToRotate) RotateVector(&viewVectorAlpha,&toShapeSpace);
+
+	numberOfItems = SetupPolygonAccess(dPtr);
+
+  	while(numberOfItems--)
+	{
+		struct ColPolyTag polyData;
+		int projectedPolyVertex[8];
+		int d;
+		int axis1;
+		int axis2;
+		int anyFacing=0;
+
+		AccessNextPolygon();
+		
+		if( (PolyheaderPtr->PolyFlags & iflag_notvis) && !(PolyheaderPtr->PolyFlags & iflag_mirror)) continue;
+
+		GetPolygonNormal(&polyData);
+
+		/* facing test for every ray at once; all polys are treated as no bfc, so a ray
+		can hit either side as long as it isn't nearly parallel to the plane */
+		for (i=0; i<numberOfRays; i++)
+		{
+			normDotBeta[i] = MUL_FIXED(polyData.PolyNormal.vx,betaX[i])
+						   + MUL_FIXED(polyData.PolyNormal.vy,betaY[i])
+						   + MUL_FIXED(polyData.PolyNormal.vz,betaZ[i]);
+			anyFacing |= (normDotBeta[i]>=POLY_REJECT_RANGE) | (normDotBeta[i]<=-POLY_REJECT_RANGE);
+		}
+		if (!anyFacing) continue;
+
+		GetPolygonVertices(&polyData);
+
+		/* signed distance from the ray origin to the plane, shared by all the rays */
+		{
+			VECTORCH pop=polyData.PolyPoint[0];
+			pop.vx -= viewVectorAlpha.vx;
+			pop.vy -= viewVectorAlpha.vy;
+			pop.vz -= viewVectorAlpha.vz;
+
+		  	d = DotProduct(&(polyData.PolyNormal),&pop);
+		}
+
+		/* decide which 2d plane to project onto */
+		{
+			VECTORCH absNormal = polyData.PolyNormal;
+			if (absNormal.vx<0) absNormal.vx=-absNormal.vx;
+			if (absNormal.vy<0) absNormal.vy=-absNormal.vy;
+			if (absNormal.vz<0) absNormal.vz=-absNormal.vz;
+
+			if (absNormal.vx > absNormal.vy)
+			{
+				if (absNormal.vx > absNormal.vz)
+				{
+					axis1=iy;
+					axis2=iz;
+				}
+				else
+				{
+					axis1=ix;
+					axis2=iy;
+				}
+			}
+			else
+			{
+				if (absNormal.vy > absNormal.vz)
+				{
+					axis1=ix;
+					axis2=iz;
+				}
+				else
+				{
+					axis1=ix;
+					axis2=iy;
+				}
+			}
+		}
+		{
+			int v;
+			for (v=0; v<polyData.NumberOfVertices; v++)
+			{
+	 			projectedPolyVertex[v*2] = *((int*)&polyData.PolyPoint[v] + axis1);
+	 			projectedPolyVertex[v*2+1] = *((int*)&polyData.PolyPoint[v] + axis2);
+			}
+		}
+
+		for (i=0; i<numberOfRays; i++)
+		{
+			LOS_RAY_RESULT *resultPtr = &FanResultsPtr[rayIndex[i]];
+			VECTORCH polyNormal = polyData.PolyNormal;
+			VECTORCH pointOnPlane;
+			int projectedPointOnPlane[2];
+			int nDotB = normDotBeta[i];
+			int rayD = d;
+			int lambda;
+
+			/* flip the plane round if it's facing away from this ray */
+			if (nDotB>0)
+			{
+				nDotB = -nDotB;
+				rayD = -rayD;
+				polyNormal.vx = -polyNormal.vx;
+				polyNormal.vy = -polyNormal.vy;
+				polyNormal.vz = -polyNormal.vz;
+			}
+	   		if (nDotB>-POLY_REJECT_RANGE) continue;
+			if (rayD>0) continue;
+
+		  	lambda = DIV_FIXED(rayD,nDotB);
+			if (lambda>=resultPtr->Lambda) continue;
+
+	   		pointOnPlane.vx	= viewVectorAlpha.vx + MUL_FIXED(lambda,betaX[i]);
+	   		pointOnPlane.vy	= viewVectorAlpha.vy + MUL_FIXED(lambda,betaY[i]);
+	   		pointOnPlane.vz	= viewVectorAlpha.vz + MUL_FIXED(lambda,betaZ[i]);
+
+			projectedPointOnPlane[0]=*(&pointOnPlane.vx+axis1);
+		 	projectedPointOnPlane[1]=*(&pointOnPlane.vx+axis2);
+
+			if (PointInPolygon(&projectedPointOnPlane[0],&projectedPolyVertex[0],polyData.NumberOfVertices,2))
+			{
+				if (needToRotate)
+				{
+					MATRIXCH matrix = dPtr->ObMat;
+					RotateVector(&pointOnPlane,&matrix);
+					RotateVector(&polyNormal,&matrix);
+				}
+				pointOnPlane.vx += position.vx;
+				pointOnPlane.vy += position.vy;
+				pointOnPlane.vz += position.vz;
+
+				resultPtr->Point = pointOnPlane;
+				resultPtr->Lambda = lambda;
+				resultPtr->ObjectHitPtr = dPtr;
+				resultPtr->ObjectNormal = polyNormal;
+				resultPtr->HModel_Section = 0;
+			}
+		}
+	}
+}
+
 /* KJL 15:35:58 14/05/98 - IsObjectVisibleFromThisPoint
 
 	Returns a non-zero value if an object can be seen from a given point in world space
@@ -19,6 +19,21 @@ extern int IsThisObjectVisibleFromThisPosition_WithIgnore(DISPLAYBLOCK *objectPt
 void FindPolygonInLineOfSight(VECTORCH *viewpointDirectionPtr, VECTORCH *viewpointPositionPtr, int useOnScreenBlockList, DISPLAYBLOCK *objectToIgnorePtr);
 void FindPolygonInLineOfSight_TwoIgnores(VECTORCH *viewpointDirectionPtr, VECTORCH *viewpointPositionPtr, int useOnScreenBlockList, DISPLAYBLOCK *objectToIgnorePtr,DISPLAYBLOCK *next_objectToIgnorePtr);
 
+/* Fan of rays from a single point: each ray gets its own copy of the LOS data */
+#define LOS_FAN_MAX_RAYS 16
+
+typedef struct los_ray_result
+{
+	VECTORCH		Point;			/* world space coords of hit point */
+	int				Lambda;			/* distance in mm to hit point (or max range if no hit) */
+	DISPLAYBLOCK*	ObjectHitPtr;	/* object that was hit (NULL if none) */
+	VECTORCH		ObjectNormal;	/* normal of the face which was hit */
+	SECTION_DATA*	HModel_Section;	/* section of HModel hit */
+
+} LOS_RAY_RESULT;
+
+void FindPolygonsInLineOfSight_Fan(VECTORCH *directionsPtr, int numberOfRays, VECTORCH *viewpointPositionPtr, int maxRange, int useOnScreenBlockList, DISPLAYBLOCK *objectToIgnorePtr, LOS_RAY_RESULT *resultsPtr);
+
 /* Line Of Sight data */
 extern VECTORCH 		LOS_Point;	 		/* point in world space which player has hit */
 extern int 				LOS_Lambda;			/* distance in mm to point from player */
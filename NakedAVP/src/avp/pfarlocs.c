@@ -17,6 +17,12 @@
 #include "bh_alien.h"
 #include "bh_far.h"
 #include "pfarlocs.h"
+#include "accessibility.h"
+#include "md5.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 
 #define UseLocalAssert Yes
 #include "ourasert.h"
@@ -30,6 +36,8 @@ static void GetFarLocHeight(FARVALIDATEDLOCATION *location, MODULE *thisModule);
 static void FarLocVolumeTest(FARVALIDATEDLOCATION *location, MODULE *thisModule);
 static int IsXZinPoly(VECTORCH* location, struct ColPolyTag *polygonData);
 static void InitFarLocDataAreas(MODULE **moduleList, int numModules);
+static void BuildFarNavMesh(MODULE **moduleList, int numModules);
+static void KillFarNavMesh(void);
 
 /* external global variables used in this file */
 extern int ModuleArraySize;
@@ -219,6 +227,9 @@ void BuildFarModuleLocs(void)
 	/* deallocate the temporary work spaces */
 	if (auxLocsGrid) DeallocateMem(auxLocsGrid);
 
+	/* Accessibility: walkable polygons and step/jump links for AutoNav */
+	BuildFarNavMesh(moduleListPointer, ModuleArraySize);
+
 	#if logFarLocData
 	fprintf(logfile, "************************************* \n");
 	fprintf(logfile, "FINISHED ! \n");
@@ -379,6 +390,11 @@ void KillFarModuleLocs(void)
 		DeallocateMem(FALLP_EntryPoints);
 	}
 	FALLP_EntryPoints = (FARENTRYPOINTSHEADER *)0;
+
+	KillFarNavMesh();
+
+	/* Accessibility: drop the route planner's copy of the module graph */
+	AutoNav_ResetPlanner();
 }
 
 
@@ -1540,3 +1556,752 @@ static int FarBoxContainsPolygon()
 	return 1;
 }
 
+
+
+/*-------------------------------------------------------------------
+NAVIGATION MESH
+
+The walkable (upward facing, not too steep) polygons of each physical
+module, in world space, plus links between polygons that meet or are
+close: level ground, steps, drops off ledges and jumps. Jumps and drops
+are only linked if no module polygon is in the way.
+
+Baking looks at every pair of nearby floor polygons, so the result is
+written to navmesh/<md5 of the rif>.nav in the local directory, and
+later loads of the same level map that file instead.
+-------------------------------------------------------------------*/
+
+NAVMESH FarNavMesh;
+
+static int navMeshMapped = 0;		/* FarNavMesh.header is a file mapping */
+static size_t navMeshSize = 0;
+
+/* any polygon of a module, for checking jumps and drops for walls */
+typedef struct navmeshsolid
+{
+	VECTORCH vertices[4];
+	VECTORCH normal;
+	int numVertices;
+	int minx, maxx, miny, maxy, minz, maxz;
+
+} NAVMESHSOLID;
+
+/* polygons by grid cell of their x/z extents */
+typedef struct navmeshgrid
+{
+	int minx, minz;
+	int cellSize;
+	int dimX, dimZ;
+	int *cellStart;
+	int *cellPolys;
+
+} NAVMESHGRID;
+
+static int NavMesh_RifDigest(unsigned char *digest);
+static int NavMesh_Attach(NAVMESHHEADER *header, size_t size, const unsigned char *digest, int numModules);
+static int NavMesh_LoadCache(const char *filename, const unsigned char *digest, int numModules);
+static void NavMesh_SaveCache(const char *filename);
+static int NavMesh_Bake(MODULE **moduleList, int numModules, const unsigned char *digest);
+static int NavMesh_LinkPolys(NAVMESHPOLY *from, NAVMESHPOLY *to, NAVMESHLINK *link, NAVMESHSOLID *solids, int *solidStart);
+
+/* modules whose polygons are baked */
+static int NavMesh_ModuleUsable(MODULE *thisModule)
+{
+	return (thisModule->m_mapptr && ModuleIsPhysical(thisModule));
+}
+
+static void BuildFarNavMesh(MODULE **moduleList, int numModules)
+{
+	unsigned char digest[16];
+	char filename[64];
+	int haveDigest;
+	int i;
+
+	KillFarNavMesh();
+
+	haveDigest = NavMesh_RifDigest(digest);
+	if(haveDigest)
+	{
+		strcpy(filename, "navmesh/");
+		for(i = 0; i < 16; i++) sprintf(&filename[8+i*2], "%02x", digest[i]);
+		strcat(filename, ".nav");
+
+		if(NavMesh_LoadCache(filename, digest, numModules)) return;
+	}
+	else memset(digest, 0, sizeof(digest));
+
+	if(!NavMesh_Bake(moduleList, numModules, digest)) return;
+
+	if(haveDigest) NavMesh_SaveCache(filename);
+}
+
+static void KillFarNavMesh(void)
+{
+	if(FarNavMesh.header)
+	{
+		#ifndef _WIN32
+		if(navMeshMapped) munmap(FarNavMesh.header, navMeshSize);
+		else
+		#endif
+		DeallocateMem(FarNavMesh.header);
+	}
+	memset(&FarNavMesh, 0, sizeof(NAVMESH));
+	navMeshMapped = 0;
+	navMeshSize = 0;
+}
+
+/* md5 of this level's rif, as loaded by LoadRifFile */
+static int NavMesh_RifDigest(unsigned char *digest)
+{
+	struct MD5Context context;
+	unsigned char buffer[16384];
+	char filename[200];
+	FILE *file;
+	size_t bytesRead;
+
+	sprintf(filename, "avp_rifs/%s.rif", Env_List[AvP.CurrentEnv]->main);
+	file = OpenGameFile(filename, FILEMODE_READONLY, FILETYPE_PERM);
+	if(!file) return 0;
+
+	MD5Init(&context);
+	while((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+	{
+		MD5Update(&context, buffer, (unsigned)bytesRead);
+	}
+	CloseGameFile(file);
+
+	MD5Final(digest, &context);
+	return 1;
+}
+
+/* point FarNavMesh into a block in cache file layout, once it checks out */
+static int NavMesh_Attach(NAVMESHHEADER *header, size_t size, const unsigned char *digest, int numModules)
+{
+	size_t expected;
+	char *data;
+	NAVMESHPOLY *polys;
+	NAVMESHLINK *links;
+	int *moduleFirstPoly;
+	int i;
+
+	if(size < sizeof(NAVMESHHEADER)) return 0;
+	if(memcmp(header->magic, "AVPN", 4) || header->version != NAVMESH_VERSION) return 0;
+	if(memcmp(header->rifDigest, digest, 16) || header->numModules != numModules) return 0;
+	if(header->numPolys < 0 || header->numLinks < 0) return 0;
+
+	expected = sizeof(NAVMESHHEADER)
+		+ (size_t)header->numPolys * sizeof(NAVMESHPOLY)
+		+ (size_t)header->numLinks * sizeof(NAVMESHLINK)
+		+ (size_t)(numModules + 1) * sizeof(int);
+	if(size != expected) return 0;
+
+	data = (char *)header;
+	polys = (NAVMESHPOLY *)(data + sizeof(NAVMESHHEADER));
+	links = (NAVMESHLINK *)(polys + header->numPolys);
+	moduleFirstPoly = (int *)(links + header->numLinks);
+
+	/* a stale or damaged file can have the right size; check every index in it before
+	anything follows one */
+	if(moduleFirstPoly[0] != 0 || moduleFirstPoly[numModules] != header->numPolys) return 0;
+	for(i = 0; i < numModules; i++)
+	{
+		if(moduleFirstPoly[i] > moduleFirstPoly[i+1]) return 0;
+	}
+	for(i = 0; i < header->numPolys; i++)
+	{
+		NAVMESHPOLY *poly = &polys[i];
+
+		if(poly->numVertices < 3 || poly->numVertices > 4) return 0;
+		if(poly->firstLink < 0 || poly->numLinks < 0) return 0;
+		if(poly->firstLink > header->numLinks - poly->numLinks) return 0;
+	}
+	for(i = 0; i < header->numLinks; i++)
+	{
+		if(links[i].target < 0 || links[i].target >= header->numPolys) return 0;
+	}
+
+	FarNavMesh.header = header;
+	FarNavMesh.polys = polys;
+	FarNavMesh.links = links;
+	FarNavMesh.moduleFirstPoly = moduleFirstPoly;
+	navMeshSize = size;
+	return 1;
+}
+
+static int NavMesh_LoadCache(const char *filename, const unsigned char *digest, int numModules)
+{
+	FILE *file;
+	long size;
+	void *data;
+
+	file = OpenGameFile(filename, FILEMODE_READONLY, FILETYPE_CONFIG);
+	if(!file) return 0;
+
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	if(size <= 0)
+	{
+		CloseGameFile(file);
+		return 0;
+	}
+
+	#ifndef _WIN32
+	data = mmap(0, (size_t)size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+	CloseGameFile(file);
+	if(data == MAP_FAILED) return 0;
+
+	if(!NavMesh_Attach((NAVMESHHEADER *)data, (size_t)size, digest, numModules))
+	{
+		munmap(data, (size_t)size);
+		return 0;
+	}
+	navMeshMapped = 1;
+	#else
+	data = AllocateMem(size);
+	if(!data || fread(data, 1, size, file) != (size_t)size
+		|| !NavMesh_Attach((NAVMESHHEADER *)data, (size_t)size, digest, numModules))
+	{
+		if(data) DeallocateMem(data);
+		CloseGameFile(file);
+		return 0;
+	}
+	CloseGameFile(file);
+	#endif
+
+	return 1;
+}
+
+static void NavMesh_SaveCache(const char *filename)
+{
+	FILE *file;
+
+	file = OpenGameFile(filename, FILEMODE_WRITEONLY, FILETYPE_CONFIG);
+	if(!file)
+	{
+		CreateGameDirectory("navmesh"); /* maybe it didn't exist.. */
+		file = OpenGameFile(filename, FILEMODE_WRITEONLY, FILETYPE_CONFIG);
+		if(!file) return;
+	}
+
+	if(fwrite(FarNavMesh.header, 1, navMeshSize, file) != navMeshSize)
+	{
+		CloseGameFile(file);
+		DeleteGameFile(filename);
+		return;
+	}
+	CloseGameFile(file);
+}
+
+static int NavMesh_IsWalkable(struct ColPolyTag *polygonData)
+{
+	return (polygonData->PolyNormal.vy <= -NAVMESH_MIN_FLOOR_NORMAL);
+}
+
+/* height of a polygon's plane at x,z */
+static int NavMesh_HeightAt(NAVMESHPOLY *poly, int x, int z)
+{
+	VECTORCH *v = poly->vertices;
+	double ax = v[1].vx - v[0].vx, ay = v[1].vy - v[0].vy, az = v[1].vz - v[0].vz;
+	double bx = v[2].vx - v[0].vx, by = v[2].vy - v[0].vy, bz = v[2].vz - v[0].vz;
+	double nx = ay*bz - az*by;
+	double ny = az*bx - ax*bz;
+	double nz = ax*by - ay*bx;
+
+	if(ny == 0) return poly->centre.vy;
+	return v[0].vy - (int)((nx*(x - v[0].vx) + nz*(z - v[0].vz)) / ny);
+}
+
+/* is x,z inside a (convex) polygon's x/z projection, for either winding */
+static int NavMesh_XZinPoly(NAVMESHPOLY *poly, int x, int z)
+{
+	int i, positive = 0, negative = 0;
+
+	for(i = 0; i < poly->numVertices; i++)
+	{
+		VECTORCH *a = &poly->vertices[i];
+		VECTORCH *b = &poly->vertices[(i+1) % poly->numVertices];
+		double cross = (double)(b->vx - a->vx)*(z - a->vz) - (double)(b->vz - a->vz)*(x - a->vx);
+
+		if(cross > 0) positive++;
+		else if(cross < 0) negative++;
+	}
+	return !(positive && negative);
+}
+
+/* horizontal distance from x,z to the nearest point of a polygon's edges,
+which is returned in nearest */
+static int NavMesh_GapToPoly(NAVMESHPOLY *poly, int x, int z, VECTORCH *nearest)
+{
+	double best = -1;
+	int i;
+
+	for(i = 0; i < poly->numVertices; i++)
+	{
+		VECTORCH *a = &poly->vertices[i];
+		VECTORCH *b = &poly->vertices[(i+1) % poly->numVertices];
+		double ex = b->vx - a->vx, ez = b->vz - a->vz;
+		double lengthSq = ex*ex + ez*ez;
+		double t = 0, dx, dz, distSq;
+
+		if(lengthSq > 0)
+		{
+			t = ((x - a->vx)*ex + (z - a->vz)*ez) / lengthSq;
+			if(t < 0) t = 0;
+			else if(t > 1) t = 1;
+		}
+		dx = a->vx + t*ex - x;
+		dz = a->vz + t*ez - z;
+		distSq = dx*dx + dz*dz;
+
+		if(best < 0 || distSq < best)
+		{
+			best = distSq;
+			nearest->vx = a->vx + (int)(t*ex);
+			nearest->vy = a->vy + (int)(t*(b->vy - a->vy));
+			nearest->vz = a->vz + (int)(t*ez);
+		}
+	}
+	return (int)sqrt(best);
+}
+
+/* the kind of link for a gap and a rise (positive if the target is higher),
+or -1 if it can't be crossed */
+static int NavMesh_LinkType(int gap, int rise)
+{
+	if(rise > NAVMESH_JUMP_RISE || rise < -NAVMESH_MAX_DROP) return -1;
+
+	if(gap <= NAVMESH_TOUCH_GAP)
+	{
+		if(rise <= NAVMESH_FLAT_RISE && rise >= -NAVMESH_FLAT_RISE) return NML_Walk;
+		if(rise <= MAXIMUM_STEP_HEIGHT && rise >= -MAXIMUM_STEP_HEIGHT) return NML_Step;
+		if(rise < 0) return NML_Drop;
+		return NML_Jump;
+	}
+	if(gap <= NAVMESH_JUMP_GAP) return NML_Jump;
+	return -1;
+}
+
+/* does the segment from p0 to p1 pass through a polygon */
+static int NavMesh_SegmentHitsSolid(NAVMESHSOLID *solid, VECTORCH *p0, VECTORCH *p1)
+{
+	VECTORCH *v = solid->vertices;
+	double nx = solid->normal.vx, ny = solid->normal.vy, nz = solid->normal.vz;
+	double d0, d1, t, hx, hy, hz;
+	int i, positive = 0, negative = 0;
+
+	d0 = nx*(p0->vx - v[0].vx) + ny*(p0->vy - v[0].vy) + nz*(p0->vz - v[0].vz);
+	d1 = nx*(p1->vx - v[0].vx) + ny*(p1->vy - v[0].vy) + nz*(p1->vz - v[0].vz);
+	if((d0 >= 0 && d1 >= 0) || (d0 <= 0 && d1 <= 0)) return 0;
+
+	t = d0 / (d0 - d1);
+	hx = p0->vx + t*(p1->vx - p0->vx);
+	hy = p0->vy + t*(p1->vy - p0->vy);
+	hz = p0->vz + t*(p1->vz - p0->vz);
+
+	for(i = 0; i < solid->numVertices; i++)
+	{
+		VECTORCH *a = &v[i];
+		VECTORCH *b = &v[(i+1) % solid->numVertices];
+		double ex = b->vx - a->vx, ey = b->vy - a->vy, ez = b->vz - a->vz;
+		double qx = hx - a->vx, qy = hy - a->vy, qz = hz - a->vz;
+		double side = nx*(ey*qz - ez*qy) + ny*(ez*qx - ex*qz) + nz*(ex*qy - ey*qx);
+
+		if(side > 0) positive++;
+		else if(side < 0) negative++;
+	}
+	return !(positive && negative);
+}
+
+/* is the way from p0 to p1 clear of the polygons of a module */
+static int NavMesh_ModuleClear(NAVMESHSOLID *solids, int *solidStart, int module, VECTORCH *p0, VECTORCH *p1)
+{
+	int minx = (p0->vx < p1->vx) ? p0->vx : p1->vx;
+	int maxx = (p0->vx < p1->vx) ? p1->vx : p0->vx;
+	int miny = (p0->vy < p1->vy) ? p0->vy : p1->vy;
+	int maxy = (p0->vy < p1->vy) ? p1->vy : p0->vy;
+	int minz = (p0->vz < p1->vz) ? p0->vz : p1->vz;
+	int maxz = (p0->vz < p1->vz) ? p1->vz : p0->vz;
+	int i;
+
+	for(i = solidStart[module]; i < solidStart[module+1]; i++)
+	{
+		NAVMESHSOLID *solid = &solids[i];
+
+		if(solid->maxx < minx || solid->minx > maxx) continue;
+		if(solid->maxy < miny || solid->miny > maxy) continue;
+		if(solid->maxz < minz || solid->minz > maxz) continue;
+		if(NavMesh_SegmentHitsSolid(solid, p0, p1)) return 0;
+	}
+	return 1;
+}
+
+/* the best link from one polygon to another, sampling the corners and
+edge midpoints of the first. Returns 0 if there is no way across */
+static int NavMesh_LinkPolys(NAVMESHPOLY *from, NAVMESHPOLY *to, NAVMESHLINK *link, NAVMESHSOLID *solids, int *solidStart)
+{
+	int bestType = -1;
+	int bestGap = 0;
+	int i, sample;
+
+	for(i = 0; i < from->numVertices; i++)
+	{
+		VECTORCH *a = &from->vertices[i];
+		VECTORCH *b = &from->vertices[(i+1) % from->numVertices];
+
+		for(sample = 0; sample < 2; sample++)
+		{
+			VECTORCH point, nearest;
+			int gap, rise, type;
+			int inside;
+
+			point = *a;
+			if(sample)
+			{
+				point.vx = (a->vx + b->vx) / 2;
+				point.vy = (a->vy + b->vy) / 2;
+				point.vz = (a->vz + b->vz) / 2;
+			}
+
+			inside = NavMesh_XZinPoly(to, point.vx, point.vz);
+			if(inside)
+			{
+				gap = 0;
+				nearest = point;
+				nearest.vy = NavMesh_HeightAt(to, point.vx, point.vz);
+			}
+			else gap = NavMesh_GapToPoly(to, point.vx, point.vz, &nearest);
+			if(gap > NAVMESH_JUMP_GAP) continue;
+
+			/* y increases downwards */
+			rise = point.vy - nearest.vy;
+
+			/* the other polygon is overhead, not reachable from here */
+			if(inside && rise > MAXIMUM_STEP_HEIGHT) continue;
+
+			type = NavMesh_LinkType(gap, rise);
+			if(type < 0) continue;
+			if(bestType >= 0 && (type > bestType || (type == bestType && gap >= bestGap))) continue;
+
+			/* anything more than stepping across needs a clear path, from
+			above the higher floor to a little way on to the other polygon */
+			if(type == NML_Drop || type == NML_Jump)
+			{
+				VECTORCH p0, p1;
+				double dx, dz, length;
+
+				dx = (gap > 0) ? nearest.vx - point.vx : to->centre.vx - point.vx;
+				dz = (gap > 0) ? nearest.vz - point.vz : to->centre.vz - point.vz;
+				length = sqrt(dx*dx + dz*dz);
+				if(length < 1) length = 1;
+
+				p0 = point;
+				p0.vy = ((point.vy < nearest.vy) ? point.vy : nearest.vy) - NAVMESH_PROBE_HEIGHT;
+				p1.vx = nearest.vx + (int)(dx * (2*NAVMESH_TOUCH_GAP) / length);
+				p1.vz = nearest.vz + (int)(dz * (2*NAVMESH_TOUCH_GAP) / length);
+				p1.vy = p0.vy;
+				if(!NavMesh_ModuleClear(solids, solidStart, from->module, &p0, &p1)) continue;
+				if(to->module != from->module
+					&& !NavMesh_ModuleClear(solids, solidStart, to->module, &p0, &p1)) continue;
+			}
+
+			bestType = type;
+			bestGap = gap;
+			link->position = point;
+		}
+	}
+
+	if(bestType < 0) return 0;
+	link->type = bestType;
+	return 1;
+}
+
+/* bucket the polygons by the grid cells their x/z extents cover */
+static int NavMesh_BuildGrid(NAVMESHGRID *grid, NAVMESHPOLY *polys, int numPolys, int *polyMin, int *polyMax)
+{
+	int maxx, maxz, total, i, x, z;
+
+	grid->minx = grid->minz = 0x7fffffff;
+	maxx = maxz = -0x7fffffff;
+	for(i = 0; i < numPolys; i++)
+	{
+		if(polyMin[i*2] < grid->minx) grid->minx = polyMin[i*2];
+		if(polyMin[i*2+1] < grid->minz) grid->minz = polyMin[i*2+1];
+		if(polyMax[i*2] > maxx) maxx = polyMax[i*2];
+		if(polyMax[i*2+1] > maxz) maxz = polyMax[i*2+1];
+	}
+
+	grid->cellSize = NAVMESH_GRID_CELL;
+	while((maxx - grid->minx) / grid->cellSize >= NAVMESH_MAX_GRID
+		|| (maxz - grid->minz) / grid->cellSize >= NAVMESH_MAX_GRID)
+	{
+		grid->cellSize *= 2;
+	}
+	grid->dimX = (maxx - grid->minx) / grid->cellSize + 1;
+	grid->dimZ = (maxz - grid->minz) / grid->cellSize + 1;
+
+	grid->cellStart = (int *)AllocateMem((grid->dimX*grid->dimZ + 1) * sizeof(int));
+	if(!grid->cellStart) return 0;
+	memset(grid->cellStart, 0, (grid->dimX*grid->dimZ + 1) * sizeof(int));
+
+	/* count, then fill */
+	for(i = 0; i < numPolys; i++)
+	{
+		for(x = (polyMin[i*2] - grid->minx) / grid->cellSize; x <= (polyMax[i*2] - grid->minx) / grid->cellSize; x++)
+		for(z = (polyMin[i*2+1] - grid->minz) / grid->cellSize; z <= (polyMax[i*2+1] - grid->minz) / grid->cellSize; z++)
+		{
+			grid->cellStart[x*grid->dimZ + z + 1]++;
+		}
+	}
+	for(i = 0; i < grid->dimX*grid->dimZ; i++) grid->cellStart[i+1] += grid->cellStart[i];
+	total = grid->cellStart[grid->dimX*grid->dimZ];
+
+	grid->cellPolys = (int *)AllocateMem((total > 0 ? total : 1) * sizeof(int));
+	if(!grid->cellPolys)
+	{
+		DeallocateMem(grid->cellStart);
+		return 0;
+	}
+	for(i = 0; i < numPolys; i++)
+	{
+		for(x = (polyMin[i*2] - grid->minx) / grid->cellSize; x <= (polyMax[i*2] - grid->minx) / grid->cellSize; x++)
+		for(z = (polyMin[i*2+1] - grid->minz) / grid->cellSize; z <= (polyMax[i*2+1] - grid->minz) / grid->cellSize; z++)
+		{
+			/* cellStart[cell] is used as the fill pointer, then shifted back below */
+			grid->cellPolys[grid->cellStart[x*grid->dimZ + z]++] = i;
+		}
+	}
+	for(i = grid->dimX*grid->dimZ; i > 0; i--) grid->cellStart[i] = grid->cellStart[i-1];
+	grid->cellStart[0] = 0;
+	return 1;
+}
+
+static int NavMesh_Bake(MODULE **moduleList, int numModules, const unsigned char *digest)
+{
+	NAVMESHPOLY *polys = 0;
+	NAVMESHLINK *links = 0;
+	NAVMESHSOLID *solids = 0;
+	int *solidStart = 0;
+	int *moduleFirstPoly = 0;
+	int *polyMin = 0, *polyMax = 0;
+	int *visited = 0;
+	NAVMESHGRID grid;
+	int numPolys = 0, numSolids = 0, numLinks = 0, maxLinks = 0;
+	int moduleCounter, i, ok = 0;
+	struct ColPolyTag polygonData;
+
+	memset(&grid, 0, sizeof(grid));
+
+	/* count polygons */
+	for(moduleCounter = 0; moduleCounter < numModules; moduleCounter++)
+	{
+		MODULE *thisModule = moduleList[moduleCounter];
+		int polyCounter;
+
+		if(!NavMesh_ModuleUsable(thisModule)) continue;
+
+		polyCounter = SetupPolygonAccessFromShapeIndex(thisModule->m_mapptr->MapShape);
+		while(polyCounter>0)
+		{
+			AccessNextPolygon();
+			GetPolygonVertices(&polygonData);
+			GetPolygonNormal(&polygonData);
+			numSolids++;
+			if(NavMesh_IsWalkable(&polygonData)) numPolys++;
+			polyCounter--;
+		}
+	}
+	if(numPolys == 0) return 0;
+
+	polys = (NAVMESHPOLY *)AllocateMem(numPolys * sizeof(NAVMESHPOLY));
+	solids = (NAVMESHSOLID *)AllocateMem(numSolids * sizeof(NAVMESHSOLID));
+	solidStart = (int *)AllocateMem((numModules + 1) * sizeof(int));
+	moduleFirstPoly = (int *)AllocateMem((numModules + 1) * sizeof(int));
+	polyMin = (int *)AllocateMem(numPolys * 2 * sizeof(int));
+	polyMax = (int *)AllocateMem(numPolys * 2 * sizeof(int));
+	visited = (int *)AllocateMem(numPolys * sizeof(int));
+	if(!polys || !solids || !solidStart || !moduleFirstPoly || !polyMin || !polyMax || !visited) goto done;
+
+	/* gather them in world space, grouped by module */
+	numPolys = numSolids = 0;
+	for(moduleCounter = 0; moduleCounter < numModules; moduleCounter++)
+	{
+		MODULE *thisModule = moduleList[moduleCounter];
+		int polyCounter;
+
+		moduleFirstPoly[moduleCounter] = numPolys;
+		solidStart[moduleCounter] = numSolids;
+		if(!NavMesh_ModuleUsable(thisModule)) continue;
+
+		polyCounter = SetupPolygonAccessFromShapeIndex(thisModule->m_mapptr->MapShape);
+		while(polyCounter>0)
+		{
+			NAVMESHSOLID *solid = &solids[numSolids++];
+
+			AccessNextPolygon();
+			GetPolygonVertices(&polygonData);
+			GetPolygonNormal(&polygonData);
+
+			solid->numVertices = polygonData.NumberOfVertices;
+			solid->normal = polygonData.PolyNormal;
+			for(i = 0; i < solid->numVertices; i++)
+			{
+				solid->vertices[i] = polygonData.PolyPoint[i];
+				AddVector(&thisModule->m_world, &solid->vertices[i]);
+
+				if(i == 0 || solid->vertices[i].vx < solid->minx) solid->minx = solid->vertices[i].vx;
+				if(i == 0 || solid->vertices[i].vx > solid->maxx) solid->maxx = solid->vertices[i].vx;
+				if(i == 0 || solid->vertices[i].vy < solid->miny) solid->miny = solid->vertices[i].vy;
+				if(i == 0 || solid->vertices[i].vy > solid->maxy) solid->maxy = solid->vertices[i].vy;
+				if(i == 0 || solid->vertices[i].vz < solid->minz) solid->minz = solid->vertices[i].vz;
+				if(i == 0 || solid->vertices[i].vz > solid->maxz) solid->maxz = solid->vertices[i].vz;
+			}
+
+			if(NavMesh_IsWalkable(&polygonData))
+			{
+				NAVMESHPOLY *poly = &polys[numPolys];
+
+				memset(poly, 0, sizeof(NAVMESHPOLY));
+				poly->numVertices = solid->numVertices;
+				for(i = 0; i < poly->numVertices; i++)
+				{
+					poly->vertices[i] = solid->vertices[i];
+					poly->centre.vx += poly->vertices[i].vx / poly->numVertices;
+					poly->centre.vy += poly->vertices[i].vy / poly->numVertices;
+					poly->centre.vz += poly->vertices[i].vz / poly->numVertices;
+				}
+				poly->module = moduleCounter;
+				poly->aimodule = thisModule->m_aimodule ? thisModule->m_aimodule->m_index : -1;
+
+				/* x/z extents, widened by the longest jump for the neighbour search */
+				polyMin[numPolys*2] = solid->minx - NAVMESH_JUMP_GAP;
+				polyMax[numPolys*2] = solid->maxx + NAVMESH_JUMP_GAP;
+				polyMin[numPolys*2+1] = solid->minz - NAVMESH_JUMP_GAP;
+				polyMax[numPolys*2+1] = solid->maxz + NAVMESH_JUMP_GAP;
+				numPolys++;
+			}
+			polyCounter--;
+		}
+	}
+	moduleFirstPoly[numModules] = numPolys;
+	solidStart[numModules] = numSolids;
+
+	if(!NavMesh_BuildGrid(&grid, polys, numPolys, polyMin, polyMax)) goto done;
+
+	/* link every polygon to the others it can reach; both are widened by a
+	jump, so some cell they share will list the other */
+	for(i = 0; i < numPolys; i++) visited[i] = -1;
+	for(i = 0; i < numPolys; i++)
+	{
+		int x, z, c;
+
+		polys[i].firstLink = numLinks;
+
+		for(x = (polyMin[i*2] - grid.minx) / grid.cellSize; x <= (polyMax[i*2] - grid.minx) / grid.cellSize; x++)
+		for(z = (polyMin[i*2+1] - grid.minz) / grid.cellSize; z <= (polyMax[i*2+1] - grid.minz) / grid.cellSize; z++)
+		{
+			int cell = x*grid.dimZ + z;
+
+			for(c = grid.cellStart[cell]; c < grid.cellStart[cell+1]; c++)
+			{
+				int target = grid.cellPolys[c];
+				NAVMESHLINK link;
+
+				if(target == i || visited[target] == i) continue;
+				visited[target] = i;
+
+				if(!NavMesh_LinkPolys(&polys[i], &polys[target], &link, solids, solidStart)) continue;
+
+				if(numLinks == maxLinks)
+				{
+					NAVMESHLINK *grown;
+
+					maxLinks = maxLinks ? maxLinks*2 : numPolys*4;
+					grown = (NAVMESHLINK *)AllocateMem(maxLinks * sizeof(NAVMESHLINK));
+					if(!grown) goto done;
+					if(links)
+					{
+						memcpy(grown, links, numLinks * sizeof(NAVMESHLINK));
+						DeallocateMem(links);
+					}
+					links = grown;
+				}
+				link.target = target;
+				links[numLinks++] = link;
+			}
+		}
+		polys[i].numLinks = numLinks - polys[i].firstLink;
+	}
+
+	/* put it all in one block, laid out as the cache file */
+	{
+		size_t size = sizeof(NAVMESHHEADER)
+			+ (size_t)numPolys * sizeof(NAVMESHPOLY)
+			+ (size_t)numLinks * sizeof(NAVMESHLINK)
+			+ (size_t)(numModules + 1) * sizeof(int);
+		NAVMESHHEADER *header = (NAVMESHHEADER *)AllocateMem(size);
+		char *data = (char *)header;
+
+		if(!header) goto done;
+
+		memcpy(header->magic, "AVPN", 4);
+		header->version = NAVMESH_VERSION;
+		memcpy(header->rifDigest, digest, 16);
+		header->numModules = numModules;
+		header->numPolys = numPolys;
+		header->numLinks = numLinks;
+		data += sizeof(NAVMESHHEADER);
+		memcpy(data, polys, numPolys * sizeof(NAVMESHPOLY));
+		data += numPolys * sizeof(NAVMESHPOLY);
+		if(numLinks) memcpy(data, links, numLinks * sizeof(NAVMESHLINK));
+		data += numLinks * sizeof(NAVMESHLINK);
+		memcpy(data, moduleFirstPoly, (numModules + 1) * sizeof(int));
+
+		ok = NavMesh_Attach(header, size, digest, numModules);
+		LOCALASSERT(ok);
+	}
+
+done:
+	if(grid.cellStart) DeallocateMem(grid.cellStart);
+	if(grid.cellPolys) DeallocateMem(grid.cellPolys);
+	if(links) DeallocateMem(links);
+	if(visited) DeallocateMem(visited);
+	if(polyMax) DeallocateMem(polyMax);
+	if(polyMin) DeallocateMem(polyMin);
+	if(moduleFirstPoly) DeallocateMem(moduleFirstPoly);
+	if(solidStart) DeallocateMem(solidStart);
+	if(solids) DeallocateMem(solids);
+	if(polys) DeallocateMem(polys);
+	return ok;
+}
+
+/*-------------------------------------------------------------------
+Returns the navigation mesh polygon of a module that a position is
+standing on (the nearest one below it, give or take a step), or -1
+-------------------------------------------------------------------*/
+int NavMeshPolyAt(VECTORCH *position, MODULE *module)
+{
+	int best = -1;
+	int bestDrop = 0;
+	int i;
+
+	if(!FarNavMesh.header || !module) return -1;
+	if(module->m_index < 0 || module->m_index >= FarNavMesh.header->numModules) return -1;
+
+	for(i = FarNavMesh.moduleFirstPoly[module->m_index]; i < FarNavMesh.moduleFirstPoly[module->m_index+1]; i++)
+	{
+		NAVMESHPOLY *poly = &FarNavMesh.polys[i];
+		int drop;
+
+		if(!NavMesh_XZinPoly(poly, position->vx, position->vz)) continue;
+
+		drop = NavMesh_HeightAt(poly, position->vx, position->vz) - position->vy;
+		if(drop < -MAXIMUM_STEP_HEIGHT) continue;	/* above us */
+		if(best < 0 || drop < bestDrop)
+		{
+			best = i;
+			bestDrop = drop;
+		}
+	}
+	return best;
+}
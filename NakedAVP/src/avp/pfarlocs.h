@@ -54,9 +54,64 @@ typedef enum moduledoortype
 } MODULEDOORTYPE;
 
 
+/* navigation mesh: the walkable polygons of every physical module, and the
+links between them. The mesh is baked at level start from the module
+collision polygons, and cached on disk keyed by the md5 of the level's rif */
+typedef enum navmeshlinktype
+{
+	NML_Walk,				/* polygons meet at about the same height */
+	NML_Step,				/* up or down no more than MAXIMUM_STEP_HEIGHT */
+	NML_Drop,				/* off a ledge, one way only */
+	NML_Jump,				/* up on to a ledge, or across a gap */
+
+} NAVMESHLINKTYPE;
+
+typedef struct navmeshpoly
+{
+	struct vectorch vertices[4];	/* world space */
+	struct vectorch centre;
+	int numVertices;
+	int module;					/* MODULE index */
+	int aimodule;				/* AIMODULE index, or -1 */
+	int firstLink;
+	int numLinks;
+
+} NAVMESHPOLY;
+
+typedef struct navmeshlink
+{
+	int target;					/* polygon index */
+	int type;					/* NAVMESHLINKTYPE */
+	struct vectorch position;	/* where to leave this polygon, world space */
+
+} NAVMESHLINK;
+
+/* cache file layout: header, polygons, links, then numModules+1 entries
+of moduleFirstPoly */
+typedef struct navmeshheader
+{
+	char magic[4];
+	int version;
+	unsigned char rifDigest[16];
+	int numModules;
+	int numPolys;
+	int numLinks;
+
+} NAVMESHHEADER;
+
+typedef struct navmesh
+{
+	NAVMESHHEADER *header;		/* null if there is no mesh for this level */
+	NAVMESHPOLY *polys;
+	NAVMESHLINK *links;
+	int *moduleFirstPoly;		/* a module's polygons are [first[m], first[m+1]) */
+
+} NAVMESH;
+
 /* globals */
 extern FARLOCATIONSHEADER *FALLP_AuxLocs;
 extern FARENTRYPOINTSHEADER *FALLP_EntryPoints;
+extern NAVMESH FarNavMesh;
 
 /* defines for auxilary locations */
 #define FAR_BB_HEIGHT	2000 /* should be height of a crouched alien */
@@ -72,6 +127,18 @@ extern FARENTRYPOINTSHEADER *FALLP_EntryPoints;
 #define EP_MAXPOINTS	200
 #define EP_MAXEDGES		200
 
+/* defines for the navigation mesh */
+#define NAVMESH_VERSION			1
+#define NAVMESH_MIN_FLOOR_NORMAL 46000	/* -PolyNormal.vy of the steepest walkable slope (~45 degrees) */
+#define NAVMESH_FLAT_RISE		50		/* polygons closer than this in height are level */
+#define NAVMESH_TOUCH_GAP		150		/* polygons closer than this horizontally meet */
+#define NAVMESH_JUMP_GAP		1500	/* widest gap that can be jumped */
+#define NAVMESH_JUMP_RISE		1000	/* highest ledge that can be jumped on to */
+#define NAVMESH_MAX_DROP		4000	/* deepest drop worth taking */
+#define NAVMESH_PROBE_HEIGHT	500		/* height above the floor that jumps and drops are checked for walls */
+#define NAVMESH_GRID_CELL		2000
+#define NAVMESH_MAX_GRID		256		/* cells along each axis */
+
 /* defines for module door types insofar as they relate to alien behaviour 
 FADT stands for Far Alien Door Type*/
 
@@ -88,6 +155,7 @@ int NumAdjacentModules(AIMODULE* target);
 FARENTRYPOINT *GetModuleEP(MODULE* thisModule, MODULE*fromModule);
 FARENTRYPOINT *GetAIModuleEP(AIMODULE* thisModule, AIMODULE*fromModule);
 int PointIsInModule(MODULE* thisModule, VECTORCH* thisPoint);
+int NavMeshPolyAt(VECTORCH *position, MODULE *module);
 
 
 	#ifdef __cplusplus
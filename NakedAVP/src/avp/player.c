@@ -37,6 +37,7 @@ so player.c is looking a bit bare at the moment. */
 
 #include "showcmds.h"
 #include "bonusabilities.h"
+#include "accessibility.h"
 
 extern DPID AVPDPNetID;
 
@@ -1041,7 +1042,12 @@ void PlayerIsDamaged(STRATEGYBLOCK *sbPtr, DAMAGE_PROFILE *damage, int multiplie
 
 		playerStatusPtr->Health=sbPtr->SBDamageBlock.Health;
 		playerStatusPtr->Armour=sbPtr->SBDamageBlock.Armour;
-		
+
+		/* Accessibility: announce damage and low health */
+		if (deltaHealth) {
+			Accessibility_PostEvent(ACCESS_EVENT_DAMAGE,playerStatusPtr->Health>>ONE_FIXED_SHIFT,
+				(playerStatusPtr->Health+deltaHealth)>>ONE_FIXED_SHIFT);
+		}
 	}
 }
 
@@ -1362,6 +1368,7 @@ void DeInitialisePlayer(void) {
 }
 
 static int cloakDebounce = 1;
+static int cloakChargeReported = -1;	/* Field charge percent last reported to accessibility */
 
 void InitPlayerCloakingSystem(void)
 {
@@ -1379,17 +1386,22 @@ void InitPlayerCloakingSystem(void)
 	GimmeChargeCalls=0;
 	HtoHStrikes=0;
 	CurrentLightAtPlayer=0;
+	cloakChargeReported=-1;
 }
 
 static void DoPlayerCloakingSystem(void)
 {
 	extern int NormalFrameTime;
 	PLAYER_STATUS *playerStatusPtr= (PLAYER_STATUS *) (Player->ObStrategyBlock->SBdataptr);
+	int wasCloaked;
+	int chargePercent;
 	LOCALASSERT(playerStatusPtr);
 
 	if(AvP.PlayerType!=I_Predator) return;
 	if(!(playerStatusPtr->IsAlive)) return;
 
+	wasCloaked = playerStatusPtr->cloakOn;
+
 	/* Handle controls. */
 	if (playerStatusPtr->Mvt_InputRequests.Flags.Rqst_ChangeVision)
 	{
@@ -1617,6 +1629,19 @@ static void DoPlayerCloakingSystem(void)
 	if (playerStatusPtr->cloakOn) {
 		CurrentGameStats_CloakOn();
 	}
+
+	/* Accessibility: report the cloak switching and the field charge moving,
+	whatever used or restored it */
+	if (playerStatusPtr->cloakOn!=wasCloaked) {
+		Accessibility_PostEvent(ACCESS_EVENT_CLOAK,playerStatusPtr->cloakOn,wasCloaked);
+	}
+	chargePercent = (playerStatusPtr->FieldCharge*100)/PLAYERCLOAK_MAXENERGY;
+	if (chargePercent!=cloakChargeReported) {
+		if (cloakChargeReported>=0) {
+			Accessibility_PostEvent(ACCESS_EVENT_FIELD_CHARGE,chargePercent,cloakChargeReported);
+		}
+		cloakChargeReported = chargePercent;
+	}
 }
 
 void GimmeCharge(void) {
@@ -60,6 +60,7 @@
 #include "extents.h"
 #include "scream.h"
 #include "avp_userprofile.h"
+#include "accessibility.h"
 
 #define BITE_HEALTH_RECOVERY	(50)
 #define BITE_ARMOUR_RECOVERY	(30)
@@ -269,6 +270,7 @@ STRATEGYBLOCK *GetTrophyTarget(SECTION_DATA **head_section_data);
 extern void PlayerIsDamaged(STRATEGYBLOCK *sbPtr, DAMAGE_PROFILE *damage, int multiplier,VECTORCH* incoming);
 
 void UpdateWeaponStateMachine(void);
+static void DoWeaponStateMachine(void);
 void HandleSpearImpact(VECTORCH *positionPtr, STRATEGYBLOCK *sbPtr, enum AMMO_ID AmmoID, VECTORCH *directionPtr, int multiple, SECTION_DATA *this_section_data);
 static void WeaponStateIdle(PLAYER_STATUS *playerStatusPtr,PLAYER_WEAPON_DATA *weaponPtr,TEMPLATE_WEAPON_DATA *twPtr, int justfiredp,int justfireds, int ps);
 static int RequestChangeOfWeapon(PLAYER_STATUS *playerStatusPtr,PLAYER_WEAPON_DATA *weaponPtr);
@@ -654,6 +656,33 @@ enum PARTICLE_ID GetBloodType(STRATEGYBLOCK *sbPtr) {
 static int FirePrimaryLate,FireSecondaryLate;
 
 void UpdateWeaponStateMachine(void)
+{
+	PLAYER_STATUS *playerStatusPtr= (PLAYER_STATUS *) (Player->ObStrategyBlock->SBdataptr);
+	PLAYER_WEAPON_DATA *weaponPtr;
+	int lastSlot,lastState,lastRounds;
+	GLOBALASSERT(playerStatusPtr);
+
+	lastSlot=playerStatusPtr->SelectedWeaponSlot;
+	weaponPtr=&(playerStatusPtr->WeaponSlot[lastSlot]);
+	lastState=weaponPtr->CurrentState;
+	lastRounds=weaponPtr->PrimaryRoundsRemaining>>ONE_FIXED_SHIFT;
+
+	DoWeaponStateMachine();
+
+	/* Accessibility: report weapon swaps, state changes and rounds used */
+	if (playerStatusPtr->SelectedWeaponSlot!=lastSlot) {
+		Accessibility_PostEvent(ACCESS_EVENT_WEAPON_SWITCH,playerStatusPtr->SelectedWeaponSlot,lastSlot);
+	} else {
+		if (weaponPtr->CurrentState!=lastState) {
+			Accessibility_PostEvent(ACCESS_EVENT_WEAPON_STATE,weaponPtr->CurrentState,lastState);
+		}
+		if ((weaponPtr->PrimaryRoundsRemaining>>ONE_FIXED_SHIFT)!=lastRounds) {
+			Accessibility_PostEvent(ACCESS_EVENT_AMMO,weaponPtr->PrimaryRoundsRemaining>>ONE_FIXED_SHIFT,lastRounds);
+		}
+	}
+}
+
+static void DoWeaponStateMachine(void)
 {
 	PLAYER_WEAPON_DATA *weaponPtr;
 	TEMPLATE_WEAPON_DATA *twPtr;
@@ -0,0 +1,115 @@
+#ifndef _kzradix_h_
+#define _kzradix_h_ 1
+
+/* Depth sorts for kzsort.c (and tests/depth_sort_bench.c): a stable LSD radix sort on an int
+SortKey, a byte at a time, nearest (lowest key) first. A byte that's the same in every key
+needs no pass, so the usual case of keys sharing their top bits costs two or three passes.
+Below RADIX_SORT_MIN_ITEMS, clearing and summing the counts costs more than the passes save
+(tests/depth_sort_bench.c), so shorter lists get a bottom-up merge sort instead. */
+#include <string.h>
+
+#define RADIX_SORT_MIN_ITEMS 80
+
+/* flip the sign bit so that the keys order as unsigned ints */
+#define SORT_KEY_BITS(k) ((unsigned int)(k) ^ 0x80000000U)
+#define SORT_KEY_BYTE(k, b) ((SORT_KEY_BITS(k) >> ((b)*8)) & 255)
+
+/* turns counts[b] into the first slot for each byte value; returns a bit for each byte to be sorted on */
+static unsigned int SortKeyOffsets(const int *keyPtr, int stride, int n, unsigned int counts[4][256])
+{
+	unsigned int firstKey = SORT_KEY_BITS(*keyPtr);
+	unsigned int passes = 0;
+	int i, b;
+
+	memset(counts, 0, 4*256*sizeof(counts[0][0]));
+
+	for (i = 0; i < n; i++)
+	{
+		unsigned int key = SORT_KEY_BITS(*keyPtr);
+
+		counts[0][key & 255]++;
+		counts[1][(key >> 8) & 255]++;
+		counts[2][(key >> 16) & 255]++;
+		counts[3][key >> 24]++;
+
+		keyPtr = (const int *)((const char *)keyPtr + stride);
+	}
+
+	for (b = 0; b < 4; b++)
+	{
+		unsigned int offset = 0;
+		int d;
+
+		if (counts[b][(firstKey >> (b*8)) & 255] == (unsigned int)n) continue;
+
+		for (d = 0; d < 256; d++)
+		{
+			unsigned int count = counts[b][d];
+			counts[b][d] = offset;
+			offset += count;
+		}
+		passes |= 1<<b;
+	}
+
+	return passes;
+}
+
+/* defines  type *name(type *items, type *scratch, int n)  for a struct with an int SortKey: it
+sorts n items using scratch (of at least n) as well, and returns whichever of the two holds the
+result */
+#define DEFINE_DEPTH_SORT(name, type) \
+type *name(type *items, type *scratch, int n) \
+{ \
+	unsigned int counts[4][256]; \
+	unsigned int passes; \
+	int b; \
+\
+	if (n < RADIX_SORT_MIN_ITEMS) \
+	{ \
+		int width; \
+		for (width = 1; width < n; width *= 2) \
+		{ \
+			type *temp; \
+			int start; \
+			for (start = 0; start < n; start += 2*width) \
+			{ \
+				int mid = start+width < n ? start+width : n; \
+				int end = start+2*width < n ? start+2*width : n; \
+				int i = start, j = mid, k = start; \
+\
+				while (i < mid && j < end) \
+				{ \
+					scratch[k++] = items[j].SortKey < items[i].SortKey ? items[j++] : items[i++]; \
+				} \
+				while (i < mid) scratch[k++] = items[i++]; \
+				while (j < end) scratch[k++] = items[j++]; \
+			} \
+			temp = items; \
+			items = scratch; \
+			scratch = temp; \
+		} \
+		return items; \
+	} \
+\
+	passes = SortKeyOffsets(&items[0].SortKey, sizeof(items[0]), n, counts); \
+\
+	for (b = 0; b < 4; b++) \
+	{ \
+		type *temp; \
+		int i; \
+\
+		if (!(passes & (1<<b))) continue; \
+\
+		for (i = 0; i < n; i++) \
+		{ \
+			scratch[counts[b][SORT_KEY_BYTE(items[i].SortKey, b)]++] = items[i]; \
+		} \
+		temp = items; \
+		items = scratch; \
+		scratch = temp; \
+	} \
+\
+	return items; \
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "gamedef.h"
 
 #include "kzsort.h"
+#include "kzradix.h"
 #include "kshape.h"
 #include "pldnet.h"
 #include "avpview.h"
@@ -34,9 +35,6 @@ extern int WireFrameMode;
 extern int DrawingAReflection;
 
 struct KItem KItemList[maxpolyptrs];
-#if 0
-static struct KItem KItemList2[maxpolyptrs];
-#endif
 
 static struct KObject VisibleModules[MAX_NUMBER_OF_VISIBLE_MODULES];
 static struct KObject VisibleModules2[MAX_NUMBER_OF_VISIBLE_MODULES];
@@ -50,259 +48,48 @@ static int PointIsInModule(VECTORCH *pointPtr,MODULE *modulePtr);
 *****************************KJL*/
 int *MorphedObjectPointsPtr=0;
 
-#if 0
-static void MergeItems(struct KItem *src1, int n1, struct KItem *src2, int n2, struct KItem *dest)
+static DEFINE_DEPTH_SORT(RadixSortKItems, struct KItem)
+static DEFINE_DEPTH_SORT(RadixSortKObjects, struct KObject)
+
+/* AVP_DUMP_DEPTH_SORTS=<file> appends every list that's depth sorted, for the benchmark in
+tests/depth_sort_bench.c: its kind (0 for polygons, 1 for modules), length and keys */
+#define MAX_DUMPED_SORTS 20000
+static void DumpSortKeys(int kind, const int *keyPtr, int stride, int n)
 {
-	/* merge the 2 sorted lists: at src1, length n1, and at src2, length n2, into dest */
+	static FILE *file;
+	static int checked;
+	static int numberDumped;
+	int i;
 
-	while (n1>0 && n2>0) /* until one list is exhausted */
+	if (!checked)
 	{
-		if (src1->SortKey < src2->SortKey)
-		{
-			/* src1 is nearer */
-			*dest++ = *src1++;
-			n1--;
-		}
-	 	else
-		{
-			/* src2 is nearer */
-			*dest++ = *src2++;
-			n2--;
-		}
+		const char *filename = getenv("AVP_DUMP_DEPTH_SORTS");
+		if (filename) file = fopen(filename, "ab");
+		checked = 1;
 	}
+	if (!file || numberDumped == MAX_DUMPED_SORTS) return;
+	numberDumped++;
 
-	if (n1==0)
+	fwrite(&kind, sizeof(int), 1, file);
+	fwrite(&n, sizeof(int), 1, file);
+	for (i = 0; i < n; i++)
 	{
-	   /* remainder in srce2 goes into dest */
-	   while (n2>0)
-	   {
-			*dest++ = *src2++;
-			n2--;
-	   }
-	}
-	else
-	{
-	   /* remainder in srce1 goes into dest */
-	   while (n1>0)
-	   {
-			*dest++ = *src1++;
-			n1--;
-	   }
+		fwrite(keyPtr, sizeof(int), 1, file);
+		keyPtr = (const int *)((const char *)keyPtr + stride);
 	}
+	fflush(file);
 }
-#endif
 
-static void MergeObjects(struct KObject *src1, int n1, struct KObject *src2, int n2, struct KObject *dest)
+struct KItem *SortKItems(struct KItem *items, struct KItem *scratch, int n)
 {
-	/* merge the 2 sorted lists: at src1, length n1, and at src2, length n2, into dest */
-
-	while (n1>0 && n2>0) /* until one list is exhausted */
-	{
-		if (src1->SortKey < src2->SortKey)
-		{
-			/* src1 is nearer */
-			*dest++ = *src1++;
-			n1--;
-		}
-	 	else
-		{
-			/* src2 is nearer */
-			*dest++ = *src2++;
-			n2--;
-		}
-	}
-
-	if (n1==0)
-	{
-	   /* remainder in srce2 goes into dest */
-	   while (n2>0)
-	   {
-			*dest++ = *src2++;
-			n2--;
-	   }
-	}
-	else
-	{
-	   /* remainder in srce1 goes into dest */
-	   while (n1>0)
-	   {
-			*dest++ = *src1++;
-			n1--;
-	   }
-	}
+	DumpSortKeys(0, &items[0].SortKey, sizeof(items[0]), n);
+	return RadixSortKItems(items, scratch, n);
 }
-#if 0
-static void ZSortItems(void)
-{
-	unsigned int partitionSize;
-	unsigned int noOfPasses = 0;
-	unsigned int noOfItems = ItemCount;
-	struct KItem *mergeFrom = &KItemList[0];
-	struct KItem *mergeTo = &KItemList2[0];
-	struct KItem *mergeTemp;
-	unsigned int offSet;
-
-	for (partitionSize=1;partitionSize<noOfItems;partitionSize*=2)
-	{
-		/* for each partition size...
-		   loop through partition pairs and merge */
-
-		/* initialise partition and destination offsets */
-		offSet = 0;
-
-		/* do merges for this partition size,
-		omitting the last merge if the second partition is incomplete  */
-		while((offSet+(partitionSize*2)) <= noOfItems)
-		{
-			MergeItems(
-				(mergeFrom+offSet),
-				partitionSize,
-				(mergeFrom+offSet+partitionSize),
-				partitionSize,
-				(mergeTo+offSet) );
-
-			offSet += partitionSize*2;
-		}
-
-		/* At this stage, there's less than 2 whole partitions
-		left in the array.  If there's no data left at all, then
-		there's nothing left to do.  However, if there's any data
-		left at the end of the array, we need to do something with it:
-
-		If there's more than a full partition, merge it against the remaining
-		partial partition.  If there's less than a full partition, just copy
-		it across (via the MergeItems fn): it will be merged in again during a
-		later pass.
 
-		*/
-
-		if((offSet+partitionSize) < noOfItems)
-		{
-			/* merge full partition against a partial partition */
-			MergeItems(
-				(mergeFrom+offSet),
-				partitionSize,
-				(mergeFrom+offSet+partitionSize),
-				(noOfItems - (offSet+partitionSize)),
-				(mergeTo+offSet) );
-		}
-		else if(offSet < noOfItems)
-		{
-			/* pass the incomplete partition thro' the merge fn
-			   to copy it across */
-			MergeItems(
-				(mergeFrom+offSet),
-				(noOfItems-offSet),
-				(mergeFrom+offSet),	/* this is a dummy parameter ... */
-				0,
-				(mergeTo+offSet) );
-		}
-
-		/* count number of passes */
-		noOfPasses++;
-		/* swap source and destination */
-		mergeTemp = mergeFrom;
-		mergeFrom = mergeTo;
-		mergeTo = mergeTemp;
-	}
-
-	/* check where the final list is, and move if neccesary */
-	if (noOfPasses%2 == 1)
-	{
-		unsigned int i;
-		/* final list is in the auxiliary buffer, so move it back */
-		for(i=0;i<noOfItems;i++)
-		{
-			KItemList[i] = KItemList2[i];
-		}
-	}
-}
-#endif
 void SortModules(unsigned int noOfItems)
 {
-	unsigned int partitionSize;
-	unsigned int noOfPasses = 0;
-
-	struct KObject *mergeFrom = &VisibleModules[0];
-	struct KObject *mergeTo = &VisibleModules2[0];
-	struct KObject *mergeTemp;
-	
-	unsigned int offSet;
-
-	for (partitionSize=1;partitionSize<noOfItems;partitionSize*=2)
-	{
-		/* for each partition size...
-		   loop through partition pairs and merge */
-
-		/* initialise partition and destination offsets */
-		offSet = 0;
-
-		/* do merges for this partition size,
-		omitting the last merge if the second partition is incomplete  */
-		while((offSet+(partitionSize*2)) <= noOfItems)
-		{
-			MergeObjects(
-				(mergeFrom+offSet),
-				partitionSize,
-				(mergeFrom+offSet+partitionSize),
-				partitionSize,
-				(mergeTo+offSet) );
-
-			offSet += partitionSize*2;
-		}
-
-		/* At this stage, there's less than 2 whole partitions
-		left in the array.  If there's no data left at all, then
-		there's nothing left to do.  However, if there's any data
-		left at the end of the array, we need to do something with it:
-
-		If there's more than a full partition, merge it against the remaining
-		partial partition.  If there's less than a full partition, just copy
-		it across (via the MergeObjects fn): it will be merged in again during a
-		later pass.
-
-		*/
-
-		if((offSet+partitionSize) < noOfItems)
-		{
-			/* merge full partition against a partial partition */
-			MergeObjects(
-				(mergeFrom+offSet),
-				partitionSize,
-				(mergeFrom+offSet+partitionSize),
-				(noOfItems - (offSet+partitionSize)),
-				(mergeTo+offSet) );
-		}
-		else if(offSet < noOfItems)
-		{
-			/* pass the incomplete partition thro' the merge fn
-			   to copy it across */
-			MergeObjects(
-				(mergeFrom+offSet),
-				(noOfItems-offSet),
-				(mergeFrom+offSet),	/* this is a dummy parameter ... */
-				0,
-				(mergeTo+offSet) );
-		}
-
-		/* count number of passes */
-		noOfPasses++;
-		/* swap source and destination */
-		mergeTemp = mergeFrom;
-		mergeFrom = mergeTo;
-		mergeTo = mergeTemp;
-	}
-
-	/* check where the final list is, and move if neccesary */
-	if (noOfPasses%2 == 1)
-	{
-		/* final list is in the auxiliary buffer */
-		SortedModules = VisibleModules2;
-	}
-	else
-	{
-		SortedModules = VisibleModules;
-	}
+	DumpSortKeys(1, &VisibleModules[0].SortKey, sizeof(VisibleModules[0]), noOfItems);
+	SortedModules = RadixSortKObjects(VisibleModules, VisibleModules2, noOfItems);
 }
 
 
@@ -442,37 +229,7 @@ void KRenderItems(VIEWDESCRIPTORBLOCK *VDBPtr)
 	textprint("numvisobjs %d\n",numVisObjs);
 
 	ProfileStart();
-	#if 1
-	{
-		int numMods = numVisMods;
-		
-		while(numMods)
-		{
-			int n = numMods;
-
-			int furthestModule=0;
-			int furthestDistance=0;
-
-		   	while(n)
-			{
-				n--;
-				if (furthestDistance < VisibleModules[n].SortKey)
-				{
-					furthestDistance = VisibleModules[n].SortKey;
-					furthestModule = n;
-				}
-			}
-		
-			numMods--;
-
-			VisibleModules2[numMods] = VisibleModules[furthestModule];
-			VisibleModules[furthestModule] = VisibleModules[numMods];
-			SortedModules = VisibleModules2;
-		}
-	}
-	#else
 	SortModules(numVisMods);
-	#endif
 	ProfileStop("MODULESORT");
 
 	ProfileStart();
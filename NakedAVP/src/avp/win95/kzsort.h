@@ -23,6 +23,9 @@ struct KObject
 /* render with new z-sort */
 extern void KRenderItems(VIEWDESCRIPTORBLOCK *VDBPtr);
 
+/* stable sort on SortKey, nearest first: the result is in either items or scratch */
+extern struct KItem *SortKItems(struct KItem *items, struct KItem *scratch, int n);
+
 /* generic item shape function */
 extern void KShapeItemsInstr(SHAPEINSTR *shapeinstrptr);
 extern void OutputKItem(int *shapeitemptr);
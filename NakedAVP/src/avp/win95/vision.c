@@ -25,6 +25,7 @@
 #include "frustum.h"
 #include "avpview.h"
 #include "game_statistics.h"
+#include "accessibility.h"
 
 /*KJL****************************************************************************************
 *  										G L O B A L S 	            					    *
@@ -197,6 +198,8 @@ void HandlePredOVision(void)
 
 extern void ChangePredatorVisionMode(void)
 {
+	enum VISION_MODE_ID lastMode = CurrentVisionMode;
+
 	switch (CurrentVisionMode)
 	{
 		case VISION_MODE_NORMAL:
@@ -224,6 +227,9 @@ extern void ChangePredatorVisionMode(void)
 	}
 	Sound_Play(SID_VISION_ON,"h");
 	PredatorVisionChangeCounter=ONE_FIXED;
+
+	/* Accessibility: announce the new vision mode */
+	Accessibility_PostEvent(ACCESS_EVENT_VISION,CurrentVisionMode,lastMode);
 }
 
 
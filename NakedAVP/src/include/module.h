@@ -77,6 +77,17 @@ typedef enum {
 
 } VMODI;
 
+
+/* Accessibility: answer from the precomputed module visibility table */
+
+typedef enum {
+
+	MVIS_Hidden,		/* Never visible, whatever the doors do */
+	MVIS_Visible,		/* Visible whatever the doors do */
+	MVIS_Conditional	/* Depends on doors; IsModuleVisibleFromModule decides */
+
+} MODULEVISIBILITY;
+
 typedef union _vmodidata {
 
 	char vmodidata_label[4];
@@ -443,6 +454,7 @@ int SaveModuleArray(MODULE *mptr, char *filename);
 MODULE* LoadModuleArray(MODULE *mptr, int size, char *filename);
 
 int IsModuleVisibleFromModule(MODULE *source, MODULE *target);
+MODULEVISIBILITY ModuleVisibility(MODULE *source, MODULE *target);
 int ThisObjectIsInAModuleVisibleFromCurrentlyVisibleModules(struct strategyblock *sbPtr);
 
 #endif	/* IncludeModuleFunctionPrototypes */
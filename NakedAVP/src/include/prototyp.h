@@ -881,6 +881,9 @@ typedef struct displayblock
 	struct hmodelcontroller * HModelControlBlock;
 	
 	unsigned int SpecialFXFlags;	
+
+	/* Accessibility: cached obstacle class plus one, zero until first classified */
+	int ObAccessClass;
 											 
 } DISPLAYBLOCK;
 
@@ -2405,6 +2408,7 @@ int LT_LL(LONGLONGCH *a, LONGLONGCH *b);
 
 
 void SetFastRandom(void);
+void SetFastRandomFromSeed(int seed);
 int FastRandom(void);
 
 
@@ -35,6 +35,7 @@
 #include "avp_userprofile.h"
 #include "hud.h"
 #include "weapons.h"
+#include "shapekernels.h"
 
 #define ALIENS_LIFEFORCE_GLOW_COLOUR 0x20ff8080
 #define MARINES_LIFEFORCE_GLOW_COLOUR 0x208080ff
@@ -2094,55 +2095,142 @@ static void VertexIntensity_Alien_Sense(RENDERVERTEX *renderVertexPtr)
 
 
 
-static void VertexIntensity_Standard_Opt(RENDERVERTEX *renderVertexPtr)
+typedef struct
 {
-	int redI,greenI,blueI;
-	int specularR,specularG,specularB;
+	int R,G,B;
+	int SpecularR,SpecularG,SpecularB;
+} VERTEXLIGHTING;
 
-	int vertexNumber = *VertexNumberPtr;
-
-	if(ColourIntensityArray[vertexNumber].Stamp==ObjectCounter)
+/* The standard lighting model, in pieces that LightStagedPoints shares */
+static void StandardLighting_Start(int vertexNumber, VERTEXLIGHTING *lightingPtr)
+{
+	if(Global_ShapeHeaderPtr->shapeflags & ShapeFlag_PreLit) 
 	{
-		renderVertexPtr->R = ColourIntensityArray[vertexNumber].R;
-		renderVertexPtr->G = ColourIntensityArray[vertexNumber].G;
-		renderVertexPtr->B = ColourIntensityArray[vertexNumber].B;	
-		renderVertexPtr->SpecularR = ColourIntensityArray[vertexNumber].SpecularR;
-		renderVertexPtr->SpecularG = ColourIntensityArray[vertexNumber].SpecularG;
-		renderVertexPtr->SpecularB = ColourIntensityArray[vertexNumber].SpecularB;	
-		return;
-	}	
-	ColourIntensityArray[vertexNumber].Stamp=ObjectCounter;
+		unsigned int packedI = Global_EID_IPtr[vertexNumber];
+		lightingPtr->B = (packedI&255)*257;
+
+		packedI >>=8;
+		lightingPtr->G = (packedI&255)*257;
+
+		packedI >>=8;
+		lightingPtr->R = (packedI&255)*257;
+	}
+	else 
 	{
-		VECTORCH *vertexNormalPtr = ((VECTORCH *)Global_ShapeVNormals) + vertexNumber;
-		VECTORCH *vertexPtr = ((VECTORCH *)Global_ShapePoints)+vertexNumber;
+		lightingPtr->R = 0;			
+		lightingPtr->G = 0;			
+		lightingPtr->B = 0;
+	}
 
-		LIGHTBLOCK **larrayptr;
-		LIGHTBLOCK *lptr;
-		int i;
+	lightingPtr->SpecularR = 0;
+	lightingPtr->SpecularG = 0;
+	lightingPtr->SpecularB = 0;
+}
 
-		if(Global_ShapeHeaderPtr->shapeflags & ShapeFlag_PreLit) 
-		{
-			unsigned int packedI = Global_EID_IPtr[vertexNumber];
-			blueI = (packedI&255)*257;
+/* for a light whose range the vertex is inside */
+static void StandardLighting_AddLight(int vertexNumber, LIGHTBLOCK *lptr, VECTORCH *vertexToLightPtr, int distanceToLight, VERTEXLIGHTING *lightingPtr)
+{
+	int idot = MUL_FIXED(lptr->LightRange-distanceToLight,lptr->BrightnessOverRange);
+	int r,g,b;
 
-			packedI >>=8;
-			greenI = (packedI&255)*257;
+	if(distanceToLight>0)
+	{
+		VECTORCH *vertexNormalPtr = ((VECTORCH *)Global_ShapeVNormals) + vertexNumber;
+	 	int dotproduct = MUL_FIXED(vertexNormalPtr->vx,vertexToLightPtr->vx)
+		     + MUL_FIXED(vertexNormalPtr->vy,vertexToLightPtr->vy)
+		     + MUL_FIXED(vertexNormalPtr->vz,vertexToLightPtr->vz);
 
-			packedI >>=8;
-			redI = (packedI&255)*257;
+		if(dotproduct>0)
+		{ 
+			idot = (WideMulNarrowDiv(idot,dotproduct,distanceToLight)+idot/4)/2;
 		}
-		else 
+		else
 		{
-			redI = 0;			
-			greenI = 0;			
-			blueI = 0;
+			idot /= 8;
 		}
+	}
 
-		specularR = 0;
-		specularG = 0;
-		specularB = 0;
+	r = MUL_FIXED(idot,lptr->RedScale);			
+	g = MUL_FIXED(idot,lptr->GreenScale);			
+	b = MUL_FIXED(idot,lptr->BlueScale);			
+
+	lightingPtr->R += r;			
+	lightingPtr->G += g;			
+	lightingPtr->B += b;			
 
+	if( !(lptr->LightFlags & LFlag_PreLitSource)
+	 && !(lptr->LightFlags & LFlag_NoSpecular) )
+	{
+		lightingPtr->SpecularR += r;			
+		lightingPtr->SpecularG += g;			
+		lightingPtr->SpecularB += b;			
+	}
+}
+
+/* clamps the result into the vertex's entry in ColourIntensityArray */
+static void StandardLighting_Finish(int vertexNumber, VERTEXLIGHTING *lightingPtr)
+{
+	COLOURINTENSITIES *intensityPtr = &ColourIntensityArray[vertexNumber];
+	int redI = lightingPtr->R;
+	int greenI = lightingPtr->G;
+	int blueI = lightingPtr->B;
+	int specularR = lightingPtr->SpecularR;
+	int specularG = lightingPtr->SpecularG;
+	int specularB = lightingPtr->SpecularB;
+
+	if(Global_ODB_Ptr->SpecialFXFlags & SFXFLAG_ONFIRE)
+	{
+		specularR>>=2;
+		specularG>>=2;
+		specularB>>=2;
 
+		redI>>=1;
+		greenI>>=1;
+		blueI>>=1;
+	}
+
+	/* Intensity for Textures */
+	redI >>= 8;
+	if(redI > 255) redI = 255;
+	intensityPtr->R = redI;
+	
+	greenI >>= 8;
+	if(greenI > 255) greenI = 255;
+	intensityPtr->G = greenI;
+	
+	blueI >>= 8;
+	if(blueI > 255) blueI = 255;
+	intensityPtr->B = blueI;
+
+	specularR >>= 10;
+	if(specularR > 255) specularR = 255;		 
+	intensityPtr->SpecularR = specularR;
+	
+	specularG >>= 10;
+	if(specularG > 255) specularG = 255;
+	intensityPtr->SpecularG = specularG;
+		
+	specularB >>= 10;
+	if(specularB > 255) specularB = 255;
+	intensityPtr->SpecularB = specularB;
+
+	intensityPtr->Stamp = ObjectCounter;
+}
+
+static void VertexIntensity_Standard_Opt(RENDERVERTEX *renderVertexPtr)
+{
+	int vertexNumber = *VertexNumberPtr;
+
+	if(ColourIntensityArray[vertexNumber].Stamp!=ObjectCounter)
+	{
+		VECTORCH *vertexPtr = ((VECTORCH *)Global_ShapePoints)+vertexNumber;
+		VERTEXLIGHTING lighting;
+
+		LIGHTBLOCK **larrayptr;
+		LIGHTBLOCK *lptr;
+		int i;
+
+		StandardLighting_Start(vertexNumber, &lighting);
 
 		larrayptr = LightSourcesForObject;
 
@@ -2196,87 +2284,98 @@ static void VertexIntensity_Standard_Opt(RENDERVERTEX *renderVertexPtr)
 																	  				
 			if(distanceToLight < lptr->LightRange) 
 			{
-				int idot = MUL_FIXED(lptr->LightRange-distanceToLight,lptr->BrightnessOverRange);
-				int r,g,b;
+				StandardLighting_AddLight(vertexNumber, lptr, &vertexToLight, distanceToLight, &lighting);
+			}
+	  	}
 
-				if(distanceToLight>0)
-				{
-				 	int dotproduct = MUL_FIXED(vertexNormalPtr->vx,vertexToLight.vx)
-					     + MUL_FIXED(vertexNormalPtr->vy,vertexToLight.vy)
-					     + MUL_FIXED(vertexNormalPtr->vz,vertexToLight.vz);
+		StandardLighting_Finish(vertexNumber, &lighting);
+	}
 
-					if(dotproduct>0)
-					{ 
-						idot = (WideMulNarrowDiv(idot,dotproduct,distanceToLight)+idot/4)/2;
-					}
-					else
-					{
-						idot /= 8;
-					}
-				}
-			
-				r = MUL_FIXED(idot,lptr->RedScale);			
-				g = MUL_FIXED(idot,lptr->GreenScale);			
-				b = MUL_FIXED(idot,lptr->BlueScale);			
+	renderVertexPtr->R = ColourIntensityArray[vertexNumber].R;
+	renderVertexPtr->G = ColourIntensityArray[vertexNumber].G;
+	renderVertexPtr->B = ColourIntensityArray[vertexNumber].B;	
+	renderVertexPtr->SpecularR = ColourIntensityArray[vertexNumber].SpecularR;
+	renderVertexPtr->SpecularG = ColourIntensityArray[vertexNumber].SpecularG;
+	renderVertexPtr->SpecularB = ColourIntensityArray[vertexNumber].SpecularB;	
+}
 
-				redI += r;			
-				greenI += g;			
-				blueI += b;			
-			
-				if( !(lptr->LightFlags & LFlag_PreLitSource)
-				 && !(lptr->LightFlags & LFlag_NoSpecular) )
-				{
-					specularR += r;			
-					specularG += g;			
-					specularB += b;			
-				}
-			}
-	  	}
+#if SHAPE_KERNELS
+/* Structure-of-arrays copy of the points the kernels work on, padded to whole blocks of four */
+static struct
+{
+	int X[maxrotpts+3];
+	int Y[maxrotpts+3];
+	int Z[maxrotpts+3];
+} StagedPts;
+
+static void StageShapePoints(const VECTORCH *pointsPtr, int numberOfPoints)
+{
+	int i;
+
+	for (i = 0; i < numberOfPoints; i++)
+	{
+		StagedPts.X[i] = pointsPtr[i].vx;
+		StagedPts.Y[i] = pointsPtr[i].vy;
+		StagedPts.Z[i] = pointsPtr[i].vz;
 	}
+	for (; i & 3; i++)
+	{
+		StagedPts.X[i] = StagedPts.Y[i] = StagedPts.Z[i] = 0;
+	}
+}
 
-	if(Global_ODB_Ptr->SpecialFXFlags & SFXFLAG_ONFIRE)
+/* VertexIntensity_Standard_Opt for every staged point at once: the distances to each light
+are found four points at a time, and only the points inside its range go on to the dot
+product and colour scaling, one at a time */
+static void LightStagedPoints(int numberOfPoints)
+{
+	int n;
+
+	for (n = 0; n < numberOfPoints; n += 4)
 	{
-		specularR>>=2;
-		specularG>>=2;
-		specularB>>=2;
+		VERTEXLIGHTING lighting[4];
+		int numberInBlock = numberOfPoints - n;
+		int lightsLeft = NumLightSourcesForObject;
+		LIGHTBLOCK **larrayptr = LightSourcesForObject;
+		int j;
 
-		redI>>=1;
-		greenI>>=1;
-		blueI>>=1;
-	}
+		if (numberInBlock > 4) numberInBlock = 4;
 
-	/* Intensity for Textures */
-	redI >>= 8;
-	if(redI > 255) redI = 255;
-	renderVertexPtr->R = redI;
-	ColourIntensityArray[vertexNumber].R = redI;
-	
-	greenI >>= 8;
-	if(greenI > 255) greenI = 255;
-	renderVertexPtr->G = greenI;
-	ColourIntensityArray[vertexNumber].G = greenI;
-	
-	blueI >>= 8;
-	if(blueI > 255) blueI = 255;
-	renderVertexPtr->B = blueI;
-	ColourIntensityArray[vertexNumber].B = blueI;
+		for (j = 0; j < numberInBlock; j++)
+		{
+			StandardLighting_Start(n+j, &lighting[j]);
+		}
 
-	specularR >>= 10;
-	if(specularR > 255) specularR = 255;		 
-	renderVertexPtr->SpecularR = specularR;
-	ColourIntensityArray[vertexNumber].SpecularR = specularR;
-	
-	specularG >>= 10;
-	if(specularG > 255) specularG = 255;
-	renderVertexPtr->SpecularG = specularG;
-	ColourIntensityArray[vertexNumber].SpecularG = specularG;
-		
-	specularB >>= 10;
-	if(specularB > 255) specularB = 255;
-	renderVertexPtr->SpecularB = specularB;
-	ColourIntensityArray[vertexNumber].SpecularB = specularB;
-	
+		while (lightsLeft--)
+		{
+			LIGHTBLOCK *lptr = *larrayptr++;
+			int toLightX[4], toLightY[4], toLightZ[4], distance[4];
+			int inRange = ShapeKernel_LightDistances(&StagedPts.X[n], &StagedPts.Y[n], &StagedPts.Z[n],
+													 lptr->LocalLP.vx, lptr->LocalLP.vy, lptr->LocalLP.vz, lptr->LightRange,
+													 toLightX, toLightY, toLightZ, distance);
+
+			for (j = 0; j < numberInBlock; j++)
+			{
+				if (inRange & (1<<j))
+				{
+					VECTORCH vertexToLight;
+
+					vertexToLight.vx = toLightX[j];
+					vertexToLight.vy = toLightY[j];
+					vertexToLight.vz = toLightZ[j];
+					StandardLighting_AddLight(n+j, lptr, &vertexToLight, distance[j], &lighting[j]);
+				}
+			}
+		}
+
+		for (j = 0; j < numberInBlock; j++)
+		{
+			StandardLighting_Finish(n+j, &lighting[j]);
+		}
+	}
 }
+#endif
+
 static void VertexIntensity_FullBright(RENDERVERTEX *renderVertexPtr)
 {
 	int vertexNumber = *VertexNumberPtr;
@@ -3836,6 +3935,71 @@ int GetMVSIndex(TXANIMHEADER
 }
 
 
+extern float ViewMatrix[12];
+
+/* Static landscape: a module's opaque polygons are baked into the renderer's
+buffers when the level loads (D3D_BakeStaticModules), so all a visible module needs each
+frame is the lighting at its points and the matrix taking them into view space. Anything
+that moves the vertices, changes the lighting model or flips the winding goes through the
+pipeline as before. Returns the polygons still to be drawn, or NULL if there are none. */
+static SHAPEHEADER *StaticModule_Pipeline(DISPLAYBLOCK *dptr, SHAPEHEADER *shapePtr)
+{
+	#if !SHAPE_KERNELS
+	RENDERVERTEX vertex;
+	#endif
+	float objectMatrix[12];
+	float matrix[12];
+	int i;
+
+	if (!dptr->ObMyModule || dptr->ObStrategyBlock || dptr->ObMorphCtrl || dptr->ShapeAnimControlBlock) return shapePtr;
+	if ((dptr->ObFlags & ObFlag_ArbRot) || (dptr->SpecialFXFlags & SFXFLAG_MELTINGINTOGROUND)) return shapePtr;
+	if (VertexIntensity != VertexIntensity_Standard_Opt) return shapePtr;
+	if (MOTIONBLUR_CHEATMODE || MIRROR_CHEATMODE || MirroringActive || HeadUpDisplayZOffset) return shapePtr;
+	if (!D3D_StaticModuleIsBaked(dptr->ObMyModule, shapePtr)) return shapePtr;
+
+	#if SHAPE_KERNELS
+	StageShapePoints((VECTORCH *)Global_ShapePoints, shapePtr->numpoints);
+	LightStagedPoints(shapePtr->numpoints);
+	#else
+	for (i = 0; i < shapePtr->numpoints; i++)
+	{
+		VertexNumberPtr = &i;
+		VertexIntensity(&vertex);
+	}
+	#endif
+
+	/* object -> world as in TranslateShapeVertices, then world -> view */
+	objectMatrix[0+0*4] = (float)(dptr->ObMat.mat11)/65536.0f;
+	objectMatrix[1+0*4] = (float)(dptr->ObMat.mat21)/65536.0f;
+	objectMatrix[2+0*4] = (float)(dptr->ObMat.mat31)/65536.0f;
+
+	objectMatrix[0+1*4] = (float)(dptr->ObMat.mat12)/65536.0f;
+	objectMatrix[1+1*4] = (float)(dptr->ObMat.mat22)/65536.0f;
+	objectMatrix[2+1*4] = (float)(dptr->ObMat.mat32)/65536.0f;
+
+	objectMatrix[0+2*4] = (float)(dptr->ObMat.mat13)/65536.0f;
+	objectMatrix[1+2*4] = (float)(dptr->ObMat.mat23)/65536.0f;
+	objectMatrix[2+2*4] = (float)(dptr->ObMat.mat33)/65536.0f;
+
+	objectMatrix[3+0*4] = dptr->ObWorld.vx;
+	objectMatrix[3+1*4] = dptr->ObWorld.vy;
+	objectMatrix[3+2*4] = dptr->ObWorld.vz;
+
+	for (i = 0; i < 3; i++)
+	{
+		int j;
+		for (j = 0; j < 4; j++)
+		{
+			matrix[j+i*4] = ViewMatrix[0+i*4]*objectMatrix[j+0*4]
+						  + ViewMatrix[1+i*4]*objectMatrix[j+1*4]
+						  + ViewMatrix[2+i*4]*objectMatrix[j+2*4];
+		}
+		matrix[3+i*4] += ViewMatrix[3+i*4];
+	}
+
+	return D3D_StaticModule_Output(dptr->ObMyModule, matrix, ColourIntensityArray);
+}
+
 void AddShape(DISPLAYBLOCK *dptr, VIEWDESCRIPTORBLOCK *VDB_Ptr)
 {
 	SHAPEHEADER *shapeheaderptr;
@@ -4000,7 +4164,11 @@ void AddShape(DISPLAYBLOCK *dptr, VIEWDESCRIPTORBLOCK *VDB_Ptr)
   	/* Find out which light sources are in range of of the object */
 	LightSourcesInRangeOfObject(dptr);
 
+	/* static landscape comes out of the renderer's buffers; the pipeline only gets what's left */
+	shapeheaderptr = StaticModule_Pipeline(dptr, shapeheaderptr);
+
 	/* Shape Language Execution Shell */
+	if (shapeheaderptr)
 	{
 		SHAPEINSTR *shapeinstrptr = shapeheaderptr->sh_instruction;
 		
@@ -4021,9 +4189,9 @@ void AddShape(DISPLAYBLOCK *dptr, VIEWDESCRIPTORBLOCK *VDB_Ptr)
 				break;
 	 		}
 		}
+		/* call polygon pipeline */
+		ShapePipeline(shapeheaderptr);
 	}
-	/* call polygon pipeline */
-	ShapePipeline(shapeheaderptr);
 	/* call sfx code */
 	HandleSfxForObject(dptr);
 	if (dptr->ObStrategyBlock)
@@ -4585,6 +4753,54 @@ void MorphPoints(SHAPEINSTR *shapeinstrptr)
 
 }
 
+#if SHAPE_KERNELS
+/* TranslatePoint through objectMatrix and then viewMatrix, and f2i, for the staged points;
+the results go to destPtr */
+static void TranslateStagedPoints(VECTORCH *destPtr, int numberOfPoints, const float *objectMatrix, const float *viewMatrix)
+{
+	int n;
+
+	ShapeKernel_Transform(StagedPts.X, StagedPts.Y, StagedPts.Z, numberOfPoints, objectMatrix, viewMatrix);
+
+	for (n = 0; n < numberOfPoints; n++)
+	{
+		destPtr[n].vx = StagedPts.X[n];
+		destPtr[n].vy = StagedPts.Y[n];
+		destPtr[n].vz = StagedPts.Z[n];
+	}
+}
+#endif
+
+/* AVP_DUMP_SHAPES=<file> appends the points of each shape TranslateShapeVertices sees, once,
+for the benchmark in tests/shape_kernels_test.c: a point count, then the points */
+#define MAX_DUMPED_SHAPES 4096
+static void DumpShapePoints(const VECTORCH *pointsPtr, int numberOfPoints)
+{
+	static FILE *file;
+	static int checked;
+	static const VECTORCH *dumped[MAX_DUMPED_SHAPES];
+	static int numberDumped;
+	int i;
+
+	if (!checked)
+	{
+		const char *filename = getenv("AVP_DUMP_SHAPES");
+		if (filename) file = fopen(filename, "ab");
+		checked = 1;
+	}
+	if (!file || numberDumped == MAX_DUMPED_SHAPES) return;
+
+	for (i = 0; i < numberDumped; i++)
+	{
+		if (dumped[i] == pointsPtr) return;
+	}
+	dumped[numberDumped++] = pointsPtr;
+
+	fwrite(&numberOfPoints, sizeof(int), 1, file);
+	fwrite(pointsPtr, sizeof(VECTORCH), numberOfPoints, file);
+	fflush(file);
+}
+
 void TranslateShapeVertices(SHAPEINSTR *shapeinstrptr)
 {
 	VECTORCH *destPtr = RotatedPts;
@@ -4624,6 +4840,11 @@ void TranslateShapeVertices(SHAPEINSTR *shapeinstrptr)
 		ObjectViewMatrix[3+0*4] = Global_ODB_Ptr->ObWorld.vx;
 		ObjectViewMatrix[3+1*4] = Global_ODB_Ptr->ObWorld.vy;
 		ObjectViewMatrix[3+2*4] = Global_ODB_Ptr->ObWorld.vz;
+		DumpShapePoints(srcPtr, shapeinstrptr->sh_numitems);
+		#if SHAPE_KERNELS
+		StageShapePoints(srcPtr, shapeinstrptr->sh_numitems);
+		TranslateStagedPoints(destPtr, shapeinstrptr->sh_numitems, ObjectViewMatrix, ViewMatrix);
+		#else
 		for(i = shapeinstrptr->sh_numitems; i!=0; i--)
 		{
 			Source[0] = srcPtr->vx;
@@ -4639,6 +4860,7 @@ void TranslateShapeVertices(SHAPEINSTR *shapeinstrptr)
 			srcPtr++;
 			destPtr++;
 		}
+		#endif
 	}
 }
 
@@ -5620,25 +5842,28 @@ void AddToTranslucentPolyList(POLYHEADER *inputPolyPtr,RENDERVERTEX *renderVerti
 
 void OutputTranslucentPolyList(void)
 {
-	int i = CurrentNumberOfTranslucentPolygons;
-	while(i--)
+	static struct KItem order[MAX_NO_OF_TRANSLUCENT_POLYGONS];
+	static struct KItem scratch[MAX_NO_OF_TRANSLUCENT_POLYGONS];
+	struct KItem *itemPtr;
+	int i;
+
+	/* furthest first; polygons as far away as each other stay in the order they were added */
+	for (i=0; i<CurrentNumberOfTranslucentPolygons; i++)
 	{
-		int k = CurrentNumberOfTranslucentPolygons;
-		int maxFound = 0;
-		while(k--)
-		{
-			if (TranslucentPolygons[k].MaxZ>TranslucentPolygons[maxFound].MaxZ)
-			{
-				maxFound = k;
-			}
-		}
-		
-		RenderAllParticlesFurtherAwayThan(TranslucentPolygons[maxFound].MaxZ);
+		order[i].PolyPtr = &TranslucentPolygonHeaders[i];
+		order[i].SortKey = -TranslucentPolygons[i].MaxZ;
+	}
+	itemPtr = SortKItems(order, scratch, CurrentNumberOfTranslucentPolygons);
+
+	for (i=0; i<CurrentNumberOfTranslucentPolygons; i++)
+	{
+		int n = itemPtr[i].PolyPtr - TranslucentPolygonHeaders;
+
+		RenderAllParticlesFurtherAwayThan(TranslucentPolygons[n].MaxZ);
 
-		RenderPolygon.NumberOfVertices = TranslucentPolygons[maxFound].NumberOfVertices;
+		RenderPolygon.NumberOfVertices = TranslucentPolygons[n].NumberOfVertices;
 		RenderPolygon.TranslucencyMode = TRANSLUCENCY_NORMAL;
-		D3D_ZBufferedGouraudTexturedPolygon_Output(&TranslucentPolygonHeaders[maxFound],TranslucentPolygons[maxFound].Vertices);
-		TranslucentPolygons[maxFound].MaxZ=0;
+		D3D_ZBufferedGouraudTexturedPolygon_Output(&TranslucentPolygonHeaders[n],TranslucentPolygons[n].Vertices);
 	}
 	
 	RenderAllParticlesFurtherAwayThan(-0x7fffffff);
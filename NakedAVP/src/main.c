@@ -45,6 +45,7 @@
 #include "version.h"
 #include "fmv.h"
 #include "accessibility.h"
+#include "replay.h"
 
 static inline void secure_avpzero(void* p, size_t n) {
 	volatile unsigned char* vp = (volatile unsigned char*)p;
@@ -631,6 +632,17 @@ static int SetOGLVideoMode(int Width, int Height)
 	}
 #endif
 
+	if (window == NULL && Replay_IsPlaying()) {
+		/* headless: no window or context, the null renderer takes every call */
+		load_null_ogl_functions();
+
+		SetWindowSize(WindowWidth, WindowHeight, WindowWidth, WindowHeight);
+
+		InitOpenGL();
+
+		return 0;
+	}
+
 	if (window == NULL) {
 		load_ogl_functions(0);
 
@@ -1103,6 +1115,13 @@ void CheckForWindowsMessages()
 	float x, y, wantmouse;
 	int buttons;
 	
+	if (Replay_IsPlaying()) {
+		/* headless: no window to read; screens waiting for a key carry on */
+		GotAnyKey = 1;
+		DebouncedGotAnyKey = 1;
+		return;
+	}
+	
 	GotAnyKey = 0;
 	DebouncedGotAnyKey = 0;
 	secure_avpzero(DebouncedKeyboardInput, sizeof DebouncedKeyboardInput);
@@ -1283,7 +1302,9 @@ void InGameFlipBuffers()
 	check_for_errors();
 #endif
 
-	SDL_GL_SwapWindow(window);
+	if (window != NULL) {
+		SDL_GL_SwapWindow(window);
+	}
 }
 
 void FlipBuffers()
@@ -1378,7 +1399,9 @@ void FlipBuffers()
 	check_for_errors();
 #endif
 
-	SDL_GL_SwapWindow(window);
+	if (window != NULL) {
+		SDL_GL_SwapWindow(window);
+	}
 }
 
 char *AvpCDPath = 0;
@@ -1395,6 +1418,8 @@ static const struct option getopt_long_options[] = {
 { "debug",	0,	NULL,	'd' },
 { "withgl",	1,	NULL,	'g' },
 { "datapath",	1,	NULL,	'p' },
+{ "record",	1,	NULL,	'r' },
+{ "replay",	1,	NULL,	'R' },
 /*
 { "loadrifs",	1,	NULL,	'l' },
 { "server",	0,	someval,	1 },
@@ -1416,6 +1441,8 @@ static const char *usage_string =
 "      [-j | --nojoy]          Do not access the joystick\n"
 "      [-p | --datapath] [x]   Look at [x] for game files\n"
 "      [-g | --withgl] [x]     Use [x] instead of /usr/lib/libGL.so.1 for OpenGL\n"
+"      [-r | --record] [x]     Record the input of the first level played to [x]\n"
+"      [-R | --replay] [x]     Replay [x] headless and print timing statistics\n"
 ;
          
 int main(int argc, char *argv[])
@@ -1424,7 +1451,7 @@ int main(int argc, char *argv[])
 	int c;
 	
 	opterr = 0;
-	while ((c = getopt_long(argc, argv, "hvfwscdg:p:", getopt_long_options, NULL)) != -1) {
+	while ((c = getopt_long(argc, argv, "hvfwscdg:p:r:R:", getopt_long_options, NULL)) != -1) {
 		switch(c) {
 			case 'h':
 				printf("%s", usage_string);
@@ -1458,6 +1485,23 @@ int main(int argc, char *argv[])
 			case 'p':
 				gamedatapath = optarg;
 				break;
+			case 'r':
+				if (!Replay_StartRecording(optarg)) {
+					exit(EXIT_FAILURE);
+				}
+				break;
+			case 'R':
+				if (!Replay_StartPlayback(optarg)) {
+					exit(EXIT_FAILURE);
+				}
+				/* headless: no window, sound, CD, joystick or speech */
+				WantFullscreen = 0;
+				WantSound = 0;
+				WantCDRom = 0;
+				WantJoystick = 0;
+				SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+				SDL_SetEnvironmentVariable(SDL_GetEnvironment(), "AVP_TTS_BACKEND", "none", true);
+				break;
 			default:
 				printf("%s", usage_string);
 				exit(EXIT_FAILURE);	
@@ -1529,9 +1573,9 @@ int main(int argc, char *argv[])
 #endif
 
 #if !(ALIEN_DEMO|PREDATOR_DEMO|MARINE_DEMO)	
-while (AvP_MainMenus())
+while (Replay_IsPlaying() ? Replay_SetupLevel() : AvP_MainMenus())
 #else
-if (AvP_MainMenus())
+if (Replay_IsPlaying() ? Replay_SetupLevel() : AvP_MainMenus())
 #endif
 {
 	int menusActive = 0;
@@ -1546,6 +1590,8 @@ if (AvP_MainMenus())
 	
 	start_of_loaded_shapes = load_precompiled_shapes();
 	
+	Replay_BeginLevel();
+	
 	InitCharacter();
 	
 	LoadRifFile(); /* sets up a map */
@@ -1560,10 +1606,14 @@ if (AvP_MainMenus())
 	
 	ScanImagesForFMVs();
 	
+	D3D_BakeStaticModules();
+	
 	ResetFrameCounter();
 
 	Game_Has_Loaded();
 	
+	Replay_StartClock();
+	
 	ResetFrameCounter();
 	
 	if(AvP.Network!=I_No_Network)
@@ -1578,32 +1628,45 @@ if (AvP_MainMenus())
 	IngameKeyboardInput_ClearBuffer();
 	
 	while(AvP.MainLoopRunning) {
-		CheckForWindowsMessages();
+		if (Replay_IsPlaying()) {
+			/* frames are only recorded while playing, see Replay_EndFrame below */
+			if (AvP.GameMode == I_GM_Playing && !Replay_ReadInput()) {
+				/* end of the recording */
+				AvP.MainLoopRunning = 0;
+				break;
+			}
+		} else {
+			CheckForWindowsMessages();
+			
+			Replay_WriteInput();
+		}
 		
 		switch(AvP.GameMode) {
 		case I_GM_Playing:
 			if ((!menusActive || (AvP.Network!=I_No_Network && !netGameData.skirmishMode)) && !AvP.LevelCompleted) {
 				/* TODO: print some debugging stuff */
 
+				Replay_StartTimer(REPLAY_TIMER_GAME);
+				
 				DoAllShapeAnimations();
 
 				UpdateGame();
 
-				/* Accessibility: Update audio radar and player state announcements */
-				AudioRadar_Update();
-				PlayerState_Update();
-				Navigation_Update();
-				PitchIndicator_Update();
-				Accessibility_CheckInteraction();
-				Accessibility_WeaponStateUpdate();
-				AutoNav_Update();
-				Obstruction_Update();
-				Accessibility_ProcessInput();
+				Replay_StopTimer(REPLAY_TIMER_GAME);
+				Replay_StartTimer(REPLAY_TIMER_ACCESSIBILITY);
+
+				/* Accessibility: run the scheduled radar, navigation and announcement updates */
+				Accessibility_Update();
+
+				Replay_StopTimer(REPLAY_TIMER_ACCESSIBILITY);
+				Replay_StartTimer(REPLAY_TIMER_VIEWS);
 
 				AvpShowViews();
 
 				MaintainHUD();
 
+				Replay_StopTimer(REPLAY_TIMER_VIEWS);
+
 				CheckCDAndChooseTrackIfNeeded();
 				
 				if(InGameMenusAreRunning() && ( (AvP.Network!=I_No_Network && netGameData.skirmishMode) || (AvP.Network==I_No_Network)) ) {
@@ -1632,6 +1695,8 @@ if (AvP_MainMenus())
 
 			InGameFlipBuffers();
 			
+			Replay_EndFrame();
+			
 			FrameCounterHandler();
 			{
 				PLAYER_STATUS *playerStatusPtr = (PLAYER_STATUS *) (Player->ObStrategyBlock->SBdataptr);
@@ -1660,6 +1725,8 @@ if (AvP_MainMenus())
 		}
 	}
 	
+	Replay_EndLevel();
+	
 	AvP.LevelCompleted = thisLevelHasBeenCompleted;
 
 	FixCheatModesInUserProfile(UserProfilePtr);
@@ -1674,6 +1741,8 @@ if (AvP_MainMenus())
 	
 	KillHUD();
 	
+	D3D_ReleaseStaticModules();
+	
 	Destroy_CurrentEnvironment();
 	
 	DeallocateAllImages();
@@ -1711,5 +1780,5 @@ if (AvP_MainMenus())
 	CDDA_End();
 	ClearMemoryPool();
 
-	return 0;
+	return Replay_Diverged() ? EXIT_FAILURE : 0;
 }
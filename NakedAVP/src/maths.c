@@ -2331,10 +2331,20 @@ static int32_t * rear_ptr = table;
 void SetSeededFastRandom(int seed);
 void SetFastRandom(void)
 
+{
+
+	SetFastRandomFromSeed(GetTickCount());
+
+}
+
+
+/* replays seed from the recording to get the same sequence back */
+void SetFastRandomFromSeed(int seed)
+
 {
 
 	int i;
-	long number = GetTickCount();
+	long number = seed;
 
 
 	for(i = 0; i < DEG_3; ++i) {
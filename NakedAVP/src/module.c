@@ -23,11 +23,24 @@ extern unsigned char KeyASCII;
 /**** Protos ****/
 
 void FindVisibleModules(VMODULE *vptr,int flag);
+static void BuildModuleVisibilityTable(MODULE **m_array_ptr);
+static void KillModuleVisibilityTable(void);
 
 /**** Statics ****/
 
 static MODULE **Global_ModuleArrayPtr;
 
+/*
+ Accessibility: module to module visibility, worked out once per level from
+ the VMODULE lists. Each source module has two rows of ModuleArraySize bits:
+ the modules its list reaches with every door open, and the subset it reaches
+ whatever state the doors are in. A list with a backward branch can't be
+ summarised this way and is left to the walk in IsModuleVisibleFromModule.
+*/
+static unsigned int *ModuleVisBits = 0;
+static unsigned char *ModuleVisUntabled = 0;
+static int ModuleVisRowWords = 0;
+
 void AllNewModuleHandler(void)
 {
 	{
@@ -602,6 +615,8 @@ void DeallocateModuleVisArrays(void)
 
 	}
 
+	KillModuleVisibilityTable();
+
 }
 
 
@@ -658,6 +673,8 @@ int GetModuleVisArrays(void)
 		textprint("visibility arrays ok, size %d\n", ModuleArraySize);
 		#endif
 
+		BuildModuleVisibilityTable(sm_ptr->sm_marray);
+
 		return Yes;
 
 	}
@@ -1045,6 +1062,16 @@ int IsModuleVisibleFromModule(MODULE *source, MODULE *target) {
 	if ((source==NULL)||(target==NULL)) return(0);
 	if (source==target) return(1);
 
+	/* Accessibility: most pairs don't depend on doors, so skip the walk */
+	switch(ModuleVisibility(source,target)) {
+		case MVIS_Hidden:
+			return(0);
+		case MVIS_Visible:
+			return(1);
+		default:
+			break;
+	}
+
 	while(! ((vptr->vmod_type == vmtype_term)||(gotit)) ) {
 
 		/* Add this module to the visible array */
@@ -1097,6 +1124,100 @@ int IsModuleVisibleFromModule(MODULE *source, MODULE *target) {
 
 }
 
+static void KillModuleVisibilityTable(void)
+{
+	if(ModuleVisBits)
+	{
+		DeallocateMem(ModuleVisBits);
+		ModuleVisBits = 0;
+	}
+	if(ModuleVisUntabled)
+	{
+		DeallocateMem(ModuleVisUntabled);
+		ModuleVisUntabled = 0;
+	}
+	ModuleVisRowWords = 0;
+}
+
+/* row 0: reached with every door open, row 1: reached whatever the doors do */
+static unsigned int *ModuleVisRow(int index, int row)
+{
+	return ModuleVisBits + (index * 2 + row) * ModuleVisRowWords;
+}
+
+static void BuildModuleVisibilityTable(MODULE **m_array_ptr)
+{
+	int words, i;
+
+	KillModuleVisibilityTable();
+
+	words = (ModuleArraySize + 31) >> 5;
+	ModuleVisBits = (unsigned int *) AllocateMem(ModuleArraySize * 2 * words * sizeof(unsigned int));
+	ModuleVisUntabled = (unsigned char *) AllocateMem(ModuleArraySize);
+	if(!ModuleVisBits || !ModuleVisUntabled)
+	{
+		KillModuleVisibilityTable();
+		return;
+	}
+	ModuleVisRowWords = words;
+
+	for(i = 0; i < ModuleArraySize * 2 * words; i++) ModuleVisBits[i] = 0;
+	for(i = 0; i < ModuleArraySize; i++) ModuleVisUntabled[i] = 0;
+
+	while(*m_array_ptr)
+	{
+		MODULE *source = *m_array_ptr++;
+		unsigned int *anyDoors = ModuleVisRow(source->m_index, 0);
+		unsigned int *allDoors = ModuleVisRow(source->m_index, 1);
+		VMODULE *vptr = source->m_vmptr;
+		VMODULE *gatedUntil = vptr;		/* entries before this are behind a door */
+
+		if(!vptr) continue;
+
+		for(; vptr->vmod_type != vmtype_term; vptr++)
+		{
+			MODULE *mptr = vptr->vmod_mref.mref_ptr;
+
+			if(mptr)
+			{
+				anyDoors[mptr->m_index >> 5] |= 1u << (mptr->m_index & 31);
+				if(vptr >= gatedUntil) allDoors[mptr->m_index >> 5] |= 1u << (mptr->m_index & 31);
+			}
+
+			if(vptr->vmod_instr == vmodi_bra_vc)
+			{
+				/* A closed door skips ahead to here, so what lies between depends on it */
+				VMODULE *branch = vptr->vmod_data.vmodidata_ptr;
+				if(!branch || branch <= vptr)
+				{
+					ModuleVisUntabled[source->m_index] = 1;
+					break;
+				}
+				if(branch > gatedUntil) gatedUntil = branch;
+			}
+		}
+	}
+}
+
+MODULEVISIBILITY ModuleVisibility(MODULE *source, MODULE *target)
+{
+	int word, bit;
+
+	if ((source==NULL)||(target==NULL)) return MVIS_Hidden;
+	if (source==target) return MVIS_Visible;
+	if (!ModuleVisBits) return MVIS_Conditional;
+	if (source->m_index < 0 || source->m_index >= ModuleArraySize) return MVIS_Conditional;
+	if (target->m_index < 0 || target->m_index >= ModuleArraySize) return MVIS_Conditional;
+	if (ModuleVisUntabled[source->m_index]) return MVIS_Conditional;
+
+	word = target->m_index >> 5;
+	bit = 1u << (target->m_index & 31);
+
+	if (!(ModuleVisRow(source->m_index, 0)[word] & bit)) return MVIS_Hidden;
+	if (ModuleVisRow(source->m_index, 1)[word] & bit) return MVIS_Visible;
+	return MVIS_Conditional;
+}
+
 int IsAIModuleVisibleFromAIModule(AIMODULE *source,AIMODULE *target) {
 
 	if ((source==NULL)||(target==NULL)) return(0);
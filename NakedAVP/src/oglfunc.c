@@ -31,6 +31,8 @@ PFNGLGETINTEGERVPROC		pglGetIntegerv;
 PFNGLGETSTRINGPROC		pglGetString;
 PFNGLGETTEXPARAMETERFVPROC	pglGetTexParameterfv;
 PFNGLHINTPROC			pglHint;
+PFNGLLOADIDENTITYPROC		pglLoadIdentity;
+PFNGLLOADMATRIXFPROC		pglLoadMatrixf;
 PFNGLPIXELSTOREIPROC		pglPixelStorei;
 PFNGLPOLYGONOFFSETPROC		pglPolygonOffset;
 PFNGLREADPIXELSPROC		pglReadPixels;
@@ -46,11 +48,23 @@ PFNGLTEXSUBIMAGE2DPROC		pglTexSubImage2D;
 PFNGLVERTEXPOINTERPROC		pglVertexPointer;
 PFNGLVIEWPORTPROC		pglViewport;
 
+PFNOGLBINDBUFFERPROC		pglBindBuffer;
+PFNOGLBUFFERDATAPROC		pglBufferData;
+PFNOGLBUFFERSUBDATAPROC		pglBufferSubData;
+PFNOGLDELETEBUFFERSPROC		pglDeleteBuffers;
+PFNOGLGENBUFFERSPROC		pglGenBuffers;
+PFNOGLMAPBUFFERRANGEPROC	pglMapBufferRange;
+PFNOGLUNMAPBUFFERPROC		pglUnmapBuffer;
+
 int ogl_have_multisample_filter_hint;
 int ogl_have_texture_filter_anisotropic;
+int ogl_have_vertex_buffer_object;
+int ogl_have_map_buffer_range;
 
 int ogl_use_multisample_filter_hint;
 int ogl_use_texture_filter_anisotropic;
+int ogl_use_vertex_buffer_object;
+int ogl_use_map_buffer_range;
 
 static void dummyfunc()
 {
@@ -67,6 +81,12 @@ static void dummyfunc()
 #define LoadOGLProc(type, func)						\
 	LoadOGLProc_(type, func, func)
 
+/* optional entry points: a missing one only disables the feature using it */
+#define LoadOptionalOGLProc(type, func, name) {				\
+	if (!mode) p##func = NULL; else					\
+	p##func = (type) SDL_GL_GetProcAddress(#name);			\
+}
+
 #define LoadOGLProc2(type, func1, func2)					\
 	LoadOGLProc_(type, func1, func1); \
 	if (p##func1 == NULL) { \
@@ -126,6 +146,8 @@ void load_ogl_functions(int mode)
 	LoadOGLProc(PFNGLGETSTRINGPROC, glGetString);
 	LoadOGLProc(PFNGLGETTEXPARAMETERFVPROC, glGetTexParameterfv);
 	LoadOGLProc(PFNGLHINTPROC, glHint);
+	LoadOGLProc(PFNGLLOADIDENTITYPROC, glLoadIdentity);
+	LoadOGLProc(PFNGLLOADMATRIXFPROC, glLoadMatrixf);
 	LoadOGLProc(PFNGLPIXELSTOREIPROC, glPixelStorei);
 	LoadOGLProc(PFNGLPOLYGONOFFSETPROC, glPolygonOffset);
 	LoadOGLProc(PFNGLREADPIXELSPROC, glReadPixels);
@@ -141,7 +163,26 @@ void load_ogl_functions(int mode)
 	LoadOGLProc(PFNGLVERTEXPOINTERPROC, glVertexPointer);
 	LoadOGLProc(PFNGLVIEWPORTPROC, glViewport);
 
+	LoadOptionalOGLProc(PFNOGLBINDBUFFERPROC, glBindBuffer, glBindBuffer);
+	LoadOptionalOGLProc(PFNOGLBUFFERDATAPROC, glBufferData, glBufferData);
+	LoadOptionalOGLProc(PFNOGLBUFFERSUBDATAPROC, glBufferSubData, glBufferSubData);
+	LoadOptionalOGLProc(PFNOGLDELETEBUFFERSPROC, glDeleteBuffers, glDeleteBuffers);
+	LoadOptionalOGLProc(PFNOGLGENBUFFERSPROC, glGenBuffers, glGenBuffers);
+	LoadOptionalOGLProc(PFNOGLMAPBUFFERRANGEPROC, glMapBufferRange, glMapBufferRange);
+	if (pglMapBufferRange == NULL) {
+		LoadOptionalOGLProc(PFNOGLMAPBUFFERRANGEPROC, glMapBufferRange, glMapBufferRangeEXT);
+	}
+	LoadOptionalOGLProc(PFNOGLUNMAPBUFFERPROC, glUnmapBuffer, glUnmapBuffer);
+	if (pglUnmapBuffer == NULL) {
+		LoadOptionalOGLProc(PFNOGLUNMAPBUFFERPROC, glUnmapBuffer, glUnmapBufferOES);
+	}
+
 	if (!mode) {
+		ogl_have_vertex_buffer_object = 0;
+		ogl_have_map_buffer_range = 0;
+
+		ogl_use_vertex_buffer_object = 0;
+		ogl_use_map_buffer_range = 0;
 		return;
 	}
 	
@@ -163,8 +204,72 @@ void load_ogl_functions(int mode)
 	ogl_have_multisample_filter_hint = check_token(ext, "GL_NV_multisample_filter_hint");
 	ogl_have_texture_filter_anisotropic = check_token(ext, "GL_EXT_texture_filter_anisotropic");
 
+	ogl_have_vertex_buffer_object = pglBindBuffer && pglBufferData && pglBufferSubData &&
+		pglDeleteBuffers && pglGenBuffers;
+	ogl_have_map_buffer_range = ogl_have_vertex_buffer_object && pglMapBufferRange && pglUnmapBuffer &&
+		(check_token(ext, "GL_ARB_map_buffer_range") || check_token(ext, "GL_EXT_map_buffer_range"));
+
 	ogl_use_multisample_filter_hint = ogl_have_multisample_filter_hint;
 	ogl_use_texture_filter_anisotropic = ogl_have_texture_filter_anisotropic;
+	ogl_use_vertex_buffer_object = ogl_have_vertex_buffer_object;
+	ogl_use_map_buffer_range = ogl_have_map_buffer_range;
+}
+
+/* null renderer for headless replays: calls are dropped, queries answer as an idle context would */
+static GLenum APIENTRY null_glGetError(void)
+{
+	return GL_NO_ERROR;
+}
+
+static const GLubyte* APIENTRY null_glGetString(GLenum name)
+{
+	return (const GLubyte *) "";
+}
+
+static void APIENTRY null_glGenTextures(GLsizei n, GLuint *textures)
+{
+	static GLuint next_texture = 1;
+	
+	while (n-- > 0) {
+		*textures++ = next_texture++;
+	}
+}
+
+static void APIENTRY null_glGetFloatv(GLenum pname, GLfloat *params)
+{
+	params[0] = 0.0f;
+}
+
+static void APIENTRY null_glGetIntegerv(GLenum pname, GLint *params)
+{
+	params[0] = 0;
+}
+
+static void APIENTRY null_glGetTexParameterfv(GLenum target, GLenum pname, GLfloat *params)
+{
+	params[0] = 0.0f;
+}
+
+void load_null_ogl_functions(void)
+{
+	load_ogl_functions(0);
+
+	pglGetError = null_glGetError;
+	pglGetString = null_glGetString;
+	pglGenTextures = null_glGenTextures;
+	pglGetFloatv = null_glGetFloatv;
+	pglGetIntegerv = null_glGetIntegerv;
+	pglGetTexParameterfv = null_glGetTexParameterfv;
+
+	ogl_have_multisample_filter_hint = 0;
+	ogl_have_texture_filter_anisotropic = 0;
+	ogl_have_vertex_buffer_object = 0;
+	ogl_have_map_buffer_range = 0;
+
+	ogl_use_multisample_filter_hint = 0;
+	ogl_use_texture_filter_anisotropic = 0;
+	ogl_use_vertex_buffer_object = 0;
+	ogl_use_map_buffer_range = 0;
 }
 
 int check_for_errors_(const char *file, int line)
@@ -25,6 +25,25 @@ typedef GLfloat GLdouble;
 #define APIENTRY
 #endif
 
+// Buffer objects: OpenGL 1.5 / OpenGL ES 1.1 core, loaded if present.
+#if !defined(GL_ARRAY_BUFFER)
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#if !defined(GL_DYNAMIC_DRAW)
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#if !defined(GL_STATIC_DRAW)
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#if !defined(GL_MAP_WRITE_BIT)
+// GL_ARB_map_buffer_range / GL_EXT_map_buffer_range
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
+
 typedef void (APIENTRY *PFNGLALPHAFUNCPROC)(GLenum, GLclampf);
 typedef void (APIENTRY *PFNGLBINDTEXTUREPROC)(GLenum, GLuint);
 typedef void (APIENTRY *PFNGLBLENDFUNCPROC)(GLenum, GLenum);
@@ -50,6 +69,8 @@ typedef void (APIENTRY *PFNGLGETINTEGERVPROC)(GLenum, GLint *);
 typedef const GLubyte* (APIENTRY *PFNGLGETSTRINGPROC)(GLenum);
 typedef void (APIENTRY *PFNGLGETTEXPARAMETERFVPROC)(GLenum, GLenum, GLfloat*);
 typedef void (APIENTRY *PFNGLHINTPROC)(GLenum, GLenum);
+typedef void (APIENTRY *PFNGLLOADIDENTITYPROC)(void);
+typedef void (APIENTRY *PFNGLLOADMATRIXFPROC)(const GLfloat *);
 typedef void (APIENTRY *PFNGLPIXELSTOREIPROC)(GLenum, GLint);
 typedef void (APIENTRY *PFNGLPOLYGONOFFSETPROC)(GLfloat, GLfloat);
 typedef void (APIENTRY *PFNGLREADPIXELSPROC)(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, GLvoid *);
@@ -65,6 +86,14 @@ typedef void (APIENTRY *PFNGLTEXSUBIMAGE2DPROC)(GLenum,GLint,GLint,GLint,GLsizei
 typedef void (APIENTRY *PFNGLVERTEXPOINTERPROC)(GLint, GLenum, GLsizei, const GLvoid *);
 typedef void (APIENTRY *PFNGLVIEWPORTPROC)(GLint, GLint, GLsizei, GLsizei);
 
+typedef void (APIENTRY *PFNOGLBINDBUFFERPROC)(GLenum, GLuint);
+typedef void (APIENTRY *PFNOGLBUFFERDATAPROC)(GLenum, GLsizeiptr, const GLvoid *, GLenum);
+typedef void (APIENTRY *PFNOGLBUFFERSUBDATAPROC)(GLenum, GLintptr, GLsizeiptr, const GLvoid *);
+typedef void (APIENTRY *PFNOGLDELETEBUFFERSPROC)(GLsizei, const GLuint *);
+typedef void (APIENTRY *PFNOGLGENBUFFERSPROC)(GLsizei, GLuint *);
+typedef GLvoid* (APIENTRY *PFNOGLMAPBUFFERRANGEPROC)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+typedef GLboolean (APIENTRY *PFNOGLUNMAPBUFFERPROC)(GLenum);
+
 extern PFNGLALPHAFUNCPROC		pglAlphaFunc;
 extern PFNGLBINDTEXTUREPROC		pglBindTexture;
 extern PFNGLBLENDFUNCPROC		pglBlendFunc;
@@ -90,6 +119,8 @@ extern PFNGLGETINTEGERVPROC		pglGetIntegerv;
 extern PFNGLGETSTRINGPROC		pglGetString;
 extern PFNGLGETTEXPARAMETERFVPROC	pglGetTexParameterfv;
 extern PFNGLHINTPROC			pglHint;
+extern PFNGLLOADIDENTITYPROC		pglLoadIdentity;
+extern PFNGLLOADMATRIXFPROC		pglLoadMatrixf;
 extern PFNGLPIXELSTOREIPROC		pglPixelStorei;
 extern PFNGLPOLYGONOFFSETPROC		pglPolygonOffset;
 extern PFNGLREADPIXELSPROC		pglReadPixels;
@@ -105,13 +136,26 @@ extern PFNGLTEXSUBIMAGE2DPROC		pglTexSubImage2D;
 extern PFNGLVERTEXPOINTERPROC		pglVertexPointer;
 extern PFNGLVIEWPORTPROC		pglViewport;
 
+extern PFNOGLBINDBUFFERPROC		pglBindBuffer;
+extern PFNOGLBUFFERDATAPROC		pglBufferData;
+extern PFNOGLBUFFERSUBDATAPROC		pglBufferSubData;
+extern PFNOGLDELETEBUFFERSPROC		pglDeleteBuffers;
+extern PFNOGLGENBUFFERSPROC		pglGenBuffers;
+extern PFNOGLMAPBUFFERRANGEPROC	pglMapBufferRange;
+extern PFNOGLUNMAPBUFFERPROC		pglUnmapBuffer;
+
 extern int ogl_have_multisample_filter_hint;
 extern int ogl_have_texture_filter_anisotropic;
+extern int ogl_have_vertex_buffer_object;
+extern int ogl_have_map_buffer_range;
 
 extern int ogl_use_multisample_filter_hint;
 extern int ogl_use_texture_filter_anisotropic;
+extern int ogl_use_vertex_buffer_object;
+extern int ogl_use_map_buffer_range;
 
 extern void load_ogl_functions(int mode);
+extern void load_null_ogl_functions(void);
 
 extern int check_for_errors_(const char *file, int line);
 #define check_for_errors() check_for_errors_(__FILE__, __LINE__)
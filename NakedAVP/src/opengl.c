@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 
 #include "oglfunc.h"
 
@@ -62,8 +63,8 @@ static D3DTexture *CurrentlyBoundTexture = NULL;
 // everything but the hud rendering used an offset
 #define TEXCOORD_FIXED(s, r) (((float)((s)+(0<<15))) * (r))
 
-#define TA_MAXVERTICES		2048
-#define TA_MAXTRIANGLES		2048
+#define TA_MAXVERTICES		16384
+#define TA_MAXTRIANGLES		16384
 
 typedef struct VertexArray
 {
@@ -90,6 +91,45 @@ static ALIGN16 TriangleArray starr[TA_MAXTRIANGLES];
 static TriangleArray *starrp = starr;
 static int starrc;
 
+/*
+ The D3D_*_Output polygons are not drawn as they arrive: their vertices
+ stay in varr and a RenderQueueItem records the state they need. When the
+ queue is flushed the opaque polygons are drawn first, sorted by state so
+ each texture/filter is bound once, followed by the translucent ones in
+ the order they were submitted (which is back to front).
+ Anything else that draws or changes GL state flushes the queue first.
+ AVP_GL_RENDER_QUEUE=0 draws them as they arrive instead, for comparison.
+*/
+#define RQ_MAXITEMS		4096
+#define RQ_TRANSLUCENT	0x80000000U
+
+typedef struct RenderQueueItem
+{
+	unsigned int key;		/* translucency, filter, texture */
+	unsigned short first;	/* first vertex in varr */
+	unsigned char rver;
+	unsigned char sver;
+	D3DTexture *tex;
+	enum TRANSLUCENCY_TYPE mode;
+	enum FILTERING_MODE_ID filter;
+} RenderQueueItem;
+
+static RenderQueueItem rq[RQ_MAXITEMS];
+static int rqc;
+static int RenderQueueEnabled = 1;
+
+/* state runs in submission order, ie. what the unsorted path would draw */
+static D3DTexture *rqLastTex;
+static int rqLastMode = -1;
+static int rqLastFilter = -1;
+static int RenderQueueStateRuns;
+static int DrawCallsThisFrame;
+static int StateChangesThisFrame;	/* texture binds, filter and blend changes */
+static int LastFrameDrawCalls;
+static int LastFrameStateChanges;
+
+static void FlushRenderQueue();
+
 /* Do not call this directly! */
 static void SetTranslucencyMode(enum TRANSLUCENCY_TYPE mode)
 {
@@ -170,6 +210,162 @@ static void SetSecondPassTranslucencyMode(enum TRANSLUCENCY_TYPE mode)
 	}
 }
 
+/*
+ Streaming buffer objects: each batch's vertices and indices are copied
+ once into a pair of ring buffers instead of being handed to the driver
+ as client arrays. A ring is written front to back; when a batch no
+ longer fits at the end it wraps to the start, and the old storage is
+ orphaned (glBufferData with no data) or, with map_buffer_range,
+ invalidated, so the driver never stalls on a draw still in flight.
+ Without map_buffer_range the copy is a plain glBufferSubData, which
+ works on OpenGL ES as well.
+
+ Vertices are uploaded once per fill of varr: the batches drawn out of
+ the render queue all index the same upload.
+
+ AVP_GL_STREAM_KB sets the vertex ring size (the index ring is a quarter
+ of it), 0 turns streaming off. With the PolyCount debug text on, the
+ bytes streamed and the number of wraps are shown each frame.
+*/
+#define STREAM_DEFAULT_KB	2048
+
+static GLuint StreamVertexBuffer;
+static GLuint StreamIndexBuffer;
+static GLsizeiptr StreamVertexSize;
+static GLsizeiptr StreamIndexSize;
+static GLintptr StreamVertexCursor;
+static GLintptr StreamIndexCursor;
+static GLintptr StreamVertexBase;	/* where varr[0] was uploaded */
+static int StreamVerticesUploaded;
+
+static int StreamBytesThisFrame;
+static int StreamWrapsThisFrame;
+
+static void InitStreamBuffers()
+{
+	const char *env = getenv("AVP_GL_STREAM_KB");
+	int kb = (env != NULL) ? atoi(env) : STREAM_DEFAULT_KB;
+
+	if (StreamVertexBuffer != 0) {
+		pglDeleteBuffers(1, &StreamVertexBuffer);
+		pglDeleteBuffers(1, &StreamIndexBuffer);
+		StreamVertexBuffer = 0;
+		StreamIndexBuffer = 0;
+	}
+
+	if (!ogl_use_vertex_buffer_object || kb <= 0) {
+		ogl_use_vertex_buffer_object = 0;
+		return;
+	}
+
+	/* a full varr/tarr must always fit */
+	StreamVertexSize = (GLsizeiptr)kb * 1024;
+	if (StreamVertexSize < (GLsizeiptr)sizeof(varr))
+		StreamVertexSize = sizeof(varr);
+	StreamIndexSize = StreamVertexSize / 4;
+	if (StreamIndexSize < (GLsizeiptr)sizeof(tarr))
+		StreamIndexSize = sizeof(tarr);
+
+	pglGenBuffers(1, &StreamVertexBuffer);
+	pglGenBuffers(1, &StreamIndexBuffer);
+
+	pglBindBuffer(GL_ARRAY_BUFFER, StreamVertexBuffer);
+	pglBufferData(GL_ARRAY_BUFFER, StreamVertexSize, NULL, GL_DYNAMIC_DRAW);
+	pglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, StreamIndexBuffer);
+	pglBufferData(GL_ELEMENT_ARRAY_BUFFER, StreamIndexSize, NULL, GL_DYNAMIC_DRAW);
+	pglBindBuffer(GL_ARRAY_BUFFER, 0);
+	pglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	StreamVertexCursor = 0;
+	StreamIndexCursor = 0;
+	StreamVertexBase = 0;
+	StreamVerticesUploaded = 0;
+}
+
+/* copies size bytes into the ring bound to target, returns their offset */
+static GLintptr StreamData(GLenum target, GLsizeiptr capacity, GLintptr *cursor, const void *data, GLsizeiptr size)
+{
+	GLintptr offset = *cursor;
+	GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+	void *dest;
+
+	if (offset + size > capacity) {
+		offset = 0;
+		access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+		StreamWrapsThisFrame++;
+
+		if (!ogl_use_map_buffer_range)
+			pglBufferData(target, capacity, NULL, GL_DYNAMIC_DRAW);
+	}
+
+	dest = ogl_use_map_buffer_range ? pglMapBufferRange(target, offset, size, access) : NULL;
+	if (dest != NULL) {
+		memcpy(dest, data, size);
+		pglUnmapBuffer(target);
+	} else {
+		pglBufferSubData(target, offset, size, data);
+	}
+
+	*cursor = offset + size;
+	StreamBytesThisFrame += size;
+
+	return offset;
+}
+
+/* uploads whatever part of varr is not in the vertex ring yet */
+static void StreamVertices()
+{
+	int first = StreamVerticesUploaded;
+	GLsizeiptr size;
+	GLintptr offset;
+
+	if (varrc <= first)
+		return;
+
+	/* the rest has to sit right after the part already there, or start over */
+	size = (varrc - first) * sizeof(varr[0]);
+	if (first && StreamVertexCursor + size > StreamVertexSize) {
+		first = 0;
+		size = varrc * sizeof(varr[0]);
+	}
+
+	offset = StreamData(GL_ARRAY_BUFFER, StreamVertexSize, &StreamVertexCursor, &varr[first], size);
+	if (first == 0)
+		StreamVertexBase = offset;
+
+	StreamVerticesUploaded = varrc;
+}
+
+/* draws count triangles out of varr, lit by its c (or s, for the specular pass) colours */
+static void DrawTriangleArray(TriangleArray *tris, int count, int specular)
+{
+	if (ogl_use_vertex_buffer_object) {
+		GLintptr indices;
+
+		pglBindBuffer(GL_ARRAY_BUFFER, StreamVertexBuffer);
+		pglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, StreamIndexBuffer);
+
+		StreamVertices();
+		indices = StreamData(GL_ELEMENT_ARRAY_BUFFER, StreamIndexSize, &StreamIndexCursor, tris, count * sizeof(tris[0]));
+
+		pglVertexPointer(4, GL_FLOAT, sizeof(varr[0]), (const GLvoid *)(StreamVertexBase + offsetof(VertexArray, v)));
+		pglTexCoordPointer(2, GL_FLOAT, sizeof(varr[0]), (const GLvoid *)(StreamVertexBase + offsetof(VertexArray, t)));
+		pglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(varr[0]), (const GLvoid *)(StreamVertexBase + (specular ? offsetof(VertexArray, s) : offsetof(VertexArray, c))));
+
+		pglDrawElements(GL_TRIANGLES, count*3, GL_UNSIGNED_SHORT, (const GLvoid *)indices);
+
+		/* leave nothing bound for the client-array drawing elsewhere (FlipBuffers) */
+		pglBindBuffer(GL_ARRAY_BUFFER, 0);
+		pglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	} else {
+		pglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(varr[0]), specular ? varr[0].s : varr[0].c);
+
+		pglDrawElements(GL_TRIANGLES, count*3, GL_UNSIGNED_SHORT, tris);
+	}
+
+	DrawCallsThisFrame++;
+}
+
 /* 
 A few things:
 - Vertices with a specular color are done twice.
@@ -219,18 +415,52 @@ void InitOpenGL()
 	
 	starrc = 0;
 	starrp = starr;
+
+	rqc = 0;
+	{
+		const char *env = getenv("AVP_GL_RENDER_QUEUE");
+		RenderQueueEnabled = (env == NULL || atoi(env) != 0);
+	}
+
+	InitStreamBuffers();
+}
+
+/* the specular colours are added over what was drawn, keeping the texture's alpha */
+static void BeginSpecularPass()
+{
+	SetSecondPassTranslucencyMode(CurrentTranslucencyMode);
+
+	pglTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_REPLACE);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_SRC0_RGB, GL_PRIMARY_COLOR);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_RGB, GL_SRC_COLOR);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_ALPHA, GL_MODULATE);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_SRC0_ALPHA, GL_TEXTURE);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_ALPHA, GL_SRC_ALPHA);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_SRC1_ALPHA, GL_PRIMARY_COLOR);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_ALPHA, GL_SRC_ALPHA);
+}
+
+static void EndSpecularPass()
+{
+	SetTranslucencyMode(CurrentTranslucencyMode);
+	pglTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 }
 
 static void FlushTriangleBuffers(int backup)
 {
+	if (rqc)
+		FlushRenderQueue();
+
 	if (tarrc) {
-		pglDrawElements(GL_TRIANGLES, tarrc*3, GL_UNSIGNED_SHORT, tarr);
+		DrawTriangleArray(tarr, tarrc, 0);
 		
 		tarrc = 0;
 		tarrp = tarr;
 		
 		varrc = 0;
 		varrp = varr;
+		StreamVerticesUploaded = 0;
 	}
 	
 	if (starrc) {
@@ -247,25 +477,12 @@ static void FlushTriangleBuffers(int backup)
 		//	//glBlendFunc(GL_SRC_ALPHA, GL_ONE);
 		//}
 
-		SetSecondPassTranslucencyMode(CurrentTranslucencyMode);
-
-		pglTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_REPLACE);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_SRC0_RGB, GL_PRIMARY_COLOR);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_RGB, GL_SRC_COLOR);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_ALPHA, GL_MODULATE);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_SRC0_ALPHA, GL_TEXTURE);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_ALPHA, GL_SRC_ALPHA);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_SRC1_ALPHA, GL_PRIMARY_COLOR);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_ALPHA, GL_SRC_ALPHA);
+		BeginSpecularPass();
 
 		//pglDisableClientState(GL_TEXTURE_COORD_ARRAY);
-		pglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(varr[0]), varr[0].s);
-
-		pglDrawElements(GL_TRIANGLES, starrc*3, GL_UNSIGNED_SHORT, starr);
+		DrawTriangleArray(starr, starrc, 1);
 
 		//pglEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		pglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(varr[0]), varr[0].c);
 		
 		//if (backup) {
 		//	//if (CurrentlyBoundTexture)
@@ -277,8 +494,7 @@ static void FlushTriangleBuffers(int backup)
 		//	CurrentTranslucencyMode = TRANSLUCENCY_GLOWING;
 		//}
 
-		SetTranslucencyMode(CurrentTranslucencyMode);
-		pglTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+		EndSpecularPass();
 
 		starrc = 0;
 		starrp = starr;
@@ -287,10 +503,15 @@ static void FlushTriangleBuffers(int backup)
 
 static void CheckBoundTextureIsCorrect(D3DTexture *tex)
 {
+	if (rqc)
+		FlushRenderQueue();
+
 	if (tex == CurrentlyBoundTexture)
 		return;
 
 	FlushTriangleBuffers(1);
+
+	StateChangesThisFrame++;
 	
 	if (tex == NULL) {
 		pglBindTexture(GL_TEXTURE_2D, 0);
@@ -324,10 +545,15 @@ static void CheckBoundTextureIsCorrect(D3DTexture *tex)
 
 static void CheckFilteringModeIsCorrect(enum FILTERING_MODE_ID filter)
 {
+	if (rqc && filter != CurrentFilteringMode)
+		FlushRenderQueue();
+
 	CurrentFilteringMode = filter;
 	
 	if (CurrentlyBoundTexture && CurrentlyBoundTexture->filter != CurrentFilteringMode) {
 		FlushTriangleBuffers(1);
+
+		StateChangesThisFrame++;
 		
 		switch(CurrentFilteringMode) {
 			case FILTERING_BILINEAR_OFF:
@@ -348,18 +574,72 @@ static void CheckFilteringModeIsCorrect(enum FILTERING_MODE_ID filter)
 		
 static void CheckTranslucencyModeIsCorrect(enum TRANSLUCENCY_TYPE mode)
 {	
+	if (rqc)
+		FlushRenderQueue();
+
 	if (CurrentTranslucencyMode == mode)
 		return;
 
 	FlushTriangleBuffers(1);
+
+	StateChangesThisFrame++;
 	
 	SetTranslucencyMode(mode);
 		
 	CurrentTranslucencyMode = mode;
 }
 
+/* writes the fan for an n-gon whose vertices start at base, returns the triangle count */
+static int OutputPolygonTriangles(TriangleArray *tp, int base, int nver)
+{
+	TriangleArray *start = tp;
+
+#define OUTPUT_TRIANGLE(x, y, z) \
+{ \
+	tp->a = base+(x);	\
+	tp->b = base+(y);	\
+	tp->c = base+(z);	\
+				\
+	tp++;			\
+}
+	
+	switch(nver) {
+		case 0:
+			break;
+		case 3:
+			OUTPUT_TRIANGLE(0, 2, 1);
+			break;
+		case 5:
+			OUTPUT_TRIANGLE(0, 1, 4);
+			OUTPUT_TRIANGLE(1, 3, 4);
+			OUTPUT_TRIANGLE(1, 2, 3);
+			break;
+		case 8:
+			OUTPUT_TRIANGLE(0, 6, 7);
+		case 7:
+			OUTPUT_TRIANGLE(0, 5, 6);
+		case 6:
+			OUTPUT_TRIANGLE(0, 4, 5);
+			OUTPUT_TRIANGLE(0, 3, 4);
+		case 4:
+			OUTPUT_TRIANGLE(0, 2, 3);
+			OUTPUT_TRIANGLE(0, 1, 2);
+			break;
+		default:
+			fprintf(stderr, "DrawTriangles_T2F_C4UB_V4F: vertices = %d\n", nver);
+	}
+#undef OUTPUT_TRIANGLE
+
+	return tp - start;
+}
+
 static void CheckTriangleBuffer(int rver, int sver, int rtri, int stri, D3DTexture *tex, enum TRANSLUCENCY_TYPE mode, enum FILTERING_MODE_ID filter)
 {
+	int n;
+
+	if (rqc)
+		FlushRenderQueue();
+
 	if ((rver+varrc) >= TA_MAXVERTICES) {
 		FlushTriangleBuffers(0);
 	} else if (rtri == 0 && ((rver-2+tarrc) >= TA_MAXTRIANGLES)) {
@@ -375,82 +655,568 @@ static void CheckTriangleBuffer(int rver, int sver, int rtri, int stri, D3DTextu
 	if (filter != -1)
 		CheckFilteringModeIsCorrect(filter);
 
-#define OUTPUT_TRIANGLE(x, y, z) \
-{ \
-	tarrp->a = varrc+(x);	\
-	tarrp->b = varrc+(y);	\
-	tarrp->c = varrc+(z);	\
-				\
-	tarrp++;		\
-	tarrc++; 		\
-}
-	
 	if (rtri == 0) {
-		switch(rver) {
-			case 0:
-				break;
-			case 3:
-				OUTPUT_TRIANGLE(0, 2, 1);
-				break;
-			case 5:
-				OUTPUT_TRIANGLE(0, 1, 4);
-				OUTPUT_TRIANGLE(1, 3, 4);
-				OUTPUT_TRIANGLE(1, 2, 3);
-				break;
-			case 8:
-				OUTPUT_TRIANGLE(0, 6, 7);
-			case 7:
-				OUTPUT_TRIANGLE(0, 5, 6);
-			case 6:
-				OUTPUT_TRIANGLE(0, 4, 5);
-				OUTPUT_TRIANGLE(0, 3, 4);
-			case 4:
-				OUTPUT_TRIANGLE(0, 2, 3);
-				OUTPUT_TRIANGLE(0, 1, 2);
-				break;
-			default:
-				fprintf(stderr, "DrawTriangles_T2F_C4UB_V4F: vertices = %d\n", rver);
+		n = OutputPolygonTriangles(tarrp, varrc, rver);
+		tarrp += n;
+		tarrc += n;
+	}
+	if (stri == 0) {
+		n = OutputPolygonTriangles(starrp, varrc, sver);
+		starrp += n;
+		starrc += n;
+	}
+}
+
+/* D3D_*_Output: reserve room in varr for a polygon and queue it */
+static void QueuePolygon(int rver, int sver, D3DTexture *tex, enum TRANSLUCENCY_TYPE mode)
+{
+	RenderQueueItem *item;
+
+	if (!RenderQueueEnabled) {
+		CheckTriangleBuffer(rver, sver, 0, 0, tex, mode, -1);
+		return;
+	}
+
+	/* immediate triangles must not be drawn with the queue's state */
+	if (tarrc || starrc || (rver+varrc) >= TA_MAXVERTICES || rqc == RQ_MAXITEMS)
+		FlushTriangleBuffers(0);
+
+	item = &rq[rqc++];
+	item->first = varrc;
+	item->rver = rver;
+	item->sver = sver;
+	item->tex = tex;
+	item->mode = mode;
+	item->filter = CurrentFilteringMode;
+
+	if (mode == TRANSLUCENCY_OFF && !(TRIPTASTIC_CHEATMODE||MOTIONBLUR_CHEATMODE)) {
+		item->key = ((unsigned int)item->filter << 24) | (tex ? (tex->id & 0xFFFFFF) : 0);
+	} else {
+		/* blended: the vertex index keeps them in submission order */
+		item->key = RQ_TRANSLUCENT;
+	}
+
+	if (tex != rqLastTex || (int)mode != rqLastMode || (int)item->filter != rqLastFilter) {
+		rqLastTex = tex;
+		rqLastMode = mode;
+		rqLastFilter = item->filter;
+		RenderQueueStateRuns++;
+	}
+}
+
+static int CompareRenderQueueItems(const void *a, const void *b)
+{
+	const RenderQueueItem *p = a;
+	const RenderQueueItem *q = b;
+
+	if (p->key != q->key)
+		return (p->key < q->key) ? -1 : 1;
+	return (int)p->first - (int)q->first;
+}
+
+static void FlushRenderQueue()
+{
+	int count = rqc;
+	int i, n;
+
+	/* the state checks below flush tarr, they must not come back here */
+	rqc = 0;
+
+	qsort(rq, count, sizeof(rq[0]), CompareRenderQueueItems);
+
+	for (i = 0; i < count; i++) {
+		RenderQueueItem *item = &rq[i];
+
+		if ((item->rver-2+tarrc) >= TA_MAXTRIANGLES || (item->sver-2+starrc) >= TA_MAXTRIANGLES)
+			FlushTriangleBuffers(1);
+
+		CheckBoundTextureIsCorrect(item->tex);
+		CheckTranslucencyModeIsCorrect(item->mode);
+		CheckFilteringModeIsCorrect(item->filter);
+
+		n = OutputPolygonTriangles(tarrp, item->first, item->rver);
+		tarrp += n;
+		tarrc += n;
+
+		n = OutputPolygonTriangles(starrp, item->first, item->sver);
+		starrp += n;
+		starrc += n;
+	}
+
+	FlushTriangleBuffers(0);
+
+	varrc = 0;
+	varrp = varr;
+	StreamVerticesUploaded = 0;
+
+	rqLastTex = NULL;
+	rqLastMode = -1;
+	rqLastFilter = -1;
+}
+
+/*
+ Baked landscape: once a level has loaded, the opaque polygons of every
+ module's shape are copied into a static buffer object, positions in the
+ shape's own space and texture coordinates already scaled, with the
+ triangles grouped into one batch per texture. A visible module is then
+ drawn with a draw call per batch (and the same again for the specular
+ pass) under a matrix doing the view transform and projection that the
+ D3D_*_Output functions do on the CPU; only the lighting changes from
+ frame to frame, one colour per shape point, and that is streamed in.
+
+ Transparent, animated and untextured polygons are left out; ShapePipeline
+ gets them in a copy of the shape holding nothing else. GL culls the back
+ faces, so each baked polygon is wound to agree with its normal, and those
+ flagged iflag_no_bfc go in batches of their own.
+
+ The projection is only linear in Z while HeadUpDisplayZOffset is 0, and
+ the lighting is the normal vision mode's; kshape.c falls back to the
+ pipeline for everything else. AVP_GL_STATIC_MODULES=0 turns this off.
+*/
+#define SM_NOLIGHT		0xFFFF
+#define SM_MAXVERTICES	0xFFFF
+
+typedef struct StaticModuleVertex
+{
+	GLfloat v[3];
+	GLfloat t[2];
+} StaticModuleVertex;
+
+typedef struct StaticModuleColour
+{
+	GLubyte c[4];
+	GLubyte s[4];
+} StaticModuleColour;
+
+typedef struct StaticModuleBatch
+{
+	D3DTexture *tex;
+	int cull;
+	int first;		/* first index */
+	int count;		/* number of indices */
+} StaticModuleBatch;
+
+typedef struct StaticModule
+{
+	SHAPEHEADER *shape;
+	GLuint vbo;
+	GLuint ibo;
+	int nvertices;
+	unsigned short *points;	/* shape point lighting each vertex, or SM_NOLIGHT */
+	int nbatches;
+	StaticModuleBatch *batches;
+	SHAPEHEADER rest;		/* the polygons left for ShapePipeline */
+} StaticModule;
+
+typedef struct StaticPolygon
+{
+	POLYHEADER *poly;
+	D3DTexture *tex;
+	int cull;
+	int nver;
+	int item;
+} StaticPolygon;
+
+static StaticModule *StaticModules;
+static int NumStaticModules;
+static StaticModuleColour *StaticModuleColours;
+static int StaticModuleColoursSize;
+
+static int StaticModulesThisFrame;
+static int StaticTrianglesThisFrame;
+
+/* number of vertices if the polygon can go in the buffers, 0 if not */
+static int StaticPolygonVertices(POLYHEADER *polyPtr)
+{
+	int *vertexNumberPtr = &polyPtr->Poly1stPt;
+	int texoffset;
+	int n = 0;
+
+	switch (polyPtr->PolyItemType) {
+		case I_ZB_Gouraud3dTexturedPolygon:
+		case I_ZB_Gouraud2dTexturedPolygon:
+			break;
+		default:
+			return 0;
+	}
+
+	if (polyPtr->PolyFlags & (iflag_notvis|iflag_transparent|iflag_txanim))
+		return 0;
+
+	texoffset = polyPtr->PolyColour & ClrTxDefn;
+	if (texoffset == 0 || ImageHeaderArray[texoffset].D3DTexture == NULL)
+		return 0;
+
+	while (*vertexNumberPtr++ != Term)
+		n++;
+
+	return (n >= 3 && n <= 8) ? n : 0;
+}
+
+static int CompareStaticPolygons(const void *a, const void *b)
+{
+	const StaticPolygon *p = a;
+	const StaticPolygon *q = b;
+
+	if (p->tex != q->tex)
+		return (p->tex->id < q->tex->id) ? -1 : 1;
+	if (p->cull != q->cull)
+		return p->cull - q->cull;
+	return p->item - q->item;
+}
+
+/* nonzero if the polygon's vertices go round the other way to its normal */
+static int StaticPolygonIsReversed(SHAPEHEADER *shapePtr, POLYHEADER *polyPtr, int nver)
+{
+	VECTORCH *points = (VECTORCH *)*shapePtr->points;
+	VECTORCH *normalPtr;
+	int *vertexNumberPtr = &polyPtr->Poly1stPt;
+	double nx = 0.0, ny = 0.0, nz = 0.0;
+	int i;
+
+	if (shapePtr->sh_normals == NULL)
+		return 0;
+	normalPtr = (VECTORCH *)(*shapePtr->sh_normals + polyPtr->PolyNormalIndex);
+
+	/* Newell's method: fine with the odd collinear vertex */
+	for (i = 0; i < nver; i++) {
+		VECTORCH *p = &points[vertexNumberPtr[i]];
+		VECTORCH *q = &points[vertexNumberPtr[(i+1) % nver]];
+
+		nx += (double)(p->vy - q->vy) * (double)(p->vz + q->vz);
+		ny += (double)(p->vz - q->vz) * (double)(p->vx + q->vx);
+		nz += (double)(p->vx - q->vx) * (double)(p->vy + q->vy);
+	}
+
+	return (nx*normalPtr->vx + ny*normalPtr->vy + nz*normalPtr->vz) < 0.0;
+}
+
+static void ReleaseStaticModule(StaticModule *sm)
+{
+	if (sm->vbo != 0)
+		pglDeleteBuffers(1, &sm->vbo);
+	if (sm->ibo != 0)
+		pglDeleteBuffers(1, &sm->ibo);
+
+	free(sm->points);
+	free(sm->batches);
+	free(sm->rest.items);
+
+	memset(sm, 0, sizeof(*sm));
+}
+
+static void BakeStaticModule(StaticModule *sm, SHAPEHEADER *shapePtr)
+{
+	VECTORCH *points;
+	StaticPolygon *polys;
+	StaticModuleVertex *vertices = NULL;
+	unsigned short *indices = NULL;
+	int npolys = 0, nvertices = 0, nindices = 0;
+	int i, v, x;
+
+	if (shapePtr == NULL || shapePtr->numitems <= 0 || shapePtr->numpoints > maxrotpts)
+		return;
+	if (shapePtr->shapeflags & ShapeFlag_Sprite)
+		return;
+
+	points = (VECTORCH *)*shapePtr->points;
+
+	polys = malloc(shapePtr->numitems * sizeof(StaticPolygon));
+	if (polys == NULL)
+		return;
+
+	for (i = 0; i < shapePtr->numitems; i++) {
+		POLYHEADER *polyPtr = (POLYHEADER *)shapePtr->items[i];
+		int nver = StaticPolygonVertices(polyPtr);
+
+		if (nver == 0)
+			continue;
+
+		polys[npolys].poly = polyPtr;
+		polys[npolys].tex = ImageHeaderArray[polyPtr->PolyColour & ClrTxDefn].D3DTexture;
+		polys[npolys].cull = !(polyPtr->PolyFlags & iflag_no_bfc);
+		polys[npolys].nver = nver;
+		polys[npolys].item = i;
+		npolys++;
+
+		nvertices += nver;
+		nindices += (nver - 2) * 3;
+	}
+
+	/* the colours for a module have to fit in the vertex ring in one go */
+	if (npolys == 0 || nvertices > SM_MAXVERTICES ||
+		nvertices * (GLsizeiptr)sizeof(StaticModuleColour) > StreamVertexSize) {
+		free(polys);
+		return;
+	}
+
+	qsort(polys, npolys, sizeof(polys[0]), CompareStaticPolygons);
+
+	vertices = malloc(nvertices * sizeof(vertices[0]));
+	indices = malloc(nindices * sizeof(indices[0]));
+	sm->points = malloc(nvertices * sizeof(sm->points[0]));
+	sm->batches = malloc(npolys * sizeof(sm->batches[0]));
+	sm->rest = *shapePtr;
+	sm->rest.numitems = 0;
+	sm->rest.items = malloc(shapePtr->numitems * sizeof(sm->rest.items[0]));
+
+	if (!vertices || !indices || !sm->points || !sm->batches || !sm->rest.items) {
+		free(vertices);
+		free(indices);
+		free(polys);
+		ReleaseStaticModule(sm);
+		return;
+	}
+
+	v = 0;
+	x = 0;
+	for (i = 0; i < npolys; i++) {
+		StaticPolygon *sp = &polys[i];
+		int *vertexNumberPtr = &sp->poly->Poly1stPt;
+		int *texture_defn_ptr = shapePtr->sh_textures[sp->poly->PolyColour >> TxDefn];
+		int reversed = sp->cull && StaticPolygonIsReversed(shapePtr, sp->poly, sp->nver);
+		float RecipW = sp->tex->RecipW / 65536.0f;
+		float RecipH = sp->tex->RecipH / 65536.0f;
+		StaticModuleBatch *batch;
+		int k;
+
+		if (i == 0 || sp->tex != polys[i-1].tex || sp->cull != polys[i-1].cull) {
+			batch = &sm->batches[sm->nbatches++];
+			batch->tex = sp->tex;
+			batch->cull = sp->cull;
+			batch->first = x;
+			batch->count = 0;
+		} else {
+			batch = &sm->batches[sm->nbatches-1];
 		}
-	}	
-#undef OUTPUT_TRIANGLE
-	
-#define OUTPUT_TRIANGLE(x, y, z) \
-{ \
-	starrp->a = varrc+(x);	\
-	starrp->b = varrc+(y);	\
-	starrp->c = varrc+(z);	\
-						\
-	starrp++;				\
-	starrc++; 				\
+
+		for (k = 0; k < sp->nver; k++) {
+			int corner = reversed ? (sp->nver - 1 - k) : k;
+			int pointNumber = vertexNumberPtr[corner];
+
+			vertices[v+k].v[0] = (GLfloat)points[pointNumber].vx;
+			vertices[v+k].v[1] = (GLfloat)points[pointNumber].vy;
+			vertices[v+k].v[2] = (GLfloat)points[pointNumber].vz;
+			vertices[v+k].t[0] = TEXCOORD_FIXED(texture_defn_ptr[corner*2+0] << 16, RecipW);
+			vertices[v+k].t[1] = TEXCOORD_FIXED(texture_defn_ptr[corner*2+1] << 16, RecipH);
+
+			sm->points[v+k] = (sp->poly->PolyFlags & iflag_nolight) ? SM_NOLIGHT : pointNumber;
+		}
+
+		for (k = 1; k < sp->nver - 1; k++) {
+			indices[x++] = v;
+			indices[x++] = v + k;
+			indices[x++] = v + k + 1;
+		}
+		batch->count += (sp->nver - 2) * 3;
+
+		v += sp->nver;
+	}
+
+	/* everything not baked, in the shape's own order */
+	for (i = 0; i < shapePtr->numitems; i++) {
+		if (StaticPolygonVertices((POLYHEADER *)shapePtr->items[i]) == 0)
+			sm->rest.items[sm->rest.numitems++] = shapePtr->items[i];
+	}
+
+	pglGenBuffers(1, &sm->vbo);
+	pglGenBuffers(1, &sm->ibo);
+
+	pglBindBuffer(GL_ARRAY_BUFFER, sm->vbo);
+	pglBufferData(GL_ARRAY_BUFFER, nvertices * sizeof(vertices[0]), vertices, GL_STATIC_DRAW);
+	pglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sm->ibo);
+	pglBufferData(GL_ELEMENT_ARRAY_BUFFER, nindices * sizeof(indices[0]), indices, GL_STATIC_DRAW);
+	pglBindBuffer(GL_ARRAY_BUFFER, 0);
+	pglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	free(vertices);
+	free(indices);
+	free(polys);
+
+	if (nvertices > StaticModuleColoursSize) {
+		StaticModuleColour *colours = realloc(StaticModuleColours, nvertices * sizeof(StaticModuleColours[0]));
+
+		if (colours == NULL) {
+			ReleaseStaticModule(sm);
+			return;
+		}
+		StaticModuleColours = colours;
+		StaticModuleColoursSize = nvertices;
+	}
+
+	sm->nvertices = nvertices;
+	sm->shape = shapePtr;
 }
-	if (stri == 0) {
-		switch(sver) {
-			case 0:
-				break;
-			case 3:
-				OUTPUT_TRIANGLE(0, 2, 1);
-				break;
-			case 5:
-				OUTPUT_TRIANGLE(0, 1, 4);
-				OUTPUT_TRIANGLE(1, 3, 4);
-				OUTPUT_TRIANGLE(1, 2, 3);
-				break;
-			case 8:
-				OUTPUT_TRIANGLE(0, 6, 7);
-			case 7:
-				OUTPUT_TRIANGLE(0, 5, 6);
-			case 6:
-				OUTPUT_TRIANGLE(0, 4, 5);
-				OUTPUT_TRIANGLE(0, 3, 4);
-			case 4:
-				OUTPUT_TRIANGLE(0, 2, 3);
-				OUTPUT_TRIANGLE(0, 1, 2);
-				break;
-			default:
-				fprintf(stderr, "DrawTriangles_T2F_C4UB_V4F: vertices = %d\n", sver);
+
+void D3D_ReleaseStaticModules()
+{
+	int i;
+
+	for (i = 0; i < NumStaticModules; i++)
+		ReleaseStaticModule(&StaticModules[i]);
+
+	free(StaticModules);
+	StaticModules = NULL;
+	NumStaticModules = 0;
+
+	free(StaticModuleColours);
+	StaticModuleColours = NULL;
+	StaticModuleColoursSize = 0;
+}
+
+/* after the level has loaded: modules with a strategy block move or change, so they are left alone */
+void D3D_BakeStaticModules()
+{
+	extern SCENE Global_Scene;
+	const char *env = getenv("AVP_GL_STATIC_MODULES");
+	MODULE **moduleListPointer;
+
+	D3D_ReleaseStaticModules();
+
+	if (!ogl_use_vertex_buffer_object || (env != NULL && atoi(env) == 0))
+		return;
+	if (Global_ModulePtr == NULL || ModuleArraySize <= 0)
+		return;
+
+	StaticModules = calloc(ModuleArraySize, sizeof(StaticModules[0]));
+	if (StaticModules == NULL)
+		return;
+	NumStaticModules = ModuleArraySize;
+
+	moduleListPointer = (Global_ModulePtr[Global_Scene])->sm_marray;
+	while (*moduleListPointer) {
+		MODULE *modulePtr = *moduleListPointer++;
+
+		if (modulePtr->m_index < 0 || modulePtr->m_index >= NumStaticModules)
+			continue;
+		if (modulePtr->m_mapptr == NULL || modulePtr->m_sbptr != NULL)
+			continue;
+
+		BakeStaticModule(&StaticModules[modulePtr->m_index], GetShapeData(modulePtr->m_mapptr->MapShape));
+	}
+}
+
+int D3D_StaticModuleIsBaked(MODULE *modulePtr, SHAPEHEADER *shapePtr)
+{
+	return modulePtr->m_index >= 0 && modulePtr->m_index < NumStaticModules &&
+		StaticModules[modulePtr->m_index].shape == shapePtr;
+}
+
+/*
+ viewMatrix takes the shape's points into view space (3x4, rows as in kshape.c),
+ lighting holds the colours worked out for each of them.
+ Returns the shape's polygons that are not in the buffers, or NULL.
+*/
+SHAPEHEADER *D3D_StaticModule_Output(MODULE *modulePtr, const float *viewMatrix, const COLOURINTENSITIES *lighting)
+{
+	StaticModule *sm = &StaticModules[modulePtr->m_index];
+	GLfloat matrix[16];
+	GLintptr colours;
+	float ZNear, ProjX, ProjY;
+	int culling = 0;
+	int i, pass;
+
+	/* nothing buffered may be drawn with the state set up below */
+	FlushTriangleBuffers(0);
+
+	for (i = 0; i < sm->nvertices; i++) {
+		StaticModuleColour *colour = &StaticModuleColours[i];
+		const COLOURINTENSITIES *ci;
+
+		if (sm->points[i] == SM_NOLIGHT) {
+			colour->c[0] = colour->c[1] = colour->c[2] = GammaValues[255];
+			colour->s[0] = colour->s[1] = colour->s[2] = GammaValues[0];
+		} else {
+			ci = &lighting[sm->points[i]];
+			colour->c[0] = GammaValues[ci->R];
+			colour->c[1] = GammaValues[ci->G];
+			colour->c[2] = GammaValues[ci->B];
+			colour->s[0] = GammaValues[ci->SpecularR];
+			colour->s[1] = GammaValues[ci->SpecularG];
+			colour->s[2] = GammaValues[ci->SpecularB];
 		}
+		colour->c[3] = 255;
+		colour->s[3] = 255;
 	}
-#undef OUTPUT_TRIANGLE
+
+	pglBindBuffer(GL_ARRAY_BUFFER, StreamVertexBuffer);
+	colours = StreamData(GL_ARRAY_BUFFER, StreamVertexSize, &StreamVertexCursor, StaticModuleColours, sm->nvertices * sizeof(StaticModuleColours[0]));
+	/* varr can no longer carry on where its last upload stopped */
+	StreamVerticesUploaded = 0;
+
+	/*
+	 x, y and w as in D3D_ZBufferedGouraudTexturedPolygon_Output;
+	 z*w = Z - 2*ZNear*Z/Z, which is Z - 2*ZNear
+	*/
+	ZNear = (float) (Global_VDB_Ptr->VDB_ClipZ * GlobalScale);
+	ProjX =  ((float)Global_VDB_Ptr->VDB_ProjX+1.0f)/(float)ScreenDescriptorBlock.SDB_CentreX;
+	ProjY = -((float)Global_VDB_Ptr->VDB_ProjY+1.0f)/(float)ScreenDescriptorBlock.SDB_CentreY;
+
+	for (i = 0; i < 4; i++) {
+		matrix[i*4+0] = ProjX * viewMatrix[0*4+i];
+		matrix[i*4+1] = ProjY * viewMatrix[1*4+i];
+		matrix[i*4+2] = viewMatrix[2*4+i];
+		matrix[i*4+3] = viewMatrix[2*4+i];
+	}
+	matrix[3*4+2] -= 2.0f*ZNear;
+
+	pglLoadMatrixf(matrix);
+
+	pglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(StaticModuleColours[0]), (const GLvoid *)(colours + offsetof(StaticModuleColour, c)));
+
+	pglBindBuffer(GL_ARRAY_BUFFER, sm->vbo);
+	pglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sm->ibo);
+	pglVertexPointer(3, GL_FLOAT, sizeof(StaticModuleVertex), (const GLvoid *)offsetof(StaticModuleVertex, v));
+	pglTexCoordPointer(2, GL_FLOAT, sizeof(StaticModuleVertex), (const GLvoid *)offsetof(StaticModuleVertex, t));
+
+	CheckTranslucencyModeIsCorrect(TRANSLUCENCY_OFF);
+
+	/* the projection flips y, so a polygon facing the camera comes out anticlockwise */
+	pglFrontFace(GL_CCW);
+	pglCullFace(GL_BACK);
+
+	for (pass = 0; pass < 2; pass++) {
+		if (pass == 1) {
+			pglBindBuffer(GL_ARRAY_BUFFER, StreamVertexBuffer);
+			pglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(StaticModuleColours[0]), (const GLvoid *)(colours + offsetof(StaticModuleColour, s)));
+			BeginSpecularPass();
+		}
+
+		for (i = 0; i < sm->nbatches; i++) {
+			StaticModuleBatch *batch = &sm->batches[i];
+
+			CheckBoundTextureIsCorrect(batch->tex);
+
+			if (batch->cull != culling) {
+				culling = batch->cull;
+				if (culling)
+					pglEnable(GL_CULL_FACE);
+				else
+					pglDisable(GL_CULL_FACE);
+			}
+
+			pglDrawElements(GL_TRIANGLES, batch->count, GL_UNSIGNED_SHORT, (const GLvoid *)(batch->first * sizeof(unsigned short)));
+
+			DrawCallsThisFrame++;
+			if (pass == 0)
+				StaticTrianglesThisFrame += batch->count / 3;
+		}
+
+		if (pass == 1)
+			EndSpecularPass();
+	}
+
+	if (culling)
+		pglDisable(GL_CULL_FACE);
+
+	pglLoadIdentity();
+
+	pglBindBuffer(GL_ARRAY_BUFFER, 0);
+	pglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	StaticModulesThisFrame++;
+
+	return sm->rest.numitems ? &sm->rest : NULL;
 }
 
 static unsigned int PowerOfTwo(unsigned int v) {
@@ -611,6 +1377,39 @@ void ThisFramesRenderingHasFinished()
 	LightBlockDeallocation();
 	
 	FlushTriangleBuffers(0);
+
+	if (ShowDebuggingText.PolyCount) {
+		ReleasePrintDebuggingText("Draw calls: %d, %d state changes (%d unsorted state runs, queue %s)\n", DrawCallsThisFrame, StateChangesThisFrame,
+			RenderQueueStateRuns, RenderQueueEnabled ? "on" : "off");
+		if (ogl_use_vertex_buffer_object) {
+			ReleasePrintDebuggingText("Streamed: %d KB, %d wraps (rings %d/%d KB)\n", StreamBytesThisFrame / 1024, StreamWrapsThisFrame,
+				(int)(StreamVertexSize / 1024), (int)(StreamIndexSize / 1024));
+		}
+		if (NumStaticModules) {
+			ReleasePrintDebuggingText("Baked modules: %d, %d triangles\n", StaticModulesThisFrame, StaticTrianglesThisFrame);
+		}
+	}
+	LastFrameDrawCalls = DrawCallsThisFrame;
+	LastFrameStateChanges = StateChangesThisFrame;
+	DrawCallsThisFrame = 0;
+	StateChangesThisFrame = 0;
+	RenderQueueStateRuns = 0;
+	StreamBytesThisFrame = 0;
+	StreamWrapsThisFrame = 0;
+	StaticModulesThisFrame = 0;
+	StaticTrianglesThisFrame = 0;
+}
+
+/* totals for the frame ThisFramesRenderingHasFinished last closed */
+void D3D_GetFrameCounters(int *drawCalls, int *stateChanges)
+{
+	*drawCalls = LastFrameDrawCalls;
+	*stateChanges = LastFrameStateChanges;
+}
+
+int D3D_RenderQueueIsEnabled()
+{
+	return RenderQueueEnabled;
 }
         
 /* ** */
@@ -730,7 +1529,7 @@ void D3D_ZBufferedGouraudTexturedPolygon_Output(POLYHEADER *inputPolyPtr, RENDER
 	RecipW = TextureHandle->RecipW / 65536.0f;
 	RecipH = TextureHandle->RecipH / 65536.0f;
 
-	CheckTriangleBuffer(RenderPolygon.NumberOfVertices, RenderPolygon.NumberOfVertices, 0, 0, TextureHandle, RenderPolygon.TranslucencyMode, -1);
+	QueuePolygon(RenderPolygon.NumberOfVertices, RenderPolygon.NumberOfVertices, TextureHandle, RenderPolygon.TranslucencyMode);
 	
 	for (i = 0; i < RenderPolygon.NumberOfVertices; i++) {
 		RENDERVERTEX *vertices = &renderVerticesPtr[i];
@@ -785,7 +1584,7 @@ void D3D_SkyPolygon_Output(POLYHEADER *inputPolyPtr, RENDERVERTEX *renderVertice
 	RecipW = TextureHandle->RecipW / 65536.0f;
 	RecipH = TextureHandle->RecipH / 65536.0f;
 	
-	CheckTriangleBuffer(RenderPolygon.NumberOfVertices, 0, 0, 0, TextureHandle, RenderPolygon.TranslucencyMode, -1);
+	QueuePolygon(RenderPolygon.NumberOfVertices, 0, TextureHandle, RenderPolygon.TranslucencyMode);
 	
 	for (i = 0; i < RenderPolygon.NumberOfVertices; i++) {
 		RENDERVERTEX *vertices = &renderVerticesPtr[i];
@@ -847,7 +1646,7 @@ void D3D_ZBufferedCloakedPolygon_Output(POLYHEADER *inputPolyPtr, RENDERVERTEX *
 	RecipW = TextureHandle->RecipW / 65536.0f;
 	RecipH = TextureHandle->RecipH / 65536.0f;
 	
-	CheckTriangleBuffer(RenderPolygon.NumberOfVertices, 0, 0, 0, TextureHandle, TRANSLUCENCY_NORMAL, -1);
+	QueuePolygon(RenderPolygon.NumberOfVertices, 0, TextureHandle, TRANSLUCENCY_NORMAL);
 	
 	for (i = 0; i < RenderPolygon.NumberOfVertices; i++) {
 		RENDERVERTEX *vertices = &renderVerticesPtr[i];
@@ -943,7 +1742,7 @@ void D3D_Decal_Output(DECAL *decalPtr, RENDERVERTEX *renderVerticesPtr)
 		a = decalDescPtr->Alpha;
 	}
 	
-	CheckTriangleBuffer(RenderPolygon.NumberOfVertices, 0, 0, 0, TextureHandle, decalDescPtr->TranslucencyType, -1);
+	QueuePolygon(RenderPolygon.NumberOfVertices, 0, TextureHandle, decalDescPtr->TranslucencyType);
 	
 	for (i = 0; i < RenderPolygon.NumberOfVertices; i++) {
 		RENDERVERTEX *vertices = &renderVerticesPtr[i];
@@ -1035,7 +1834,7 @@ void D3D_Particle_Output(PARTICLE *particlePtr, RENDERVERTEX *renderVerticesPtr)
 		a = particleDescPtr->Alpha;
 	}
 
-	CheckTriangleBuffer(RenderPolygon.NumberOfVertices, 0, 0, 0, TextureHandle, particleDescPtr->TranslucencyType, -1);
+	QueuePolygon(RenderPolygon.NumberOfVertices, 0, TextureHandle, particleDescPtr->TranslucencyType);
 	
 	for (i = 0; i < RenderPolygon.NumberOfVertices; i++) {
 		RENDERVERTEX *vertices = &renderVerticesPtr[i];
@@ -1087,7 +1886,7 @@ void D3D_PredatorThermalVisionPolygon_Output(POLYHEADER *inputPolyPtr, RENDERVER
 	int i;
 	ZNear = (float) (Global_VDB_Ptr->VDB_ClipZ * GlobalScale);
 	
-	CheckTriangleBuffer(RenderPolygon.NumberOfVertices, 0, 0, 0, NULL, TRANSLUCENCY_OFF, -1);
+	QueuePolygon(RenderPolygon.NumberOfVertices, 0, NULL, TRANSLUCENCY_OFF);
 	
 	for (i = 0; i < RenderPolygon.NumberOfVertices; i++) {
 		RENDERVERTEX *vertices = &renderVerticesPtr[i];
@@ -1133,7 +1932,7 @@ void D3D_ZBufferedGouraudPolygon_Output(POLYHEADER *inputPolyPtr, RENDERVERTEX *
 	
 	flags = inputPolyPtr->PolyFlags;
 	
-	CheckTriangleBuffer(RenderPolygon.NumberOfVertices, 0, 0, 0, NULL, RenderPolygon.TranslucencyMode, -1);
+	QueuePolygon(RenderPolygon.NumberOfVertices, 0, NULL, RenderPolygon.TranslucencyMode);
 	
 	for (i = 0; i < RenderPolygon.NumberOfVertices; i++) {
 		RENDERVERTEX *vertices = &renderVerticesPtr[i];	
@@ -6,6 +6,8 @@
 void InitOpenGL();
 void ThisFramesRenderingHasBegun();
 void ThisFramesRenderingHasFinished();
+void D3D_GetFrameCounters(int *drawCalls, int *stateChanges);
+int D3D_RenderQueueIsEnabled();
 void D3D_SkyPolygon_Output(POLYHEADER *inputPolyPtr, RENDERVERTEX *renderVerticesPtr);
 void D3D_DrawBackdrop();
 void D3D_FadeDownScreen(int brightness, int colour);
@@ -20,4 +22,10 @@ void D3D_PredatorScreenInversionOverlay();
 void D3D_ScreenInversionOverlay();
 void D3D_DrawColourBar(int yTop, int yBottom, int rScale, int gScale, int bScale);
 
+struct module;
+void D3D_BakeStaticModules();
+void D3D_ReleaseStaticModules();
+int D3D_StaticModuleIsBaked(struct module *modulePtr, SHAPEHEADER *shapePtr);
+SHAPEHEADER *D3D_StaticModule_Output(struct module *modulePtr, const float *viewMatrix, const COLOURINTENSITIES *lighting);
+
 #endif
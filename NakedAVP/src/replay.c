@@ -0,0 +1,565 @@
+/*
+ * replay.c - input recording and headless playback of the main loop
+ *
+ * The recording is a header followed by one fixed-size record per pass
+ * of the main loop. Input is stored as the key state the game reads
+ * (after CheckForWindowsMessages), so playback does not go through SDL.
+ * While a level is recorded or played back, timeGetTime returns the time
+ * latched at the end of the previous frame; every clock read in a frame
+ * therefore sees the same value in both runs.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#include "3dc.h"
+#include "platform.h"
+#include "inline.h"
+#include "gamedef.h"
+#include "stratdef.h"
+#include "dynblock.h"
+#include "avp_userprofile.h"
+#include "opengl.h"
+#include "replay.h"
+
+#define REPLAY_MAGIC		"AVPR"
+#define REPLAY_VERSION		1
+#define REPLAY_NAME_LENGTH	32		/* size of LevelName in main.c */
+#define REPLAY_KEY_BYTES	((MAX_NUMBER_OF_INPUT_KEYS + 7) / 8)
+
+typedef struct replay_header
+{
+	char magic[4];
+	int version;
+	int seed;
+	int playerType;
+	int difficulty;
+	unsigned int startTime;
+	int numberOfFrames;			/* filled in when the recording is closed */
+	char levelName[REPLAY_NAME_LENGTH];
+	char profileName[REPLAY_NAME_LENGTH];
+
+} REPLAY_HEADER;
+
+typedef struct replay_frame
+{
+	unsigned int time;			/* clock as FrameCounterHandler read it */
+	int mouseVelX;
+	int mouseVelY;
+	unsigned char gotAnyKey;
+	unsigned char debouncedGotAnyKey;
+	unsigned char keys[REPLAY_KEY_BYTES];
+	unsigned char debouncedKeys[REPLAY_KEY_BYTES];
+	Uint64 worldHash;			/* after the frame's updates */
+
+} REPLAY_FRAME;
+
+enum REPLAY_MODE {
+	REPLAY_MODE_NONE,
+	REPLAY_MODE_RECORD,
+	REPLAY_MODE_PLAYBACK
+};
+
+extern char LevelName[];
+extern unsigned char KeyboardInput[];
+extern unsigned char DebouncedKeyboardInput[];
+extern unsigned char GotAnyKey;
+extern int DebouncedGotAnyKey;
+extern int MouseVelX;
+extern int MouseVelY;
+extern int TimeScale;
+extern void LoadDefaultPrimaryConfigs(void);
+
+static enum REPLAY_MODE ReplayMode = REPLAY_MODE_NONE;
+static FILE *ReplayFile;
+static REPLAY_HEADER ReplayHeader;
+static REPLAY_FRAME ReplayFrame;
+static int ReplayFrameNumber;
+static int ReplayLevelSetUp;
+static int ReplayLevelDone;		/* only the first level is recorded or played back */
+
+static int ReplayClockRunning;
+static unsigned int ReplayClock;
+
+static int ReplayDivergedFrame = -1;
+
+/* playback timing, ReplayHeader.numberOfFrames samples per timer */
+static Uint64 *ReplayTimings;
+static Uint64 ReplayTimerStart[REPLAY_TIMER_COUNT];
+static const char *ReplayTimerNames[REPLAY_TIMER_COUNT] = {
+	"frame", "game", "accessibility", "views"
+};
+
+/* playback renderer counters, per frame */
+enum REPLAY_COUNTER {
+	REPLAY_COUNTER_DRAW_CALLS,
+	REPLAY_COUNTER_STATE_CHANGES,
+
+	REPLAY_COUNTER_COUNT
+};
+
+static int *ReplayCounters;
+static const char *ReplayCounterNames[REPLAY_COUNTER_COUNT] = {
+	"draw calls", "state changes"
+};
+
+static void PackKeys(unsigned char *bits, const unsigned char *keys)
+{
+	int i;
+
+	memset(bits, 0, REPLAY_KEY_BYTES);
+	for (i = 0; i < MAX_NUMBER_OF_INPUT_KEYS; i++) {
+		if (keys[i]) bits[i >> 3] |= 1 << (i & 7);
+	}
+}
+
+static void UnpackKeys(unsigned char *keys, const unsigned char *bits)
+{
+	int i;
+
+	for (i = 0; i < MAX_NUMBER_OF_INPUT_KEYS; i++) {
+		keys[i] = (bits[i >> 3] >> (i & 7)) & 1;
+	}
+}
+
+/* FNV-1a over what the game simulates: every active strategy block's type,
+ * position, orientation, velocity and damage */
+static Uint64 HashInts(Uint64 hash, const int *values, int count)
+{
+	const unsigned char *bytes = (const unsigned char *) values;
+	int i;
+
+	for (i = 0; i < count * (int) sizeof(int); i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static Uint64 HashWorldState(void)
+{
+	Uint64 hash = 14695981039346656037ULL;
+	int i;
+
+	hash = HashInts(hash, &NumActiveStBlocks, 1);
+
+	for (i = 0; i < NumActiveStBlocks; i++) {
+		STRATEGYBLOCK *sbPtr = ActiveStBlockList[i];
+		int values[12];
+		int n = 0;
+
+		values[n++] = sbPtr->I_SBtype;
+		values[n++] = sbPtr->SBDamageBlock.Health;
+		values[n++] = sbPtr->SBDamageBlock.Armour;
+
+		if (sbPtr->DynPtr) {
+			DYNAMICSBLOCK *dynPtr = sbPtr->DynPtr;
+
+			values[n++] = dynPtr->Position.vx;
+			values[n++] = dynPtr->Position.vy;
+			values[n++] = dynPtr->Position.vz;
+			values[n++] = dynPtr->OrientEuler.EulerX;
+			values[n++] = dynPtr->OrientEuler.EulerY;
+			values[n++] = dynPtr->OrientEuler.EulerZ;
+			values[n++] = dynPtr->LinVelocity.vx;
+			values[n++] = dynPtr->LinVelocity.vy;
+			values[n++] = dynPtr->LinVelocity.vz;
+		}
+
+		hash = HashInts(hash, values, n);
+	}
+
+	return hash;
+}
+
+int Replay_StartRecording(const char *filename)
+{
+	ReplayFile = fopen(filename, "wb");
+	if (ReplayFile == NULL) {
+		fprintf(stderr, "Replay: unable to create %s\n", filename);
+		return 0;
+	}
+
+	ReplayMode = REPLAY_MODE_RECORD;
+	return 1;
+}
+
+int Replay_StartPlayback(const char *filename)
+{
+	long fileSize;
+	int framesInFile;
+
+	ReplayFile = fopen(filename, "rb");
+	if (ReplayFile == NULL) {
+		fprintf(stderr, "Replay: unable to open %s\n", filename);
+		return 0;
+	}
+
+	if (fread(&ReplayHeader, sizeof(ReplayHeader), 1, ReplayFile) != 1 ||
+		memcmp(ReplayHeader.magic, REPLAY_MAGIC, 4) != 0 ||
+		ReplayHeader.version != REPLAY_VERSION) {
+		fprintf(stderr, "Replay: %s is not a recording\n", filename);
+		fclose(ReplayFile);
+		ReplayFile = NULL;
+		return 0;
+	}
+
+	/* a game that quit without leaving the level never wrote the frame count */
+	fseek(ReplayFile, 0, SEEK_END);
+	fileSize = ftell(ReplayFile);
+	fseek(ReplayFile, sizeof(ReplayHeader), SEEK_SET);
+	framesInFile = (int) ((fileSize - (long) sizeof(ReplayHeader)) / (long) sizeof(ReplayFrame));
+	if (ReplayHeader.numberOfFrames <= 0 || ReplayHeader.numberOfFrames > framesInFile) {
+		ReplayHeader.numberOfFrames = framesInFile;
+	}
+	if (ReplayHeader.numberOfFrames <= 0) {
+		fprintf(stderr, "Replay: %s holds no frames\n", filename);
+		fclose(ReplayFile);
+		ReplayFile = NULL;
+		return 0;
+	}
+	ReplayHeader.levelName[REPLAY_NAME_LENGTH-1] = 0;
+	ReplayHeader.profileName[REPLAY_NAME_LENGTH-1] = 0;
+
+	ReplayTimings = (Uint64 *) calloc((size_t) ReplayHeader.numberOfFrames * REPLAY_TIMER_COUNT, sizeof(Uint64));
+	if (ReplayTimings == NULL) {
+		fprintf(stderr, "Replay: out of memory for %d frames\n", ReplayHeader.numberOfFrames);
+		fclose(ReplayFile);
+		ReplayFile = NULL;
+		return 0;
+	}
+
+	ReplayCounters = (int *) calloc((size_t) ReplayHeader.numberOfFrames * REPLAY_COUNTER_COUNT, sizeof(int));
+	if (ReplayCounters == NULL) {
+		fprintf(stderr, "Replay: out of memory for %d frames\n", ReplayHeader.numberOfFrames);
+		free(ReplayTimings);
+		ReplayTimings = NULL;
+		fclose(ReplayFile);
+		ReplayFile = NULL;
+		return 0;
+	}
+
+	ReplayMode = REPLAY_MODE_PLAYBACK;
+	return 1;
+}
+
+int Replay_IsPlaying(void)
+{
+	return ReplayMode == REPLAY_MODE_PLAYBACK;
+}
+
+int Replay_SetupLevel(void)
+{
+	AVP_USER_PROFILE *profilePtr;
+	int i;
+
+	if (ReplayLevelSetUp) return 0;
+	ReplayLevelSetUp = 1;
+
+	LoadDefaultPrimaryConfigs();
+	TimeScale = ONE_FIXED;
+
+	/* key bindings and detail levels come from the recording's profile */
+	ExamineSavedUserProfiles();
+	UserProfilePtr = GetFirstUserProfile();
+	for (i = 0; i <= NumberOfUserProfiles(); i++) {
+		profilePtr = (i == 0) ? UserProfilePtr : GetNextUserProfile();
+		if (strcmp(profilePtr->Name, ReplayHeader.profileName) == 0) {
+			UserProfilePtr = profilePtr;
+			break;
+		}
+	}
+	if (strcmp(UserProfilePtr->Name, ReplayHeader.profileName) != 0) {
+		fprintf(stderr, "Replay: no user profile \"%s\", using \"%s\"\n", ReplayHeader.profileName, UserProfilePtr->Name);
+	}
+	GetSettingsFromUserProfile();
+
+	AvP.Network = I_No_Network;
+	AvP.PlayerType = (I_PLAYER_TYPE) ReplayHeader.playerType;
+	AvP.Difficulty = (I_HARDANUFF) ReplayHeader.difficulty;
+	AvP.LevelCompleted = 0;
+	CheatMode_Active = CHEATMODE_NONACTIVE;
+	strcpy(LevelName, ReplayHeader.levelName);
+
+	return 1;
+}
+
+void Replay_BeginLevel(void)
+{
+	if (ReplayLevelDone) return;
+
+	switch (ReplayMode) {
+		case REPLAY_MODE_RECORD:
+			if (AvP.Network != I_No_Network) {
+				fprintf(stderr, "Replay: network games can't be recorded\n");
+				fclose(ReplayFile);
+				ReplayFile = NULL;
+				ReplayLevelDone = 1;
+				return;
+			}
+
+			memset(&ReplayHeader, 0, sizeof(ReplayHeader));
+			memcpy(ReplayHeader.magic, REPLAY_MAGIC, 4);
+			ReplayHeader.version = REPLAY_VERSION;
+			ReplayHeader.seed = GetTickCount();
+			ReplayHeader.playerType = AvP.PlayerType;
+			ReplayHeader.difficulty = AvP.Difficulty;
+			strncpy(ReplayHeader.levelName, LevelName, REPLAY_NAME_LENGTH-1);
+			if (UserProfilePtr) {
+				strncpy(ReplayHeader.profileName, UserProfilePtr->Name, REPLAY_NAME_LENGTH-1);
+			}
+			/* header is rewritten with the frame count at the end */
+			fwrite(&ReplayHeader, sizeof(ReplayHeader), 1, ReplayFile);
+
+			SetFastRandomFromSeed(ReplayHeader.seed);
+			break;
+
+		case REPLAY_MODE_PLAYBACK:
+			SetFastRandomFromSeed(ReplayHeader.seed);
+			break;
+
+		default:
+			break;
+	}
+}
+
+void Replay_StartClock(void)
+{
+	if (ReplayLevelDone) return;
+
+	switch (ReplayMode) {
+		case REPLAY_MODE_RECORD:
+			ReplayClock = timeGetTime();
+			ReplayHeader.startTime = ReplayClock;
+			ReplayClockRunning = 1;
+			break;
+
+		case REPLAY_MODE_PLAYBACK:
+			ReplayClock = ReplayHeader.startTime;
+			ReplayClockRunning = 1;
+			break;
+
+		default:
+			break;
+	}
+}
+
+int Replay_GetClock(unsigned int *time)
+{
+	if (!ReplayClockRunning) return 0;
+
+	*time = ReplayClock;
+	return 1;
+}
+
+void Replay_WriteInput(void)
+{
+	if (ReplayMode != REPLAY_MODE_RECORD || !ReplayClockRunning) return;
+
+	ReplayFrame.mouseVelX = MouseVelX;
+	ReplayFrame.mouseVelY = MouseVelY;
+	ReplayFrame.gotAnyKey = GotAnyKey;
+	ReplayFrame.debouncedGotAnyKey = DebouncedGotAnyKey;
+	PackKeys(ReplayFrame.keys, KeyboardInput);
+	PackKeys(ReplayFrame.debouncedKeys, DebouncedKeyboardInput);
+}
+
+int Replay_ReadInput(void)
+{
+	if (ReplayMode != REPLAY_MODE_PLAYBACK || !ReplayClockRunning) return 0;
+
+	if (ReplayFrameNumber >= ReplayHeader.numberOfFrames ||
+		fread(&ReplayFrame, sizeof(ReplayFrame), 1, ReplayFile) != 1) {
+		return 0;
+	}
+
+	MouseVelX = ReplayFrame.mouseVelX;
+	MouseVelY = ReplayFrame.mouseVelY;
+	GotAnyKey = ReplayFrame.gotAnyKey;
+	DebouncedGotAnyKey = ReplayFrame.debouncedGotAnyKey;
+	UnpackKeys(KeyboardInput, ReplayFrame.keys);
+	UnpackKeys(DebouncedKeyboardInput, ReplayFrame.debouncedKeys);
+
+	Replay_StartTimer(REPLAY_TIMER_FRAME);
+	return 1;
+}
+
+void Replay_EndFrame(void)
+{
+	Uint64 hash;
+
+	if (!ReplayClockRunning) return;
+
+	hash = HashWorldState();
+
+	if (ReplayMode == REPLAY_MODE_RECORD) {
+		/* step the latched clock on to the real time */
+		ReplayClockRunning = 0;
+		ReplayClock = timeGetTime();
+		ReplayClockRunning = 1;
+
+		ReplayFrame.time = ReplayClock;
+		ReplayFrame.worldHash = hash;
+		fwrite(&ReplayFrame, sizeof(ReplayFrame), 1, ReplayFile);
+	} else {
+		Replay_StopTimer(REPLAY_TIMER_FRAME);
+
+		if (ReplayFrameNumber < ReplayHeader.numberOfFrames) {
+			int *counters = &ReplayCounters[ReplayFrameNumber * REPLAY_COUNTER_COUNT];
+
+			D3D_GetFrameCounters(&counters[REPLAY_COUNTER_DRAW_CALLS], &counters[REPLAY_COUNTER_STATE_CHANGES]);
+		}
+
+		if (hash != ReplayFrame.worldHash && ReplayDivergedFrame < 0) {
+			ReplayDivergedFrame = ReplayFrameNumber;
+		}
+		ReplayClock = ReplayFrame.time;
+	}
+
+	ReplayFrameNumber++;
+}
+
+void Replay_StartTimer(enum REPLAY_TIMER timer)
+{
+	if (ReplayMode != REPLAY_MODE_PLAYBACK || !ReplayClockRunning) return;
+
+	ReplayTimerStart[timer] = SDL_GetPerformanceCounter();
+}
+
+void Replay_StopTimer(enum REPLAY_TIMER timer)
+{
+	if (ReplayMode != REPLAY_MODE_PLAYBACK || !ReplayClockRunning ||
+		ReplayFrameNumber >= ReplayHeader.numberOfFrames) return;
+
+	ReplayTimings[ReplayFrameNumber * REPLAY_TIMER_COUNT + timer] += SDL_GetPerformanceCounter() - ReplayTimerStart[timer];
+}
+
+static int CompareTimings(const void *a, const void *b)
+{
+	Uint64 x = *(const Uint64 *) a;
+	Uint64 y = *(const Uint64 *) b;
+
+	return (x > y) - (x < y);
+}
+
+static int CompareCounters(const void *a, const void *b)
+{
+	int x = *(const int *) a;
+	int y = *(const int *) b;
+
+	return (x > y) - (x < y);
+}
+
+static void PrintCounters(int frames)
+{
+	int *sorted;
+	int counter, i;
+
+	sorted = (int *) malloc(frames * sizeof(int));
+	if (sorted == NULL) return;
+
+	printf("Render queue %s\n", D3D_RenderQueueIsEnabled() ? "on" : "off");
+	printf("%-14s %10s %10s %10s %10s %10s %10s\n", "per frame", "min", "mean", "median", "p95", "p99", "max");
+	for (counter = 0; counter < REPLAY_COUNTER_COUNT; counter++) {
+		double total = 0.0;
+
+		for (i = 0; i < frames; i++) {
+			sorted[i] = ReplayCounters[i * REPLAY_COUNTER_COUNT + counter];
+			total += (double) sorted[i];
+		}
+		qsort(sorted, frames, sizeof(int), CompareCounters);
+
+		printf("%-14s %10d %10.1f %10d %10d %10d %10d\n", ReplayCounterNames[counter],
+			sorted[0],
+			total / frames,
+			sorted[frames / 2],
+			sorted[(frames * 95) / 100],
+			sorted[(frames * 99) / 100],
+			sorted[frames - 1]);
+	}
+	free(sorted);
+}
+
+static void PrintReport(void)
+{
+	double usPerTick = 1000000.0 / (double) SDL_GetPerformanceFrequency();
+	int frames = ReplayFrameNumber;
+	Uint64 *sorted;
+	int timer, i;
+
+	printf("Replay: %s, %d of %d frames\n", ReplayHeader.levelName, frames, ReplayHeader.numberOfFrames);
+	if (frames == 0) return;
+
+	sorted = (Uint64 *) malloc(frames * sizeof(Uint64));
+	if (sorted == NULL) return;
+
+	printf("%-14s %10s %10s %10s %10s %10s %10s\n", "us", "min", "mean", "median", "p95", "p99", "max");
+	for (timer = 0; timer < REPLAY_TIMER_COUNT; timer++) {
+		double total = 0.0;
+
+		for (i = 0; i < frames; i++) {
+			sorted[i] = ReplayTimings[i * REPLAY_TIMER_COUNT + timer];
+			total += (double) sorted[i];
+		}
+		qsort(sorted, frames, sizeof(Uint64), CompareTimings);
+
+		printf("%-14s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", ReplayTimerNames[timer],
+			sorted[0] * usPerTick,
+			total / frames * usPerTick,
+			sorted[frames / 2] * usPerTick,
+			sorted[(frames * 95) / 100] * usPerTick,
+			sorted[(frames * 99) / 100] * usPerTick,
+			sorted[frames - 1] * usPerTick);
+	}
+	free(sorted);
+
+	PrintCounters(frames);
+
+	printf("World state hash: %016llx\n", (unsigned long long) HashWorldState());
+	if (ReplayDivergedFrame >= 0) {
+		printf("World state diverged from the recording at frame %d\n", ReplayDivergedFrame);
+	} else {
+		printf("World state matched the recording on every frame\n");
+	}
+}
+
+void Replay_EndLevel(void)
+{
+	if (!ReplayClockRunning) return;
+
+	switch (ReplayMode) {
+		case REPLAY_MODE_RECORD:
+			ReplayHeader.numberOfFrames = ReplayFrameNumber;
+			fseek(ReplayFile, 0, SEEK_SET);
+			fwrite(&ReplayHeader, sizeof(ReplayHeader), 1, ReplayFile);
+			fclose(ReplayFile);
+			ReplayFile = NULL;
+
+			printf("Replay: recorded %d frames of %s\n", ReplayFrameNumber, ReplayHeader.levelName);
+			break;
+
+		case REPLAY_MODE_PLAYBACK:
+			PrintReport();
+
+			fclose(ReplayFile);
+			ReplayFile = NULL;
+			free(ReplayTimings);
+			ReplayTimings = NULL;
+			free(ReplayCounters);
+			ReplayCounters = NULL;
+			break;
+
+		default:
+			return;
+	}
+
+	ReplayLevelDone = 1;
+	ReplayClockRunning = 0;
+}
+
+int Replay_Diverged(void)
+{
+	return ReplayDivergedFrame >= 0;
+}
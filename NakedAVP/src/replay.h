@@ -0,0 +1,59 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+/*
+ * Input recording and headless playback of the main game loop.
+ *
+ * A recording holds the level, species, difficulty, user profile and RNG
+ * seed, then the keyboard and mouse state and the clock for every frame.
+ * Playback runs without a window, renderer or sound device, feeds the
+ * recorded input back through UpdateGame, AvpShowViews and the
+ * accessibility updates, checks the world state against the recording
+ * each frame and prints per-frame timing and draw call statistics at the
+ * end.
+ */
+
+enum REPLAY_TIMER {
+	REPLAY_TIMER_FRAME,
+	REPLAY_TIMER_GAME,			/* DoAllShapeAnimations + UpdateGame */
+	REPLAY_TIMER_ACCESSIBILITY,	/* Accessibility_Update */
+	REPLAY_TIMER_VIEWS,			/* AvpShowViews + MaintainHUD */
+
+	REPLAY_TIMER_COUNT
+};
+
+int Replay_StartRecording(const char *filename);
+int Replay_StartPlayback(const char *filename);
+int Replay_IsPlaying(void);
+
+/* playback: stands in for the main menus, true once for the recorded level */
+int Replay_SetupLevel(void);
+
+/* after the menus, before the level loads: seeds the random number generator */
+void Replay_BeginLevel(void);
+
+/* just before the level's frame counter is reset: latches the clock */
+void Replay_StartClock(void);
+
+/* recording: after CheckForWindowsMessages */
+void Replay_WriteInput(void);
+
+/* playback: loads the frame's input, false once the recording has run out */
+int Replay_ReadInput(void);
+
+/* just before FrameCounterHandler */
+void Replay_EndFrame(void);
+
+/* after the level's main loop: closes the recording or prints the report */
+void Replay_EndLevel(void);
+
+/* playback: nonzero if the world state stopped matching the recording */
+int Replay_Diverged(void);
+
+void Replay_StartTimer(enum REPLAY_TIMER timer);
+void Replay_StopTimer(enum REPLAY_TIMER timer);
+
+/* latched frame clock for timeGetTime while recording or playing back */
+int Replay_GetClock(unsigned int *time);
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef SHAPEKERNELS_H
+#define SHAPEKERNELS_H
+
+/*
+ * 4-wide kernels for transforming and lighting shape points, used by kshape.c
+ * (TranslateStagedPoints, LightStagedPoints) and checked against the scalar
+ * code by tests/shape_kernels_test.c.
+ *
+ * They work on points staged as separate x, y and z arrays padded to a whole
+ * number of blocks of four, and do the same float and integer operations in
+ * the same order as the scalar code. The results are identical to it as long
+ * as the compiler isn't allowed to fuse multiplies and adds: build with
+ * -ffp-contract=off wherever FMA instructions are enabled.
+ */
+
+#if defined(__SSE2_MATH__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SHAPE_KERNELS_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SHAPE_KERNELS_NEON 1
+#endif
+#if SHAPE_KERNELS_SSE2 || SHAPE_KERNELS_NEON
+#define SHAPE_KERNELS 1
+#endif
+
+#if SHAPE_KERNELS
+
+/* TranslatePoint through objectMatrix and then viewMatrix, then f2i, for each staged point;
+the results replace the points */
+static void ShapeKernel_Transform(int *x, int *y, int *z, int numberOfPoints, const float *objectMatrix, const float *viewMatrix)
+{
+	int n;
+
+	for (n = 0; n < numberOfPoints; n += 4)
+	{
+		#if SHAPE_KERNELS_SSE2
+		#define MATRIX_ROW(m,r,x,y,z) _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[r*4+0]),x), \
+											_mm_mul_ps(_mm_set1_ps(m[r*4+1]),y)), _mm_mul_ps(_mm_set1_ps(m[r*4+2]),z)), _mm_set1_ps(m[r*4+3]))
+		__m128 px = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&x[n]));
+		__m128 py = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&y[n]));
+		__m128 pz = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&z[n]));
+		__m128 worldX = MATRIX_ROW(objectMatrix,0,px,py,pz);
+		__m128 worldY = MATRIX_ROW(objectMatrix,1,px,py,pz);
+		__m128 worldZ = MATRIX_ROW(objectMatrix,2,px,py,pz);
+
+		_mm_storeu_si128((__m128i *)&x[n], _mm_cvtps_epi32(MATRIX_ROW(viewMatrix,0,worldX,worldY,worldZ)));
+		_mm_storeu_si128((__m128i *)&y[n], _mm_cvtps_epi32(MATRIX_ROW(viewMatrix,1,worldX,worldY,worldZ)));
+		_mm_storeu_si128((__m128i *)&z[n], _mm_cvtps_epi32(MATRIX_ROW(viewMatrix,2,worldX,worldY,worldZ)));
+		#undef MATRIX_ROW
+		#else
+		#define MATRIX_ROW(m,r,x,y,z) vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(vdupq_n_f32(m[r*4+0]),x), \
+											vmulq_f32(vdupq_n_f32(m[r*4+1]),y)), vmulq_f32(vdupq_n_f32(m[r*4+2]),z)), vdupq_n_f32(m[r*4+3]))
+		float32x4_t px = vcvtq_f32_s32(vld1q_s32(&x[n]));
+		float32x4_t py = vcvtq_f32_s32(vld1q_s32(&y[n]));
+		float32x4_t pz = vcvtq_f32_s32(vld1q_s32(&z[n]));
+		float32x4_t worldX = MATRIX_ROW(objectMatrix,0,px,py,pz);
+		float32x4_t worldY = MATRIX_ROW(objectMatrix,1,px,py,pz);
+		float32x4_t worldZ = MATRIX_ROW(objectMatrix,2,px,py,pz);
+
+		vst1q_s32(&x[n], vcvtnq_s32_f32(MATRIX_ROW(viewMatrix,0,worldX,worldY,worldZ)));
+		vst1q_s32(&y[n], vcvtnq_s32_f32(MATRIX_ROW(viewMatrix,1,worldX,worldY,worldZ)));
+		vst1q_s32(&z[n], vcvtnq_s32_f32(MATRIX_ROW(viewMatrix,2,worldX,worldY,worldZ)));
+		#undef MATRIX_ROW
+		#endif
+	}
+}
+
+/* The distance from four staged points to a light, as VertexIntensity_Standard_Opt
+approximates it: max(dx,dy,dz) plus a quarter of the other two, which is what its
+comparisons pick. Returns a bit for each point inside the light's range; if there are any,
+the vectors to the light and the distances are stored too. */
+static int ShapeKernel_LightDistances(const int *x, const int *y, const int *z, int lightX, int lightY, int lightZ, int lightRange,
+									  int *toLightX, int *toLightY, int *toLightZ, int *distance)
+{
+	int inRange;
+
+	#if SHAPE_KERNELS_SSE2
+	__m128i dx = _mm_sub_epi32(_mm_set1_epi32(lightX), _mm_loadu_si128((const __m128i *)x));
+	__m128i dy = _mm_sub_epi32(_mm_set1_epi32(lightY), _mm_loadu_si128((const __m128i *)y));
+	__m128i dz = _mm_sub_epi32(_mm_set1_epi32(lightZ), _mm_loadu_si128((const __m128i *)z));
+	__m128i sign, ax, ay, az, greater, largest, d;
+
+	sign = _mm_srai_epi32(dx, 31);
+	ax = _mm_sub_epi32(_mm_xor_si128(dx, sign), sign);
+	sign = _mm_srai_epi32(dy, 31);
+	ay = _mm_sub_epi32(_mm_xor_si128(dy, sign), sign);
+	sign = _mm_srai_epi32(dz, 31);
+	az = _mm_sub_epi32(_mm_xor_si128(dz, sign), sign);
+
+	greater = _mm_cmpgt_epi32(ax, ay);
+	largest = _mm_or_si128(_mm_and_si128(greater, ax), _mm_andnot_si128(greater, ay));
+	greater = _mm_cmpgt_epi32(largest, az);
+	largest = _mm_or_si128(_mm_and_si128(greater, largest), _mm_andnot_si128(greater, az));
+
+	d = _mm_add_epi32(_mm_add_epi32(ax, ay), az);
+	d = _mm_add_epi32(largest, _mm_srai_epi32(_mm_sub_epi32(d, largest), 2));
+
+	inRange = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(_mm_set1_epi32(lightRange), d)));
+	if (!inRange) return 0;
+
+	_mm_storeu_si128((__m128i *)toLightX, dx);
+	_mm_storeu_si128((__m128i *)toLightY, dy);
+	_mm_storeu_si128((__m128i *)toLightZ, dz);
+	_mm_storeu_si128((__m128i *)distance, d);
+	#else
+	static const uint32_t laneBits[4] = {1, 2, 4, 8};
+	int32x4_t dx = vsubq_s32(vdupq_n_s32(lightX), vld1q_s32(x));
+	int32x4_t dy = vsubq_s32(vdupq_n_s32(lightY), vld1q_s32(y));
+	int32x4_t dz = vsubq_s32(vdupq_n_s32(lightZ), vld1q_s32(z));
+	int32x4_t ax = vabsq_s32(dx);
+	int32x4_t ay = vabsq_s32(dy);
+	int32x4_t az = vabsq_s32(dz);
+	int32x4_t largest = vmaxq_s32(vmaxq_s32(ax, ay), az);
+	int32x4_t d = vaddq_s32(vaddq_s32(ax, ay), az);
+
+	d = vaddq_s32(largest, vshrq_n_s32(vsubq_s32(d, largest), 2));
+
+	inRange = (int)vaddvq_u32(vandq_u32(vcltq_s32(d, vdupq_n_s32(lightRange)), vld1q_u32(laneBits)));
+	if (!inRange) return 0;
+
+	vst1q_s32(toLightX, dx);
+	vst1q_s32(toLightY, dy);
+	vst1q_s32(toLightZ, dz);
+	vst1q_s32(distance, d);
+	#endif
+
+	return inRange;
+}
+
+#endif	/* SHAPE_KERNELS */
+
+#endif
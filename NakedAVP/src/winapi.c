@@ -16,6 +16,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include "fixer.h"
+#include "replay.h"
 
 size_t _AVPmbclen(const unsigned char *s)
 {
@@ -219,6 +220,12 @@ unsigned int timeGetTime()
 	static struct timeval tv0;
 	struct timeval tv1;
 	int secs, usecs;
+	unsigned int replay_time;
+	
+	/* recordings and replays run on the clock latched once per frame */
+	if (Replay_GetClock(&replay_time)) {
+		return replay_time;
+	}
 	
 	if (tv0.tv_sec == 0) {
 		gettimeofday(&tv0, NULL);
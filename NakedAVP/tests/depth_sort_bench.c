@@ -0,0 +1,266 @@
+/*
+ * Times the radix depth sort (src/avp/win95/kzradix.h) against the merge sort
+ * kzsort.c used before it, on the same lists.
+ *
+ *   cc -O2 -I../src/avp/win95 depth_sort_bench.c -o depth_sort_bench
+ *   ./depth_sort_bench [sorts.dump]
+ *
+ * With no argument it sorts random lists shaped like the game's. With one, it
+ * sorts the lists the game recorded when run with AVP_DUMP_DEPTH_SORTS=sorts.dump.
+ * Those are the translucent polygon lists (KItem) and the visible module lists
+ * (KObject). It also checks that the radix sort leaves every list in key order,
+ * with equal keys kept in their original order.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "kzradix.h"
+
+/* as in kzsort.h; the sorts only look at SortKey */
+struct KItem
+{
+	void *PolyPtr;
+
+	int SortKey;
+};
+
+struct KObject
+{
+	void *DispPtr;
+
+	int SortKey;
+
+	int DrawBeforeEnvironment;
+};
+
+static DEFINE_DEPTH_SORT(RadixSortKItems, struct KItem)
+static DEFINE_DEPTH_SORT(RadixSortKObjects, struct KObject)
+
+/* kzsort.c's old bottom-up merge sort (MergeObjects and SortModules) */
+#define DEFINE_MERGE_SORT(name, type) \
+static void name##_Merge(type *src1, int n1, type *src2, int n2, type *dest) \
+{ \
+	while (n1>0 && n2>0) \
+	{ \
+		if (src1->SortKey < src2->SortKey) { *dest++ = *src1++; n1--; } \
+		else { *dest++ = *src2++; n2--; } \
+	} \
+	while (n2>0) { *dest++ = *src2++; n2--; } \
+	while (n1>0) { *dest++ = *src1++; n1--; } \
+} \
+static type *name(type *mergeFrom, type *mergeTo, int noOfItems) \
+{ \
+	int partitionSize; \
+\
+	for (partitionSize=1;partitionSize<noOfItems;partitionSize*=2) \
+	{ \
+		type *mergeTemp; \
+		int offSet = 0; \
+\
+		while((offSet+(partitionSize*2)) <= noOfItems) \
+		{ \
+			name##_Merge(mergeFrom+offSet, partitionSize, mergeFrom+offSet+partitionSize, partitionSize, mergeTo+offSet); \
+			offSet += partitionSize*2; \
+		} \
+		if((offSet+partitionSize) < noOfItems) \
+		{ \
+			name##_Merge(mergeFrom+offSet, partitionSize, mergeFrom+offSet+partitionSize, noOfItems-(offSet+partitionSize), mergeTo+offSet); \
+		} \
+		else if(offSet < noOfItems) \
+		{ \
+			name##_Merge(mergeFrom+offSet, noOfItems-offSet, mergeFrom+offSet, 0, mergeTo+offSet); \
+		} \
+		mergeTemp = mergeFrom; \
+		mergeFrom = mergeTo; \
+		mergeTo = mergeTemp; \
+	} \
+	return mergeFrom; \
+}
+
+DEFINE_MERGE_SORT(MergeSortKItems, struct KItem)
+DEFINE_MERGE_SORT(MergeSortKObjects, struct KObject)
+
+#define MAX_LIST 4096
+#define MAX_LISTS 20000
+#define REPEATS 200
+
+typedef struct
+{
+	int kind;			/* 0: KItem, 1: KObject */
+	int length;
+	int *keys;
+
+} SORTLIST;
+
+static SORTLIST Lists[MAX_LISTS];
+static int NumberOfLists;
+
+static void AddList(int kind, int length, const int *keys)
+{
+	SORTLIST *list = &Lists[NumberOfLists++];
+
+	list->kind = kind;
+	list->length = length;
+	list->keys = (int *)malloc((length ? length : 1) * sizeof(int));
+	memcpy(list->keys, keys, length * sizeof(int));
+}
+
+static int LoadLists(const char *filename)
+{
+	FILE *file = fopen(filename, "rb");
+	int keys[MAX_LIST];
+
+	if (!file) return 0;
+
+	while (NumberOfLists < MAX_LISTS)
+	{
+		int header[2];
+
+		if (fread(header, sizeof(int), 2, file) != 2) break;
+		if (header[0] < 0 || header[0] > 1 || header[1] < 0 || header[1] > MAX_LIST) break;
+		if (fread(keys, sizeof(int), header[1], file) != (size_t)header[1]) break;
+		AddList(header[0], header[1], keys);
+	}
+	fclose(file);
+	return 1;
+}
+
+/* translucent polygons: a few hundred keys of -MaxZ; modules: a few dozen view space
+distances, one of them smallint for the module the camera is in */
+static void RandomLists(void)
+{
+	int keys[MAX_LIST];
+
+	while (NumberOfLists < 2000)
+	{
+		int kind = NumberOfLists & 1;
+		int length = kind ? 10 + rand() % 60 : 20 + rand() % 600;
+		int i;
+
+		for (i = 0; i < length; i++)
+		{
+			keys[i] = kind ? rand() % 60000 : -(rand() % 30000);
+		}
+		if (kind) keys[rand() % length] = -0x7fffffff;
+		AddList(kind, length, keys);
+	}
+}
+
+static struct KItem Items[MAX_LIST], ItemsScratch[MAX_LIST];
+static struct KObject Objects[MAX_LIST], ObjectsScratch[MAX_LIST];
+
+enum { NO_SORT, MERGE_SORT, RADIX_SORT };
+
+/* fills in and sorts every list of a kind REPEATS times, returning the seconds taken; checks
+the results of the first time round */
+static double SortLists(int kind, int sort, int *failures)
+{
+	clock_t start = clock();
+	int l, r, i;
+
+	for (l = 0; l < NumberOfLists; l++)
+	{
+		SORTLIST *list = &Lists[l];
+
+		if (list->kind != kind) continue;
+
+		for (r = 0; r < REPEATS; r++)
+		{
+			if (kind == 0)
+			{
+				struct KItem *sorted = Items;
+
+				for (i = 0; i < list->length; i++)
+				{
+					Items[i].PolyPtr = (void *)(size_t)i;
+					Items[i].SortKey = list->keys[i];
+				}
+				if (sort == MERGE_SORT) sorted = MergeSortKItems(Items, ItemsScratch, list->length);
+				if (sort == RADIX_SORT) sorted = RadixSortKItems(Items, ItemsScratch, list->length);
+
+				for (i = 1; i < list->length && r == 0 && sort != NO_SORT; i++)
+				{
+					if (sorted[i-1].SortKey > sorted[i].SortKey
+					 || (sort == RADIX_SORT && sorted[i-1].SortKey == sorted[i].SortKey && sorted[i-1].PolyPtr > sorted[i].PolyPtr))
+					{
+						(*failures)++;
+						break;
+					}
+				}
+			}
+			else
+			{
+				struct KObject *sorted = Objects;
+
+				for (i = 0; i < list->length; i++)
+				{
+					Objects[i].DispPtr = (void *)(size_t)i;
+					Objects[i].SortKey = list->keys[i];
+					Objects[i].DrawBeforeEnvironment = 0;
+				}
+				if (sort == MERGE_SORT) sorted = MergeSortKObjects(Objects, ObjectsScratch, list->length);
+				if (sort == RADIX_SORT) sorted = RadixSortKObjects(Objects, ObjectsScratch, list->length);
+
+				for (i = 1; i < list->length && r == 0 && sort != NO_SORT; i++)
+				{
+					if (sorted[i-1].SortKey > sorted[i].SortKey
+					 || (sort == RADIX_SORT && sorted[i-1].SortKey == sorted[i].SortKey && sorted[i-1].DispPtr > sorted[i].DispPtr))
+					{
+						(*failures)++;
+						break;
+					}
+				}
+			}
+		}
+	}
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+	int failures = 0;
+	int kind;
+
+	if (argc > 1)
+	{
+		if (!LoadLists(argv[1]))
+		{
+			fprintf(stderr, "can't open %s\n", argv[1]);
+			return 1;
+		}
+	}
+	else
+	{
+		srand(1);
+		RandomLists();
+	}
+
+	for (kind = 0; kind < 2; kind++)
+	{
+		int numberOfLists = 0, totalLength = 0, l;
+		double setup, merge, radix;
+
+		for (l = 0; l < NumberOfLists; l++)
+		{
+			if (Lists[l].kind != kind) continue;
+			numberOfLists++;
+			totalLength += Lists[l].length;
+		}
+		if (!numberOfLists) continue;
+
+		/* filling in the lists is timed on its own and taken off */
+		setup = SortLists(kind, NO_SORT, &failures);
+		merge = SortLists(kind, MERGE_SORT, &failures) - setup;
+		radix = SortLists(kind, RADIX_SORT, &failures) - setup;
+
+		printf("%s: %d %s lists, %.1f entries on average\n", kind ? "modules (KObject)" : "translucent polygons (KItem)",
+			   numberOfLists, argc > 1 ? "dumped" : "random", (double)totalLength / numberOfLists);
+		printf("  merge sort %.1f ns/list, radix sort %.1f ns/list\n",
+			   merge * 1e9 / ((double)numberOfLists * REPEATS), radix * 1e9 / ((double)numberOfLists * REPEATS));
+	}
+
+	if (failures) printf("%d lists sorted wrongly\n", failures);
+	return failures ? 1 : 0;
+}
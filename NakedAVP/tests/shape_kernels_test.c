@@ -0,0 +1,472 @@
+/*
+ * Checks the SSE2/NEON shape kernels (src/shapekernels.h) against the scalar
+ * code in kshape.c they replace, then times both.
+ *
+ *   cc -O2 -ffp-contract=off -I../src shape_kernels_test.c -lm -o shape_kernels_test
+ *   ./shape_kernels_test [shapes.dump]
+ *
+ * The transform must give the same ints as TranslatePoint twice and f2i, and
+ * the lighting the same intensities as VertexIntensity_Standard_Opt, for every
+ * point. The benchmark runs over random shapes, or over real level shapes
+ * dumped by running the game with AVP_DUMP_SHAPES=shapes.dump.
+ *
+ * Exit status is nonzero on any mismatch, or if this build fuses multiplies
+ * and adds. The fused results can't match the kernels.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "shapekernels.h"
+
+/* GCC only has -ffp-contract, which FusesMultiplyAdd checks for */
+#ifdef __clang__
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#define MAX_POINTS 10000
+
+typedef struct
+{
+	int vx, vy, vz;
+
+} POINT;
+
+/* the parts of a LIGHTBLOCK that the standard lighting model reads */
+typedef struct
+{
+	POINT LocalLP;
+	int LightRange;
+	int BrightnessOverRange;
+	int RedScale, GreenScale, BlueScale;
+	int Specular;
+
+} LIGHT;
+
+typedef struct
+{
+	int R, G, B;
+	int SpecularR, SpecularG, SpecularB;
+
+} LIGHTING;
+
+static int MUL_FIXED(int a, int b)
+{
+	long long cc = (long long)a * (long long)b;
+	return (int)((cc >> 16) & 0xffffffff);
+}
+
+static int WideMulNarrowDiv(int a, int b, int c)
+{
+	return (int)(((long long)a * (long long)b) / (long long)c);
+}
+
+static void TranslatePoint(const float *source, float *dest, const float *matrix)
+{
+	dest[0] = matrix[ 0] * source[0] + matrix[ 1] * source[1] + matrix[ 2] * source[2] + matrix[ 3];
+	dest[1] = matrix[ 4] * source[0] + matrix[ 5] * source[1] + matrix[ 6] * source[2] + matrix[ 7];
+	dest[2] = matrix[ 8] * source[0] + matrix[ 9] * source[1] + matrix[10] * source[2] + matrix[11];
+}
+
+/* TranslateShapeVertices' scalar loop */
+static void Transform_Scalar(const POINT *srcPtr, POINT *destPtr, int numberOfPoints, const float *objectMatrix, const float *viewMatrix)
+{
+	float source[3], dest[3];
+	int i;
+
+	for (i = 0; i < numberOfPoints; i++)
+	{
+		source[0] = srcPtr[i].vx;
+		source[1] = srcPtr[i].vy;
+		source[2] = srcPtr[i].vz;
+
+		TranslatePoint(source, dest, objectMatrix);
+		TranslatePoint(dest, source, viewMatrix);
+
+		destPtr[i].vx = lrintf(source[0]);
+		destPtr[i].vy = lrintf(source[1]);
+		destPtr[i].vz = lrintf(source[2]);
+	}
+}
+
+/* StandardLighting_AddLight */
+static void AddLight(const LIGHT *lptr, const POINT *normalPtr, const POINT *vertexToLightPtr, int distanceToLight, LIGHTING *lightingPtr)
+{
+	int idot = MUL_FIXED(lptr->LightRange-distanceToLight,lptr->BrightnessOverRange);
+	int r,g,b;
+
+	if(distanceToLight>0)
+	{
+		int dotproduct = MUL_FIXED(normalPtr->vx,vertexToLightPtr->vx)
+			+ MUL_FIXED(normalPtr->vy,vertexToLightPtr->vy)
+			+ MUL_FIXED(normalPtr->vz,vertexToLightPtr->vz);
+
+		if(dotproduct>0)
+		{
+			idot = (WideMulNarrowDiv(idot,dotproduct,distanceToLight)+idot/4)/2;
+		}
+		else
+		{
+			idot /= 8;
+		}
+	}
+
+	r = MUL_FIXED(idot,lptr->RedScale);
+	g = MUL_FIXED(idot,lptr->GreenScale);
+	b = MUL_FIXED(idot,lptr->BlueScale);
+
+	lightingPtr->R += r;
+	lightingPtr->G += g;
+	lightingPtr->B += b;
+
+	if (lptr->Specular)
+	{
+		lightingPtr->SpecularR += r;
+		lightingPtr->SpecularG += g;
+		lightingPtr->SpecularB += b;
+	}
+}
+
+/* VertexIntensity_Standard_Opt's loop over the lights, for every point */
+static void Light_Scalar(const POINT *points, const POINT *normals, int numberOfPoints, const LIGHT *lights, int numberOfLights, LIGHTING *lighting)
+{
+	int v, i;
+
+	for (v = 0; v < numberOfPoints; v++)
+	{
+		memset(&lighting[v], 0, sizeof(LIGHTING));
+
+		for (i = 0; i < numberOfLights; i++)
+		{
+			const LIGHT *lptr = &lights[i];
+			POINT vertexToLight;
+			int distanceToLight;
+			int dx,dy,dz;
+
+			vertexToLight.vx = lptr->LocalLP.vx - points[v].vx;
+			vertexToLight.vy = lptr->LocalLP.vy - points[v].vy;
+			vertexToLight.vz = lptr->LocalLP.vz - points[v].vz;
+
+			dx = vertexToLight.vx;
+			if (dx<0) dx = -dx;
+			dy = vertexToLight.vy;
+			if (dy<0) dy = -dy;
+			dz = vertexToLight.vz;
+			if (dz<0) dz = -dz;
+
+			if (dx>dy)
+			{
+				if (dx>dz) distanceToLight = dx + ((dy+dz)>>2);
+				else distanceToLight = dz + ((dy+dx)>>2);
+			}
+			else
+			{
+				if (dy>dz) distanceToLight = dy + ((dx+dz)>>2);
+				else distanceToLight = dz + ((dx+dy)>>2);
+			}
+
+			if(distanceToLight < lptr->LightRange)
+			{
+				AddLight(lptr, &normals[v], &vertexToLight, distanceToLight, &lighting[v]);
+			}
+		}
+	}
+}
+
+#if SHAPE_KERNELS
+static int StagedX[MAX_POINTS+3], StagedY[MAX_POINTS+3], StagedZ[MAX_POINTS+3];
+
+static void Stage(const POINT *points, int numberOfPoints)
+{
+	int i;
+
+	for (i = 0; i < numberOfPoints; i++)
+	{
+		StagedX[i] = points[i].vx;
+		StagedY[i] = points[i].vy;
+		StagedZ[i] = points[i].vz;
+	}
+	for (; i & 3; i++)
+	{
+		StagedX[i] = StagedY[i] = StagedZ[i] = 0;
+	}
+}
+
+/* TranslateStagedPoints */
+static void Transform_Kernel(const POINT *srcPtr, POINT *destPtr, int numberOfPoints, const float *objectMatrix, const float *viewMatrix)
+{
+	int i;
+
+	Stage(srcPtr, numberOfPoints);
+	ShapeKernel_Transform(StagedX, StagedY, StagedZ, numberOfPoints, objectMatrix, viewMatrix);
+	for (i = 0; i < numberOfPoints; i++)
+	{
+		destPtr[i].vx = StagedX[i];
+		destPtr[i].vy = StagedY[i];
+		destPtr[i].vz = StagedZ[i];
+	}
+}
+
+/* LightStagedPoints */
+static void Light_Kernel(const POINT *points, const POINT *normals, int numberOfPoints, const LIGHT *lights, int numberOfLights, LIGHTING *lighting)
+{
+	int n;
+
+	Stage(points, numberOfPoints);
+	memset(lighting, 0, numberOfPoints * sizeof(LIGHTING));
+
+	for (n = 0; n < numberOfPoints; n += 4)
+	{
+		int numberInBlock = numberOfPoints - n < 4 ? numberOfPoints - n : 4;
+		int i, j;
+
+		for (i = 0; i < numberOfLights; i++)
+		{
+			const LIGHT *lptr = &lights[i];
+			int toLightX[4], toLightY[4], toLightZ[4], distance[4];
+			int inRange = ShapeKernel_LightDistances(&StagedX[n], &StagedY[n], &StagedZ[n],
+													 lptr->LocalLP.vx, lptr->LocalLP.vy, lptr->LocalLP.vz, lptr->LightRange,
+													 toLightX, toLightY, toLightZ, distance);
+
+			for (j = 0; j < numberInBlock; j++)
+			{
+				if (inRange & (1<<j))
+				{
+					POINT vertexToLight;
+
+					vertexToLight.vx = toLightX[j];
+					vertexToLight.vy = toLightY[j];
+					vertexToLight.vz = toLightZ[j];
+					AddLight(lptr, &normals[n+j], &vertexToLight, distance[j], &lighting[n+j]);
+				}
+			}
+		}
+	}
+}
+#endif
+
+static int Random(int range)
+{
+	return (int)(((unsigned int)rand() << 15 ^ (unsigned int)rand()) % (unsigned int)(2*range+1)) - range;
+}
+
+static void RandomMatrices(float *objectMatrix, float *viewMatrix)
+{
+	int i;
+
+	/* orientations as MATRIXCH / 65536, as TranslateShapeVertices builds them */
+	for (i = 0; i < 12; i++)
+	{
+		objectMatrix[i] = (float)Random(65536)/65536.0f;
+		viewMatrix[i] = (float)Random(65536)/65536.0f;
+	}
+	objectMatrix[3] = Random(200000);
+	objectMatrix[7] = Random(200000);
+	objectMatrix[11] = Random(200000);
+	viewMatrix[3] = Random(200000);
+	viewMatrix[7] = Random(200000);
+	viewMatrix[11] = Random(200000);
+}
+
+static void RandomLights(LIGHT *lights, int numberOfLights)
+{
+	int i;
+
+	for (i = 0; i < numberOfLights; i++)
+	{
+		lights[i].LocalLP.vx = Random(20000);
+		lights[i].LocalLP.vy = Random(20000);
+		lights[i].LocalLP.vz = Random(20000);
+		lights[i].LightRange = 1 + rand() % 30000;
+		lights[i].BrightnessOverRange = rand() % 65536;
+		lights[i].RedScale = rand() % 65537;
+		lights[i].GreenScale = rand() % 65537;
+		lights[i].BlueScale = rand() % 65537;
+		lights[i].Specular = rand() & 1;
+	}
+}
+
+static void RandomNormals(POINT *normals, int numberOfPoints)
+{
+	int i;
+
+	for (i = 0; i < numberOfPoints; i++)
+	{
+		normals[i].vx = Random(65536);
+		normals[i].vy = Random(65536);
+		normals[i].vz = Random(65536);
+	}
+}
+
+/* a*b+c evaluated as written; true if the compiler fused it */
+static int FusesMultiplyAdd(void)
+{
+	volatile float a = 1.0f + 1.0f/4096.0f;
+	volatile float b = 1.0f + 1.0f/4096.0f;
+	volatile float c = -1.0f;
+	float sum = a*b + c;
+
+	return sum != 1.0f/2048.0f;
+}
+
+static POINT Points[MAX_POINTS], Normals[MAX_POINTS], Expected[MAX_POINTS], Result[MAX_POINTS];
+static LIGHTING ExpectedLighting[MAX_POINTS], ResultLighting[MAX_POINTS];
+
+int main(int argc, char **argv)
+{
+	int failures = 0;
+	int test;
+
+	if (FusesMultiplyAdd())
+	{
+		fprintf(stderr, "this build fuses multiplies and adds: rebuild with -ffp-contract=off\n");
+		return 1;
+	}
+
+	#if !SHAPE_KERNELS
+	printf("no SSE2 or NEON shape kernels on this target\n");
+	(void)argc; (void)argv; (void)test;
+	return 0;
+	#else
+	srand(1);
+
+	for (test = 0; test < 2000; test++)
+	{
+		float objectMatrix[12], viewMatrix[12];
+		LIGHT lights[8];
+		int numberOfPoints = 1 + rand() % 1000;
+		int numberOfLights = rand() % 9;
+		int range = test & 1 ? 20000 : 1000000;
+		int i;
+
+		for (i = 0; i < numberOfPoints; i++)
+		{
+			Points[i].vx = Random(range);
+			Points[i].vy = Random(range);
+			Points[i].vz = Random(range);
+		}
+		RandomNormals(Normals, numberOfPoints);
+		RandomMatrices(objectMatrix, viewMatrix);
+		RandomLights(lights, numberOfLights);
+
+		Transform_Scalar(Points, Expected, numberOfPoints, objectMatrix, viewMatrix);
+		Transform_Kernel(Points, Result, numberOfPoints, objectMatrix, viewMatrix);
+		if (memcmp(Expected, Result, numberOfPoints * sizeof(POINT)))
+		{
+			printf("transform mismatch in test %d\n", test);
+			failures++;
+		}
+
+		Light_Scalar(Points, Normals, numberOfPoints, lights, numberOfLights, ExpectedLighting);
+		Light_Kernel(Points, Normals, numberOfPoints, lights, numberOfLights, ResultLighting);
+		if (memcmp(ExpectedLighting, ResultLighting, numberOfPoints * sizeof(LIGHTING)))
+		{
+			printf("lighting mismatch in test %d\n", test);
+			failures++;
+		}
+	}
+	printf("%d mismatches in %d random shapes\n", failures, test);
+
+	/* benchmark */
+	{
+		FILE *file = argc > 1 ? fopen(argv[1], "rb") : NULL;
+		POINT *shapes = (POINT *)malloc(MAX_POINTS * 64 * sizeof(POINT));
+		int shapeSize[256];
+		int numberOfShapes = 0, totalPoints = 0;
+		float objectMatrix[12], viewMatrix[12];
+		LIGHT lights[8];
+		double seconds[4] = {0};
+		int repeat, s, k;
+
+		if (argc > 1 && !file)
+		{
+			fprintf(stderr, "can't open %s\n", argv[1]);
+			return 1;
+		}
+
+		while (numberOfShapes < 256)
+		{
+			int numberOfPoints;
+
+			if (file)
+			{
+				if (fread(&numberOfPoints, sizeof(int), 1, file) != 1) break;
+				if (numberOfPoints <= 0 || numberOfPoints > MAX_POINTS || totalPoints + numberOfPoints > MAX_POINTS * 64) break;
+				if (fread(&shapes[totalPoints], sizeof(POINT), numberOfPoints, file) != (size_t)numberOfPoints) break;
+			}
+			else
+			{
+				if (numberOfShapes == 64) break;
+				numberOfPoints = 8 + rand() % 600;
+				for (k = 0; k < numberOfPoints; k++)
+				{
+					shapes[totalPoints+k].vx = Random(20000);
+					shapes[totalPoints+k].vy = Random(20000);
+					shapes[totalPoints+k].vz = Random(20000);
+				}
+			}
+			shapeSize[numberOfShapes++] = numberOfPoints;
+			totalPoints += numberOfPoints;
+		}
+		if (file) fclose(file);
+
+		RandomMatrices(objectMatrix, viewMatrix);
+		RandomLights(lights, 4);
+		RandomNormals(Normals, MAX_POINTS);
+
+		for (k = 0; k < 4; k++)
+		{
+			clock_t start = clock();
+
+			for (repeat = 0; repeat < 200; repeat++)
+			{
+				POINT *shapePtr = shapes;
+
+				for (s = 0; s < numberOfShapes; s++)
+				{
+					switch (k)
+					{
+						case 0: Transform_Scalar(shapePtr, Expected, shapeSize[s], objectMatrix, viewMatrix); break;
+						case 1: Transform_Kernel(shapePtr, Result, shapeSize[s], objectMatrix, viewMatrix); break;
+						case 2: Light_Scalar(shapePtr, Normals, shapeSize[s], lights, 4, ExpectedLighting); break;
+						case 3: Light_Kernel(shapePtr, Normals, shapeSize[s], lights, 4, ResultLighting); break;
+					}
+					shapePtr += shapeSize[s];
+				}
+			}
+			seconds[k] = (double)(clock() - start) / CLOCKS_PER_SEC;
+		}
+
+		/* and the shapes themselves must come out the same */
+		{
+			POINT *shapePtr = shapes;
+
+			for (s = 0; s < numberOfShapes; s++)
+			{
+				Transform_Scalar(shapePtr, Expected, shapeSize[s], objectMatrix, viewMatrix);
+				Transform_Kernel(shapePtr, Result, shapeSize[s], objectMatrix, viewMatrix);
+				Light_Scalar(shapePtr, Normals, shapeSize[s], lights, 4, ExpectedLighting);
+				Light_Kernel(shapePtr, Normals, shapeSize[s], lights, 4, ResultLighting);
+				if (memcmp(Expected, Result, shapeSize[s] * sizeof(POINT))
+				 || memcmp(ExpectedLighting, ResultLighting, shapeSize[s] * sizeof(LIGHTING)))
+				{
+					printf("mismatch in shape %d\n", s);
+					failures++;
+				}
+				shapePtr += shapeSize[s];
+			}
+		}
+		free(shapes);
+
+		printf("%d %s shapes, %d points\n", numberOfShapes, argc > 1 ? "dumped" : "random", totalPoints);
+		printf("transform: scalar %.2f ns/point, kernel %.2f ns/point\n",
+			   seconds[0] * 1e9 / (200.0 * totalPoints), seconds[1] * 1e9 / (200.0 * totalPoints));
+		printf("lighting (4 lights): scalar %.2f ns/point, kernel %.2f ns/point\n",
+			   seconds[2] * 1e9 / (200.0 * totalPoints), seconds[3] * 1e9 / (200.0 * totalPoints));
+	}
+
+	return failures ? 1 : 0;
+	#endif
+}